@@ -8,10 +8,12 @@
 #include "mic_array/pdm_resources.h"
 #include "mic_array/dc_elimination.h"
 #include "mic_array/frame_transfer.h"
+#include "mic_array/frame_callback.h"
 #include "mic_array/shutdown.h"
 #include "mic_array/setup.h"
 #include "mic_array/etc/filters_default.h"
 #include "mic_array/mic_array_conf_struct.h"
+#include "mic_array/latency.h"
 #include "mic_array/mic_array_task.h"
 #include "mic_array/mic_array_conf_full.h"
 
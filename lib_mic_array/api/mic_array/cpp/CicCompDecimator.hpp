@@ -0,0 +1,293 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <cstring>
+#include <cassert>
+
+#include "xmath/xmath.h"
+#include "Decimator.hpp"
+
+// This has caused problems previously, so just catch the problems here.
+#if defined (MIC_COUNT)
+# error Application must not define the following as precompiler macros: MIC_COUNT, S2_DEC_FACTOR.
+#endif
+
+namespace  mic_array {
+
+namespace detail {
+
+  /**
+   * @brief Number of `1` bits in `x`.
+   */
+  static inline unsigned popcount(uint32_t x)
+  {
+    return __builtin_popcount(x);
+  }
+
+  /**
+   * @brief Binomial coefficient `n` choose `k`.
+   */
+  constexpr uint32_t binomial(unsigned n, unsigned k)
+  {
+    return (k == 0)? 1 : (binomial(n - 1, k - 1) * n) / k;
+  }
+
+}
+
+
+/**
+ * @brief CIC and compensation FIR decimator
+ *
+ * This class template is an alternative to @ref TwoStageDecimator with a
+ * lower latency. The first stage is a cascaded integrator-comb (CIC) filter of order `N`
+ * (`1 <= N <= MAX_ORDER`) with a decimation factor of 32, in place of the
+ * 256-tap bit-sliced stage-1 FIR filter. It is equivalent to `N` cascaded
+ * 32-sample moving average filters, as used by the default stage-1 filters
+ * (the 16 kHz default filter is a 4th order moving average, and the 32 kHz
+ * and 48 kHz filters are 5th order).
+ *
+ * The integrators are advanced one PDM word at a time. The contribution of
+ * the 32 PDM samples of a word to the `k`th integrator is a weighted count of
+ * its `1` bits, computed as a sum of population counts of the word masked by
+ * each bit-plane of the weights. The combs then run once per word. Integrator
+ * and comb arithmetic wraps modulo `2^32`, as usual for CIC filters.
+ *
+ * The second stage is a FIR filter, usually short, which compensates for the
+ * passband droop of the CIC filter and decimates to the output sample rate.
+ * It is the same as the stage-2 filter of @ref TwoStageDecimator.
+ *
+ * The stage-1 output for a full scale PDM input is `2^28` for any order, which
+ * is the same as for the 16 kHz default stage 1 filter (`stage1_coef`).
+ *
+ * The configuration is given in @ref mic_array_decimator_conf_t, with 2
+ * filter stages, as for @ref TwoStageDecimator except for stage 1.
+ * `filter_conf[0].cic_order` is the CIC order `N`, and `filter_conf[0].coef`
+ * is not used. `filter_conf[0].state` holds `2 * N` words of integrator and
+ * comb state per channel.
+ *
+ * Concrete implementations of this class template are meant to be used as the
+ * `TDecimator` template parameter in the @ref MicArray class template.
+ *
+ * @tparam MIC_COUNT      Number of microphone channels.
+ */
+template <unsigned MIC_COUNT>
+class CicCompDecimator
+{
+  public:
+
+    /**
+     * Largest supported CIC order.
+     */
+    static constexpr unsigned MAX_ORDER = 5;
+
+  private:
+
+    /**
+     * Number of bit-planes of the largest integrator input weight,
+     * `binomial(35 + MAX_ORDER - 4, MAX_ORDER - 1)`.
+     */
+    static constexpr unsigned MAX_PLANES = 16;
+
+    /**
+     * Stage 1 (CIC) decimator configuration and state.
+     */
+    struct {
+      /**
+       * CIC filter order.
+       */
+      unsigned order;
+      /**
+       * Pointer to integrator and comb state, `2 * order` words per channel.
+       */
+      uint32_t *state_ptr;
+      /**
+       * Per channel state size in 32-bit words.
+       */
+      unsigned state_sz;
+      /**
+       * Bit-planes of the weight of each PDM sample of a word in the input
+       * to each integrator.
+       */
+      uint32_t masks[MAX_ORDER][MAX_PLANES];
+      /**
+       * Number of bit-planes of each integrator input weight.
+       */
+      unsigned plane_count[MAX_ORDER];
+      /**
+       * Gain `binomial(31 + d, d)` over a word from integrator `j` to
+       * integrator `j + d`.
+       */
+      uint32_t gain[MAX_ORDER];
+      /**
+       * Output left shift to a full scale of `2^28`.
+       */
+      unsigned shl;
+    } stage1;
+
+    /**
+     * Stage 2 decimation configuration and state.
+     */
+    struct {
+      /**
+       * Stage 2 FIR filters
+       */
+      filter_fir_s32_t filters[MIC_COUNT];
+      /**
+       * Stage 2 filter decimation factor.
+       */
+      unsigned decimation_factor;
+    } stage2;
+
+    /**
+     * Advance the CIC filter state of one channel by one PDM word, and get
+     * the stage-1 output.
+     */
+    int32_t Stage1(uint32_t* state, uint32_t pdm_word);
+
+  public:
+
+    constexpr CicCompDecimator() noexcept { }
+
+    /**
+     * @brief Initialize the decimator from a configuration struct
+     * @ref mic_array_decimator_conf_t @p decimator_conf
+     *
+     * `filter_conf[0].cic_order` must be in the range `[1, MAX_ORDER]`, and
+     * `filter_conf[0].state_words_per_channel` at least twice that.
+     *
+     * @param decimator_conf Decimator pipeline configuration.
+     */
+    void Init(mic_array_decimator_conf_t &decimator_conf);
+
+    /**
+     * @brief Process one block of PDM data.
+     *
+     * `pdm_block` has the same layout as for
+     * @ref TwoStageDecimator::ProcessBlock().
+     *
+     * @param sample_out  Output sample vector.
+     * @param pdm_block   PDM data to be processed.
+     */
+    void ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t *pdm_block);
+};
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT>
+constexpr unsigned mic_array::CicCompDecimator<MIC_COUNT>::MAX_ORDER;
+
+
+template <unsigned MIC_COUNT>
+void mic_array::CicCompDecimator<MIC_COUNT>::Init(
+    mic_array_decimator_conf_t &decimator_conf)
+{
+  assert(decimator_conf.num_filter_stages == 2);
+
+  const mic_array_filter_conf_t& conf1 = decimator_conf.filter_conf[0];
+  assert(conf1.cic_order >= 1 && conf1.cic_order <= MAX_ORDER);
+  assert(conf1.state_words_per_channel >= 2 * conf1.cic_order);
+
+  this->stage1.order = conf1.cic_order;
+  this->stage1.state_ptr = (uint32_t*) conf1.state;
+  this->stage1.state_sz = conf1.state_words_per_channel;
+  this->stage1.shl = 28 - 5 * conf1.cic_order;
+
+  // Over a word, PDM sample s (1 oldest, 32 newest, i.e. bit s-1) adds
+  // binomial(32 - s + k, k) to the (k+1)th integrator.
+  for(unsigned k = 0; k < this->stage1.order; k++){
+    const uint32_t max_weight = detail::binomial(31 + k, k);
+    this->stage1.gain[k] = max_weight;
+    this->stage1.plane_count[k] = 0;
+    while(max_weight >> this->stage1.plane_count[k])
+      this->stage1.plane_count[k]++;
+    for(unsigned p = 0; p < this->stage1.plane_count[k]; p++){
+      uint32_t mask = 0;
+      for(unsigned s = 1; s <= 32; s++){
+        if((detail::binomial(32 - s + k, k) >> p) & 1)
+          mask |= (1u << (s - 1));
+      }
+      this->stage1.masks[k][p] = mask;
+    }
+  }
+
+  // Start from a history of 0x55555555 (i.e. silence), which fills the combs
+  // after `order` words.
+  memset(this->stage1.state_ptr, 0, sizeof(uint32_t) * MIC_COUNT * this->stage1.state_sz);
+  for(unsigned mic = 0; mic < MIC_COUNT; mic++){
+    for(unsigned k = 0; k < this->stage1.order; k++)
+      Stage1(this->stage1.state_ptr + (mic * this->stage1.state_sz), 0x55555555);
+  }
+
+  const mic_array_filter_conf_t& conf2 = decimator_conf.filter_conf[1];
+  for(int k = 0; k < MIC_COUNT; k++){
+    filter_fir_s32_init(&this->stage2.filters[k], conf2.state + (k * conf2.state_words_per_channel),
+                        conf2.num_taps, conf2.coef, conf2.shr);
+  }
+  this->stage2.decimation_factor = conf2.decimation_factor;
+}
+
+
+template <unsigned MIC_COUNT>
+int32_t mic_array::CicCompDecimator<MIC_COUNT>::Stage1(
+    uint32_t* state,
+    uint32_t pdm_word)
+{
+  const unsigned N = this->stage1.order;
+  uint32_t* integ = &state[0];
+  uint32_t* comb = &state[N];
+
+  // Over 32 samples, integrator k (from 0) becomes the sum of
+  // binomial(31 + k - j, k - j) times integrator j <= k, plus the weighted
+  // count of the new samples. Update from the last integrator back, so that
+  // the earlier integrators still hold their previous values.
+  for(int k = N - 1; k >= 0; k--){
+    uint32_t acc = 0;
+    for(unsigned p = 0; p < this->stage1.plane_count[k]; p++)
+      acc += detail::popcount(pdm_word & this->stage1.masks[k][p]) << p;
+    for(int j = 0; j <= k; j++)
+      acc += this->stage1.gain[k - j] * integ[j];
+    integ[k] = acc;
+  }
+
+  uint32_t y = integ[N - 1];
+  for(unsigned k = 0; k < N; k++){
+    const uint32_t prev = comb[k];
+    comb[k] = y;
+    y -= prev;
+  }
+
+  // y counts the 1 bits (each -1) weighted by the filter, whose taps sum to 32^N.
+  return ((int32_t) ((1u << (5 * N)) - 2 * y)) * (1 << this->stage1.shl);
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::CicCompDecimator<MIC_COUNT>
+    ::ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t *pdm_block)
+{
+  for(unsigned mic = 0; mic < MIC_COUNT; mic++){
+    uint32_t* state = this->stage1.state_ptr + (mic * this->stage1.state_sz);
+
+    for(unsigned k = 0; k < this->stage2.decimation_factor; k++){
+      int32_t streamA_sample = Stage1(state, *(pdm_block + (mic*this->stage2.decimation_factor + k)));
+
+      if(k < (this->stage2.decimation_factor-1)){
+        filter_fir_s32_add_sample(&this->stage2.filters[mic], streamA_sample);
+      } else {
+        sample_out[mic] = filter_fir_s32(&this->stage2.filters[mic], streamA_sample);
+      }
+    }
+  }
+}
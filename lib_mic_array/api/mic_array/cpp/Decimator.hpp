@@ -8,7 +8,7 @@
 #include <cassert>
 
 #include "xmath/xmath.h"
-#include "mic_array/etc/fir_1x16_bit.h"
+#include "mic_array/etc/fir_1xN_bit.h"
 
 // This has caused problems previously, so just catch the problems here.
 #if defined (MIC_COUNT)
@@ -29,6 +29,23 @@ static inline
 void shift_buffer(uint32_t* buff);
 
 
+/**
+ * @brief Delay a stream of PDM words by a number of bits.
+ *
+ * `word` is the next word of the PDM stream, and `carry` holds the previous
+ * word, which is updated to `word`. The returned word is the PDM stream
+ * delayed by `bits` PDM samples. Less significant bits are older samples.
+ *
+ * @param word  Next word of the PDM stream.
+ * @param carry Previous word of the PDM stream. Updated to `word`.
+ * @param bits  Delay in PDM samples, in the range `[0, 31]`.
+ *
+ * @returns Delayed PDM word.
+ */
+static inline
+uint32_t delay_pdm_word(uint32_t word, uint32_t& carry, unsigned bits);
+
+
 /**
  * @brief First and Second Stage Decimator
  *
@@ -43,6 +60,9 @@ void shift_buffer(uint32_t* buff);
 template <unsigned MIC_COUNT>
 class TwoStageDecimator
 {
+  static_assert(MIC_COUNT <= 32,
+      "TwoStageDecimator supports at most 32 channels.");
+
   private:
 
     /**
@@ -54,6 +74,10 @@ class TwoStageDecimator
        */
 
       const uint32_t* filter_coef;
+      /**
+       * Number of coefficient bit-planes of the stage 1 filter (`0` for 16).
+       */
+      unsigned coef_bits;
       /**
        * Pointer to filter state (PDM history) for stage-1 filter.
        */
@@ -79,6 +103,97 @@ class TwoStageDecimator
       unsigned decimation_factor;
     } stage2;
 
+    /**
+     * PDM domain delay of each channel.
+     */
+    struct {
+      /**
+       * Delay of each channel, in PDM samples.
+       */
+      unsigned bits[MIC_COUNT];
+      /**
+       * Previous PDM word of each channel.
+       */
+      uint32_t carry[MIC_COUNT];
+    } pdm_delay;
+
+    /**
+     * Channel gating.
+     */
+    struct {
+      /**
+       * Requested active channels. Bit `k` is set if channel `k` is active.
+       */
+      volatile uint32_t requested;
+      /**
+       * Active channels when the previous block was processed.
+       */
+      uint32_t current;
+    } active;
+
+    /**
+     * Progress of a reconfiguration.
+     */
+    enum {
+      RECONFIG_IDLE,
+      RECONFIG_REQUESTED,
+      RECONFIG_WARMING,
+    };
+
+    /**
+     * Reconfiguration requested with `Reconfigure()`.
+     */
+    struct {
+      /**
+       * Progress of the reconfiguration.
+       */
+      volatile unsigned state;
+      /**
+       * Stage 1 filter coefficients of the new configuration.
+       */
+      const uint32_t* stage1_coef;
+      /**
+       * Number of stage 1 coefficient bit-planes of the new configuration.
+       */
+      unsigned stage1_coef_bits;
+      /**
+       * Stage 2 filter configuration of the new configuration.
+       */
+      mic_array_filter_conf_t stage2_conf;
+      /**
+       * Stage 2 FIR filters of the new configuration, which are filled with
+       * the stage 1 output before they are used.
+       */
+      filter_fir_s32_t filters[MIC_COUNT];
+      /**
+       * Ratio of the DC gain of the new stage 1 filter to the current one
+       * (Q8.24), applied to the stage 1 output passed to `filters`.
+       */
+      int32_t stage1_gain;
+      /**
+       * Number of stage 1 output samples passed to `filters`.
+       */
+      unsigned warm_samples;
+    } reconfig;
+
+    /**
+     * Clear the filter state of a channel.
+     */
+    void ResetChannel(unsigned channel);
+
+    /**
+     * Apply the stage 1 filter to a channel's PDM history, whose newest word
+     * is `hist[0]`, and pass the result to stage 2. `k` is the index of the
+     * word within the block, and the output sample is written to
+     * `sample_out[mic]` for the last word.
+     */
+    void FilterPdmWord(
+        int32_t sample_out[MIC_COUNT],
+        unsigned mic,
+        unsigned k,
+        uint32_t* hist,
+        filter_fir_s32_t* warm_filter);
+
   public:
 
     constexpr TwoStageDecimator() noexcept { }
@@ -93,6 +208,10 @@ class TwoStageDecimator
      * and @p decimator_conf.filter_conf[1] are valid and persist for the
      * lifetime of the decimator.
      *
+     * `filter_conf[0].coef_bits` selects `fir_1x16_bit()` or one of the
+     * reduced precision `fir_1x8_bit()` family for stage 1 (see
+     * `fir_1xN_bit()`).
+     *
      * @param decimator_conf Decimator pipeline configuration.
      */
     void Init(mic_array_decimator_conf_t &decimator_conf);
@@ -126,6 +245,152 @@ class TwoStageDecimator
     void ProcessBlock(
         int32_t sample_out[MIC_COUNT],
         uint32_t *pdm_block);
+
+    /**
+     * @brief Get the output shift of the stage-2 filters.
+     *
+     * This is initially `filter_conf[1].shr` from the configuration passed to
+     * `Init()`.
+     *
+     * @returns Right-shift applied to the stage-2 filter accumulators.
+     */
+    right_shift_t GetOutputShift() const;
+
+    /**
+     * @brief Set the output shift of the stage-2 filters.
+     *
+     * Reducing the shift by 1 doubles the output (+6.02 dB) and increasing it
+     * by 1 halves it, at no extra cost per sample. Use this to apply a gain
+     * which is a power of 2 and common to all channels, rather than a sample
+     * filter. The output saturates if the gain is too large.
+     *
+     * May be called while the decimator is running. Each channel uses the new
+     * shift from its next output sample.
+     *
+     * @param shr Right-shift to apply to the stage-2 filter accumulators.
+     */
+    void SetOutputShift(right_shift_t shr);
+
+    /**
+     * @brief Delay a channel in the PDM domain.
+     *
+     * The channel's PDM stream is delayed by `bits` PDM clock periods before
+     * the stage-1 filter, for sub-sample alignment of channels (e.g. 1/192 of
+     * a sample at 16 kHz output with a 3.072 MHz PDM clock). This costs a few
+     * instructions per PDM word. For larger delays, use
+     * @ref FractionalDelaySampleFilter.
+     *
+     * All delays are 0 after `Init()`. May be called while the decimator is
+     * running.
+     *
+     * @param channel Channel to delay.
+     * @param bits    Delay in PDM clock periods, in the range `[0, 31]`.
+     */
+    void SetPdmDelay(unsigned channel, unsigned bits);
+
+    /**
+     * @brief Get the PDM domain delay of a channel.
+     *
+     * @param channel Channel of interest.
+     *
+     * @returns Delay in PDM clock periods.
+     */
+    unsigned GetPdmDelay(unsigned channel) const;
+
+    /**
+     * @brief Set which channels are decimated.
+     *
+     * Inactive channels skip both decimation stages and output `0`, so the
+     * cost of `ProcessBlock()` scales with the number of active channels.
+     * For example, a device may decimate only 2 of 8 microphones while its
+     * beamformer is idle.
+     *
+     * When a channel is made active again, its filter state is cleared
+     * before its next block, so no stale samples are output. Its output
+     * then settles within the length of the stage-2 filter (e.g. about 11
+     * output samples with the default 16 kHz filters).
+     *
+     * All channels are active after `Init()`. May be called from another
+     * thread while the decimator is running. The new mask applies from the
+     * next block.
+     *
+     * @param mask  Bit `k` set if channel `k` is to be active.
+     */
+    void SetActiveChannels(uint32_t mask);
+
+    /**
+     * @brief Get the most recently set active channel mask.
+     *
+     * @returns Bit mask, with bit `k` set if channel `k` is active.
+     */
+    uint32_t GetActiveChannels() const;
+
+    /**
+     * @brief Change the filters and stage 2 decimation factor while running.
+     *
+     * This allows the output sample rate to be changed without stopping the
+     * mic array. The new stage 2 filters are first filled with the stage 1
+     * output, alongside the current filters. The stage 1 output is scaled by
+     * the ratio of the DC gains of the new and current stage 1 filters for
+     * this. Once they are full (after `filter_conf[1].num_taps` stage 1
+     * output samples), the decimator asks for blocks of the new size (see
+     * `RequiredWordsPerChannel()`) and switches to the new configuration with
+     * the first such block. The stage 1 PDM history is kept. So the output
+     * continues at the new sample rate without a warm-up transient. Until the
+     * new stage 2 filters hold only output of the new stage 1 filter, the
+     * output differs slightly from that of a decimator which always used the
+     * new configuration (by about 1% of the signal amplitude for a 500 Hz tone
+     * with the default filters).
+     *
+     * May be called from another thread while the decimator is running, on
+     * the same tile. The new configuration is published to the decimator
+     * thread through shared memory, with compiler barriers either side of
+     * the request. The caller must wait until `IsReconfiguring()` returns
+     * `false` before calling it again, which takes
+     * `filter_conf[1].num_taps` stage 1 output samples and one PDM block.
+     *
+     * Only the coefficients and `coef_bits` of stage 1 are changed;
+     * `filter_conf[0].state` is ignored. Stage 2 uses the memory in `filter_conf[1].state`, which must
+     * not be the memory in use by the current configuration. After the
+     * switch, the output shift is `filter_conf[1].shr`.
+     *
+     * The decimator must be used with a PDM rx service which can change its
+     * block size, such as @ref StandardPdmRxService. @ref MicArray keeps the
+     * two in step.
+     *
+     * @param decimator_conf New decimator configuration.
+     */
+    void Reconfigure(mic_array_decimator_conf_t &decimator_conf);
+
+    /**
+     * @brief Whether a reconfiguration is in progress.
+     *
+     * @returns `true` from a call to `Reconfigure()` until the decimator has
+     *          switched to the new configuration.
+     */
+    bool IsReconfiguring() const;
+
+    /**
+     * @brief Get the PDM block size required by the decimator.
+     *
+     * This is the stage 2 decimation factor, unless a reconfiguration is
+     * ready to switch, in which case it is the new decimation factor.
+     *
+     * @returns Words per channel of subsequent PDM blocks.
+     */
+    unsigned RequiredWordsPerChannel() const;
+
+    /**
+     * @brief Prepare to process a PDM block of the given size.
+     *
+     * Switches to the configuration requested with `Reconfigure()` if it is
+     * ready and the block has its decimation factor. Must be called from the
+     * decimator thread before `ProcessBlock()` when the configuration may
+     * change.
+     *
+     * @param words_per_channel Words per channel in the next block.
+     */
+    void StartBlock(unsigned words_per_channel);
   };
 }
 
@@ -137,17 +402,28 @@ template <unsigned MIC_COUNT>
 void mic_array::TwoStageDecimator<MIC_COUNT>::Init(
     mic_array_decimator_conf_t &decimator_conf)
 {
+  assert(fir_1xN_bit_supported(decimator_conf.filter_conf[0].coef_bits));
   this->stage1.filter_coef = (const uint32_t*)decimator_conf.filter_conf[0].coef;
+  this->stage1.coef_bits = decimator_conf.filter_conf[0].coef_bits;
   this->stage1.pdm_history_ptr = (uint32_t*)decimator_conf.filter_conf[0].state;
   this->stage1.pdm_history_sz = decimator_conf.filter_conf[0].state_words_per_channel;
 
   memset(this->stage1.pdm_history_ptr, 0x55, sizeof(int32_t) * MIC_COUNT * this->stage1.pdm_history_sz);
 
+  for(int k = 0; k < MIC_COUNT; k++){
+    this->pdm_delay.bits[k] = 0;
+    this->pdm_delay.carry[k] = 0x55555555;
+  }
+
   for(int k = 0; k < MIC_COUNT; k++){
     filter_fir_s32_init(&this->stage2.filters[k], decimator_conf.filter_conf[1].state + (k * decimator_conf.filter_conf[1].state_words_per_channel),
                         decimator_conf.filter_conf[1].num_taps, decimator_conf.filter_conf[1].coef, decimator_conf.filter_conf[1].shr);
   }
   this->stage2.decimation_factor = decimator_conf.filter_conf[1].decimation_factor;
+
+  this->active.requested = this->active.current = (uint32_t) ((1ULL << MIC_COUNT) - 1);
+
+  this->reconfig.state = RECONFIG_IDLE;
 }
 
 
@@ -157,21 +433,218 @@ void mic_array::TwoStageDecimator<MIC_COUNT>
         int32_t sample_out[MIC_COUNT],
         uint32_t *pdm_block)
 {
+  const uint32_t active = this->active.requested;
+  const uint32_t enabled = active & ~this->active.current;
+  this->active.current = active;
+
+  if(this->reconfig.state == RECONFIG_REQUESTED){
+    // Read the configuration written by Reconfigure() only after the request
+    asm volatile("" ::: "memory");
+    const mic_array_filter_conf_t& conf = this->reconfig.stage2_conf;
+    for(int k = 0; k < MIC_COUNT; k++){
+      filter_fir_s32_init(&this->reconfig.filters[k], conf.state + (k * conf.state_words_per_channel),
+                          conf.num_taps, conf.coef, conf.shr);
+    }
+    // An all-zero PDM history (all +1) gives the DC gain of a stage 1 filter
+    uint32_t ones[8] = {0};
+    const int64_t current_gain = fir_1xN_bit(ones, this->stage1.filter_coef, this->stage1.coef_bits);
+    const int64_t new_gain = fir_1xN_bit(ones, this->reconfig.stage1_coef, this->reconfig.stage1_coef_bits);
+    this->reconfig.stage1_gain = current_gain? (int32_t) ((new_gain << 24) / current_gain)
+                                             : (1 << 24);
+    this->reconfig.warm_samples = 0;
+    this->reconfig.state = RECONFIG_WARMING;
+  }
+  const bool warming = (this->reconfig.state == RECONFIG_WARMING);
+
   for(unsigned mic = 0; mic < MIC_COUNT; mic++){
-    uint32_t* hist = this->stage1.pdm_history_ptr + (mic * this->stage1.pdm_history_sz);
+    if(!((active >> mic) & 1)){
+      sample_out[mic] = 0;
+      continue;
+    }
+
+    if((enabled >> mic) & 1)
+      this->ResetChannel(mic);
 
-    for(unsigned k = 0; k < this->stage2.decimation_factor; k++){
-      hist[0] = *(pdm_block + (mic*this->stage2.decimation_factor + k));
-      int32_t streamA_sample = fir_1x16_bit(hist, this->stage1.filter_coef);
-      shift_buffer(hist);
+    uint32_t* hist = this->stage1.pdm_history_ptr + (mic * this->stage1.pdm_history_sz);
+    const uint32_t* pdm = pdm_block + (mic * this->stage2.decimation_factor);
+    const unsigned delay_bits = this->pdm_delay.bits[mic];
+    filter_fir_s32_t* warm_filter = warming? &this->reconfig.filters[mic] : nullptr;
 
-      if(k < (this->stage2.decimation_factor-1)){
-        filter_fir_s32_add_sample(&this->stage2.filters[mic], streamA_sample);
-      } else {
-        sample_out[mic] = filter_fir_s32(&this->stage2.filters[mic], streamA_sample);
+    if(delay_bits == 0){
+      for(unsigned k = 0; k < this->stage2.decimation_factor; k++){
+        hist[0] = pdm[k];
+        this->FilterPdmWord(sample_out, mic, k, hist, warm_filter);
+      }
+      // Keep the carry current in case a delay is set later
+      this->pdm_delay.carry[mic] = pdm[this->stage2.decimation_factor - 1];
+    } else {
+      uint32_t carry = this->pdm_delay.carry[mic];
+      for(unsigned k = 0; k < this->stage2.decimation_factor; k++){
+        hist[0] = delay_pdm_word(pdm[k], carry, delay_bits);
+        this->FilterPdmWord(sample_out, mic, k, hist, warm_filter);
       }
+      this->pdm_delay.carry[mic] = carry;
     }
   }
+
+  if(warming)
+    this->reconfig.warm_samples += this->stage2.decimation_factor;
+}
+
+
+template <unsigned MIC_COUNT>
+inline void mic_array::TwoStageDecimator<MIC_COUNT>::FilterPdmWord(
+    int32_t sample_out[MIC_COUNT],
+    unsigned mic,
+    unsigned k,
+    uint32_t* hist,
+    filter_fir_s32_t* warm_filter)
+{
+  int32_t streamA_sample = fir_1xN_bit(hist, this->stage1.filter_coef, this->stage1.coef_bits);
+  shift_buffer(hist);
+
+  if(warm_filter)
+    filter_fir_s32_add_sample(warm_filter,
+        (int32_t) ((((int64_t) streamA_sample) * this->reconfig.stage1_gain) >> 24));
+
+  if(k < (this->stage2.decimation_factor-1)){
+    filter_fir_s32_add_sample(&this->stage2.filters[mic], streamA_sample);
+  } else {
+    sample_out[mic] = filter_fir_s32(&this->stage2.filters[mic], streamA_sample);
+  }
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::TwoStageDecimator<MIC_COUNT>::ResetChannel(
+    unsigned channel)
+{
+  memset(this->stage1.pdm_history_ptr + (channel * this->stage1.pdm_history_sz), 0x55,
+         sizeof(int32_t) * this->stage1.pdm_history_sz);
+  this->pdm_delay.carry[channel] = 0x55555555;
+  memset(this->stage2.filters[channel].state, 0,
+         sizeof(int32_t) * this->stage2.filters[channel].num_taps);
+}
+
+
+template <unsigned MIC_COUNT>
+right_shift_t mic_array::TwoStageDecimator<MIC_COUNT>::GetOutputShift() const
+{
+  return this->stage2.filters[0].shift;
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::TwoStageDecimator<MIC_COUNT>::SetOutputShift(
+    right_shift_t shr)
+{
+  assert(shr >= 0);
+  for(int k = 0; k < MIC_COUNT; k++)
+    this->stage2.filters[k].shift = shr;
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::TwoStageDecimator<MIC_COUNT>::SetPdmDelay(
+    unsigned channel,
+    unsigned bits)
+{
+  assert(channel < MIC_COUNT);
+  assert(bits < 32);
+  this->pdm_delay.bits[channel] = bits;
+}
+
+
+template <unsigned MIC_COUNT>
+unsigned mic_array::TwoStageDecimator<MIC_COUNT>::GetPdmDelay(
+    unsigned channel) const
+{
+  assert(channel < MIC_COUNT);
+  return this->pdm_delay.bits[channel];
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::TwoStageDecimator<MIC_COUNT>::SetActiveChannels(
+    uint32_t mask)
+{
+  this->active.requested = mask & (uint32_t) ((1ULL << MIC_COUNT) - 1);
+}
+
+
+template <unsigned MIC_COUNT>
+uint32_t mic_array::TwoStageDecimator<MIC_COUNT>::GetActiveChannels() const
+{
+  return this->active.requested;
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::TwoStageDecimator<MIC_COUNT>::Reconfigure(
+    mic_array_decimator_conf_t &decimator_conf)
+{
+  assert(this->reconfig.state == RECONFIG_IDLE); // Previous reconfiguration still in progress
+  assert(decimator_conf.num_filter_stages == 2);
+  assert(decimator_conf.filter_conf[0].state_words_per_channel == this->stage1.pdm_history_sz);
+  assert(fir_1xN_bit_supported(decimator_conf.filter_conf[0].coef_bits));
+
+  this->reconfig.stage1_coef = (const uint32_t*)decimator_conf.filter_conf[0].coef;
+  this->reconfig.stage1_coef_bits = decimator_conf.filter_conf[0].coef_bits;
+  this->reconfig.stage2_conf = decimator_conf.filter_conf[1];
+  // Publish the new configuration before the request which makes it visible
+  // to the decimator thread
+  asm volatile("" ::: "memory");
+  this->reconfig.state = RECONFIG_REQUESTED;
+}
+
+
+template <unsigned MIC_COUNT>
+bool mic_array::TwoStageDecimator<MIC_COUNT>::IsReconfiguring() const
+{
+  return this->reconfig.state != RECONFIG_IDLE;
+}
+
+
+template <unsigned MIC_COUNT>
+unsigned mic_array::TwoStageDecimator<MIC_COUNT>::RequiredWordsPerChannel() const
+{
+  if(this->reconfig.state == RECONFIG_WARMING
+      && this->reconfig.warm_samples >= this->reconfig.stage2_conf.num_taps)
+    return this->reconfig.stage2_conf.decimation_factor;
+  return this->stage2.decimation_factor;
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::TwoStageDecimator<MIC_COUNT>::StartBlock(
+    unsigned words_per_channel)
+{
+  if(this->reconfig.state == RECONFIG_WARMING
+      && this->reconfig.warm_samples >= this->reconfig.stage2_conf.num_taps
+      && words_per_channel == this->reconfig.stage2_conf.decimation_factor){
+    this->stage1.filter_coef = this->reconfig.stage1_coef;
+    this->stage1.coef_bits = this->reconfig.stage1_coef_bits;
+    for(int k = 0; k < MIC_COUNT; k++)
+      this->stage2.filters[k] = this->reconfig.filters[k];
+    this->stage2.decimation_factor = this->reconfig.stage2_conf.decimation_factor;
+    // Reconfigure() may overwrite the configuration as soon as this is seen
+    asm volatile("" ::: "memory");
+    this->reconfig.state = RECONFIG_IDLE;
+  }
+  assert(words_per_channel == this->stage2.decimation_factor);
+}
+
+
+static inline
+uint32_t mic_array::delay_pdm_word(
+    uint32_t word,
+    uint32_t& carry,
+    unsigned bits)
+{
+  // Older samples are in less significant bits, so the stream is (word:carry)
+  const uint64_t stream = (((uint64_t) word) << 32) | carry;
+  carry = word;
+  return (uint32_t) (stream >> (32 - bits));
 }
 
 
@@ -9,10 +9,15 @@
 #include <cstdio>
 #include <type_traits>
 #include <functional>
+#include <tuple>
 
 #include "PdmRx.hpp"
 #include "Decimator.hpp"
 #include "ThreeStageDecimator.hpp"
+#include "SummingDecimator.hpp"
+#include "MultiRateDecimator.hpp"
+#include "CicCompDecimator.hpp"
+#include "MultiStageDecimator.hpp"
 #include "SampleFilter.hpp"
 #include "OutputHandler.hpp"
 
@@ -30,6 +35,142 @@ using namespace std;
 
 namespace  mic_array {
 
+  namespace detail {
+
+    /**
+     * @brief Pass a sample to an output handler which applies the sample
+     *        filter to each completed frame.
+     *
+     * Selected when `TOutputHandler` has `OutputSample(sample, filter)` for
+     * this `TSampleFilter`, i.e. the filter provides `FilterFrame()`.
+     */
+    template <class TOutputHandler, class TSampleFilter>
+    auto output_filtered_sample(TOutputHandler& output_handler,
+                                TSampleFilter& sample_filter,
+                                int32_t sample[], int)
+        -> decltype(output_handler.OutputSample(sample, sample_filter))
+    {
+      return output_handler.OutputSample(sample, sample_filter);
+    }
+
+    /**
+     * @brief Apply the sample filter to a sample and pass it to an output
+     *        handler.
+     */
+    template <class TOutputHandler, class TSampleFilter>
+    bool output_filtered_sample(TOutputHandler& output_handler,
+                                TSampleFilter& sample_filter,
+                                int32_t sample[], long)
+    {
+      sample_filter.Filter(sample);
+      return output_handler.OutputSample(sample);
+    }
+
+    /**
+     * @brief Process a block of PDM data with a decimator which may not
+     *        output a sample for every block.
+     *
+     * Selected when `TDecimator::ProcessBlock()` returns `bool` (e.g.
+     * @ref ThreeStageDecimator with a resampling third stage), which is
+     * whether a sample was output.
+     */
+    template <class TDecimator>
+    auto process_block(TDecimator& decimator,
+                       int32_t sample_out[],
+                       uint32_t* pdm_block, int)
+        -> typename std::enable_if<std::is_same<decltype(decimator.ProcessBlock(sample_out, pdm_block)),
+                                                bool>::value, bool>::type
+    {
+      return decimator.ProcessBlock(sample_out, pdm_block);
+    }
+
+    /**
+     * @brief Process a block of PDM data with a decimator which outputs a
+     *        sample for every block.
+     */
+    template <class TDecimator>
+    bool process_block(TDecimator& decimator,
+                       int32_t sample_out[],
+                       uint32_t* pdm_block, long)
+    {
+      decimator.ProcessBlock(sample_out, pdm_block);
+      return true;
+    }
+
+    /**
+     * @brief Keep the PDM block size in step with the decimator's
+     *        configuration.
+     *
+     * Selected when `TDecimator` and `TPdmRx` both support changing the
+     * block size at run time (e.g. @ref TwoStageDecimator and
+     * @ref StandardPdmRxService). Tells the decimator the size of the block
+     * just received, and the PDM rx service the size of the blocks the
+     * decimator requires next.
+     */
+    template <class TDecimator, class TPdmRx>
+    auto update_block_size(TDecimator& decimator,
+                           TPdmRx& pdm_rx, int)
+        -> decltype(decimator.StartBlock(pdm_rx.GetWordsPerChannel()),
+                    pdm_rx.SetWordsPerChannel(decimator.RequiredWordsPerChannel()))
+    {
+      decimator.StartBlock(pdm_rx.GetWordsPerChannel());
+      return pdm_rx.SetWordsPerChannel(decimator.RequiredWordsPerChannel());
+    }
+
+    /**
+     * @brief Fixed PDM block size.
+     */
+    template <class TDecimator, class TPdmRx>
+    void update_block_size(TDecimator& decimator,
+                           TPdmRx& pdm_rx, long)
+    {
+    }
+
+    /**
+     * @brief Pass a sample of branch `branch` to the output handler at that
+     *        index of `handlers`, unless it has already been shut down.
+     */
+    template <unsigned I, class TTuple>
+    typename std::enable_if<(I == std::tuple_size<TTuple>::value)>::type
+    output_branch_sample(TTuple& handlers, unsigned branch,
+                         int32_t sample[], bool shutdown[])
+    {
+    }
+
+    template <unsigned I, class TTuple>
+    typename std::enable_if<(I < std::tuple_size<TTuple>::value)>::type
+    output_branch_sample(TTuple& handlers, unsigned branch,
+                         int32_t sample[], bool shutdown[])
+    {
+      if(branch != I){
+        output_branch_sample<I + 1>(handlers, branch, sample, shutdown);
+      } else if(!shutdown[I]){
+        shutdown[I] = std::get<I>(handlers).OutputSample(sample);
+      }
+    }
+
+    /**
+     * @brief Call `CompleteShutdown()` on the output handler for `branch` in
+     * `handlers`.
+     */
+    template <unsigned I, class TTuple>
+    typename std::enable_if<(I == std::tuple_size<TTuple>::value)>::type
+    complete_branch_shutdown(TTuple& handlers, unsigned branch)
+    {
+    }
+
+    template <unsigned I, class TTuple>
+    typename std::enable_if<(I < std::tuple_size<TTuple>::value)>::type
+    complete_branch_shutdown(TTuple& handlers, unsigned branch)
+    {
+      if(branch != I)
+        complete_branch_shutdown<I + 1>(handlers, branch);
+      else
+        std::get<I>(handlers).CompleteShutdown();
+    }
+
+  }
+
   /**
    * @brief Represents the microphone array component of an application.
    *
@@ -92,6 +233,12 @@ namespace  mic_array {
        * The size and formatting of the PDM block expected by the decimator
        * depends on its particular implementation.
        *
+       * A decimator whose output sample rate is not an integer fraction of
+       * the PDM block rate (e.g. @ref ThreeStageDecimator with a resampling
+       * third stage) may instead return `bool` from `ProcessBlock()`. It then
+       * returns `false` for blocks which do not produce an output sample, and
+       * the sample filter and output handler are not called for them.
+       *
        */
       TDecimator Decimator;
 
@@ -121,6 +268,23 @@ namespace  mic_array {
        * eliminated at build time. That way no addition run-time compute or
        * memory costs need be introduced for the additional flexibility.
        *
+       * A sample filter may instead (or additionally) implement a frame-level
+       * interface:
+       * @code{.cpp}
+       * template <unsigned SAMPLE_COUNT>
+       * void FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+       * @endcode
+       *
+       * If it does, and `TOutputHandler` accepts the filter through
+       * `OutputSample(sample, filter)` (as @ref FrameOutputHandler does), then
+       * `Filter()` is not called. Instead the output handler calls
+       * `FilterFrame()` once on each completed frame, before the frame is
+       * transmitted. This allows block implementations of filters and avoids a
+       * call per sample. Which interface is used is determined at compile time.
+       * The filtering of a whole frame is then done in the sample period in
+       * which the frame completes, rather than spread over every sample
+       * period, and delays the transmission of the frame by that time.
+       *
        * Even though `TDecimator` and `TSampleFilter` both (possibly) apply
        * filtering, they are separate components of the `MicArray` because they
        * are conceptually independent.
@@ -179,6 +343,88 @@ namespace  mic_array {
       void ThreadEntry();
   };
 
+  /**
+   * @brief Represents a microphone array component with several output
+   *        sample rates.
+   *
+   * This is the multi-rate counterpart of @ref MicArray. A single decimation
+   * thread runs a @ref MultiRateDecimator, and delivers the samples of each of
+   * its branches to a separate output handler. The output handler of branch
+   * `b` is the `b`th of `TOutputHandlers`, and the decimator must have one
+   * branch for each output handler.
+   *
+   * There is no sample filter component; any filtering of a branch's output
+   * may be applied by its output handler.
+   *
+   * @tparam MIC_COUNT        Number of microphone output channels from the
+   *                          mic array component.
+   * @tparam TDecimator       Type for the decimator. See
+   *                          @ref MultiRateDecimator.
+   * @tparam TPdmRx           Type for the PDM rx service used. See
+   *                          @ref MicArray::PdmRx.
+   * @tparam TOutputHandlers  Types for the output handler of each branch. See
+   *                          @ref MicArray::OutputHandler.
+   */
+  template <unsigned MIC_COUNT,
+            class TDecimator,
+            class TPdmRx,
+            class... TOutputHandlers>
+  class MultiRateMicArray
+  {
+
+    public:
+
+      /**
+       * @brief Number of output sample rates.
+       */
+      static constexpr unsigned BRANCH_COUNT = sizeof...(TOutputHandlers);
+
+      /**
+       * @brief The PDM rx service.
+       *
+       * As @ref MicArray::PdmRx. It must deliver blocks of
+       * `Decimator.BlockWords()` words per channel.
+       */
+      TPdmRx PdmRx;
+
+      /**
+       * @brief The Decimator.
+       *
+       * `TDecimator` must implement `ProcessBlock()` as
+       * @ref MultiRateDecimator::ProcessBlock() does.
+       */
+      TDecimator Decimator;
+
+      /**
+       * @brief The output handlers, one for each branch of the decimator.
+       *
+       * Each must implement `OutputSample()` and `CompleteShutdown()` as for
+       * @ref MicArray::OutputHandler.
+       */
+      std::tuple<TOutputHandlers...> OutputHandlers;
+
+    public:
+
+      /**
+       * @brief Construct a `MultiRateMicArray`.
+       */
+      MultiRateMicArray() {}
+
+      /**
+       * @brief Entry point for the decimation thread.
+       *
+       * Loops until every output handler has reported shutdown, collecting
+       * blocks of PDM data from @ref PdmRx, decimating them with
+       * @ref Decimator, and delivering the samples of each branch to its
+       * output handler. Once a branch's output handler has reported shutdown,
+       * no further samples are passed to it, and its `CompleteShutdown()` is
+       * called, so the branches may be shut down one at a time from a single
+       * thread. The last branch's `CompleteShutdown()` is called after
+       * @ref PdmRx has been shut down.
+       */
+      void ThreadEntry();
+  };
+
 }
 
 //////////////////////////////////////////////
@@ -199,12 +445,56 @@ void mic_array::MicArray<MIC_COUNT,TDecimator,TPdmRx,
 
   while(!shutdown){
     uint32_t *pdm_samples = PdmRx.GetPdmBlock();
-    Decimator.ProcessBlock(sample_out, pdm_samples);
-    SampleFilter.Filter(sample_out);
-    shutdown = OutputHandler.OutputSample(sample_out);
+    detail::update_block_size(Decimator, PdmRx, 0);
+    if(detail::process_block(Decimator, sample_out, pdm_samples, 0))
+      shutdown = detail::output_filtered_sample(OutputHandler, SampleFilter,
+                                                sample_out, 0);
   }
   PdmRx.Shutdown();
   OutputHandler.CompleteShutdown(); // Exchange end token with the app to close channel and indicate completion.
                                     // ma_shutdown() will now return
   return;
 }
+
+
+template <unsigned MIC_COUNT,
+          class TDecimator,
+          class TPdmRx,
+          class... TOutputHandlers>
+constexpr unsigned mic_array::MultiRateMicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                                TOutputHandlers...>::BRANCH_COUNT;
+
+
+template <unsigned MIC_COUNT,
+          class TDecimator,
+          class TPdmRx,
+          class... TOutputHandlers>
+void mic_array::MultiRateMicArray<MIC_COUNT,TDecimator,TPdmRx,
+                                  TOutputHandlers...>::ThreadEntry()
+{
+  bool shutdown[BRANCH_COUNT] = {false};
+  unsigned remaining = BRANCH_COUNT;
+  unsigned last_branch = 0;
+
+  while(remaining){
+    uint32_t *pdm_samples = PdmRx.GetPdmBlock();
+    Decimator.ProcessBlock(pdm_samples,
+        [&](unsigned branch, int32_t sample[MIC_COUNT]){
+          const bool was_shutdown = shutdown[branch];
+          detail::output_branch_sample<0>(OutputHandlers, branch, sample, shutdown);
+          if(shutdown[branch] && !was_shutdown){
+            // Complete a branch's shutdown straight away, so that its
+            // ma_shutdown() returns without waiting for the other branches,
+            // which may be read by the same thread. The last branch is
+            // completed once PDM rx has stopped, as for MicArray.
+            if(--remaining)
+              detail::complete_branch_shutdown<0>(OutputHandlers, branch);
+            else
+              last_branch = branch;
+          }
+        });
+  }
+  PdmRx.Shutdown();
+  detail::complete_branch_shutdown<0>(OutputHandlers, last_branch);
+  return;
+}
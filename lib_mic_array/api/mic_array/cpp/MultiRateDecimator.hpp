@@ -0,0 +1,250 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <cassert>
+
+#include "xmath/xmath.h"
+#include "mic_array/etc/fir_1xN_bit.h"
+#include "Decimator.hpp"
+
+// This has caused problems previously, so just catch the problems here.
+#if defined (MIC_COUNT)
+# error Application must not define the following as precompiler macros: MIC_COUNT, S2_DEC_FACTOR.
+#endif
+
+namespace  mic_array {
+
+namespace detail {
+
+  /**
+   * @brief Greatest common divisor of `a` and `b`.
+   */
+  constexpr unsigned gcd(unsigned a, unsigned b)
+  {
+    return (b == 0)? a : gcd(b, a % b);
+  }
+
+}
+
+
+/**
+ * @brief Multi-rate decimator
+ *
+ * This class template decimates `MIC_COUNT` microphone channels to
+ * `BRANCH_COUNT` output sample rates at once. The stage-1 filter, which
+ * dominates the cost of a @ref TwoStageDecimator, is run only once for each
+ * PDM word of each channel, and its output is fed to a stage-2 filter for
+ * each output rate (a "branch"). Each branch has its own stage-2 filter
+ * coefficients, decimation factor and output shift. For example, 48 kHz and
+ * 16 kHz outputs for a wake word engine and a voice pipeline cost one
+ * stage-1 pass and two stage-2 filters, rather than two complete decimators.
+ *
+ * The configuration is given in @ref mic_array_decimator_conf_t, with
+ * `1 + BRANCH_COUNT` filter stages. `filter_conf[0]` is the shared stage-1
+ * filter, as for @ref TwoStageDecimator, and `filter_conf[1 + b]` is the
+ * stage-2 filter of branch `b`. The shared stage-1 filter must have a cutoff
+ * suitable for the highest output rate, so a lower rate branch is at the
+ * gain of this stage-1 filter, which may differ from that of the stage-1
+ * filter usually used at that rate. For example, with `stage1_48k_coefs` the
+ * 16 kHz output of `stage2_coef` is about 4.4 dB louder than that of the
+ * default 16 kHz decimator. This can be corrected with the branch's `shr`.
+ *
+ * Each block of PDM data holds `BlockWords()` words per channel, the least
+ * common multiple of the branches' decimation factors, in the same layout
+ * as for @ref TwoStageDecimator. So, each call to `ProcessBlock()` outputs
+ * `BlockWords() / DecimationFactor(b)` samples of branch `b`.
+ *
+ * Concrete implementations of this class template are meant to be used as the
+ * `TDecimator` template parameter in the @ref MultiRateMicArray class template.
+ *
+ * @tparam MIC_COUNT      Number of microphone channels.
+ * @tparam BRANCH_COUNT   Number of output sample rates.
+ */
+template <unsigned MIC_COUNT, unsigned BRANCH_COUNT>
+class MultiRateDecimator
+{
+  private:
+
+    /**
+     * Stage 1 decimator configuration and state.
+     */
+    struct {
+      /**
+       * Pointer to filter coefficients for Stage 1
+       */
+      const uint32_t* filter_coef;
+      /**
+       * Number of coefficient bit-planes of the stage 1 filter (`0` for 16).
+       */
+      unsigned coef_bits;
+      /**
+       * Pointer to filter state (PDM history) for stage-1 filters.
+       */
+      uint32_t *pdm_history_ptr;
+      /**
+       * Per channel filter state (PDM history) size in 32-bit words.
+       */
+      unsigned pdm_history_sz;
+    } stage1;
+
+    /**
+     * Stage 2 decimation configuration and state of each branch.
+     */
+    struct {
+      /**
+       * Stage 2 FIR filters
+       */
+      filter_fir_s32_t filters[MIC_COUNT];
+      /**
+       * Stage 2 filter decimation factor.
+       */
+      unsigned decimation_factor;
+    } stage2[BRANCH_COUNT];
+
+    /**
+     * Number of PDM words per channel in each block.
+     */
+    unsigned block_words;
+
+  public:
+
+    constexpr MultiRateDecimator() noexcept { }
+
+    /**
+     * @brief Initialize the decimator from a configuration struct
+     * @ref mic_array_decimator_conf_t @p decimator_conf
+     *
+     * `decimator_conf.num_filter_stages` must be `1 + BRANCH_COUNT`. The
+     * stage-1 state in `filter_conf[0]` must have room for `MIC_COUNT`
+     * channels, as must the stage-2 state of each branch.
+     *
+     * @param decimator_conf Decimator pipeline configuration.
+     */
+    void Init(mic_array_decimator_conf_t &decimator_conf);
+
+    /**
+     * @brief Get the number of PDM words per channel in each block.
+     *
+     * The PDM rx service must be configured to capture blocks of this many
+     * words per channel.
+     */
+    unsigned BlockWords() const;
+
+    /**
+     * @brief Get the stage-2 decimation factor of a branch.
+     *
+     * @param branch  Branch of interest.
+     */
+    unsigned DecimationFactor(unsigned branch) const;
+
+    /**
+     * @brief Process one block of PDM data.
+     *
+     * `pdm_block` holds `BlockWords()` words for each of the `MIC_COUNT`
+     * channels. Each time a branch completes an output sample, `output` is
+     * called with the branch index and the (multi-channel) sample:
+     * @code{.cpp}
+     * void output(unsigned branch, int32_t sample[MIC_COUNT]);
+     * @endcode
+     *
+     * Samples are output in time order. Where several branches complete a
+     * sample after the same PDM word, they are output in branch order.
+     *
+     * @param pdm_block   PDM data to be processed.
+     * @param output      Callable which receives each output sample.
+     */
+    template <class TOutput>
+    void ProcessBlock(
+        uint32_t *pdm_block,
+        TOutput&& output);
+};
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+
+template <unsigned MIC_COUNT, unsigned BRANCH_COUNT>
+void mic_array::MultiRateDecimator<MIC_COUNT,BRANCH_COUNT>::Init(
+    mic_array_decimator_conf_t &decimator_conf)
+{
+  assert(decimator_conf.num_filter_stages == 1 + BRANCH_COUNT);
+
+  assert(fir_1xN_bit_supported(decimator_conf.filter_conf[0].coef_bits));
+  this->stage1.filter_coef = (const uint32_t*)decimator_conf.filter_conf[0].coef;
+  this->stage1.coef_bits = decimator_conf.filter_conf[0].coef_bits;
+  this->stage1.pdm_history_ptr = (uint32_t*)decimator_conf.filter_conf[0].state;
+  this->stage1.pdm_history_sz = decimator_conf.filter_conf[0].state_words_per_channel;
+
+  memset(this->stage1.pdm_history_ptr, 0x55, sizeof(int32_t) * MIC_COUNT * this->stage1.pdm_history_sz);
+
+  this->block_words = 1;
+  for(unsigned b = 0; b < BRANCH_COUNT; b++){
+    const mic_array_filter_conf_t& conf = decimator_conf.filter_conf[1 + b];
+    assert(conf.decimation_factor > 0);
+
+    for(int k = 0; k < MIC_COUNT; k++){
+      filter_fir_s32_init(&this->stage2[b].filters[k], conf.state + (k * conf.state_words_per_channel),
+                          conf.num_taps, conf.coef, conf.shr);
+    }
+    this->stage2[b].decimation_factor = conf.decimation_factor;
+
+    this->block_words = (this->block_words / detail::gcd(this->block_words, conf.decimation_factor))
+                      * conf.decimation_factor;
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned BRANCH_COUNT>
+unsigned mic_array::MultiRateDecimator<MIC_COUNT,BRANCH_COUNT>::BlockWords() const
+{
+  return this->block_words;
+}
+
+
+template <unsigned MIC_COUNT, unsigned BRANCH_COUNT>
+unsigned mic_array::MultiRateDecimator<MIC_COUNT,BRANCH_COUNT>::DecimationFactor(
+    unsigned branch) const
+{
+  assert(branch < BRANCH_COUNT);
+  return this->stage2[branch].decimation_factor;
+}
+
+
+template <unsigned MIC_COUNT, unsigned BRANCH_COUNT>
+template <class TOutput>
+void mic_array::MultiRateDecimator<MIC_COUNT,BRANCH_COUNT>
+    ::ProcessBlock(
+        uint32_t *pdm_block,
+        TOutput&& output)
+{
+  int32_t sample_out[BRANCH_COUNT][MIC_COUNT];
+
+  for(unsigned k = 0; k < this->block_words; k++){
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++){
+      uint32_t* hist = this->stage1.pdm_history_ptr + (mic * this->stage1.pdm_history_sz);
+      hist[0] = *(pdm_block + (mic*this->block_words + k));
+      int32_t streamA_sample = fir_1xN_bit(hist, this->stage1.filter_coef, this->stage1.coef_bits);
+      shift_buffer(hist);
+
+      for(unsigned b = 0; b < BRANCH_COUNT; b++){
+        if((k + 1) % this->stage2[b].decimation_factor){
+          filter_fir_s32_add_sample(&this->stage2[b].filters[mic], streamA_sample);
+        } else {
+          sample_out[b][mic] = filter_fir_s32(&this->stage2[b].filters[mic], streamA_sample);
+        }
+      }
+    }
+
+    for(unsigned b = 0; b < BRANCH_COUNT; b++){
+      if(!((k + 1) % this->stage2[b].decimation_factor))
+        output(b, sample_out[b]);
+    }
+  }
+}
@@ -0,0 +1,446 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <cstring>
+#include <cassert>
+#include <type_traits>
+
+#include "xmath/xmath.h"
+#include "mic_array/etc/fir_1xN_bit.h"
+
+// This has caused problems previously, so just catch the problems here.
+#if defined (MIC_COUNT)
+# error Application must not define the following as precompiler macros: MIC_COUNT, S2_DEC_FACTOR.
+#endif
+
+namespace  mic_array {
+
+namespace detail {
+
+  /**
+   * @brief 32-bit FIR filter stage of a @ref MultiStageDecimator
+   *
+   * The filters of one PCM stage for each channel, using `filter_fir_s32_t`
+   * from lib_xcore_math, as for the second stage of @ref TwoStageDecimator.
+   */
+  template <unsigned MIC_COUNT>
+  struct FirStageS32
+  {
+    /**
+     * Type of the samples into and out of the filters.
+     */
+    using sample_t = int32_t;
+
+    /**
+     * FIR filter of each channel.
+     */
+    filter_fir_s32_t filters[MIC_COUNT];
+
+    /**
+     * Initialize the filters from the stage configuration.
+     */
+    void Init(const mic_array_filter_conf_t& conf)
+    {
+      for(int k = 0; k < MIC_COUNT; k++){
+        filter_fir_s32_init(&this->filters[k], conf.state + (k * conf.state_words_per_channel),
+                            conf.num_taps, conf.coef, conf.shr);
+      }
+    }
+
+    /**
+     * Convert a stage 1 output sample to a filter input sample.
+     */
+    static sample_t FromStage1(int32_t sample)
+    {
+      return sample;
+    }
+
+    /**
+     * Convert a filter output sample to a decimator output sample.
+     */
+    static int32_t ToOutput(sample_t sample)
+    {
+      return sample;
+    }
+
+    /**
+     * Add a sample to the filter of channel `mic` without computing an output.
+     */
+    void AddSample(unsigned mic, sample_t sample)
+    {
+      filter_fir_s32_add_sample(&this->filters[mic], sample);
+    }
+
+    /**
+     * Add a sample to the filter of channel `mic` and compute an output.
+     */
+    sample_t Filter(unsigned mic, sample_t sample)
+    {
+      return filter_fir_s32(&this->filters[mic], sample);
+    }
+  };
+
+  /**
+   * @brief 16-bit FIR filter stage of a @ref MultiStageDecimator
+   *
+   * The filters of one PCM stage for each channel, using `filter_fir_s16_t`
+   * from lib_xcore_math. This halves the size of the filter state and
+   * coefficients, and the cost of filtering, at the expense of precision.
+   *
+   * The stage configuration's `coef` points to `num_taps` 16-bit coefficients,
+   * and its `state` to `state_words_per_channel` 32-bit words per channel,
+   * which must be at least `(num_taps + 1) / 2`. `shr` is the right-shift
+   * applied to the 32-bit accumulator to get the 16-bit output.
+   *
+   * Stage 1 outputs are rounded to 16 bits by a right-shift of `STAGE1_SHR`
+   * bits, which keeps the full scale output of any of the default stage 1
+   * filters in range. Outputs of the last stage are left-shifted by 16 bits.
+   * `python/stage2.py --s16` exports coefficients and shifts for which the
+   * output has the same scale as for @ref FirStageS32.
+   */
+  template <unsigned MIC_COUNT>
+  struct FirStageS16
+  {
+    /**
+     * Right-shift from stage 1 output samples to 16-bit samples.
+     */
+    static constexpr right_shift_t STAGE1_SHR = 14;
+
+    /**
+     * Type of the samples into and out of the filters.
+     */
+    using sample_t = int16_t;
+
+    /**
+     * FIR filter of each channel.
+     */
+    filter_fir_s16_t filters[MIC_COUNT];
+
+    /**
+     * Initialize the filters from the stage configuration.
+     */
+    void Init(const mic_array_filter_conf_t& conf)
+    {
+      assert(2 * conf.state_words_per_channel >= conf.num_taps);
+      for(int k = 0; k < MIC_COUNT; k++){
+        filter_fir_s16_init(&this->filters[k], (int16_t*) (conf.state + (k * conf.state_words_per_channel)),
+                            conf.num_taps, (const int16_t*) conf.coef, conf.shr);
+      }
+    }
+
+    /**
+     * Convert a stage 1 output sample to a filter input sample.
+     */
+    static sample_t FromStage1(int32_t sample)
+    {
+      return (sample_t) ((sample + (1 << (STAGE1_SHR - 1))) >> STAGE1_SHR);
+    }
+
+    /**
+     * Convert a filter output sample to a decimator output sample.
+     */
+    static int32_t ToOutput(sample_t sample)
+    {
+      return ((int32_t) sample) * (1 << 16);
+    }
+
+    /**
+     * Add a sample to the filter of channel `mic` without computing an output.
+     */
+    void AddSample(unsigned mic, sample_t sample)
+    {
+      filter_fir_s16_add_sample(&this->filters[mic], sample);
+    }
+
+    /**
+     * Add a sample to the filter of channel `mic` and compute an output.
+     */
+    sample_t Filter(unsigned mic, sample_t sample)
+    {
+      return filter_fir_s16(&this->filters[mic], sample);
+    }
+  };
+
+}
+
+
+/**
+ * @brief Multi-stage decimator
+ *
+ * This class template represents a decimator with any number of stages, from
+ * 2 up to `MAX_STAGES`, which converts a stream of PDM samples to a lower
+ * sample rate stream of PCM samples.
+ *
+ * The first stage is the same 256-tap bit-sliced FIR filter as the first stage
+ * of @ref TwoStageDecimator, decimating by 32. It is followed by a cascade of
+ * decimating FIR filters on PCM samples, by default each the same as the
+ * second stage of @ref TwoStageDecimator. Several short filters with small
+ * decimation factors can be cheaper than one or two long filters for the same
+ * overall decimation factor, e.g. for 8 kHz output.
+ *
+ * Only the largest number of stages, `MAX_STAGES`, is fixed at compile time.
+ * It sets the length of the list of PCM stages, and the calls from one stage
+ * to the next are resolved at compile time. The number of stages actually
+ * used is read at run time from
+ * @ref mic_array_decimator_conf_t::num_filter_stages, and each stage checks
+ * whether it is the last in use before passing its output on.
+ * @ref ThreeStageDecimator runs its decimating stages with a
+ * `MultiStageDecimator<MIC_COUNT, 3>`.
+ *
+ * The PCM stages are implemented by `TFirStage`, which is
+ * @ref detail::FirStageS32 by default. @ref MultiStageDecimatorS16 uses
+ * @ref detail::FirStageS16 instead, for 16-bit coefficients and state.
+ *
+ * Concrete implementations of this class template are meant to be used as the
+ * `TDecimator` template parameter in the @ref MicArray class template.
+ *
+ * @tparam MIC_COUNT      Number of microphone channels.
+ * @tparam MAX_STAGES     Largest number of filter stages, including stage 1.
+ * @tparam TFirStage      Filters of each PCM stage.
+ */
+template <unsigned MIC_COUNT, unsigned MAX_STAGES,
+          class TFirStage = detail::FirStageS32<MIC_COUNT>>
+class MultiStageDecimator
+{
+  static_assert(MAX_STAGES >= 2, "MultiStageDecimator needs at least 2 stages");
+
+  private:
+
+    using sample_t = typename TFirStage::sample_t;
+
+    /**
+     * Stage 1 decimator configuration and state.
+     */
+    struct {
+      /**
+       * Pointer to filter coefficients for Stage 1
+       */
+      const uint32_t* filter_coef;
+      /**
+       * Number of coefficient bit-planes of the stage 1 filter (`0` for 16).
+       */
+      unsigned coef_bits;
+      /**
+       * Pointer to filter state (PDM history) for stage-1 filter.
+       */
+      uint32_t *pdm_history_ptr;
+      /**
+       * Per-mic channel filter state (PDM history) size in 32-bit words for stage-1 filter.
+       */
+      unsigned pdm_history_sz;
+    } stage1;
+
+    /**
+     * Configuration and state of each PCM stage, i.e. stages 2 to
+     * `MAX_STAGES`.
+     */
+    struct {
+      /**
+       * FIR filters of this stage.
+       */
+      TFirStage fir;
+      /**
+       * Decimation factor of this stage.
+       */
+      unsigned decimation_factor;
+    } stage[MAX_STAGES - 1];
+
+    /**
+     * Number of filter stages in use, including stage 1.
+     */
+    unsigned stage_count;
+
+    /**
+     * Number of PDM words per channel in each block, the product of the
+     * decimation factors of the PCM stages.
+     */
+    unsigned block_words;
+
+    /**
+     * Pass a sample from the previous stage to PCM stage `S` (from 0) of
+     * channel `mic`, and on to the following stages whenever this stage
+     * produces an output sample. `count[S]` is the number of samples still
+     * to be added to stage `S` before its next output sample.
+     */
+    template <unsigned S>
+    typename std::enable_if<(S + 1 < MAX_STAGES)>::type
+    Cascade(unsigned mic, sample_t sample, unsigned count[], int32_t sample_out[]);
+
+    /**
+     * End of the stage list. Never called, as the last stage in use always
+     * writes to `sample_out[]`.
+     */
+    template <unsigned S>
+    typename std::enable_if<(S + 1 == MAX_STAGES)>::type
+    Cascade(unsigned mic, sample_t sample, unsigned count[], int32_t sample_out[]) { }
+
+  public:
+
+    constexpr MultiStageDecimator() noexcept { }
+
+    /**
+     * @brief Initialize the decimator from a configuration struct
+     * @ref mic_array_decimator_conf_t @p decimator_conf
+     *
+     * `decimator_conf.num_filter_stages` must be in the range
+     * `[2, MAX_STAGES]`. Stage 1 must be a FIR filter as for
+     * @ref TwoStageDecimator, and the other stages decimating FIR filters
+     * (i.e. with an `interpolation_factor` of `0` or `1`).
+     *
+     * The caller must ensure all pointers inside @p decimator_conf.filter_conf
+     * are valid and remain alive for the lifetime of the decimator.
+     *
+     * @param decimator_conf Decimator pipeline configuration.
+     */
+    void Init(mic_array_decimator_conf_t &decimator_conf);
+
+    /**
+     * @brief Process one block of PDM data.
+     *
+     * Processes a block of PDM data to produce an output sample from the last
+     * stage in use.
+     *
+     * `pdm_block` contains exactly enough PDM samples to produce a single
+     * output sample, i.e. the product of the decimation factors of stages 2
+     * onwards, `BLOCK_WORDS`, words per channel. The layout of `pdm_block`
+     * should (effectively) be:
+     *
+     * @code{.cpp}
+     *  struct {
+     *    struct {
+     *      // lower word indices are older samples.
+     *      // less significant bits in a word are older samples.
+     *      uint32_t samples[BLOCK_WORDS];
+     *    } microphone[MIC_COUNT]; // mic channels are in ascending order
+     *  } pdm_block;
+     * @endcode
+     *
+     * @param sample_out  Output sample vector.
+     * @param pdm_block   PDM data to be processed.
+     */
+    void ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t *pdm_block);
+
+    /**
+     * @brief Number of PDM words per channel in each block.
+     */
+    unsigned BlockWords() const;
+};
+
+
+/**
+ * @brief Multi-stage decimator with 16-bit PCM stages
+ *
+ * A @ref MultiStageDecimator whose PCM stages have 16-bit coefficients and
+ * state, as described for @ref detail::FirStageS16.
+ *
+ * @tparam MIC_COUNT      Number of microphone channels.
+ * @tparam MAX_STAGES     Largest number of filter stages, including stage 1.
+ */
+template <unsigned MIC_COUNT, unsigned MAX_STAGES>
+using MultiStageDecimatorS16 = MultiStageDecimator<MIC_COUNT, MAX_STAGES,
+                                                   detail::FirStageS16<MIC_COUNT>>;
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT>
+constexpr right_shift_t mic_array::detail::FirStageS16<MIC_COUNT>::STAGE1_SHR;
+
+
+template <unsigned MIC_COUNT, unsigned MAX_STAGES, class TFirStage>
+void mic_array::MultiStageDecimator<MIC_COUNT, MAX_STAGES, TFirStage>::Init(
+    mic_array_decimator_conf_t &decimator_conf)
+{
+  assert(decimator_conf.num_filter_stages >= 2);
+  assert(decimator_conf.num_filter_stages <= MAX_STAGES);
+  assert(decimator_conf.filter_conf[0].cic_order == 0);
+  assert(fir_1xN_bit_supported(decimator_conf.filter_conf[0].coef_bits));
+
+  this->stage_count = decimator_conf.num_filter_stages;
+
+  this->stage1.filter_coef = (const uint32_t*)decimator_conf.filter_conf[0].coef;
+  this->stage1.coef_bits = decimator_conf.filter_conf[0].coef_bits;
+  this->stage1.pdm_history_ptr = (uint32_t*)decimator_conf.filter_conf[0].state;
+  this->stage1.pdm_history_sz = decimator_conf.filter_conf[0].state_words_per_channel;
+
+  memset(this->stage1.pdm_history_ptr, 0x55, sizeof(int32_t) * MIC_COUNT * this->stage1.pdm_history_sz);
+
+  this->block_words = 1;
+  for(unsigned s = 0; s < this->stage_count - 1; s++){
+    const mic_array_filter_conf_t& conf = decimator_conf.filter_conf[s + 1];
+    assert(conf.interpolation_factor <= 1);
+    assert(conf.decimation_factor >= 1);
+
+    this->stage[s].fir.Init(conf);
+    this->stage[s].decimation_factor = conf.decimation_factor;
+    this->block_words *= conf.decimation_factor;
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_STAGES, class TFirStage>
+template <unsigned S>
+typename std::enable_if<(S + 1 < MAX_STAGES)>::type
+mic_array::MultiStageDecimator<MIC_COUNT, MAX_STAGES, TFirStage>::Cascade(
+    unsigned mic,
+    sample_t sample,
+    unsigned count[],
+    int32_t sample_out[])
+{
+  if(count[S]){
+    this->stage[S].fir.AddSample(mic, sample);
+    count[S] -= 1;
+    return;
+  }
+  count[S] = this->stage[S].decimation_factor - 1;
+
+  const sample_t out = this->stage[S].fir.Filter(mic, sample);
+  if(S + 2 == this->stage_count){
+    sample_out[mic] = TFirStage::ToOutput(out);
+    return;
+  }
+  this->template Cascade<S + 1>(mic, out, count, sample_out);
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_STAGES, class TFirStage>
+void mic_array::MultiStageDecimator<MIC_COUNT, MAX_STAGES, TFirStage>
+    ::ProcessBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t *pdm_block)
+{
+  for(unsigned mic = 0; mic < MIC_COUNT; mic++){
+    uint32_t* hist = this->stage1.pdm_history_ptr + (mic * this->stage1.pdm_history_sz);
+    uint32_t* mic_base = pdm_block + (mic * this->block_words);
+
+    // Each block ends with an output from every stage.
+    unsigned count[MAX_STAGES - 1];
+    for(unsigned s = 0; s < this->stage_count - 1; s++)
+      count[s] = this->stage[s].decimation_factor - 1;
+
+    for(unsigned k = 0; k < this->block_words; k++)
+    {
+      hist[0] = mic_base[k];
+
+      int32_t streamA_sample = fir_1xN_bit(hist, this->stage1.filter_coef, this->stage1.coef_bits);
+      shift_buffer(hist);
+
+      this->template Cascade<0>(mic, TFirStage::FromStage1(streamA_sample), count, sample_out);
+    }
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_STAGES, class TFirStage>
+unsigned mic_array::MultiStageDecimator<MIC_COUNT, MAX_STAGES, TFirStage>::BlockWords() const
+{
+  return this->block_words;
+}
@@ -5,15 +5,19 @@
 
 #include <cstdint>
 #include <string>
+#include <cstring>
 #include <cassert>
 #include <iostream>
 #include <type_traits>
 #include <functional>
 
 #include "mic_array/frame_transfer.h"
+#include "mic_array/frame_callback.h"
+#include "mic_array/cpp/SampleFilter.hpp"
 
 #include <xcore/channel.h>
 #include <xcore/select.h>
+#include <xcore/hwtimer.h>
 
 // This has caused problems previously, so just catch the problems here.
 #if defined(MIC_COUNT) || defined(SAMPLE_COUNT) || defined(FRAME_COUNT)
@@ -24,6 +28,44 @@ using namespace std;
 
 namespace  mic_array {
 
+  namespace detail {
+
+    /**
+     * @brief Pass a frame, with its metadata, to a frame transmitter.
+     *
+     * Selected when the transmitter provides
+     * `OutputFrame(frame, const ma_frame_metadata_t*)`.
+     */
+    template <class TFrameTx, class TFrame>
+    auto output_frame(TFrameTx& frame_tx, TFrame frame,
+                      const ma_frame_metadata_t* metadata, int)
+        -> decltype(frame_tx.OutputFrame(frame, metadata))
+    {
+      return frame_tx.OutputFrame(frame, metadata);
+    }
+
+    /**
+     * @brief Pass a frame to a frame transmitter which does not accept frame
+     *        metadata.
+     */
+    template <class TFrameTx, class TFrame>
+    bool output_frame(TFrameTx& frame_tx, TFrame frame,
+                      const ma_frame_metadata_t* metadata, long)
+    {
+      return frame_tx.OutputFrame(frame);
+    }
+
+    /**
+     * @brief Frame filter which does nothing.
+     */
+    struct NopFrameFilter
+    {
+      template <class TFrame>
+      void FilterFrame(TFrame frame) {}
+    };
+
+  }
+
   /**
    * @brief OutputHandler implementation which groups samples into
    *        non-overlapping multi-sample audio frames and sends entire frames to
@@ -46,6 +88,16 @@ namespace  mic_array {
    * `SAMPLE_COUNT` calls to @ref OutputSample() results in an actual
    * transmission to subsequent stages.
    *
+   * Each completed frame is accompanied by a @ref ma_frame_metadata_t header
+   * carrying the frame's sequence number, the reference timer value when its
+   * first sample was output by the decimator and the number of PDM blocks
+   * dropped since the previous frame. The timestamp is later than the capture
+   * of the PDM data by the group delay of the decimator (see
+   * @ref ma_frame_metadata_t::timestamp). The dropped block count is only
+   * available if a counter was supplied with @ref SetDroppedBlockCounter().
+   * The metadata is passed on to `FrameTx` if it accepts it (see
+   * @ref FrameTx).
+   *
    * With `FrameOutputHandler`, the thread receiving the audio will generally
    * need to know how many microphone channels and how many samples to expect
    * per frame (although, strictly speaking, that depends upon the chosen
@@ -96,6 +148,27 @@ namespace  mic_array {
        */
       int32_t frames[FRAME_COUNT][MIC_COUNT][SAMPLE_COUNT];
 
+      /**
+       * @brief Metadata for each of the frame buffers.
+       */
+      ma_frame_metadata_t metadata[FRAME_COUNT];
+
+      /**
+       * @brief Sequence number of the next frame.
+       */
+      uint32_t frame_sequence = 0;
+
+      /**
+       * @brief Counter of dropped PDM blocks, or `nullptr` if unavailable.
+       */
+      const volatile unsigned* dropped_block_counter = nullptr;
+
+      /**
+       * @brief Value of `*dropped_block_counter` when the previous frame was
+       *        completed.
+       */
+      unsigned last_dropped_blocks = 0;
+
     public:
 
       /**
@@ -126,6 +199,17 @@ namespace  mic_array {
        * Alternative implementations might use shared memory or an RTOS queue to
        * transmit the frame data, or might even use a port to signal the samples
        * directly to an external DAC.
+       *
+       * A `FrameTransmitter` may additionally implement
+       *
+       * @code{.cpp}
+       * bool OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT],
+       *                  const ma_frame_metadata_t* metadata);
+       * @endcode
+       *
+       * in which case it is called instead, and is given the frame's metadata.
+       * The metadata object remains valid for as long as the frame buffer
+       * itself.
        */
       FrameTransmitter<MIC_COUNT, SAMPLE_COUNT> FrameTx;
 
@@ -156,6 +240,36 @@ namespace  mic_array {
        */
       bool OutputSample(int32_t sample[MIC_COUNT]);
 
+      /**
+       * @brief Add a new sample, filtering each frame as it completes.
+       *
+       * As @ref OutputSample(int32_t*), except that once the frame is
+       * complete `filter.FilterFrame()` is called on it, in-place, before it is
+       * passed to @ref FrameTx.
+       *
+       * This overload only participates in overload resolution if
+       * `TSampleFilter` provides `FilterFrame()`. @ref MicArray uses it
+       * automatically in that case.
+       *
+       * @param sample  Sample to be added to current frame.
+       * @param filter  Sample filter applied to each completed frame.
+       */
+      template <class TSampleFilter>
+      auto OutputSample(int32_t sample[MIC_COUNT], TSampleFilter& filter)
+          -> decltype(filter.FilterFrame(
+                          std::declval<int32_t (*)[SAMPLE_COUNT]>()), bool());
+
+      /**
+       * @brief Set the counter from which dropped PDM blocks are reported.
+       *
+       * `counter` is read once per frame and the increase since the previous
+       * frame is reported in the frame's metadata. Typically this is the
+       * counter returned by @ref StandardPdmRxService::DroppedBlockCounter().
+       *
+       * @param counter Pointer to dropped block counter, or `nullptr`.
+       */
+      void SetDroppedBlockCounter(const volatile unsigned* counter);
+
       /**
        * @brief Complete mic array shutdown process
        *
@@ -205,6 +319,11 @@ namespace  mic_array {
        */
       chanend_t c_frame_out;
 
+      /**
+       * @brief Whether frame metadata is sent ahead of each frame.
+       */
+      bool send_metadata = false;
+
     public:
 
       /**
@@ -250,6 +369,29 @@ namespace  mic_array {
        */
       bool OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
 
+      /**
+       * @brief Transmit the specified frame with its metadata.
+       *
+       * If metadata has been enabled with @ref SetMetadataEnabled(), the frame
+       * is sent using `ma_frame_tx_metadata()` and must be received using
+       * `ma_frame_rx_metadata()`. Otherwise `metadata` is ignored.
+       *
+       * @param frame     Frame to be transmitted.
+       * @param metadata  Metadata of the frame.
+       */
+      bool OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT],
+                       const ma_frame_metadata_t* metadata);
+
+      /**
+       * @brief Set whether frame metadata is transmitted with each frame.
+       *
+       * Disabled by default. The receiver must use the matching receive
+       * function.
+       *
+       * @param enable Whether to transmit frame metadata.
+       */
+      void SetMetadataEnabled(bool enable);
+
       /**
        * @brief Complete mic array shutdown process by exchanging
        * end tokens with the app.
@@ -258,6 +400,545 @@ namespace  mic_array {
       void CompleteShutdown();
   };
 
+
+  /**
+   * @brief Frame transmitter which publishes each frame to several consumers.
+   *
+   * This class template is meant for use as the `FrameTransmitter` template
+   * parameter of @ref FrameOutputHandler in applications where the same mic
+   * frames must be delivered to more than one consumer (e.g. a keyword
+   * spotter, a beamformer and a USB audio path).
+   *
+   * Each frame passed to @ref OutputFrame() is copied once into one of
+   * `BUFFER_COUNT` shared frame buffers. Consumers running on the same tile
+   * read frames directly from those buffers through their own read cursor
+   * using @ref AcquireFrame() and @ref ReleaseFrame(). A buffer is only reused
+   * once no consumer holds it, so a frame obtained with @ref AcquireFrame()
+   * remains valid until the corresponding @ref ReleaseFrame().
+   *
+   * Publishing a frame never waits on the shared-memory consumers. Because
+   * each consumer can hold at most one frame at a time and `BUFFER_COUNT` is
+   * greater than `CONSUMER_COUNT`, there is always a buffer available for the
+   * new frame; the oldest unheld buffer is overwritten. A consumer which falls
+   * behind by more than the available buffers skips forward to the oldest
+   * frame still available, and the number of frames it skipped is reported by
+   * @ref SkippedFrames().
+   *
+   * Consumers on another tile can be served through a channel by calling
+   * @ref SetChannel(). When a channel is configured each frame is additionally
+   * sent with `ma_frame_tx()` exactly as by @ref ChannelFrameTransmitter, and
+   * the same blocking behaviour and shutdown protocol apply to that channel.
+   * If no channel is configured, the mic array is shut down by calling
+   * @ref RequestShutdown().
+   *
+   * Because this template has more than two template parameters, an alias
+   * template is used to adapt it for @ref FrameOutputHandler:
+   *
+   * @code{.cpp}
+   * template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+   * using TFrameTx = mic_array::BroadcastFrameTransmitter<MIC_COUNT,
+   *                                                       SAMPLE_COUNT, 3>;
+   *
+   * using TOutputHandler = mic_array::FrameOutputHandler<2, 16, TFrameTx>;
+   * @endcode
+   *
+   * @note Frame buffers are accessed without locks. All shared-memory
+   * consumers must run on the same tile as the mic array's decimator thread.
+   * Each consumer index may only be used by a single thread.
+   *
+   * @tparam MIC_COUNT      Number of audio channels in each frame.
+   * @tparam SAMPLE_COUNT   Number of samples per frame.
+   * @tparam CONSUMER_COUNT Number of shared-memory consumers.
+   * @tparam BUFFER_COUNT   Number of shared frame buffers. Must be greater
+   *                        than `CONSUMER_COUNT`.
+   */
+  template <unsigned MIC_COUNT,
+            unsigned SAMPLE_COUNT,
+            unsigned CONSUMER_COUNT = 2,
+            unsigned BUFFER_COUNT = CONSUMER_COUNT + 2>
+  class BroadcastFrameTransmitter
+  {
+    static_assert(CONSUMER_COUNT >= 1,
+        "BroadcastFrameTransmitter requires at least one consumer.");
+    static_assert(BUFFER_COUNT > CONSUMER_COUNT,
+        "BroadcastFrameTransmitter requires more buffers than consumers.");
+    static_assert(BUFFER_COUNT <= 32,
+        "BroadcastFrameTransmitter supports at most 32 buffers.");
+
+    public:
+
+      /**
+       * @brief Pointer to a published frame, indexed as `frame[mic][sample]`.
+       */
+      using frame_ptr_t = const int32_t (*)[SAMPLE_COUNT];
+
+    private:
+
+      /**
+       * @brief Shared frame buffer.
+       *
+       * `seq` holds the sequence number of the frame in `frame`, or `0` if the
+       * buffer is empty or is currently being written.
+       */
+      struct {
+        int32_t frame[MIC_COUNT][SAMPLE_COUNT];
+        ma_frame_metadata_t metadata;
+        volatile uint32_t seq;
+      } buffers[BUFFER_COUNT];
+
+      /**
+       * @brief Sequence number which will be given to the next frame.
+       */
+      uint32_t next_seq = 1;
+
+      /**
+       * @brief Sequence number of the next frame each consumer wants.
+       */
+      uint32_t read_seq[CONSUMER_COUNT];
+
+      /**
+       * @brief Index (plus one) of the buffer held by each consumer, or `0`.
+       */
+      volatile unsigned held[CONSUMER_COUNT];
+
+      /**
+       * @brief Number of frames each consumer has skipped.
+       */
+      unsigned skipped[CONSUMER_COUNT];
+
+      /**
+       * @brief Channel for consumers on another tile, or `0` if unused.
+       */
+      chanend_t c_frame_out = 0;
+
+      /**
+       * @brief Whether frame metadata is sent over `c_frame_out`.
+       */
+      bool send_metadata = false;
+
+      /**
+       * @brief Set by @ref RequestShutdown().
+       */
+      volatile unsigned shutdown_requested = 0;
+
+      /**
+       * @brief Whether any consumer currently holds the specified buffer.
+       */
+      bool IsHeld(unsigned buffer);
+
+    public:
+
+      /**
+       * @brief Construct a `BroadcastFrameTransmitter`.
+       *
+       * No channel is configured. @ref SetChannel() may be called to add a
+       * channel consumer prior to starting the mic array.
+       */
+      BroadcastFrameTransmitter();
+
+      /**
+       * @brief Set channel used for frame transfers to another tile.
+       *
+       * The supplied value of `c_frame_out` must be a valid chanend, or `0` to
+       * disable the channel consumer.
+       *
+       * @param c_frame_out Chanend over which frames will be transmitted.
+       */
+      void SetChannel(chanend_t c_frame_out);
+
+      /**
+       * @brief Get the chanend used for frame transfers to another tile.
+       *
+       * @returns Channel used for frame transfers, or `0` if none.
+       */
+      chanend_t GetChannel();
+
+      /**
+       * @brief Publish the specified frame to all consumers.
+       *
+       * See @ref BroadcastFrameTransmitter for additional details.
+       *
+       * @param frame Frame to be published.
+       *
+       * @returns Whether mic array shutdown has been requested.
+       */
+      bool OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Publish the specified frame and its metadata to all consumers.
+       *
+       * The metadata is stored alongside the frame and can be read by
+       * shared-memory consumers with @ref FrameMetadata(). It is sent to the
+       * channel consumer if enabled with @ref SetMetadataEnabled().
+       *
+       * @param frame     Frame to be published.
+       * @param metadata  Metadata of the frame, or `nullptr`.
+       *
+       * @returns Whether mic array shutdown has been requested.
+       */
+      bool OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT],
+                       const ma_frame_metadata_t* metadata);
+
+      /**
+       * @brief Set whether frame metadata is sent to the channel consumer.
+       *
+       * See @ref ChannelFrameTransmitter::SetMetadataEnabled().
+       *
+       * @param enable Whether to transmit frame metadata.
+       */
+      void SetMetadataEnabled(bool enable);
+
+      /**
+       * @brief Get the next unread frame for a consumer.
+       *
+       * If a frame newer than the last one released by `consumer` is
+       * available, a pointer to it is returned and the frame is held until
+       * @ref ReleaseFrame() is called. Otherwise `nullptr` is returned
+       * immediately.
+       *
+       * A consumer may hold at most one frame at a time.
+       *
+       * @param consumer Index of the consumer, less than `CONSUMER_COUNT`.
+       *
+       * @returns Pointer to the frame, or `nullptr` if none is available.
+       */
+      frame_ptr_t AcquireFrame(unsigned consumer);
+
+      /**
+       * @brief Release the frame held by a consumer.
+       *
+       * @param consumer Index of the consumer, less than `CONSUMER_COUNT`.
+       */
+      void ReleaseFrame(unsigned consumer);
+
+      /**
+       * @brief Get the metadata of the frame held by a consumer.
+       *
+       * May only be called between @ref AcquireFrame() and
+       * @ref ReleaseFrame(). If the frame was published without metadata, all
+       * fields are zero.
+       *
+       * @param consumer Index of the consumer, less than `CONSUMER_COUNT`.
+       *
+       * @returns Metadata of the held frame.
+       */
+      const ma_frame_metadata_t* FrameMetadata(unsigned consumer);
+
+      /**
+       * @brief Get the number of frames a consumer has skipped.
+       *
+       * Frames are skipped when a consumer falls so far behind that the
+       * buffers holding them have been reused.
+       *
+       * @param consumer Index of the consumer, less than `CONSUMER_COUNT`.
+       *
+       * @returns Number of frames skipped by `consumer` so far.
+       */
+      unsigned SkippedFrames(unsigned consumer);
+
+      /**
+       * @brief Request that the mic array shut down.
+       *
+       * The next call to @ref OutputFrame() will report that shutdown has been
+       * requested. This is intended for applications with no channel consumer;
+       * with a channel consumer `ma_shutdown()` may be used instead.
+       */
+      void RequestShutdown();
+
+      /**
+       * @brief Complete mic array shutdown process.
+       *
+       * If a channel is configured, end tokens are exchanged with the app as by
+       * @ref ChannelFrameTransmitter::CompleteShutdown().
+       */
+      void CompleteShutdown();
+  };
+
+
+  /**
+   * @brief Frame transmitter which delivers frames to a C callback or queue.
+   *
+   * This class template is meant for use as the `FrameTransmitter` template
+   * parameter of @ref FrameOutputHandler in applications which consume frames
+   * on the same tile, including C applications which cannot provide their own
+   * transmitter class.
+   *
+   * Frames are delivered by pointer directly into the frame buffers of the
+   * @ref FrameOutputHandler, so no copy is made and no channel is used.
+   *
+   * If a callback is set with @ref SetCallback(), it is called from the mic
+   * array thread for each frame. See @ref ma_frame_callback_t.
+   *
+   * Otherwise each frame is pushed onto the @ref ma_frame_queue_t returned by
+   * @ref GetQueue(), from which a consumer thread takes it with
+   * `ma_frame_queue_acquire()` and returns it with `ma_frame_queue_release()`.
+   * The @ref FrameOutputHandler reuses its frame buffers in turn, so
+   * `QUEUE_DEPTH` must be less than its `FRAME_COUNT` for a queued frame never
+   * to be overwritten. If the queue is full, @ref OutputFrame() waits for the
+   * consumer.
+   *
+   * Because this template has more than two template parameters, an alias
+   * template is used to adapt it for @ref FrameOutputHandler:
+   *
+   * @code{.cpp}
+   * template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+   * using TFrameTx = mic_array::CallbackFrameTransmitter<MIC_COUNT,
+   *                                                      SAMPLE_COUNT, 2>;
+   *
+   * using TOutputHandler = mic_array::FrameOutputHandler<2, 16, TFrameTx, 3>;
+   * @endcode
+   *
+   * @tparam MIC_COUNT    Number of audio channels in each frame.
+   * @tparam SAMPLE_COUNT Number of samples per frame.
+   * @tparam QUEUE_DEPTH  Number of frames which may be queued or held by the
+   *                      consumer.
+   */
+  template <unsigned MIC_COUNT,
+            unsigned SAMPLE_COUNT,
+            unsigned QUEUE_DEPTH = 1>
+  class CallbackFrameTransmitter
+  {
+    static_assert(QUEUE_DEPTH >= 1,
+        "CallbackFrameTransmitter requires a queue depth of at least 1.");
+
+    private:
+
+      /**
+       * @brief Function called for each frame, or `nullptr` to use the queue.
+       */
+      ma_frame_callback_t callback = nullptr;
+
+      /**
+       * @brief Context passed to `callback`.
+       */
+      void* callback_context = nullptr;
+
+      /**
+       * @brief Queue used when no callback is set.
+       */
+      ma_frame_queue_t queue;
+
+      /**
+       * @brief Storage for `queue`.
+       */
+      ma_frame_queue_entry_t queue_entries[QUEUE_DEPTH];
+
+    public:
+
+      /**
+       * @brief Construct a `CallbackFrameTransmitter`.
+       *
+       * Frames are pushed onto the queue until a callback is set.
+       */
+      CallbackFrameTransmitter();
+
+      /**
+       * @brief Set the function to be called for each frame.
+       *
+       * @param callback  Function to call, or `nullptr` to use the queue.
+       * @param context   Application context passed to `callback`.
+       */
+      void SetCallback(ma_frame_callback_t callback, void* context);
+
+      /**
+       * @brief Get the queue onto which frames are pushed.
+       *
+       * @returns Frame queue.
+       */
+      ma_frame_queue_t* GetQueue();
+
+      /**
+       * @brief Deliver the specified frame.
+       *
+       * @param frame Frame to be delivered.
+       *
+       * @returns Whether mic array shutdown has been requested.
+       */
+      bool OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+
+      /**
+       * @brief Deliver the specified frame with its metadata.
+       *
+       * @param frame     Frame to be delivered.
+       * @param metadata  Metadata of the frame, or `nullptr`.
+       *
+       * @returns Whether mic array shutdown has been requested.
+       */
+      bool OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT],
+                       const ma_frame_metadata_t* metadata);
+
+      /**
+       * @brief Complete mic array shutdown process by closing the queue.
+       */
+      void CompleteShutdown();
+  };
+
+
+  /**
+   * @brief OutputHandler which forms delay-and-sum beams from the microphone
+   *        channels and outputs only the beams.
+   *
+   * To be used as the `TOutputHandler` template parameter of @ref MicArray
+   * when only a few steered beams are needed downstream. Each beam is computed
+   * in the decimation thread, and `BEAM_COUNT`-channel beam samples are passed
+   * to another output handler, `BeamOutput` (typically a
+   * @ref FrameOutputHandler with `BEAM_COUNT` channels). This reduces the
+   * data transferred to the next stage by a factor of `MIC_COUNT /
+   * BEAM_COUNT`.
+   *
+   * Beam `b` is
+   *
+   * @code
+   * beam[b][t] = sum over m of ( weight[b][m] * mic[m][t - 1 - delay[b][m]] )
+   * @endcode
+   *
+   * Each delay has an integer part in `[0, MAX_DELAY]` and a fractional part,
+   * which is interpolated with the same 4-tap cubic Lagrange interpolator as
+   * @ref FractionalDelaySampleFilter. All beams see one sample of additional
+   * latency. After `Init()`, every delay is 0 and every weight is
+   * `1 / MIC_COUNT`.
+   *
+   * Delays and weights may be changed with `SetBeam()`, `SetDelay()` and
+   * `SetWeight()` from another thread while the mic array is running, in the
+   * same way as @ref GainSampleFilter's gains. Only one thread may update
+   * them.
+   *
+   * A sample filter used with this output handler is applied to the
+   * microphone channels, before beamforming, one sample at a time.
+   *
+   * @tparam MIC_COUNT    Number of microphone channels.
+   * @tparam BEAM_COUNT   Number of beams.
+   * @tparam TBeamOutput  Output handler for `BEAM_COUNT`-channel beam samples.
+   * @tparam MAX_DELAY    Maximum integer part of a delay, in samples.
+   */
+  template <unsigned MIC_COUNT,
+            unsigned BEAM_COUNT,
+            class TBeamOutput,
+            unsigned MAX_DELAY = 8>
+  class BeamformingOutputHandler
+  {
+    static_assert(BEAM_COUNT >= 1,
+        "BeamformingOutputHandler requires at least one beam.");
+
+    public:
+
+      /**
+       * @brief Output handler to which beam samples are passed.
+       */
+      TBeamOutput BeamOutput;
+
+    protected:
+
+      /**
+       * @brief Length of each channel's sample history.
+       */
+      static constexpr unsigned HISTORY_LEN = MAX_DELAY + 4;
+
+      /**
+       * @brief Interpolator for each beam and microphone, indexed by
+       *        `beam * MIC_COUNT + mic`. The beam weights are included in the
+       *        interpolator taps.
+       */
+      detail::SharedParams<detail::fractional_delay_t,
+                           BEAM_COUNT * MIC_COUNT> interp;
+
+      /**
+       * @brief Most recently set delay of each beam and microphone.
+       */
+      float delay[BEAM_COUNT][MIC_COUNT];
+
+      /**
+       * @brief Most recently set weight of each beam and microphone.
+       */
+      float weight[BEAM_COUNT][MIC_COUNT];
+
+      /**
+       * @brief Sample history of each microphone.
+       *
+       * Each sample is stored twice, at `head` and `head + HISTORY_LEN`, so
+       * that the most recent `HISTORY_LEN` samples are always contiguous.
+       */
+      int32_t history[MIC_COUNT][2 * HISTORY_LEN];
+
+      /**
+       * @brief Index in `history` of the newest sample.
+       */
+      unsigned head;
+
+    public:
+
+      /**
+       * @brief Initialize the beamformer.
+       *
+       * Every delay is set to 0, every weight to `1 / MIC_COUNT`, and the
+       * sample history is cleared. Unlike the other setters, this is not safe
+       * to call while the mic array is running. `BeamOutput` is not
+       * initialized.
+       */
+      void Init();
+
+      /**
+       * @brief Set the delays, and optionally weights, of every microphone in
+       *        a beam.
+       *
+       * The whole beam is updated at once, so no output sample is computed
+       * with a partially steered beam.
+       *
+       * @param beam    Beam to update.
+       * @param delay   Delay of each microphone, in samples, in the range
+       *                `[0, MAX_DELAY + 1)`.
+       * @param weight  Weight of each microphone, or `nullptr` to leave the
+       *                weights unchanged.
+       */
+      void SetBeam(unsigned beam,
+                   const float delay[MIC_COUNT],
+                   const float weight[MIC_COUNT] = nullptr);
+
+      /**
+       * @brief Set the delay of one microphone in one beam.
+       *
+       * @param beam  Beam to update.
+       * @param mic   Microphone to update.
+       * @param delay Delay in samples, in the range `[0, MAX_DELAY + 1)`.
+       */
+      void SetDelay(unsigned beam, unsigned mic, float delay);
+
+      /**
+       * @brief Get the delay of one microphone in one beam.
+       */
+      float GetDelay(unsigned beam, unsigned mic) const;
+
+      /**
+       * @brief Set the weight of one microphone in one beam.
+       *
+       * @param beam    Beam to update.
+       * @param mic     Microphone to update.
+       * @param weight  Weight of the microphone.
+       */
+      void SetWeight(unsigned beam, unsigned mic, float weight);
+
+      /**
+       * @brief Get the weight of one microphone in one beam.
+       */
+      float GetWeight(unsigned beam, unsigned mic) const;
+
+      /**
+       * @brief Form the beams for one sample of every microphone and pass
+       *        them to `BeamOutput`.
+       *
+       * @param sample  Sample of each microphone.
+       *
+       * @returns Whether mic array shutdown has been requested, as reported by
+       *          `BeamOutput`.
+       */
+      bool OutputSample(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Complete mic array shutdown process through `BeamOutput`.
+       */
+      void CompleteShutdown();
+  };
+
 }
 
 
@@ -274,9 +955,29 @@ template <unsigned MIC_COUNT,
 bool mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,
                         FrameTransmitter,FRAME_COUNT>::OutputSample(
     int32_t sample[MIC_COUNT])
+{
+  detail::NopFrameFilter nop_filter;
+  return this->OutputSample(sample, nop_filter);
+}
+
+template <unsigned MIC_COUNT,
+          unsigned SAMPLE_COUNT,
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT>
+template <class TSampleFilter>
+auto mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,
+                        FrameTransmitter,FRAME_COUNT>::OutputSample(
+    int32_t sample[MIC_COUNT],
+    TSampleFilter& filter)
+        -> decltype(filter.FilterFrame(
+                        std::declval<int32_t (*)[SAMPLE_COUNT]>()), bool())
 {
   auto* cur_frame = reinterpret_cast<int32_t (*)[SAMPLE_COUNT]>(
                         &this->frames[this->current_frame][0][0]);
+  ma_frame_metadata_t* cur_metadata = &this->metadata[this->current_frame];
+
+  if(current_sample == 0)
+    cur_metadata->timestamp = get_reference_time();
 
   for(int k = 0; k < MIC_COUNT; k++)
     cur_frame[k][this->current_sample] = sample[k];
@@ -286,11 +987,34 @@ bool mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,
     current_frame++;
     if(current_frame == FRAME_COUNT) current_frame = 0;
 
-    return FrameTx.OutputFrame( cur_frame );
+    cur_metadata->sequence = this->frame_sequence++;
+    cur_metadata->dropped_blocks = 0;
+    if(this->dropped_block_counter){
+      unsigned dropped = *this->dropped_block_counter;
+      cur_metadata->dropped_blocks = dropped - this->last_dropped_blocks;
+      this->last_dropped_blocks = dropped;
+    }
+
+    filter.FilterFrame(cur_frame);
+
+    return detail::output_frame(FrameTx, cur_frame, cur_metadata, 0);
   }
   return false;
 }
 
+template <unsigned MIC_COUNT,
+          unsigned SAMPLE_COUNT,
+          template <unsigned, unsigned> class FrameTransmitter,
+          unsigned FRAME_COUNT>
+void mic_array::FrameOutputHandler<MIC_COUNT,SAMPLE_COUNT,
+                        FrameTransmitter,FRAME_COUNT>::SetDroppedBlockCounter(
+    const volatile unsigned* counter)
+{
+  this->dropped_block_counter = counter;
+  if(counter)
+    this->last_dropped_blocks = *counter;
+}
+
 template <unsigned MIC_COUNT,
           unsigned SAMPLE_COUNT,
           template <unsigned, unsigned> class FrameTransmitter,
@@ -327,9 +1051,443 @@ bool mic_array::ChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::OutputFrame(
   return shutdown;
 }
 
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+bool mic_array::ChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT],
+    const ma_frame_metadata_t* metadata)
+{
+  if(!this->send_metadata)
+    return this->OutputFrame(frame);
+
+  unsigned shutdown = ma_frame_tx_metadata(this->c_frame_out, metadata,
+                        reinterpret_cast<int32_t*>(frame),
+                        MIC_COUNT, SAMPLE_COUNT);
+  return shutdown;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+void mic_array::ChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::SetMetadataEnabled(
+    bool enable)
+{
+  this->send_metadata = enable;
+}
+
 template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
 void mic_array::ChannelFrameTransmitter<MIC_COUNT,SAMPLE_COUNT>::CompleteShutdown()
 {
   chanend_out_control_token(this->c_frame_out, XS1_CT_END); // close the channel only when not shutting down
   chanend_check_control_token(this->c_frame_out, XS1_CT_END);
 }
+
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::BroadcastFrameTransmitter()
+{
+  for(int k = 0; k < BUFFER_COUNT; k++)
+    this->buffers[k].seq = 0;
+
+  for(int k = 0; k < CONSUMER_COUNT; k++){
+    this->read_seq[k] = 1;
+    this->held[k] = 0;
+    this->skipped[k] = 0;
+  }
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+void mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::SetChannel(
+    chanend_t c_frame_out)
+{
+  this->c_frame_out = c_frame_out;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+chanend_t mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::GetChannel()
+{
+  return this->c_frame_out;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+bool mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::IsHeld(
+    unsigned buffer)
+{
+  for(int k = 0; k < CONSUMER_COUNT; k++)
+    if(this->held[k] == buffer + 1) return true;
+  return false;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+bool mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  return this->OutputFrame(frame, nullptr);
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+bool mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::OutputFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT],
+    const ma_frame_metadata_t* metadata)
+{
+  unsigned shutdown = 0;
+  uint32_t seq = this->next_seq;
+  uint32_t rejected = 0;
+
+  // Each consumer holds at most one buffer, so this loop always finds a free
+  // one within (CONSUMER_COUNT + 1) attempts.
+  while(1){
+    // Pick the oldest buffer which no consumer currently holds.
+    int victim = -1;
+    for(int k = 0; k < BUFFER_COUNT; k++){
+      if((rejected & (1u << k)) || IsHeld(k)) continue;
+      if(victim < 0 || (int32_t)(this->buffers[k].seq - this->buffers[victim].seq) < 0)
+        victim = k;
+    }
+    assert(victim >= 0);
+
+    // Invalidate the buffer before checking the holds again. A consumer sets
+    // its hold before checking the sequence number, so either we see its hold
+    // here or it sees the invalidated sequence number.
+    uint32_t old_seq = this->buffers[victim].seq;
+    this->buffers[victim].seq = 0;
+    asm volatile("" ::: "memory");
+
+    if(IsHeld(victim)){
+      this->buffers[victim].seq = old_seq;
+      rejected |= (1u << victim);
+      continue;
+    }
+
+    memcpy(&this->buffers[victim].frame[0][0], &frame[0][0],
+           sizeof(this->buffers[victim].frame));
+    if(metadata)
+      this->buffers[victim].metadata = *metadata;
+    else
+      memset(&this->buffers[victim].metadata, 0, sizeof(ma_frame_metadata_t));
+    asm volatile("" ::: "memory");
+    this->buffers[victim].seq = seq;
+    break;
+  }
+
+  this->next_seq = (seq + 1) ? (seq + 1) : 1;
+
+  if(this->c_frame_out){
+    if(this->send_metadata && metadata)
+      shutdown = ma_frame_tx_metadata(this->c_frame_out, metadata,
+                    reinterpret_cast<int32_t*>(frame),
+                    MIC_COUNT, SAMPLE_COUNT);
+    else
+      shutdown = ma_frame_tx(this->c_frame_out,
+                    reinterpret_cast<int32_t*>(frame),
+                    MIC_COUNT, SAMPLE_COUNT);
+  }
+
+  return shutdown || this->shutdown_requested;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+typename mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::frame_ptr_t
+  mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::AcquireFrame(
+    unsigned consumer)
+{
+  assert(consumer < CONSUMER_COUNT);
+  assert(this->held[consumer] == 0);
+
+  const uint32_t want = this->read_seq[consumer];
+
+  while(1){
+    // Find the oldest buffer at or after the consumer's read cursor.
+    int found = -1;
+    uint32_t found_seq = 0;
+    for(int k = 0; k < BUFFER_COUNT; k++){
+      uint32_t seq = this->buffers[k].seq;
+      if(seq == 0 || (int32_t)(seq - want) < 0) continue;
+      if(found < 0 || (int32_t)(seq - found_seq) < 0){
+        found = k;
+        found_seq = seq;
+      }
+    }
+
+    if(found < 0) return nullptr;
+
+    this->held[consumer] = found + 1;
+    asm volatile("" ::: "memory");
+
+    // If the producer invalidated the buffer before seeing our hold, try again.
+    if(this->buffers[found].seq != found_seq){
+      this->held[consumer] = 0;
+      continue;
+    }
+
+    this->skipped[consumer] += found_seq - want;
+    this->read_seq[consumer] = found_seq;
+    return this->buffers[found].frame;
+  }
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+void mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::ReleaseFrame(
+    unsigned consumer)
+{
+  assert(consumer < CONSUMER_COUNT);
+  assert(this->held[consumer] != 0);
+
+  asm volatile("" ::: "memory");
+  this->held[consumer] = 0;
+  uint32_t seq = this->read_seq[consumer] + 1;
+  this->read_seq[consumer] = seq ? seq : 1;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+void mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::SetMetadataEnabled(
+    bool enable)
+{
+  this->send_metadata = enable;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+const ma_frame_metadata_t* mic_array::BroadcastFrameTransmitter<MIC_COUNT,
+                SAMPLE_COUNT,CONSUMER_COUNT,BUFFER_COUNT>::FrameMetadata(
+    unsigned consumer)
+{
+  assert(consumer < CONSUMER_COUNT);
+  assert(this->held[consumer] != 0);
+  return &this->buffers[this->held[consumer] - 1].metadata;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+unsigned mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::SkippedFrames(
+    unsigned consumer)
+{
+  assert(consumer < CONSUMER_COUNT);
+  return this->skipped[consumer];
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+void mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::RequestShutdown()
+{
+  this->shutdown_requested = 1;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT,
+          unsigned CONSUMER_COUNT, unsigned BUFFER_COUNT>
+void mic_array::BroadcastFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                CONSUMER_COUNT,BUFFER_COUNT>::CompleteShutdown()
+{
+  if(this->c_frame_out){
+    chanend_out_control_token(this->c_frame_out, XS1_CT_END);
+    chanend_check_control_token(this->c_frame_out, XS1_CT_END);
+  }
+}
+
+
+//////////////////////////////////////////////
+//        CallbackFrameTransmitter          //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, unsigned QUEUE_DEPTH>
+mic_array::CallbackFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,QUEUE_DEPTH>
+    ::CallbackFrameTransmitter()
+{
+  ma_frame_queue_init(&this->queue, &this->queue_entries[0], QUEUE_DEPTH);
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, unsigned QUEUE_DEPTH>
+void mic_array::CallbackFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,QUEUE_DEPTH>
+    ::SetCallback(ma_frame_callback_t callback, void* context)
+{
+  this->callback = callback;
+  this->callback_context = context;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, unsigned QUEUE_DEPTH>
+ma_frame_queue_t* mic_array::CallbackFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,
+                QUEUE_DEPTH>::GetQueue()
+{
+  return &this->queue;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, unsigned QUEUE_DEPTH>
+bool mic_array::CallbackFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,QUEUE_DEPTH>
+    ::OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  return this->OutputFrame(frame, nullptr);
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, unsigned QUEUE_DEPTH>
+bool mic_array::CallbackFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,QUEUE_DEPTH>
+    ::OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT],
+                  const ma_frame_metadata_t* metadata)
+{
+  int32_t* frame_ptr = &frame[0][0];
+
+  if(this->callback){
+    ma_frame_metadata_t empty_metadata = {0};
+    if(!metadata)
+      metadata = &empty_metadata;
+    return this->callback(this->callback_context, frame_ptr, metadata) != 0;
+  }
+
+  return ma_frame_queue_push(&this->queue, frame_ptr, metadata) != 0;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT, unsigned QUEUE_DEPTH>
+void mic_array::CallbackFrameTransmitter<MIC_COUNT,SAMPLE_COUNT,QUEUE_DEPTH>
+    ::CompleteShutdown()
+{
+  ma_frame_queue_close(&this->queue);
+}
+
+
+//////////////////////////////////////////////
+//         BeamformingOutputHandler         //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT, unsigned BEAM_COUNT, class TBeamOutput, unsigned MAX_DELAY>
+void mic_array::BeamformingOutputHandler<MIC_COUNT,BEAM_COUNT,TBeamOutput,MAX_DELAY>
+    ::Init()
+{
+  detail::fractional_delay_t interpolator;
+  detail::design_fractional_delay(interpolator, 0, 1.0f / MIC_COUNT);
+  this->interp.Init(interpolator);
+
+  for(int b = 0; b < BEAM_COUNT; b++){
+    for(int m = 0; m < MIC_COUNT; m++){
+      this->delay[b][m] = 0;
+      this->weight[b][m] = 1.0f / MIC_COUNT;
+    }
+  }
+
+  memset(this->history, 0, sizeof(this->history));
+  this->head = 0;
+}
+
+template <unsigned MIC_COUNT, unsigned BEAM_COUNT, class TBeamOutput, unsigned MAX_DELAY>
+void mic_array::BeamformingOutputHandler<MIC_COUNT,BEAM_COUNT,TBeamOutput,MAX_DELAY>
+    ::SetBeam(unsigned beam,
+              const float delay[MIC_COUNT],
+              const float weight[MIC_COUNT])
+{
+  assert(beam < BEAM_COUNT);
+
+  detail::fractional_delay_t* next = this->interp.BeginUpdate();
+  for(int m = 0; m < MIC_COUNT; m++){
+    assert(delay[m] >= 0 && delay[m] < MAX_DELAY + 1);
+    this->delay[beam][m] = delay[m];
+    if(weight)
+      this->weight[beam][m] = weight[m];
+    detail::design_fractional_delay(next[beam * MIC_COUNT + m],
+                                    this->delay[beam][m],
+                                    this->weight[beam][m]);
+  }
+  this->interp.EndUpdate();
+}
+
+template <unsigned MIC_COUNT, unsigned BEAM_COUNT, class TBeamOutput, unsigned MAX_DELAY>
+void mic_array::BeamformingOutputHandler<MIC_COUNT,BEAM_COUNT,TBeamOutput,MAX_DELAY>
+    ::SetDelay(unsigned beam, unsigned mic, float delay)
+{
+  assert(beam < BEAM_COUNT);
+  assert(mic < MIC_COUNT);
+  assert(delay >= 0 && delay < MAX_DELAY + 1);
+
+  this->delay[beam][mic] = delay;
+  detail::design_fractional_delay(this->interp.BeginUpdate()[beam * MIC_COUNT + mic],
+                                  delay, this->weight[beam][mic]);
+  this->interp.EndUpdate();
+}
+
+template <unsigned MIC_COUNT, unsigned BEAM_COUNT, class TBeamOutput, unsigned MAX_DELAY>
+float mic_array::BeamformingOutputHandler<MIC_COUNT,BEAM_COUNT,TBeamOutput,MAX_DELAY>
+    ::GetDelay(unsigned beam, unsigned mic) const
+{
+  assert(beam < BEAM_COUNT);
+  assert(mic < MIC_COUNT);
+  return this->delay[beam][mic];
+}
+
+template <unsigned MIC_COUNT, unsigned BEAM_COUNT, class TBeamOutput, unsigned MAX_DELAY>
+void mic_array::BeamformingOutputHandler<MIC_COUNT,BEAM_COUNT,TBeamOutput,MAX_DELAY>
+    ::SetWeight(unsigned beam, unsigned mic, float weight)
+{
+  assert(beam < BEAM_COUNT);
+  assert(mic < MIC_COUNT);
+
+  this->weight[beam][mic] = weight;
+  detail::design_fractional_delay(this->interp.BeginUpdate()[beam * MIC_COUNT + mic],
+                                  this->delay[beam][mic], weight);
+  this->interp.EndUpdate();
+}
+
+template <unsigned MIC_COUNT, unsigned BEAM_COUNT, class TBeamOutput, unsigned MAX_DELAY>
+float mic_array::BeamformingOutputHandler<MIC_COUNT,BEAM_COUNT,TBeamOutput,MAX_DELAY>
+    ::GetWeight(unsigned beam, unsigned mic) const
+{
+  assert(beam < BEAM_COUNT);
+  assert(mic < MIC_COUNT);
+  return this->weight[beam][mic];
+}
+
+template <unsigned MIC_COUNT, unsigned BEAM_COUNT, class TBeamOutput, unsigned MAX_DELAY>
+bool mic_array::BeamformingOutputHandler<MIC_COUNT,BEAM_COUNT,TBeamOutput,MAX_DELAY>
+    ::OutputSample(int32_t sample[MIC_COUNT])
+{
+  const detail::fractional_delay_t* interpolator = this->interp.Current();
+
+  this->head = (this->head + 1) % HISTORY_LEN;
+  for(int m = 0; m < MIC_COUNT; m++){
+    this->history[m][this->head] = sample[m];
+    this->history[m][this->head + HISTORY_LEN] = sample[m];
+  }
+
+  int32_t beam_sample[BEAM_COUNT];
+
+  for(int b = 0; b < BEAM_COUNT; b++){
+    int64_t acc = 0;
+    for(int m = 0; m < MIC_COUNT; m++){
+      const detail::fractional_delay_t& f = interpolator[b * MIC_COUNT + m];
+      const int32_t* x = &this->history[m][this->head + HISTORY_LEN - f.offset];
+      acc += (int64_t) f.coef[0] * x[ 0];
+      acc += (int64_t) f.coef[1] * x[-1];
+      acc += (int64_t) f.coef[2] * x[-2];
+      acc += (int64_t) f.coef[3] * x[-3];
+    }
+
+    acc = (acc + (1 << 29)) >> 30;
+    if(acc > INT32_MAX)       acc = INT32_MAX;
+    else if(acc < -INT32_MAX) acc = -INT32_MAX;
+    beam_sample[b] = (int32_t) acc;
+  }
+
+  return this->BeamOutput.OutputSample(beam_sample);
+}
+
+template <unsigned MIC_COUNT, unsigned BEAM_COUNT, class TBeamOutput, unsigned MAX_DELAY>
+void mic_array::BeamformingOutputHandler<MIC_COUNT,BEAM_COUNT,TBeamOutput,MAX_DELAY>
+    ::CompleteShutdown()
+{
+  this->BeamOutput.CompleteShutdown();
+}
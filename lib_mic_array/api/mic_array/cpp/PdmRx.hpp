@@ -132,37 +132,36 @@ extern "C" {
     unsigned missed_blocks;
   } pdm_rx_isr_context_t;
 
-  /**
-   * Configuration and context of the PDM rx ISR when @ref
-   * mic_array::StandardPdmRxService is used in interrupt mode.
-   *
-   * `pdm_rx_isr` (`pdm_rx_isr.S`) directly allocates this object as
-   * configuration and state parameters required by that interrupt routine.
-   */
-  extern pdm_rx_isr_context_t pdm_rx_isr_context;
-
   /**
    * @brief Configure port to use `pdm_rx_isr` as an interrupt routine.
    *
    * This function configures `p_pdm_mics` to use `pdm_rx_isr` as its interrupt
-   * vector and enables the interrupt on the current hardware thread.
+   * vector, with `context` as its environment vector, and enables the
+   * interrupt on the current hardware thread. `pdm_rx_isr` (`pdm_rx_isr.S`)
+   * gets its context from the environment vector, so each port has its own
+   * context and several PDM rx ISRs can run on the same tile.
    *
    * This function does NOT unmask interrupts.
    *
    * @param p_pdm_mics Port resource to enable ISR on.
+   * @param context    Context of the ISR for this port, which must remain
+   *                   valid while the ISR is enabled.
    */
   static inline
   void enable_pdm_rx_isr(
-      const port_t p_pdm_mics)
+      const port_t p_pdm_mics,
+      pdm_rx_isr_context_t* context)
   {
     #if defined(__XS3A__)
     asm volatile(
       "setc res[%0], %1       \n"
       "ldap r11, pdm_rx_isr   \n"
       "setv res[%0], r11      \n"
+      "mov r11, %2            \n"
+      "setev res[%0], r11     \n"
       "eeu res[%0]              "
         :
-        : "r"(p_pdm_mics), "r"(XS1_SETC_IE_MODE_INTERRUPT)
+        : "r"(p_pdm_mics), "r"(XS1_SETC_IE_MODE_INTERRUPT), "r"(context)
         : "r11" );
     #endif // __XS3A__
   }
@@ -171,6 +170,143 @@ extern "C" {
 
 
 namespace  mic_array {
+
+  /**
+   * @brief Monitor which detects failed PDM microphones from their raw PDM
+   *        streams.
+   *
+   * A microphone which is stuck at 0 or 1, disconnected or without a clock
+   * produces a constant bit pattern, which still goes through the decimator
+   * and appears as silence or a DC level. This monitor detects such channels
+   * from the statistics of their PDM bits, before decimation.
+   *
+   * For each channel, the monitor counts the `1` bits (ones density) and the
+   * bit transitions in the PDM words passed to `Update()`. After every window
+   * of `window_words` words per channel, a channel is flagged as failed if
+   * fewer than 1 in 32 of its bits are `1`, fewer than 1 in 32 of its bits are
+   * `0`, or fewer than 1 in 32 of its adjacent bit pairs differ. A working
+   * microphone has a ones density near 1/2 and many transitions, even when
+   * loud. The flags are re-evaluated every window, so a channel which
+   * recovers is cleared.
+   *
+   * The flags and the statistics of the last complete window are written
+   * only by the thread calling `Update()`, and may be read from any thread
+   * without locking.
+   *
+   * @ref StandardPdmRxService::EnableHealthMonitor() runs this monitor in
+   * `GetPdmBlock()`.
+   *
+   * @tparam CHANNEL_COUNT  Number of microphone channels, at most 32.
+   */
+  template <unsigned CHANNEL_COUNT>
+  class PdmHealthMonitor
+  {
+    static_assert(CHANNEL_COUNT <= 32,
+        "PdmHealthMonitor supports at most 32 channels.");
+
+    public:
+
+      /**
+       * @brief Default window length, in words per channel.
+       *
+       * With one word per channel examined in each 16 kHz PDM block, this is
+       * 256 ms.
+       */
+      static constexpr unsigned DEFAULT_WINDOW_WORDS = 4096;
+
+    protected:
+
+      /**
+       * @brief Words per channel in each window.
+       */
+      unsigned window_words;
+
+      /**
+       * @brief Words per channel counted so far in the current window.
+       */
+      unsigned words;
+
+      /**
+       * @brief Count of `1` bits of each channel in the current window.
+       */
+      unsigned ones[CHANNEL_COUNT];
+
+      /**
+       * @brief Count of bit transitions of each channel in the current window.
+       */
+      unsigned transitions[CHANNEL_COUNT];
+
+      /**
+       * @brief Count of `1` bits of each channel in the last complete window.
+       */
+      volatile unsigned last_ones[CHANNEL_COUNT];
+
+      /**
+       * @brief Count of bit transitions of each channel in the last complete
+       *        window.
+       */
+      volatile unsigned last_transitions[CHANNEL_COUNT];
+
+      /**
+       * @brief Bit `k` is set if channel `k` failed in the last window.
+       */
+      volatile uint32_t failed;
+
+      /**
+       * @brief Evaluate the current window and start a new one.
+       */
+      void EndWindow();
+
+    public:
+
+      /**
+       * @brief Initialize the monitor.
+       *
+       * No channels are flagged as failed until the first window completes.
+       *
+       * @param window_words  Words per channel in each window.
+       */
+      void Init(unsigned window_words = DEFAULT_WINDOW_WORDS);
+
+      /**
+       * @brief Update the statistics with one word of each channel.
+       *
+       * `pdm_block` has the layout returned by
+       * @ref StandardPdmRxService::GetPdmBlock(). Only the newest word of
+       * each channel is examined, which is enough for the statistics and
+       * keeps the cost to a few instructions per channel and block.
+       *
+       * @param pdm_block           Block of PDM data.
+       * @param words_per_channel   Words of each channel in `pdm_block`.
+       */
+      void Update(const uint32_t* pdm_block, unsigned words_per_channel);
+
+      /**
+       * @brief Get the channels which failed in the last window.
+       *
+       * @returns Bit mask, with bit `k` set if channel `k` failed.
+       */
+      uint32_t GetFailedChannels() const;
+
+      /**
+       * @brief Get the ones density of a channel in the last window.
+       *
+       * @param channel Channel of interest.
+       *
+       * @returns Fraction of PDM bits which were `1`.
+       */
+      float GetOnesDensity(unsigned channel) const;
+
+      /**
+       * @brief Get the transition density of a channel in the last window.
+       *
+       * @param channel Channel of interest.
+       *
+       * @returns Fraction of adjacent PDM bit pairs which differed.
+       */
+      float GetTransitionDensity(unsigned channel) const;
+  };
+
   /**
    * @brief PDM rx service which collects PDM sample data from a port
    * and uses a streaming channel to send a block of data by pointer further
@@ -328,6 +464,32 @@ namespace  mic_array {
       uint32_t pdm_out_words_per_channel; // number of 32-sample subblocks per channel
       uint32_t num_phases;
 
+      /**
+       * @brief Capacity of each block, in words per channel.
+       */
+      unsigned max_words_per_channel;
+
+      /**
+       * @brief Words per channel requested for subsequent blocks.
+       */
+      volatile unsigned requested_words;
+
+      /**
+       * @brief Words per channel of the block being captured by the ISR.
+       */
+      unsigned isr_words;
+
+      /**
+       * @brief Start of the pair of capture buffers.
+       */
+      uint32_t* pdm_in_buffer;
+
+      /**
+       * @brief Words per channel of the last block captured in each buffer,
+       *        when running as a thread.
+       */
+      volatile unsigned block_words[2];
+
       /**
        * @brief Streaming channel over which PDM blocks are sent.
        */
@@ -348,6 +510,29 @@ namespace  mic_array {
 
       volatile bool isr_used = false;
 
+      /**
+       * @brief Context of the PDM rx ISR, when running as an ISR.
+       *
+       * `missed_blocks` starts at `-1`, so that dropped blocks raise an
+       * exception until @ref AssertOnDroppedBlock() is called with `false`.
+       */
+      pdm_rx_isr_context_t isr_context = {0, {nullptr, nullptr}, 0, 0, 0, 0, (unsigned) -1};
+
+      /**
+       * @brief Monitor of the output channels' PDM streams.
+       */
+      PdmHealthMonitor<CHANNELS_OUT> health;
+
+      /**
+       * @brief Whether `health` is updated in `GetPdmBlock()`.
+       */
+      bool health_enabled = false;
+
+      /**
+       * @brief Whether failed channels are replaced with silence.
+       */
+      bool mute_failed = false;
+
     public:
 
       /**
@@ -378,10 +563,17 @@ namespace  mic_array {
        *   CHANNELS_OUT * @p pdm_rx_config.pdm_out_words_per_channel words and remain valid
        *   for the lifetime of the service.
        *
-       * @param p_pdm_mics     Port from which PDM samples are captured.
-       * @param pdm_rx_config  PDM RX configuration
+       * If the block size is to be changed with `SetWordsPerChannel()`, the
+       * buffers must instead be sized for @p max_words_per_channel words per
+       * channel.
+       *
+       * @param p_pdm_mics            Port from which PDM samples are captured.
+       * @param pdm_rx_config         PDM RX configuration
+       * @param max_words_per_channel Largest block size, in words per channel. If
+       *                              `0`, @p pdm_rx_config.pdm_out_words_per_channel.
        */
-      void Init(port_t p_pdm_mics, pdm_rx_conf_t &pdm_rx_config);
+      void Init(port_t p_pdm_mics, pdm_rx_conf_t &pdm_rx_config,
+                unsigned max_words_per_channel = 0);
 
       /**
        * @brief Set the input-output mapping for all output channels.
@@ -448,10 +640,75 @@ namespace  mic_array {
        * exception (`ET_CALL`) if it is ready to deliver a PDM block to the mic
        * array thread when the mic array thread is not ready to receive it. If
        * `false`, dropped blocks can be tracked through
-       * `pdm_rx_isr_context.missed_blocks`.
+       * @ref DroppedBlockCounter().
        */
       void AssertOnDroppedBlock(bool doAssert);
 
+      /**
+       * @brief Get the counter of dropped PDM blocks.
+       *
+       * When running as an ISR, this is the `missed_blocks` field of this
+       * service's @ref pdm_rx_isr_context_t, which only counts if @ref AssertOnDroppedBlock() was called with
+       * `false`. When running as a thread, blocks are never dropped (the PDM rx
+       * thread blocks instead) and `nullptr` is returned.
+       *
+       * This must be called after @ref InstallISR() if the ISR is used.
+       *
+       * @returns Pointer to dropped block counter, or `nullptr`.
+       */
+      const volatile unsigned* DroppedBlockCounter() const;
+
+      /**
+       * @brief Enable the microphone health monitor.
+       *
+       * Once enabled, `GetPdmBlock()` updates a @ref PdmHealthMonitor with
+       * each block of the output channels. If `mute_failed` is `true`, the
+       * PDM data of channels flagged as failed is replaced with a pattern
+       * which decimates to silence.
+       *
+       * Must be called before the mic array is started.
+       *
+       * @param mute_failed   Whether to mute failed channels.
+       * @param window_words  Words per channel in each monitor window.
+       */
+      void EnableHealthMonitor(
+          bool mute_failed = false,
+          unsigned window_words = PdmHealthMonitor<CHANNELS_OUT>::DEFAULT_WINDOW_WORDS);
+
+      /**
+       * @brief Get the health monitor.
+       *
+       * Its statistics may be read from any thread.
+       *
+       * @returns The health monitor.
+       */
+      const PdmHealthMonitor<CHANNELS_OUT>& HealthMonitor() const;
+
+      /**
+       * @brief Change the number of words per channel in each block.
+       *
+       * The change is made at a block boundary, without stopping PDM capture.
+       * When running as an ISR, the block returned by the next call to
+       * `GetPdmBlock()` has the previous size. When running as a thread, up to
+       * 3 more blocks may have the previous size, as blocks are buffered in
+       * the streaming channel. Use `GetWordsPerChannel()` to get the size of
+       * each block.
+       *
+       * Must be called from the thread which calls `GetPdmBlock()`. The
+       * buffers passed to `Init()` must be large enough for @p words.
+       *
+       * @param words Words per channel of subsequent blocks.
+       */
+      void SetWordsPerChannel(unsigned words);
+
+      /**
+       * @brief Get the number of words per channel in the block most recently
+       *        returned by `GetPdmBlock()`.
+       *
+       * @returns Words per channel.
+       */
+      unsigned GetWordsPerChannel() const;
+
       void Shutdown();
       /**
        * @brief Set the port from which to collect PDM samples.
@@ -474,6 +731,94 @@ namespace  mic_array {
 //////////////////////////////////////////////
 
 
+//////////////////////////////////////////////
+//            PdmHealthMonitor              //
+//////////////////////////////////////////////
+
+template <unsigned CHANNEL_COUNT>
+void mic_array::PdmHealthMonitor<CHANNEL_COUNT>::Init(
+    unsigned window_words)
+{
+  assert(window_words > 0);
+  this->window_words = window_words;
+  this->words = 0;
+  for(int ch = 0; ch < CHANNEL_COUNT; ch++){
+    this->ones[ch] = 0;
+    this->transitions[ch] = 0;
+    this->last_ones[ch] = 0;
+    this->last_transitions[ch] = 0;
+  }
+  this->failed = 0;
+}
+
+
+template <unsigned CHANNEL_COUNT>
+void mic_array::PdmHealthMonitor<CHANNEL_COUNT>::Update(
+    const uint32_t* pdm_block,
+    unsigned words_per_channel)
+{
+  for(int ch = 0; ch < CHANNEL_COUNT; ch++){
+    const uint32_t word = pdm_block[(ch + 1) * words_per_channel - 1];
+    this->ones[ch] += __builtin_popcount(word);
+    // 31 adjacent bit pairs within the word
+    this->transitions[ch] += __builtin_popcount((word ^ (word >> 1)) & 0x7FFFFFFF);
+  }
+
+  if(++this->words == this->window_words)
+    this->EndWindow();
+}
+
+
+template <unsigned CHANNEL_COUNT>
+void mic_array::PdmHealthMonitor<CHANNEL_COUNT>::EndWindow()
+{
+  // Each threshold is 1/32 of the bits (or bit pairs) in the window
+  const unsigned threshold = this->window_words;
+  const unsigned bits = 32 * this->window_words;
+
+  uint32_t failed = 0;
+  for(int ch = 0; ch < CHANNEL_COUNT; ch++){
+    const unsigned ones = this->ones[ch];
+    const unsigned transitions = this->transitions[ch];
+
+    if(ones < threshold || (bits - ones) < threshold || transitions < threshold)
+      failed |= (1u << ch);
+
+    this->last_ones[ch] = ones;
+    this->last_transitions[ch] = transitions;
+    this->ones[ch] = 0;
+    this->transitions[ch] = 0;
+  }
+  this->failed = failed;
+  this->words = 0;
+}
+
+
+template <unsigned CHANNEL_COUNT>
+uint32_t mic_array::PdmHealthMonitor<CHANNEL_COUNT>::GetFailedChannels() const
+{
+  return this->failed;
+}
+
+
+template <unsigned CHANNEL_COUNT>
+float mic_array::PdmHealthMonitor<CHANNEL_COUNT>::GetOnesDensity(
+    unsigned channel) const
+{
+  assert(channel < CHANNEL_COUNT);
+  return this->last_ones[channel] / (32.0f * this->window_words);
+}
+
+
+template <unsigned CHANNEL_COUNT>
+float mic_array::PdmHealthMonitor<CHANNEL_COUNT>::GetTransitionDensity(
+    unsigned channel) const
+{
+  assert(channel < CHANNEL_COUNT);
+  return this->last_transitions[channel] / (31.0f * this->window_words);
+}
+
+
 //////////////////////////////////////////////
 //          StandardPdmRxService            //
 //////////////////////////////////////////////
@@ -491,11 +836,16 @@ void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>::ThreadEntry()
     this->blocks[0][--phase] =  this->ReadPort();
 
     if(!phase){
-      this->phase = this->num_phases;
       uint32_t* ready_block = this->blocks[0];
       this->blocks[0] = this->blocks[1];
       this->blocks[1] = ready_block;
 
+      // Record the size of the completed block, and start the next block with
+      // the requested size.
+      this->block_words[ready_block != this->pdm_in_buffer] = this->num_phases / CHANNELS_IN;
+      this->num_phases = CHANNELS_IN * this->requested_words;
+      this->phase = this->num_phases;
+
       this->SendBlock(ready_block);
       // Check for shutdown only after sending a block so we know there's atleast one pending block at the time of shutdown
       if(this->shutdown)
@@ -526,16 +876,23 @@ void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>
 
 template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT>
 void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>
-    ::Init(port_t p_pdm_mics, pdm_rx_conf_t &pdm_rx_config)
+    ::Init(port_t p_pdm_mics, pdm_rx_conf_t &pdm_rx_config,
+           unsigned max_words_per_channel)
 {
   this->pdm_out_block_ptr = pdm_rx_config.pdm_out_block;
   this->pdm_out_words_per_channel = pdm_rx_config.pdm_out_words_per_channel;
   this->num_phases = CHANNELS_IN * this->pdm_out_words_per_channel;
   this->phase = this->num_phases;
 
+  if(max_words_per_channel == 0)
+    max_words_per_channel = this->pdm_out_words_per_channel;
+  assert(max_words_per_channel >= this->pdm_out_words_per_channel);
+  this->max_words_per_channel = max_words_per_channel;
+  this->requested_words = this->isr_words = this->pdm_out_words_per_channel;
 
+  this->pdm_in_buffer = pdm_rx_config.pdm_in_double_buf;
   this->blocks[0] = pdm_rx_config.pdm_in_double_buf;
-  this->blocks[1] = pdm_rx_config.pdm_in_double_buf + this->num_phases;
+  this->blocks[1] = pdm_rx_config.pdm_in_double_buf + (CHANNELS_IN * max_words_per_channel);
 
   for(int k = 0; k < CHANNELS_OUT; k++)
     this->channel_map[k] = k;
@@ -567,21 +924,61 @@ void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>
     ::InstallISR()
 {
   this->isr_used = true;
-  pdm_rx_isr_context.p_pdm_mics = this->p_pdm_mics;
-  pdm_rx_isr_context.c_pdm_data = this->c_pdm_blocks.end_a;
-  pdm_rx_isr_context.pdm_buffer[0] = this->blocks[0];
-  pdm_rx_isr_context.pdm_buffer[1] = this->blocks[1];
-  pdm_rx_isr_context.phase_reset = this->num_phases - 1;
-  pdm_rx_isr_context.phase = this->num_phases - 1;
-
-  enable_pdm_rx_isr(this->p_pdm_mics);
+  this->isr_context.p_pdm_mics = this->p_pdm_mics;
+  this->isr_context.c_pdm_data = this->c_pdm_blocks.end_a;
+  this->isr_context.pdm_buffer[0] = this->blocks[0];
+  this->isr_context.pdm_buffer[1] = this->blocks[1];
+  this->isr_context.phase_reset = this->num_phases - 1;
+  this->isr_context.phase = this->num_phases - 1;
+
+  enable_pdm_rx_isr(this->p_pdm_mics, &this->isr_context);
 }
 
 template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT>
 void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>
     ::AssertOnDroppedBlock(bool doAssert)
 {
-  pdm_rx_isr_context.missed_blocks = doAssert? -1 : 0;
+  this->isr_context.missed_blocks = doAssert? -1 : 0;
+}
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT>
+const volatile unsigned* mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>
+    ::DroppedBlockCounter() const
+{
+  if(!this->isr_used)
+    return nullptr;
+  return &this->isr_context.missed_blocks;
+}
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>
+    ::EnableHealthMonitor(bool mute_failed, unsigned window_words)
+{
+  this->health.Init(window_words);
+  this->mute_failed = mute_failed;
+  this->health_enabled = true;
+}
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT>
+const mic_array::PdmHealthMonitor<CHANNELS_OUT>&
+    mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>::HealthMonitor() const
+{
+  return this->health;
+}
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT>
+void mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>
+    ::SetWordsPerChannel(unsigned words)
+{
+  assert(words > 0 && words <= this->max_words_per_channel);
+  this->requested_words = words;
+}
+
+template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT>
+unsigned mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>
+    ::GetWordsPerChannel() const
+{
+  return this->pdm_out_words_per_channel;
 }
 
 template <unsigned CHANNELS_IN, unsigned CHANNELS_OUT>
@@ -600,11 +997,21 @@ uint32_t* mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>
   // Limiting credit to 1 prevents the ISR from attempting to enqueue an additional block
   // while two buffers are already occupied (which would happen if the ISR gets triggered between interrupt_unmask_all()
   // and s_chan_in_word()), thereby avoiding deadlock.
-  pdm_rx_isr_context.credit = 1;
+  this->isr_context.credit = 1;
+  // The block received below is the one the ISR is part way through, which
+  // has the size set by the previous call. A new size applies to the blocks
+  // after it.
+  const unsigned isr_block_words = this->isr_words;
+  if(this->isr_used && this->requested_words != this->isr_words){
+    this->isr_words = this->requested_words;
+    this->isr_context.phase_reset = CHANNELS_IN * this->isr_words - 1;
+  }
   interrupt_unmask_all();
 
 
   uint32_t* full_block = (uint32_t*) s_chan_in_word(this->c_pdm_blocks.end_b);
+  this->pdm_out_words_per_channel = this->isr_used? isr_block_words
+                                  : this->block_words[full_block != this->pdm_in_buffer];
   mic_array::deinterleave_pdm_samples<CHANNELS_IN>(full_block, this->pdm_out_words_per_channel);
 
   uint32_t (*block)[CHANNELS_IN] = (uint32_t (*)[CHANNELS_IN]) full_block;
@@ -616,6 +1023,21 @@ uint32_t* mic_array::StandardPdmRxService<CHANNELS_IN, CHANNELS_OUT>
       out_ptr[sb] = block[this->pdm_out_words_per_channel - 1 - sb][d];
     }
   }
+
+  if(this->health_enabled){
+    this->health.Update(this->pdm_out_block_ptr, this->pdm_out_words_per_channel);
+
+    uint32_t failed = this->health.GetFailedChannels();
+    if(this->mute_failed && failed){
+      for(int ch = 0; ch < CHANNELS_OUT; ch++){
+        if((failed >> ch) & 1){
+          out_ptr = this->pdm_out_block_ptr + (ch * this->pdm_out_words_per_channel);
+          for(int sb = 0; sb < this->pdm_out_words_per_channel; sb++)
+            out_ptr[sb] = 0x55555555;
+        }
+      }
+    }
+  }
   return this->pdm_out_block_ptr;
 }
 
@@ -5,6 +5,8 @@
 
 #include <cstdint>
 #include <string>
+#include <cstring>
+#include <cmath>
 #include <cassert>
 #include <iostream>
 #include <type_traits>
@@ -12,6 +14,9 @@
 
 #include <xcore/channel.h>
 
+#include "xmath/xmath.h"
+#include "mic_array/dc_elimination.h"
+
 // This has caused problems previously, so just catch the problems here.
 #if defined(MIC_COUNT)
 # error Application must not define the following as precompiler macros: MIC_COUNT.
@@ -40,6 +45,12 @@ namespace  mic_array {
        * @brief Do nothing.
        */
       void Filter(int32_t sample[MIC_COUNT]) {};
+
+      /**
+       * @brief Do nothing.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]) {};
   };
 
   /**
@@ -90,6 +101,749 @@ namespace  mic_array {
        */
       void Filter(int32_t sample[MIC_COUNT]);
   };
+
+  /**
+   * @brief DCOE filter which also implements the frame-level interface.
+   *
+   * Identical to @ref DcoeSampleFilter, but also provides `FilterFrame()`.
+   * When used with @ref FrameOutputHandler, @ref MicArray then filters each
+   * frame once, just before it is transmitted, instead of each sample as it
+   * is decimated.
+   *
+   * @ref DcoeSampleFilter does not provide `FilterFrame()`, so that the
+   * default DCOE work stays spread evenly over the output sample periods.
+   * Use this class only if filtering whole frames has been measured to be
+   * cheaper for the application's frame size.
+   *
+   * @tparam MIC_COUNT  Number of microphone channels.
+   */
+  template<unsigned MIC_COUNT>
+  class DcoeFrameSampleFilter : public DcoeSampleFilter<MIC_COUNT>
+  {
+    public:
+
+      /**
+       * @brief Apply DCOE filter on a frame of samples.
+       *
+       * `frame` is updated in-place. The result is identical to calling
+       * `Filter()` on each sample of the frame in turn.
+       *
+       * @param frame Frame to be filtered. Updated in-place.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+  };
+
+  /**
+   * @brief Filter which applies a cascade of biquad filters to each channel.
+   *
+   * To be used as the `TSampleFilter` template parameter of @ref MicArray when
+   * high-pass filtering, equalisation or microphone response compensation is
+   * desired as post-processing after the decimation filter.
+   *
+   * Each channel is filtered by a cascade of `N_SECTIONS` second-order IIR
+   * sections:
+   *
+   * @code
+   * y[t] = b0 * x[t] + b1 * x[t-1] + b2 * x[t-2] - a1 * y[t-1] - a2 * y[t-2]
+   * @endcode
+   *
+   * The coefficients of each section are supplied as
+   * `{ b0, b1, b2, -a1, -a2 }` in Q2.30 format. Note the negated `a`
+   * coefficients. All channels may share the same coefficients, or each
+   * channel may be given its own (e.g. for per-microphone compensation). The
+   * design helper `python/filter_design/biquad_design.py` generates
+   * coefficients in this format.
+   *
+   * Filtering uses `filter_biquads_s32()` from lib_xcore_math, which processes
+   * up to 8 sections of a channel in parallel in the VPU lanes.
+   *
+   * Both the per-sample `Filter()` and frame-level `FilterFrame()` interfaces
+   * are implemented.
+   *
+   * @tparam MIC_COUNT  Number of microphone channels.
+   * @tparam N_SECTIONS Number of biquad sections in each channel's cascade.
+   */
+  template <unsigned MIC_COUNT, unsigned N_SECTIONS>
+  class BiquadCascadeSampleFilter
+  {
+    static_assert(N_SECTIONS >= 1,
+        "BiquadCascadeSampleFilter requires at least one section.");
+
+    public:
+
+      /**
+       * @brief Number of coefficients in each biquad section.
+       */
+      static constexpr unsigned COEFS_PER_SECTION = 5;
+
+    protected:
+
+      /**
+       * @brief Number of lib_xcore_math biquad blocks per channel.
+       */
+      static constexpr unsigned BLOCK_COUNT = (N_SECTIONS + 7) / 8;
+
+      /**
+       * @brief Coefficients and state of each channel's biquad cascade.
+       */
+      filter_biquad_s32_t blocks[MIC_COUNT][BLOCK_COUNT];
+
+    public:
+
+      /**
+       * @brief Initialize the filters with coefficients shared by all
+       *        channels.
+       *
+       * The filter states are cleared.
+       *
+       * @param coef Coefficients `{ b0, b1, b2, -a1, -a2 }` of each section,
+       *             in Q2.30 format.
+       */
+      void Init(const int32_t coef[N_SECTIONS][COEFS_PER_SECTION]);
+
+      /**
+       * @brief Set the coefficients of a single channel.
+       *
+       * The filter state of the channel is cleared.
+       *
+       * @param channel Channel to update.
+       * @param coef    Coefficients `{ b0, b1, b2, -a1, -a2 }` of each
+       *                section, in Q2.30 format.
+       */
+      void SetChannelCoefficients(unsigned channel,
+                                  const int32_t coef[N_SECTIONS][COEFS_PER_SECTION]);
+
+      /**
+       * @brief Apply the biquad cascade to samples.
+       *
+       * `sample` is an array of samples to be filtered, and is updated
+       * in-place.
+       *
+       * @param sample Samples to be filtered. Updated in-place.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Apply the biquad cascade to a frame of samples.
+       *
+       * `frame` is updated in-place. The result is identical to calling
+       * `Filter()` on each sample of the frame in turn.
+       *
+       * @param frame Frame to be filtered. Updated in-place.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+  };
+
+  namespace detail {
+
+    /**
+     * @brief Filter parameters which one thread may update while the filter
+     *        uses them, without locking.
+     *
+     * The updating thread writes a requested copy of the parameters between
+     * two increments of a sequence counter. Before each use, the filter
+     * checks the counter. If a complete new update is available, it copies the
+     * requested parameters to its inactive buffer and, if the counter did not
+     * change while copying, switches to that buffer. Neither thread ever waits
+     * for the other, and the filter never uses a partially updated set of
+     * parameters. Only one thread may update the parameters.
+     *
+     * @tparam T      Parameter type.
+     * @tparam COUNT  Number of parameters (e.g. one per channel).
+     */
+    template <class T, unsigned COUNT>
+    class SharedParams
+    {
+      protected:
+
+        /** Parameter buffers used by the filter. */
+        T buffer[2][COUNT];
+
+        /** Most recently requested parameters. */
+        T requested[COUNT];
+
+        /** Index of the buffer in use by the filter. */
+        unsigned active;
+
+        /** Sequence number of the update in use by the filter. */
+        unsigned applied_seq;
+
+        /** Update sequence number. Odd while an update is being written. */
+        volatile unsigned seq;
+
+      public:
+
+        /**
+         * @brief Set every parameter to `value`. Not thread-safe.
+         */
+        void Init(const T& value);
+
+        /**
+         * @brief Begin an update.
+         *
+         * @returns The requested parameters, to be modified by the caller.
+         */
+        T* BeginUpdate();
+
+        /**
+         * @brief Publish the requested parameters to the filter.
+         */
+        void EndUpdate();
+
+        /**
+         * @brief Get a requested parameter.
+         */
+        const T& Requested(unsigned index) const { return requested[index]; }
+
+        /**
+         * @brief Get the parameters for the filter to use, applying the most
+         *        recent complete update.
+         */
+        const T* Current();
+    };
+
+    /**
+     * @brief Taps of a cubic Lagrange (4-tap Farrow) fractional delay
+     *        interpolator.
+     */
+    struct fractional_delay_t {
+      /** Q2.30 interpolator taps, newest sample first. */
+      int32_t coef[4];
+      /** Integer part of the delay. */
+      unsigned offset;
+    };
+
+    /**
+     * @brief Compute a fractional delay interpolator.
+     *
+     * The interpolator estimates `gain * x[t - 1 - delay]` from the four
+     * samples `x[t-n]` to `x[t-n-3]`, where `n` is the integer part of
+     * `delay`.
+     *
+     * @param interpolator  Interpolator to compute.
+     * @param delay         Delay in samples, excluding one sample of latency.
+     * @param gain          Gain applied to the interpolated sample.
+     */
+    static inline
+    void design_fractional_delay(fractional_delay_t& interpolator,
+                                 float delay,
+                                 float gain = 1.0f);
+
+  }
+
+  /**
+   * @brief Filter which applies a fixed-point gain to each channel.
+   *
+   * To be used as the `TSampleFilter` template parameter of @ref MicArray when
+   * per-channel gain is desired as post-processing after the decimation
+   * filter, e.g. to calibrate microphones with differing sensitivities.
+   *
+   * Gains are in Q2.30 format, so the gain of each channel may be in the range
+   * `[-2.0, 2.0)` (up to about +6 dB). Unity gain is @ref GAIN_UNITY. Output
+   * samples are rounded and saturated. The gains are applied to all channels
+   * at once using the VPU (`vect_s32_mul()` from lib_xcore_math).
+   *
+   * The gains may be changed with `SetGains()` or `SetChannelGain()` from
+   * another thread while the mic array is running. The filter picks up a
+   * complete set of new gains before its next sample, so every sample sees a
+   * consistent set of gains, and neither thread waits for the other. Only one
+   * thread may update the gains.
+   *
+   * A gain which is common to all channels and a power of 2 is best applied
+   * through the decimator's output shift instead (see
+   * @ref TwoStageDecimator::SetOutputShift()), which costs nothing extra.
+   * This filter is then only needed for the per-channel differences.
+   *
+   * Both the per-sample `Filter()` and frame-level `FilterFrame()` interfaces
+   * are implemented.
+   *
+   * @tparam MIC_COUNT  Number of microphone channels.
+   */
+  template <unsigned MIC_COUNT>
+  class GainSampleFilter
+  {
+    public:
+
+      /**
+       * @brief Unity gain, in Q2.30 format.
+       */
+      static constexpr int32_t GAIN_UNITY = 0x40000000;
+
+    protected:
+
+      /**
+       * @brief Q2.30 gain of each channel.
+       */
+      detail::SharedParams<int32_t, MIC_COUNT> gains;
+
+    public:
+
+      /**
+       * @brief Initialize the filter with the specified gains.
+       *
+       * Unlike `SetGains()`, this is not safe to call while the filter is in
+       * use.
+       *
+       * @param gain  Q2.30 gain of each channel, or `nullptr` for unity gain.
+       */
+      void Init(const int32_t gain[MIC_COUNT] = nullptr);
+
+      /**
+       * @brief Set the gain of every channel.
+       *
+       * May be called from another thread while the filter is in use. The new
+       * gains apply from the next filtered sample.
+       *
+       * @param gain  Q2.30 gain of each channel.
+       */
+      void SetGains(const int32_t gain[MIC_COUNT]);
+
+      /**
+       * @brief Set the gain of a single channel.
+       *
+       * Same as `SetGains()`, with other channels' gains unchanged.
+       *
+       * @param channel Channel to update.
+       * @param gain    Q2.30 gain of the channel.
+       */
+      void SetChannelGain(unsigned channel, int32_t gain);
+
+      /**
+       * @brief Get the most recently set gain of a channel.
+       *
+       * @param channel Channel of interest.
+       *
+       * @returns Q2.30 gain of the channel.
+       */
+      int32_t GetChannelGain(unsigned channel) const;
+
+      /**
+       * @brief Apply the gains to samples.
+       *
+       * @param sample Samples to be filtered. Updated in-place.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Apply the gains to a frame of samples.
+       *
+       * `frame` is updated in-place. The result is identical to calling
+       * `Filter()` on each sample of the frame in turn.
+       *
+       * @param frame Frame to be filtered. Updated in-place.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+  };
+
+  /**
+   * @brief Filter which delays each channel by a fractional number of samples.
+   *
+   * To be used as the `TSampleFilter` template parameter of @ref MicArray when
+   * channels need sub-sample alignment, e.g. to compensate for PCB trace or
+   * microphone group delay differences before beamforming.
+   *
+   * Each channel's delay is `delay = n + mu` samples, with integer part `n` in
+   * `[0, MAX_DELAY]` and fractional part `mu` in `[0, 1)`. The output is
+   * interpolated from the four input samples around `t - 1 - delay` using a
+   * cubic Lagrange (4-tap Farrow) interpolator, so every channel has an
+   * additional latency of one sample. The interpolator taps are computed
+   * when a delay is set, leaving 4 multiply-accumulates per channel and
+   * sample.
+   *
+   * Delays may be changed with `SetDelay()` from another thread while the mic
+   * array is running, in the same way as @ref GainSampleFilter's gains. The
+   * sample history is kept, so a new delay applies immediately. Only one
+   * thread may update the delays.
+   *
+   * For delays of up to 31 PDM clock periods, @ref
+   * TwoStageDecimator::SetPdmDelay() delays the PDM stream before decimation
+   * at almost no cost.
+   *
+   * Both the per-sample `Filter()` and frame-level `FilterFrame()` interfaces
+   * are implemented.
+   *
+   * @tparam MIC_COUNT  Number of microphone channels.
+   * @tparam MAX_DELAY  Maximum integer part of a channel's delay, in samples.
+   */
+  template <unsigned MIC_COUNT, unsigned MAX_DELAY = 4>
+  class FractionalDelaySampleFilter
+  {
+    public:
+
+      /**
+       * @brief Number of interpolator taps.
+       */
+      static constexpr unsigned TAP_COUNT = 4;
+
+    protected:
+
+      /**
+       * @brief Length of each channel's sample history.
+       */
+      static constexpr unsigned HISTORY_LEN = MAX_DELAY + TAP_COUNT;
+
+      /**
+       * @brief Interpolator for one channel.
+       */
+      using interpolator_t = detail::fractional_delay_t;
+
+      /**
+       * @brief Interpolator of each channel.
+       */
+      detail::SharedParams<interpolator_t, MIC_COUNT> interp;
+
+      /**
+       * @brief Sample history of each channel (circular buffers).
+       */
+      int32_t history[MIC_COUNT][HISTORY_LEN];
+
+      /**
+       * @brief Index in `history` of the newest sample.
+       */
+      unsigned head;
+
+      /**
+       * @brief Most recently set delay of each channel, in samples.
+       */
+      float delay[MIC_COUNT];
+
+      /**
+       * @brief Filter the next sample of one channel.
+       */
+      int32_t FilterChannel(unsigned channel, int32_t sample,
+                            const interpolator_t& interpolator);
+
+    public:
+
+      /**
+       * @brief Initialize the filter with every channel's delay set to 0.
+       *
+       * The sample history is cleared. Unlike `SetDelay()`, this is not safe
+       * to call while the filter is in use.
+       */
+      void Init();
+
+      /**
+       * @brief Set the delay of a channel.
+       *
+       * May be called from another thread while the filter is in use. The new
+       * delay applies from the next filtered sample.
+       *
+       * @param channel Channel to update.
+       * @param delay   Delay in samples, in the range `[0, MAX_DELAY + 1)`.
+       */
+      void SetDelay(unsigned channel, float delay);
+
+      /**
+       * @brief Get the most recently set delay of a channel.
+       *
+       * @param channel Channel of interest.
+       *
+       * @returns Delay in samples, excluding the fixed one sample latency.
+       */
+      float GetDelay(unsigned channel) const;
+
+      /**
+       * @brief Apply the delays to samples.
+       *
+       * @param sample Samples to be filtered. Updated in-place.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Apply the delays to a frame of samples.
+       *
+       * `frame` is updated in-place. The result is identical to calling
+       * `Filter()` on each sample of the frame in turn.
+       *
+       * @param frame Frame to be filtered. Updated in-place.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+  };
+
+  /**
+   * @brief Filter which measures the level of each channel.
+   *
+   * To be used as the `TSampleFilter` template parameter of @ref MicArray
+   * (or as a stage of a @ref SampleFilterChain) to meter the channels in the
+   * decimation thread, so that AGC or diagnostics code does not need to scan
+   * every frame. Samples are not modified.
+   *
+   * For each channel, the filter keeps:
+   *
+   * - the peak absolute sample value since the last `ResetPeaks()`,
+   * - a running mean square, from a leaky integrator with a time constant of
+   *   about `2^RMS_SHIFT` samples,
+   * - a count of samples whose absolute value has reached the clip threshold.
+   *   Samples saturated by the decimator are counted with the default
+   *   threshold of `INT32_MAX`.
+   *
+   * The levels are held in per-channel arrays of 32-bit words, which are
+   * only written by the filter. They may be read with the getters from any
+   * thread without locking. Each value read is consistent, but values of
+   * different channels may be from different samples.
+   *
+   * A microphone which has failed can be detected from a peak (or RMS) level
+   * which stays near 0, or from a clip count which keeps increasing.
+   *
+   * Both the per-sample `Filter()` and frame-level `FilterFrame()` interfaces
+   * are implemented. `FilterFrame()` uses the VPU to find each channel's peak
+   * and energy. It updates the mean square once per frame, so its result is
+   * close to, but not identical to, that of `Filter()`.
+   *
+   * @tparam MIC_COUNT  Number of microphone channels.
+   * @tparam RMS_SHIFT  log2 of the RMS integrator's time constant in samples.
+   */
+  template <unsigned MIC_COUNT, unsigned RMS_SHIFT = 10>
+  class LevelMeterSampleFilter
+  {
+    protected:
+
+      /**
+       * @brief Peak absolute value of each channel.
+       */
+      volatile int32_t peak[MIC_COUNT];
+
+      /**
+       * @brief Mean square of each channel, scaled by `2^-32`.
+       */
+      volatile int32_t mean_square[MIC_COUNT];
+
+      /**
+       * @brief Number of clipped samples of each channel.
+       */
+      volatile uint32_t clip_count[MIC_COUNT];
+
+      /**
+       * @brief Absolute sample value at or above which a sample is clipped.
+       */
+      int32_t clip_threshold;
+
+      /**
+       * @brief Incremented by `ResetPeaks()`.
+       */
+      volatile unsigned reset_request;
+
+      /**
+       * @brief Value of `reset_request` when the peaks were last reset.
+       */
+      unsigned reset_ack;
+
+      /**
+       * @brief Clear the peaks if `ResetPeaks()` has been called.
+       */
+      void HandleReset();
+
+    public:
+
+      /**
+       * @brief Initialize the filter and clear all levels.
+       *
+       * Not safe to call while the filter is in use.
+       *
+       * @param clip_threshold  Absolute sample value at or above which a
+       *                        sample is counted as clipped.
+       */
+      void Init(int32_t clip_threshold = INT32_MAX);
+
+      /**
+       * @brief Reset the peaks of all channels.
+       *
+       * May be called from any thread. The filter clears the peaks before it
+       * processes the next sample or frame.
+       */
+      void ResetPeaks();
+
+      /**
+       * @brief Get the peak absolute value of a channel.
+       *
+       * @param channel Channel of interest.
+       *
+       * @returns Largest absolute sample value since the peaks were reset.
+       */
+      int32_t GetPeak(unsigned channel) const;
+
+      /**
+       * @brief Get the running RMS level of a channel.
+       *
+       * @param channel Channel of interest.
+       *
+       * @returns RMS level, on the same scale as the samples.
+       */
+      int32_t GetRms(unsigned channel) const;
+
+      /**
+       * @brief Get the running mean square of a channel.
+       *
+       * This is the value from which `GetRms()` is computed, without the
+       * square root.
+       *
+       * @param channel Channel of interest.
+       *
+       * @returns Mean square of the samples, scaled by `2^-32`.
+       */
+      int32_t GetMeanSquare(unsigned channel) const;
+
+      /**
+       * @brief Get the number of clipped samples of a channel.
+       *
+       * The count is never reset, and wraps at `2^32`. Compare with an
+       * earlier count to find the number of samples clipped in between.
+       *
+       * @param channel Channel of interest.
+       *
+       * @returns Number of clipped samples since `Init()`.
+       */
+      uint32_t GetClipCount(unsigned channel) const;
+
+      /**
+       * @brief Update the levels with a sample.
+       *
+       * @param sample Samples to be measured. Not modified.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Update the levels with a frame of samples.
+       *
+       * @param frame Frame to be measured. Not modified.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]);
+  };
+
+  template <unsigned MIC_COUNT, class... TFilters>
+  class SampleFilterChain;
+
+  namespace detail {
+
+    /**
+     * @brief Type of, and accessor for, stage `N` of a @ref SampleFilterChain.
+     */
+    template <unsigned N, class TChain>
+    struct chain_stage
+    {
+      using next = chain_stage<N-1, typename TChain::TTail>;
+      using type = typename next::type;
+
+      static type& get(TChain& chain) { return next::get(chain.Tail); }
+    };
+
+    template <class TChain>
+    struct chain_stage<0, TChain>
+    {
+      using type = typename TChain::THead;
+
+      static type& get(TChain& chain) { return chain.Head; }
+    };
+
+  }
+
+  /**
+   * @brief SampleFilter which applies several sample filters in sequence.
+   *
+   * To be used as the `TSampleFilter` template parameter of @ref MicArray when
+   * more than one post-decimation filter is desired, e.g. DCOE followed by a
+   * biquad cascade, without writing a wrapper class for the combination.
+   *
+   * @code{.cpp}
+   * using TSampleFilter = mic_array::SampleFilterChain<MIC_COUNT,
+   *                          mic_array::DcoeSampleFilter<MIC_COUNT>,
+   *                          mic_array::BiquadCascadeSampleFilter<MIC_COUNT, 2>>;
+   * ...
+   * mics.SampleFilter.Stage<0>().Init();
+   * mics.SampleFilter.Stage<1>().Init(coef);
+   * @endcode
+   *
+   * The chain is resolved entirely at compile time. `Filter()` calls each
+   * stage's `Filter()` directly, in order, so the stages are inlined exactly
+   * as they would be in a hand-written wrapper.
+   *
+   * `FilterFrame()` is available only if every stage implements
+   * `FilterFrame()`, in which case each stage processes the whole frame in
+   * turn. Otherwise the chain only provides `Filter()`, and @ref MicArray
+   * applies it to each sample.
+   *
+   * @tparam MIC_COUNT  Number of microphone channels.
+   * @tparam TFilters   Sample filter types, in the order they are applied.
+   */
+  template <unsigned MIC_COUNT, class TFirst, class... TRest>
+  class SampleFilterChain<MIC_COUNT, TFirst, TRest...>
+  {
+    public:
+
+      /**
+       * @brief Type of the first stage.
+       */
+      using THead = TFirst;
+
+      /**
+       * @brief Type of the chain of the remaining stages.
+       */
+      using TTail = SampleFilterChain<MIC_COUNT, TRest...>;
+
+      /**
+       * @brief The first stage.
+       */
+      THead Head;
+
+      /**
+       * @brief The remaining stages.
+       */
+      TTail Tail;
+
+      /**
+       * @brief Get stage `N` of the chain.
+       *
+       * Stages are numbered from 0 in the order given in `TFilters`.
+       */
+      template <unsigned N>
+      typename detail::chain_stage<N, SampleFilterChain>::type& Stage();
+
+      /**
+       * @brief Apply each stage to samples.
+       *
+       * @param sample Samples to be filtered. Updated in-place.
+       */
+      void Filter(int32_t sample[MIC_COUNT]);
+
+      /**
+       * @brief Apply each stage to a frame of samples.
+       *
+       * Only available if every stage implements `FilterFrame()`. (`THeadT`
+       * and `TTailT` only exist to defer that check until this function is
+       * used, and should not be specified.)
+       *
+       * @param frame Frame to be filtered. Updated in-place.
+       */
+      template <unsigned SAMPLE_COUNT, class THeadT = THead, class TTailT = TTail>
+      auto FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+          -> decltype(std::declval<THeadT&>().FilterFrame(frame),
+                      std::declval<TTailT&>().FilterFrame(frame), void());
+  };
+
+  /**
+   * @brief Terminating case of @ref SampleFilterChain, with no stages.
+   */
+  template <unsigned MIC_COUNT>
+  class SampleFilterChain<MIC_COUNT>
+  {
+    public:
+      /**
+       * @brief Do nothing.
+       */
+      void Filter(int32_t sample[MIC_COUNT]) {};
+
+      /**
+       * @brief Do nothing.
+       */
+      template <unsigned SAMPLE_COUNT>
+      void FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT]) {};
+  };
 }
 
 //////////////////////////////////////////////
@@ -109,4 +863,482 @@ void mic_array::DcoeSampleFilter<MIC_COUNT>::Filter(
     int32_t sample[MIC_COUNT])
 {
   dcoe_filter(&sample[0], &state[0], &sample[0], MIC_COUNT);
-}
\ No newline at end of file
+}
+
+
+//////////////////////////////////////////////
+//          DcoeFrameSampleFilter           //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT>
+template <unsigned SAMPLE_COUNT>
+void mic_array::DcoeFrameSampleFilter<MIC_COUNT>::FilterFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  dcoe_filter_frame(&frame[0][0], &this->state[0], MIC_COUNT, SAMPLE_COUNT);
+}
+
+
+//////////////////////////////////////////////
+//        BiquadCascadeSampleFilter         //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT, unsigned N_SECTIONS>
+void mic_array::BiquadCascadeSampleFilter<MIC_COUNT,N_SECTIONS>::Init(
+    const int32_t coef[N_SECTIONS][COEFS_PER_SECTION])
+{
+  for(int ch = 0; ch < MIC_COUNT; ch++)
+    this->SetChannelCoefficients(ch, coef);
+}
+
+
+template <unsigned MIC_COUNT, unsigned N_SECTIONS>
+void mic_array::BiquadCascadeSampleFilter<MIC_COUNT,N_SECTIONS>::SetChannelCoefficients(
+    unsigned channel,
+    const int32_t coef[N_SECTIONS][COEFS_PER_SECTION])
+{
+  assert(channel < MIC_COUNT);
+
+  memset(&this->blocks[channel][0], 0, sizeof(this->blocks[channel]));
+
+  for(int sec = 0; sec < N_SECTIONS; sec++){
+    filter_biquad_s32_t* block = &this->blocks[channel][sec / 8];
+    block->biquad_count++;
+    for(int k = 0; k < COEFS_PER_SECTION; k++)
+      block->coef[k][sec % 8] = coef[sec][k];
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned N_SECTIONS>
+void mic_array::BiquadCascadeSampleFilter<MIC_COUNT,N_SECTIONS>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  for(int ch = 0; ch < MIC_COUNT; ch++)
+    sample[ch] = filter_biquads_s32(&this->blocks[ch][0], BLOCK_COUNT, sample[ch]);
+}
+
+
+template <unsigned MIC_COUNT, unsigned N_SECTIONS>
+template <unsigned SAMPLE_COUNT>
+void mic_array::BiquadCascadeSampleFilter<MIC_COUNT,N_SECTIONS>::FilterFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  for(int ch = 0; ch < MIC_COUNT; ch++){
+    filter_biquad_s32_t* chan_blocks = &this->blocks[ch][0];
+    for(int s = 0; s < SAMPLE_COUNT; s++)
+      frame[ch][s] = filter_biquads_s32(chan_blocks, BLOCK_COUNT, frame[ch][s]);
+  }
+}
+
+
+//////////////////////////////////////////////
+//               SharedParams               //
+//////////////////////////////////////////////
+
+template <class T, unsigned COUNT>
+void mic_array::detail::SharedParams<T,COUNT>::Init(
+    const T& value)
+{
+  for(int k = 0; k < COUNT; k++){
+    this->requested[k] = value;
+    this->buffer[0][k] = value;
+    this->buffer[1][k] = value;
+  }
+  this->active = 0;
+  this->applied_seq = 0;
+  this->seq = 0;
+}
+
+
+template <class T, unsigned COUNT>
+T* mic_array::detail::SharedParams<T,COUNT>::BeginUpdate()
+{
+  this->seq = this->seq + 1;
+  asm volatile("" ::: "memory");
+  return &this->requested[0];
+}
+
+
+template <class T, unsigned COUNT>
+void mic_array::detail::SharedParams<T,COUNT>::EndUpdate()
+{
+  asm volatile("" ::: "memory");
+  this->seq = this->seq + 1;
+}
+
+
+template <class T, unsigned COUNT>
+const T* mic_array::detail::SharedParams<T,COUNT>::Current()
+{
+  const unsigned seq = this->seq;
+
+  if(seq != this->applied_seq && !(seq & 1)){
+    T* next = &this->buffer[this->active ^ 1][0];
+    asm volatile("" ::: "memory");
+    for(int k = 0; k < COUNT; k++)
+      next[k] = this->requested[k];
+    asm volatile("" ::: "memory");
+
+    // Discard the copy if another update started while copying.
+    if(this->seq == seq){
+      this->active ^= 1;
+      this->applied_seq = seq;
+    }
+  }
+
+  return &this->buffer[this->active][0];
+}
+
+
+static inline
+void mic_array::detail::design_fractional_delay(
+    fractional_delay_t& interpolator,
+    float delay,
+    float gain)
+{
+  const unsigned n = (unsigned) delay;
+  const float mu = delay - n;
+
+  // Cubic Lagrange interpolation of x[t-1-n-mu] from x[t-n] .. x[t-n-3]
+  const float taps[4] = {
+    -mu * (mu - 1) * (mu - 2) / 6,
+    (mu + 1) * (mu - 1) * (mu - 2) / 2,
+    -(mu + 1) * mu * (mu - 2) / 2,
+    (mu + 1) * mu * (mu - 1) / 6,
+  };
+
+  for(int k = 0; k < 4; k++){
+    const float tap = gain * taps[k] * (1 << 30);
+    interpolator.coef[k] = (int32_t) (tap + ((tap < 0)? -0.5f : 0.5f));
+  }
+  interpolator.offset = n;
+}
+
+
+//////////////////////////////////////////////
+//             GainSampleFilter             //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT>
+void mic_array::GainSampleFilter<MIC_COUNT>::Init(
+    const int32_t gain[MIC_COUNT])
+{
+  this->gains.Init(GAIN_UNITY);
+  if(gain)
+    this->SetGains(gain);
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::GainSampleFilter<MIC_COUNT>::SetGains(
+    const int32_t gain[MIC_COUNT])
+{
+  int32_t* next = this->gains.BeginUpdate();
+  for(int ch = 0; ch < MIC_COUNT; ch++)
+    next[ch] = gain[ch];
+  this->gains.EndUpdate();
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::GainSampleFilter<MIC_COUNT>::SetChannelGain(
+    unsigned channel,
+    int32_t gain)
+{
+  assert(channel < MIC_COUNT);
+  this->gains.BeginUpdate()[channel] = gain;
+  this->gains.EndUpdate();
+}
+
+
+template <unsigned MIC_COUNT>
+int32_t mic_array::GainSampleFilter<MIC_COUNT>::GetChannelGain(
+    unsigned channel) const
+{
+  assert(channel < MIC_COUNT);
+  return this->gains.Requested(channel);
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::GainSampleFilter<MIC_COUNT>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  vect_s32_mul(&sample[0], &sample[0], this->gains.Current(), MIC_COUNT, 0, 0);
+}
+
+
+template <unsigned MIC_COUNT>
+template <unsigned SAMPLE_COUNT>
+void mic_array::GainSampleFilter<MIC_COUNT>::FilterFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  const int32_t* gain = this->gains.Current();
+  for(int ch = 0; ch < MIC_COUNT; ch++)
+    vect_s32_scale(&frame[ch][0], &frame[ch][0], SAMPLE_COUNT, gain[ch], 0, 0);
+}
+
+
+//////////////////////////////////////////////
+//       FractionalDelaySampleFilter        //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT, unsigned MAX_DELAY>
+void mic_array::FractionalDelaySampleFilter<MIC_COUNT,MAX_DELAY>::Init()
+{
+  interpolator_t zero_delay;
+  detail::design_fractional_delay(zero_delay, 0);
+  this->interp.Init(zero_delay);
+
+  for(int ch = 0; ch < MIC_COUNT; ch++)
+    this->delay[ch] = 0;
+  memset(this->history, 0, sizeof(this->history));
+  this->head = 0;
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_DELAY>
+void mic_array::FractionalDelaySampleFilter<MIC_COUNT,MAX_DELAY>::SetDelay(
+    unsigned channel,
+    float delay)
+{
+  assert(channel < MIC_COUNT);
+  assert(delay >= 0 && delay < MAX_DELAY + 1);
+
+  this->delay[channel] = delay;
+  detail::design_fractional_delay(this->interp.BeginUpdate()[channel], delay);
+  this->interp.EndUpdate();
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_DELAY>
+float mic_array::FractionalDelaySampleFilter<MIC_COUNT,MAX_DELAY>::GetDelay(
+    unsigned channel) const
+{
+  assert(channel < MIC_COUNT);
+  return this->delay[channel];
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_DELAY>
+int32_t mic_array::FractionalDelaySampleFilter<MIC_COUNT,MAX_DELAY>::FilterChannel(
+    unsigned channel,
+    int32_t sample,
+    const interpolator_t& interpolator)
+{
+  int32_t* hist = &this->history[channel][0];
+  hist[this->head] = sample;
+
+  unsigned idx = this->head + HISTORY_LEN - interpolator.offset;
+  int64_t acc = 0;
+  for(int k = 0; k < TAP_COUNT; k++, idx--)
+    acc += (int64_t) interpolator.coef[k] * hist[idx % HISTORY_LEN];
+
+  acc = (acc + (1 << 29)) >> 30;
+  if(acc > INT32_MAX)       acc = INT32_MAX;
+  else if(acc < -INT32_MAX) acc = -INT32_MAX;
+  return (int32_t) acc;
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_DELAY>
+void mic_array::FractionalDelaySampleFilter<MIC_COUNT,MAX_DELAY>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  const interpolator_t* interpolator = this->interp.Current();
+
+  this->head = (this->head + 1) % HISTORY_LEN;
+  for(int ch = 0; ch < MIC_COUNT; ch++)
+    sample[ch] = this->FilterChannel(ch, sample[ch], interpolator[ch]);
+}
+
+
+template <unsigned MIC_COUNT, unsigned MAX_DELAY>
+template <unsigned SAMPLE_COUNT>
+void mic_array::FractionalDelaySampleFilter<MIC_COUNT,MAX_DELAY>::FilterFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  const interpolator_t* interpolator = this->interp.Current();
+
+  const unsigned start = this->head;
+  for(int ch = 0; ch < MIC_COUNT; ch++){
+    this->head = start;
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      this->head = (this->head + 1) % HISTORY_LEN;
+      frame[ch][s] = this->FilterChannel(ch, frame[ch][s], interpolator[ch]);
+    }
+  }
+}
+
+
+//////////////////////////////////////////////
+//          LevelMeterSampleFilter          //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT, unsigned RMS_SHIFT>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT,RMS_SHIFT>::Init(
+    int32_t clip_threshold)
+{
+  assert(clip_threshold > 0);
+  this->clip_threshold = clip_threshold;
+  for(int ch = 0; ch < MIC_COUNT; ch++){
+    this->peak[ch] = 0;
+    this->mean_square[ch] = 0;
+    this->clip_count[ch] = 0;
+  }
+  this->reset_request = 0;
+  this->reset_ack = 0;
+}
+
+
+template <unsigned MIC_COUNT, unsigned RMS_SHIFT>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT,RMS_SHIFT>::ResetPeaks()
+{
+  this->reset_request = this->reset_request + 1;
+}
+
+
+template <unsigned MIC_COUNT, unsigned RMS_SHIFT>
+int32_t mic_array::LevelMeterSampleFilter<MIC_COUNT,RMS_SHIFT>::GetPeak(
+    unsigned channel) const
+{
+  assert(channel < MIC_COUNT);
+  return this->peak[channel];
+}
+
+
+template <unsigned MIC_COUNT, unsigned RMS_SHIFT>
+int32_t mic_array::LevelMeterSampleFilter<MIC_COUNT,RMS_SHIFT>::GetRms(
+    unsigned channel) const
+{
+  // sqrt(mean_square * 2^32)
+  float rms = sqrtf((float) this->GetMeanSquare(channel)) * 65536.0f;
+  return (rms >= (float) INT32_MAX)? INT32_MAX : (int32_t) rms;
+}
+
+
+template <unsigned MIC_COUNT, unsigned RMS_SHIFT>
+int32_t mic_array::LevelMeterSampleFilter<MIC_COUNT,RMS_SHIFT>::GetMeanSquare(
+    unsigned channel) const
+{
+  assert(channel < MIC_COUNT);
+  return this->mean_square[channel];
+}
+
+
+template <unsigned MIC_COUNT, unsigned RMS_SHIFT>
+uint32_t mic_array::LevelMeterSampleFilter<MIC_COUNT,RMS_SHIFT>::GetClipCount(
+    unsigned channel) const
+{
+  assert(channel < MIC_COUNT);
+  return this->clip_count[channel];
+}
+
+
+template <unsigned MIC_COUNT, unsigned RMS_SHIFT>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT,RMS_SHIFT>::HandleReset()
+{
+  const unsigned request = this->reset_request;
+  if(request != this->reset_ack){
+    for(int ch = 0; ch < MIC_COUNT; ch++)
+      this->peak[ch] = 0;
+    this->reset_ack = request;
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned RMS_SHIFT>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT,RMS_SHIFT>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  this->HandleReset();
+
+  for(int ch = 0; ch < MIC_COUNT; ch++){
+    const int32_t x = sample[ch];
+    const int32_t mag = (x >= 0)? x : (x == INT32_MIN)? INT32_MAX : -x;
+
+    if(mag > this->peak[ch])
+      this->peak[ch] = mag;
+
+    if(mag >= this->clip_threshold)
+      this->clip_count[ch] = this->clip_count[ch] + 1;
+
+    const int32_t sq = (int32_t) (((int64_t) x * x) >> 32);
+    const int32_t ms = this->mean_square[ch];
+    this->mean_square[ch] = ms + ((sq - ms) >> RMS_SHIFT);
+  }
+}
+
+
+template <unsigned MIC_COUNT, unsigned RMS_SHIFT>
+template <unsigned SAMPLE_COUNT>
+void mic_array::LevelMeterSampleFilter<MIC_COUNT,RMS_SHIFT>::FilterFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+{
+  this->HandleReset();
+
+  for(int ch = 0; ch < MIC_COUNT; ch++){
+    const int32_t max = vect_s32_max(&frame[ch][0], SAMPLE_COUNT);
+    const int32_t min = vect_s32_min(&frame[ch][0], SAMPLE_COUNT);
+    const int32_t neg = (min == INT32_MIN)? INT32_MAX : -min;
+    const int32_t mag = (max > neg)? max : neg;
+
+    if(mag > this->peak[ch])
+      this->peak[ch] = mag;
+
+    // Only scan for clipped samples if there are any.
+    if(mag >= this->clip_threshold){
+      uint32_t clips = 0;
+      for(int s = 0; s < SAMPLE_COUNT; s++){
+        const int32_t x = frame[ch][s];
+        clips += (x >= this->clip_threshold || x <= -this->clip_threshold);
+      }
+      this->clip_count[ch] = this->clip_count[ch] + clips;
+    }
+
+    // Each element is shifted right by 1 bit, so the energy is scaled by 2^-32
+    const int32_t sq = (int32_t) (vect_s32_energy(&frame[ch][0], SAMPLE_COUNT, 1) / SAMPLE_COUNT);
+    const int32_t ms = this->mean_square[ch];
+    if(SAMPLE_COUNT >= (1 << RMS_SHIFT))
+      this->mean_square[ch] = sq;
+    else
+      this->mean_square[ch] = ms + (int32_t) (((int64_t) (sq - ms) * SAMPLE_COUNT) >> RMS_SHIFT);
+  }
+}
+
+
+//////////////////////////////////////////////
+//            SampleFilterChain             //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT, class TFirst, class... TRest>
+template <unsigned N>
+typename mic_array::detail::chain_stage<N,
+    mic_array::SampleFilterChain<MIC_COUNT, TFirst, TRest...>>::type&
+  mic_array::SampleFilterChain<MIC_COUNT, TFirst, TRest...>::Stage()
+{
+  static_assert(N <= sizeof...(TRest), "Stage index out of range.");
+  return detail::chain_stage<N, SampleFilterChain>::get(*this);
+}
+
+
+template <unsigned MIC_COUNT, class TFirst, class... TRest>
+void mic_array::SampleFilterChain<MIC_COUNT, TFirst, TRest...>::Filter(
+    int32_t sample[MIC_COUNT])
+{
+  this->Head.Filter(sample);
+  this->Tail.Filter(sample);
+}
+
+
+template <unsigned MIC_COUNT, class TFirst, class... TRest>
+template <unsigned SAMPLE_COUNT, class THeadT, class TTailT>
+auto mic_array::SampleFilterChain<MIC_COUNT, TFirst, TRest...>::FilterFrame(
+    int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+        -> decltype(std::declval<THeadT&>().FilterFrame(frame),
+                    std::declval<TTailT&>().FilterFrame(frame), void())
+{
+  this->Head.FilterFrame(frame);
+  this->Tail.FilterFrame(frame);
+}
@@ -0,0 +1,301 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <cassert>
+
+#include "xmath/xmath.h"
+#include "mic_array/etc/fir_1xN_bit.h"
+#include "Decimator.hpp"
+
+// This has caused problems previously, so just catch the problems here.
+#if defined (MIC_COUNT)
+# error Application must not define the following as precompiler macros: MIC_COUNT, S2_DEC_FACTOR.
+#endif
+
+namespace  mic_array {
+
+namespace detail {
+
+  /**
+   * @brief Number of bit-planes needed to hold a count in `[0, N]`.
+   */
+  constexpr unsigned bit_plane_count(unsigned N)
+  {
+    return (N == 0)? 0 : 1 + bit_plane_count(N >> 1);
+  }
+
+  /**
+   * @brief Smallest `L` such that `(1 << L) >= N`.
+   */
+  constexpr unsigned ceil_log2(unsigned N)
+  {
+    return (N <= 1)? 0 : 1 + ceil_log2((N + 1) >> 1);
+  }
+
+}
+
+
+/**
+ * @brief PDM domain summing decimator
+ *
+ * This class template sums the PDM streams of `MIC_COUNT` microphones and
+ * decimates the sum, producing a single channel of PCM samples. Only one
+ * stage-2 filter is run, rather than `MIC_COUNT`, and the stage-1 filter is
+ * run `PLANE_COUNT` times rather than `MIC_COUNT` times. This is intended for
+ * low-power, always-on capture of a mono or broadside beam signal.
+ *
+ * For each PDM word period, the `MIC_COUNT` 1-bit streams are added bitwise
+ * into a multi-bit stream, held as `PLANE_COUNT` bit-planes (i.e. bit `p` of
+ * the per-sample count of `1` bits across the mics). The stage-1 filter is
+ * linear, so its output for the summed stream is the weighted sum of the
+ * outputs of @ref fir_1x16_bit() for each bit-plane. This is exactly the sum
+ * of the stage-1 outputs of the individual channels.
+ *
+ * Each channel's PDM stream may be delayed by a whole number of PDM clock
+ * periods with `SetPdmDelay()` before summing, to steer the beam.
+ *
+ * The output is the sum of the channels divided by `2^ceil(log2(MIC_COUNT))`,
+ * which is the mean if `MIC_COUNT` is a power of 2, so it cannot exceed the
+ * full scale of a single channel. The stage-1 outputs are summed with 64-bit
+ * precision and divided before stage 2, so even in-phase full-scale inputs
+ * on every channel do not overflow.
+ *
+ * Concrete implementations of this class template are meant to be used as the
+ * `TDecimator` template parameter in the @ref MicArray class template, with
+ * the `MIC_COUNT` parameter of @ref MicArray, the sample filter and the output
+ * handler all set to `1`. The PDM rx service still captures `MIC_COUNT`
+ * channels.
+ *
+ * The stage-1 state in `filter_conf[0]` must have room for `PLANE_COUNT`
+ * channels, and the stage-2 state in `filter_conf[1]` for `1` channel.
+ * `PLANE_COUNT` never exceeds `MIC_COUNT`, so state sized for
+ * @ref TwoStageDecimator is sufficient.
+ *
+ * @tparam MIC_COUNT      Number of microphone channels to be summed.
+ */
+template <unsigned MIC_COUNT>
+class SummingDecimator
+{
+  public:
+
+    /**
+     * Number of bit-planes used to represent the summed PDM stream.
+     */
+    static constexpr unsigned PLANE_COUNT = detail::bit_plane_count(MIC_COUNT);
+
+  private:
+
+    /**
+     * Stage 1 decimator configuration and state.
+     */
+    struct {
+      /**
+       * Pointer to filter coefficients for Stage 1
+       */
+      const uint32_t* filter_coef;
+      /**
+       * Number of coefficient bit-planes of the stage 1 filter (`0` for 16).
+       */
+      unsigned coef_bits;
+      /**
+       * Pointer to filter state (PDM history) for stage-1 filter, one history
+       * per bit-plane.
+       */
+      uint32_t *pdm_history_ptr;
+      /**
+       * Per bit-plane filter state (PDM history) size in 32-bit words.
+       */
+      unsigned pdm_history_sz;
+      /**
+       * Constant correction to the weighted sum of the bit-plane outputs.
+       */
+      int64_t offset;
+    } stage1;
+
+    /**
+     * Stage 2 decimation configuration and state.
+     */
+    struct {
+      /**
+       * Stage 2 FIR filter
+       */
+      filter_fir_s32_t filter;
+      /**
+       * Stage 2 filter decimation factor.
+       */
+      unsigned decimation_factor;
+    } stage2;
+
+    /**
+     * PDM domain delay of each channel.
+     */
+    struct {
+      /**
+       * Delay of each channel, in PDM samples.
+       */
+      unsigned bits[MIC_COUNT];
+      /**
+       * Previous PDM word of each channel.
+       */
+      uint32_t carry[MIC_COUNT];
+    } pdm_delay;
+
+  public:
+
+    constexpr SummingDecimator() noexcept { }
+
+    /**
+     * @brief Initialize the summing decimator from a configuration struct
+     * @ref mic_array_decimator_conf_t @p decimator_conf
+     *
+     * The configuration is the same as for @ref TwoStageDecimator, except
+     * for the sizes of the state buffers (see class description).
+     *
+     * @param decimator_conf Decimator pipeline configuration.
+     */
+    void Init(mic_array_decimator_conf_t &decimator_conf);
+
+    /**
+     * @brief Process one block of PDM data.
+     *
+     * `pdm_block` has the same layout as for
+     * @ref TwoStageDecimator::ProcessBlock(), with `MIC_COUNT` channels. A
+     * single output sample of the summed channels is written to
+     * `sample_out[0]`.
+     *
+     * @param sample_out  Output sample vector.
+     * @param pdm_block   PDM data to be processed.
+     */
+    void ProcessBlock(
+        int32_t sample_out[1],
+        uint32_t *pdm_block);
+
+    /**
+     * @brief Delay a channel in the PDM domain before summing.
+     *
+     * See @ref TwoStageDecimator::SetPdmDelay().
+     *
+     * @param channel Channel to delay.
+     * @param bits    Delay in PDM clock periods, in the range `[0, 31]`.
+     */
+    void SetPdmDelay(unsigned channel, unsigned bits);
+
+    /**
+     * @brief Get the PDM domain delay of a channel.
+     *
+     * @param channel Channel of interest.
+     *
+     * @returns Delay in PDM clock periods.
+     */
+    unsigned GetPdmDelay(unsigned channel) const;
+};
+
+}
+
+//////////////////////////////////////////////
+// Template function implementations below. //
+//////////////////////////////////////////////
+
+template <unsigned MIC_COUNT>
+constexpr unsigned mic_array::SummingDecimator<MIC_COUNT>::PLANE_COUNT;
+
+
+template <unsigned MIC_COUNT>
+void mic_array::SummingDecimator<MIC_COUNT>::Init(
+    mic_array_decimator_conf_t &decimator_conf)
+{
+  assert(fir_1xN_bit_supported(decimator_conf.filter_conf[0].coef_bits));
+  this->stage1.filter_coef = (const uint32_t*)decimator_conf.filter_conf[0].coef;
+  this->stage1.coef_bits = decimator_conf.filter_conf[0].coef_bits;
+  this->stage1.pdm_history_ptr = (uint32_t*)decimator_conf.filter_conf[0].state;
+  this->stage1.pdm_history_sz = decimator_conf.filter_conf[0].state_words_per_channel;
+
+  // The bit-planes of MIC_COUNT channels of 0x55.. are 0x55.. where MIC_COUNT
+  // has a 1 bit, and 0 elsewhere.
+  for(unsigned p = 0; p < PLANE_COUNT; p++){
+    memset(this->stage1.pdm_history_ptr + (p * this->stage1.pdm_history_sz),
+           ((MIC_COUNT >> p) & 1)? 0x55 : 0x00,
+           sizeof(int32_t) * this->stage1.pdm_history_sz);
+  }
+
+  // The count of 1 bits is sum(2^p * plane[p]), and each plane's filter
+  // output is offset by the output for an all-0 input. The remaining offset
+  // is that for (MIC_COUNT - (2^PLANE_COUNT - 1)) all-0 channels.
+  uint32_t zeros[8] = {0};
+  const int32_t zero_output = fir_1xN_bit(zeros, this->stage1.filter_coef, this->stage1.coef_bits);
+  this->stage1.offset = ((int64_t) zero_output) * (int32_t)(MIC_COUNT - ((1 << PLANE_COUNT) - 1));
+
+  for(int k = 0; k < MIC_COUNT; k++){
+    this->pdm_delay.bits[k] = 0;
+    this->pdm_delay.carry[k] = 0x55555555;
+  }
+
+  filter_fir_s32_init(&this->stage2.filter, decimator_conf.filter_conf[1].state,
+                      decimator_conf.filter_conf[1].num_taps, decimator_conf.filter_conf[1].coef,
+                      decimator_conf.filter_conf[1].shr);
+  this->stage2.decimation_factor = decimator_conf.filter_conf[1].decimation_factor;
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::SummingDecimator<MIC_COUNT>
+    ::ProcessBlock(
+        int32_t sample_out[1],
+        uint32_t *pdm_block)
+{
+  for(unsigned k = 0; k < this->stage2.decimation_factor; k++){
+    uint32_t plane[PLANE_COUNT] = {0};
+
+    // Bitwise ripple-carry add of each channel into the bit-planes.
+    for(unsigned mic = 0; mic < MIC_COUNT; mic++){
+      uint32_t carry = delay_pdm_word(*(pdm_block + (mic*this->stage2.decimation_factor + k)),
+                                      this->pdm_delay.carry[mic], this->pdm_delay.bits[mic]);
+      for(unsigned p = 0; p < PLANE_COUNT; p++){
+        const uint32_t c = plane[p] & carry;
+        plane[p] ^= carry;
+        carry = c;
+      }
+    }
+
+    // The sum of MIC_COUNT stage-1 outputs can exceed 32 bits, so it is
+    // scaled down to a single channel's range before stage 2.
+    int64_t streamA_sum = this->stage1.offset;
+    for(unsigned p = 0; p < PLANE_COUNT; p++){
+      uint32_t* hist = this->stage1.pdm_history_ptr + (p * this->stage1.pdm_history_sz);
+      hist[0] = plane[p];
+      streamA_sum += ((int64_t) fir_1xN_bit(hist, this->stage1.filter_coef, this->stage1.coef_bits)) << p;
+      shift_buffer(hist);
+    }
+    const int32_t streamA_sample = (int32_t) (streamA_sum >> detail::ceil_log2(MIC_COUNT));
+
+    if(k < (this->stage2.decimation_factor-1)){
+      filter_fir_s32_add_sample(&this->stage2.filter, streamA_sample);
+    } else {
+      sample_out[0] = filter_fir_s32(&this->stage2.filter, streamA_sample);
+    }
+  }
+}
+
+
+template <unsigned MIC_COUNT>
+void mic_array::SummingDecimator<MIC_COUNT>::SetPdmDelay(
+    unsigned channel,
+    unsigned bits)
+{
+  assert(channel < MIC_COUNT);
+  assert(bits < 32);
+  this->pdm_delay.bits[channel] = bits;
+}
+
+
+template <unsigned MIC_COUNT>
+unsigned mic_array::SummingDecimator<MIC_COUNT>::GetPdmDelay(
+    unsigned channel) const
+{
+  assert(channel < MIC_COUNT);
+  return this->pdm_delay.bits[channel];
+}
@@ -8,7 +8,8 @@
 #include <cassert>
 
 #include "xmath/xmath.h"
-#include "mic_array/etc/fir_1x16_bit.h"
+#include "mic_array/etc/fir_1xN_bit.h"
+#include "MultiStageDecimator.hpp"
 
 // This has caused problems previously, so just catch the problems here.
 #if defined (MIC_COUNT)
@@ -24,6 +25,24 @@ namespace  mic_array {
  * This class template represents a three stage decimator which converts a stream
  * of PDM samples to a lower sample rate stream of PCM samples.
  *
+ * If the third stage's `interpolation_factor` is greater than `1`, the third
+ * stage is a polyphase rational resampler rather than a decimating FIR
+ * filter. It changes the sample rate of the second stage output by
+ * `L / M`, where `L` is its `interpolation_factor` and `M` its
+ * `decimation_factor`, e.g. `147 / 160` for 44.1 kHz from a 48 kHz second
+ * stage output. `L` must not exceed `M`, so that each second stage output
+ * sample results in at most one output sample.
+ *
+ * The resampler's `num_taps` coefficients are those of a prototype low-pass
+ * filter at `L` times the second stage output rate, `h[]`, rearranged into `L`
+ * phases of `num_taps / L` taps. Phase `p` is stored at
+ * `coef[p * (num_taps / L)]` and holds `h[p + j * L]` for `j` in
+ * `[0, num_taps / L)`. Its state needs `num_taps / L` words per channel.
+ * `python/filter_design/resampler_design.py` designs such filters.
+ *
+ * The first two stages, and the third stage unless it is a resampler, are run
+ * by a @ref MultiStageDecimator.
+ *
  * Concrete implementations of this class template are meant to be used as the
  * `TDecimator` template parameter in the @ref MicArray class template.
  *
@@ -35,53 +54,48 @@ class ThreeStageDecimator
   private:
 
     /**
-     * Stage 1 decimator configuration and state.
+     * Stages 1 to 3, or stages 1 and 2 if stage 3 is a resampler.
      */
-    struct {
-      /**
-       * Pointer to filter coefficients for Stage 1
-       */
-
-      const uint32_t* filter_coef;
-      /**
-       * Pointer to filter state (PDM history) for stage-1 filter.
-       */
-      uint32_t *pdm_history_ptr;
-
-      /**
-       * Per-mic channel filter state (PDM history) size in 32-bit words for stage-1 filter.
-       */
-      unsigned pdm_history_sz;
-    } stage1;
+    MultiStageDecimator<MIC_COUNT, 3> cascade;
 
     /**
-     * Stage 2 decimation configuration and state.
+     * Stage 3 configuration and state, if it is a resampler.
      */
     struct {
       /**
-       * Stage 2 FIR filters
+       * Resampler FIR filters
        */
       filter_fir_s32_t filters[MIC_COUNT];
       /**
-       * Stage 2 filter decimation factor.
+       * Stage 3 decimation factor.
        */
       unsigned decimation_factor;
-    } stage2;
-
-    /**
-     * Stage 3 decimation configuration and state.
-     */
-    struct {
       /**
-       * Stage 3 FIR filters
+       * Stage 3 interpolation factor. `1` unless stage 3 is a resampler.
        */
-      filter_fir_s32_t filters[MIC_COUNT];
+      unsigned interpolation_factor;
       /**
-       * Stage 3 filter decimation factor.
+       * Resampler coefficients, one phase after another.
        */
-      unsigned decimation_factor;
+      int32_t* coef;
+      /**
+       * Resampler taps per phase.
+       */
+      unsigned phase_taps;
+      /**
+       * Position of the next resampler output after the newest input, at
+       * the interpolated sample rate.
+       */
+      unsigned phase;
     } stage3;
 
+    /**
+     * Process one block of PDM data when stage 3 is a resampler.
+     */
+    bool ResampleBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t *pdm_block);
+
   public:
 
     constexpr ThreeStageDecimator() noexcept { }
@@ -123,10 +137,17 @@ class ThreeStageDecimator
      * A single output sample from the third stage decimator is computed and
      * written to `sample_out[]`.
      *
+     * If the third stage is a resampler, `pdm_block` instead contains
+     * `S2_DEC_FACTOR` words per channel, i.e. enough for one second stage
+     * output sample. An output sample is written to `sample_out[]` only if
+     * the resampler produces one from it.
+     *
      * @param sample_out  Output sample vector.
      * @param pdm_block   PDM data to be processed.
+     *
+     * @returns Whether an output sample was written to `sample_out[]`.
      */
-    void ProcessBlock(
+    bool ProcessBlock(
         int32_t sample_out[MIC_COUNT],
         uint32_t *pdm_block);
 };
@@ -140,60 +161,70 @@ template <unsigned MIC_COUNT>
 void mic_array::ThreeStageDecimator<MIC_COUNT>::Init(
     mic_array_decimator_conf_t &decimator_conf)
 {
-  this->stage1.filter_coef = (const uint32_t*)decimator_conf.filter_conf[0].coef;
-  this->stage1.pdm_history_ptr = (uint32_t*)decimator_conf.filter_conf[0].state;
-  this->stage1.pdm_history_sz = decimator_conf.filter_conf[0].state_words_per_channel;
+  const mic_array_filter_conf_t& conf3 = decimator_conf.filter_conf[2];
+  this->stage3.decimation_factor = conf3.decimation_factor;
+  this->stage3.interpolation_factor = (conf3.interpolation_factor > 1)? conf3.interpolation_factor : 1;
 
-  memset(this->stage1.pdm_history_ptr, 0x55, sizeof(int32_t) * MIC_COUNT * this->stage1.pdm_history_sz);
+  const bool resampler = (this->stage3.interpolation_factor > 1);
+  mic_array_decimator_conf_t cascade_conf = { decimator_conf.filter_conf, resampler? 2u : 3u };
+  this->cascade.Init(cascade_conf);
+  if(!resampler)
+    return;
 
-  for(int k = 0; k < MIC_COUNT; k++){
-    filter_fir_s32_init(&this->stage2.filters[k], decimator_conf.filter_conf[1].state + (k * decimator_conf.filter_conf[1].state_words_per_channel),
-                        decimator_conf.filter_conf[1].num_taps, decimator_conf.filter_conf[1].coef, decimator_conf.filter_conf[1].shr);
-  }
-  this->stage2.decimation_factor = decimator_conf.filter_conf[1].decimation_factor;
+  this->stage3.coef = conf3.coef;
+  this->stage3.phase_taps = conf3.num_taps / this->stage3.interpolation_factor;
+  this->stage3.phase = 0;
+
+  // A resampler holds the history of a single phase.
+  assert(this->stage3.phase_taps * this->stage3.interpolation_factor == conf3.num_taps);
+  assert(this->stage3.interpolation_factor <= this->stage3.decimation_factor);
 
   for(int k = 0; k < MIC_COUNT; k++){
-    filter_fir_s32_init(&this->stage3.filters[k], decimator_conf.filter_conf[2].state + (k * decimator_conf.filter_conf[2].state_words_per_channel),
-                        decimator_conf.filter_conf[2].num_taps, decimator_conf.filter_conf[2].coef, decimator_conf.filter_conf[2].shr);
+    filter_fir_s32_init(&this->stage3.filters[k], conf3.state + (k * conf3.state_words_per_channel),
+                        this->stage3.phase_taps, conf3.coef, conf3.shr);
   }
-  this->stage3.decimation_factor = decimator_conf.filter_conf[2].decimation_factor;
 }
 
 
 template <unsigned MIC_COUNT>
-void mic_array::ThreeStageDecimator<MIC_COUNT>
+bool mic_array::ThreeStageDecimator<MIC_COUNT>
     ::ProcessBlock(
         int32_t sample_out[MIC_COUNT],
         uint32_t *pdm_block)
 {
-  unsigned stage1_output_words = this->stage2.decimation_factor * this->stage3.decimation_factor;
+  if(this->stage3.interpolation_factor > 1)
+    return this->ResampleBlock(sample_out, pdm_block);
+
+  this->cascade.ProcessBlock(sample_out, pdm_block);
+  return true;
+}
+
+
+template <unsigned MIC_COUNT>
+bool mic_array::ThreeStageDecimator<MIC_COUNT>
+    ::ResampleBlock(
+        int32_t sample_out[MIC_COUNT],
+        uint32_t *pdm_block)
+{
+  // The input at the interpolated rate is zero except at every L-th sample,
+  // so an output at phase p only needs taps p, p + L, p + 2L, ...
+  const bool output = (this->stage3.phase < this->stage3.interpolation_factor);
+  int32_t* phase_coef = this->stage3.coef + (output? this->stage3.phase : 0) * this->stage3.phase_taps;
+
+  int32_t streamB[MIC_COUNT];
+  this->cascade.ProcessBlock(streamB, pdm_block);
+
   for(unsigned mic = 0; mic < MIC_COUNT; mic++){
-    uint32_t* hist = this->stage1.pdm_history_ptr + (mic * this->stage1.pdm_history_sz);
-    uint32_t* mic_base = pdm_block + (mic * stage1_output_words);
-    int count2 = this->stage2.decimation_factor - 1;
-    int count3 = this->stage3.decimation_factor - 1;
-    for(unsigned k = 0; k < stage1_output_words; k++)
-    {
-      hist[0] = mic_base[k];
-
-      int32_t streamA_sample = fir_1x16_bit(hist, this->stage1.filter_coef);
-      shift_buffer(hist);
-
-      if(count2) {
-        filter_fir_s32_add_sample(&this->stage2.filters[mic], streamA_sample);
-        count2 -= 1;
-        continue;
-      }
-      int32_t streamB_sample = filter_fir_s32(&this->stage2.filters[mic], streamA_sample);
-      count2 = this->stage2.decimation_factor - 1;
-      if(count3) {
-        filter_fir_s32_add_sample(&this->stage3.filters[mic], streamB_sample);
-        count3 -= 1;
-      }
-      else {
-        sample_out[mic] = filter_fir_s32(&this->stage3.filters[mic], streamB_sample);
-        count3 = this->stage3.decimation_factor - 1;
-      }
+    if(output){
+      this->stage3.filters[mic].coef = phase_coef;
+      sample_out[mic] = filter_fir_s32(&this->stage3.filters[mic], streamB[mic]);
+    } else {
+      filter_fir_s32_add_sample(&this->stage3.filters[mic], streamB[mic]);
     }
   }
+
+  if(output)
+    this->stage3.phase += this->stage3.decimation_factor;
+  this->stage3.phase -= this->stage3.interpolation_factor;
+  return output;
 }
@@ -104,4 +104,29 @@ void dcoe_filter(
     int32_t new_input[],
     const unsigned chan_count);
 
+
+/**
+ * @brief Apply DCOE filter to a frame of samples.
+ *
+ * Applies the DC offset elimination filter in-place to `sample_count`
+ * consecutive samples of each of `chan_count` channels, updating the filter
+ * state. The result is identical to calling `dcoe_filter()` once for each
+ * sample of the frame, but the state of each channel is only loaded and stored
+ * once per frame.
+ *
+ * `frame` has layout `int32_t[chan_count][sample_count]`, i.e. all samples of
+ * channel 0, followed by all samples of channel 1, and so on.
+ *
+ * @param[inout]  frame         Frame of samples to be filtered.
+ * @param[in]     state         DC offset elimination state vector.
+ * @param[in]     chan_count    Number of channels to be processed.
+ * @param[in]     sample_count  Number of samples per channel.
+ */
+MA_C_API
+void dcoe_filter_frame(
+    int32_t frame[],
+    dcoe_chan_state_t state[],
+    const unsigned chan_count,
+    const unsigned sample_count);
+
 C_API_END
@@ -124,4 +124,72 @@ extern uint32_t stage1_48k_coefs[MIC_ARRAY_48K_STAGE_1_FILTER_WORD_COUNT];
 extern int32_t stage2_48k_coefs[MIC_ARRAY_48K_STAGE_2_TAP_COUNT];
 extern right_shift_t stage2_48k_shift;
 
+/*
+Presets for 8 kHz, 24 kHz and 96 kHz, designed with
+python/filter_design/design_filter.py and converted with stage1.py and stage2.py.
+The output shifts are chosen to give output levels in line with the 16 kHz,
+32 kHz and 48 kHz filters.
+
+8 kHz (good_8k_filter_int.pkl) uses stage1_coef, with a stage 2 decimation
+factor of 12.
+*/
+#define MIC_ARRAY_8K_STAGE_2_TAP_COUNT (384)
+extern int32_t stage2_8k_coefs[MIC_ARRAY_8K_STAGE_2_TAP_COUNT];
+extern right_shift_t stage2_8k_shift;
+
+/*
+Low MIPS 8 kHz (good_8k_3_stage_filter_int.pkl) uses stage1_coef, then a half
+band stage 2 to 48 kHz and a stage 3 decimation factor of 6.
+*/
+#define MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT (19)
+#define MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT (192)
+extern int32_t stage2_8k_3stg_coefs[MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT];
+extern right_shift_t stage2_8k_3stg_shift;
+extern int32_t stage3_8k_3stg_coefs[MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT];
+extern right_shift_t stage3_8k_3stg_shift;
+
+/*
+24 kHz (good_24k_filter_int.pkl) uses stage1_48k_coefs, with a stage 2
+decimation factor of 4.
+*/
+#define MIC_ARRAY_24K_STAGE_2_TAP_COUNT (128)
+extern int32_t stage2_24k_coefs[MIC_ARRAY_24K_STAGE_2_TAP_COUNT];
+extern right_shift_t stage2_24k_shift;
+
+/*
+96 kHz (good_96k_filter_int.pkl) has its own stage 1 filter, and a stage 2
+decimation factor of 1. Stage 2 only compensates for the stage 1 rolloff.
+*/
+#define MIC_ARRAY_96K_STAGE_1_FILTER_WORD_COUNT 128
+#define MIC_ARRAY_96K_STAGE_2_TAP_COUNT (48)
+extern uint32_t stage1_96k_coefs[MIC_ARRAY_96K_STAGE_1_FILTER_WORD_COUNT];
+extern int32_t stage2_96k_coefs[MIC_ARRAY_96K_STAGE_2_TAP_COUNT];
+extern right_shift_t stage2_96k_shift;
+
+/*
+Low latency 16 kHz, 32 kHz and 48 kHz presets (min_phase_16k_filter_int.pkl,
+min_phase_32k_filter_int.pkl and min_phase_48k_filter_int.pkl). These are
+minimum phase versions of stage2_coef, stage2_32k_coefs and stage2_48k_coefs,
+scaled to the same DC gain, so they use the same stage 1 filters and output
+shifts (stage2_shr, stage2_32k_shift and stage2_48k_shift).
+*/
+#define MIC_ARRAY_16K_MIN_PHASE_STAGE_2_TAP_COUNT (256)
+#define MIC_ARRAY_32K_MIN_PHASE_STAGE_2_TAP_COUNT (96)
+#define MIC_ARRAY_48K_MIN_PHASE_STAGE_2_TAP_COUNT (96)
+extern int32_t stage2_16k_min_phase_coefs[MIC_ARRAY_16K_MIN_PHASE_STAGE_2_TAP_COUNT];
+extern int32_t stage2_32k_min_phase_coefs[MIC_ARRAY_32K_MIN_PHASE_STAGE_2_TAP_COUNT];
+extern int32_t stage2_48k_min_phase_coefs[MIC_ARRAY_48K_MIN_PHASE_STAGE_2_TAP_COUNT];
+
+/*
+CIC 16 kHz preset (cic_16k_filter_int.pkl), for use with
+mic_array::CicCompDecimator. Stage 1 is a 4th order CIC filter, with the same
+response as stage1_coef, and stage 2 is a short CIC compensation filter with
+a stage 2 decimation factor of 6. It is scaled to the same DC gain as
+stage2_coef.
+*/
+#define MIC_ARRAY_16K_CIC_ORDER (4)
+#define MIC_ARRAY_16K_CIC_STAGE_2_TAP_COUNT (96)
+extern int32_t stage2_16k_cic_coefs[MIC_ARRAY_16K_CIC_STAGE_2_TAP_COUNT];
+extern right_shift_t stage2_16k_cic_shift;
+
 C_API_END
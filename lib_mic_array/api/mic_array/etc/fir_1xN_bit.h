@@ -0,0 +1,87 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "mic_array/api.h"
+#include "fir_1x16_bit.h"
+
+C_API_START
+
+/** Functions that compute an FIR over a 1-bit signal with reduced precision
+ * coefficients, for low-power first stage filters.
+ *
+ * These are the same as fir_1x16_bit(), except that only the `N` most
+ * significant of the 16 coefficient bit-planes are stored and filtered. The
+ * coefficients of 256 taps then take `N * 8` words, in the same order as for
+ * fir_1x16_bit() without the first `(16 - N) * 8` words, i.e. words 0..7 have
+ * magnitude +/-2^(16-N) and the last 8 words have magnitude +/-32767.
+ *
+ * The output has the same scale as that of fir_1x16_bit(), so a stage 1 filter
+ * can be switched to fewer bit-planes without changing later stages. Dropping
+ * the least significant bit-planes rounds each coefficient to an odd multiple
+ * of 2^(15-N), and the filter takes about `N` rather than 16 VLMACCR1 passes.
+ *
+ * @param    signal     the 1-bit signal (32-bit aligned)
+ * @param    coeff_1    N-bit coefficients split as above (32-bit aligned)
+ *
+ * @returns  The inner product
+ */
+MA_C_API
+int fir_1x8_bit(uint32_t signal[], const uint32_t coeff_1[]);
+
+/** @copydoc fir_1x8_bit */
+MA_C_API
+int fir_1x10_bit(uint32_t signal[], const uint32_t coeff_1[]);
+
+/** @copydoc fir_1x8_bit */
+MA_C_API
+int fir_1x12_bit(uint32_t signal[], const uint32_t coeff_1[]);
+
+/** @copydoc fir_1x8_bit */
+MA_C_API
+int fir_1x14_bit(uint32_t signal[], const uint32_t coeff_1[]);
+
+C_API_END
+
+#if !defined(__XC__)
+
+/** Whether a stage 1 filter with `coef_bits` coefficient bit-planes is
+ * supported by fir_1xN_bit().
+ *
+ * `0` stands for the full 16 bit-planes of fir_1x16_bit().
+ */
+static inline
+unsigned fir_1xN_bit_supported(unsigned coef_bits)
+{
+  return coef_bits == 0 || coef_bits == 16 || coef_bits == 14
+      || coef_bits == 12 || coef_bits == 10 || coef_bits == 8;
+}
+
+/** FIR over a 1-bit signal with `coef_bits` coefficient bit-planes.
+ *
+ * Calls fir_1x16_bit() when `coef_bits` is `0` or `16`, or else the
+ * fir_1x8_bit() family function for `coef_bits`, which must be one for which
+ * fir_1xN_bit_supported() is true.
+ *
+ * @param    signal     the 1-bit signal (32-bit aligned)
+ * @param    coeff_1    coefficients split into bit-planes (32-bit aligned)
+ * @param    coef_bits  number of coefficient bit-planes in `coeff_1`
+ *
+ * @returns  The inner product
+ */
+static inline
+int fir_1xN_bit(uint32_t signal[], const uint32_t coeff_1[], unsigned coef_bits)
+{
+  switch(coef_bits){
+    case 8:   return fir_1x8_bit(signal, coeff_1);
+    case 10:  return fir_1x10_bit(signal, coeff_1);
+    case 12:  return fir_1x12_bit(signal, coeff_1);
+    case 14:  return fir_1x14_bit(signal, coeff_1);
+    default:  return fir_1x16_bit(signal, coeff_1);
+  }
+}
+
+#endif // !defined(__XC__)
@@ -0,0 +1,175 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+#pragma once
+
+#include "api.h"
+#include "etc/xcore_compat.h"
+#include "frame_transfer.h"
+
+#include <stdint.h>
+
+/**
+ * @defgroup frame_callback_h_ frame_callback.h
+ */
+
+C_API_START
+
+/**
+ * @brief Function called by the mic array thread for each completed frame.
+ *
+ * `frame` points to a library-owned frame buffer with layout
+ * `int32_t[MIC_COUNT][SAMPLE_COUNT]`. The buffer is not modified until the
+ * callback returns, and then remains untouched for a further `FRAME_COUNT - 1`
+ * frame periods, where `FRAME_COUNT` is the number of frame buffers in the
+ * output handler.
+ *
+ * The callback runs in the mic array thread and must return well within one
+ * frame period, or PDM data will be lost.
+ *
+ * @param context   Application context supplied with the callback.
+ * @param frame     Pointer to the completed frame.
+ * @param metadata  Metadata of the completed frame.
+ *
+ * @returns Non-zero to request mic array shutdown, otherwise 0.
+ */
+typedef unsigned (*ma_frame_callback_t)(
+    void* context,
+    int32_t* frame,
+    const ma_frame_metadata_t* metadata);
+
+/**
+ * @brief Entry of a @ref ma_frame_queue_t.
+ */
+typedef struct {
+  /** Pointer to the frame buffer. */
+  int32_t* frame;
+  /** Metadata of the frame. */
+  ma_frame_metadata_t metadata;
+} ma_frame_queue_entry_t;
+
+/**
+ * @brief Lock-free single-producer single-consumer queue of frame pointers.
+ *
+ * The mic array thread pushes a pointer to each completed frame. A consumer
+ * thread on the same tile takes the oldest frame with
+ * @ref ma_frame_queue_acquire() and hands it back with
+ * @ref ma_frame_queue_release(). Frames are never copied.
+ *
+ * A frame buffer is not reused by the mic array until it has been released. If
+ * the queue is full the mic array thread waits for the consumer, so the
+ * consumer must keep up on average or PDM blocks will be dropped.
+ *
+ * The members of this struct should not be accessed directly.
+ */
+typedef struct {
+  /** Storage for queued entries. */
+  ma_frame_queue_entry_t* entries;
+  /** Number of entries in `entries`. */
+  unsigned depth;
+  /** Number of frames pushed. Written only by the producer. */
+  volatile unsigned head;
+  /** Number of frames released. Written only by the consumer. */
+  volatile unsigned tail;
+  /** Set by the consumer to request mic array shutdown. */
+  volatile unsigned shutdown_requested;
+  /** Set by the producer once no further frames will be pushed. */
+  volatile unsigned closed;
+} ma_frame_queue_t;
+
+/**
+ * @brief Initialise a frame queue.
+ *
+ * @param queue   Queue to initialise.
+ * @param entries Storage for `depth` queue entries.
+ * @param depth   Maximum number of frames which may be queued or held by the
+ *                consumer. Must be non-zero.
+ */
+MA_C_API
+void ma_frame_queue_init(
+    ma_frame_queue_t* queue,
+    ma_frame_queue_entry_t* entries,
+    const unsigned depth);
+
+/**
+ * @brief Push a frame onto a frame queue.
+ *
+ * Called by the mic array thread. If the queue is full this waits until the
+ * consumer releases a frame, or until shutdown is requested, in which case the
+ * frame is discarded.
+ *
+ * @param queue     Queue to push onto.
+ * @param frame     Frame to push.
+ * @param metadata  Metadata of the frame, or `NULL`.
+ *
+ * @returns 1 if shutdown has been requested by the consumer, otherwise 0.
+ */
+MA_C_API
+unsigned ma_frame_queue_push(
+    ma_frame_queue_t* queue,
+    int32_t* frame,
+    const ma_frame_metadata_t* metadata);
+
+/**
+ * @brief Take the oldest frame from a frame queue.
+ *
+ * This does not block. The frame remains valid until
+ * @ref ma_frame_queue_release() is called. Calling this again before the
+ * frame is released returns the same frame.
+ *
+ * @param queue     Queue to take a frame from.
+ * @param metadata  If not `NULL`, receives the metadata of the frame.
+ *
+ * @returns Pointer to a frame with layout `int32_t[MIC_COUNT][SAMPLE_COUNT]`,
+ *          or `NULL` if the queue is empty.
+ */
+MA_C_API
+int32_t* ma_frame_queue_acquire(
+    ma_frame_queue_t* queue,
+    ma_frame_metadata_t* metadata);
+
+/**
+ * @brief Return the frame taken with @ref ma_frame_queue_acquire() to the
+ *        mic array.
+ *
+ * @param queue Queue from which the frame was taken.
+ */
+MA_C_API
+void ma_frame_queue_release(
+    ma_frame_queue_t* queue);
+
+/**
+ * @brief Request that the mic array shuts down.
+ *
+ * The mic array thread acts on the request when it next pushes a frame. The
+ * consumer should continue releasing frames until @ref ma_frame_queue_closed()
+ * returns non-zero.
+ *
+ * @param queue Queue whose producer should shut down.
+ */
+MA_C_API
+void ma_frame_queue_request_shutdown(
+    ma_frame_queue_t* queue);
+
+/**
+ * @brief Mark a frame queue as closed.
+ *
+ * Called by the mic array thread once it will push no further frames.
+ *
+ * @param queue Queue to close.
+ */
+MA_C_API
+void ma_frame_queue_close(
+    ma_frame_queue_t* queue);
+
+/**
+ * @brief Check whether the producer has closed a frame queue.
+ *
+ * @param queue Queue to check.
+ *
+ * @returns Non-zero if no further frames will be pushed, otherwise 0.
+ */
+MA_C_API
+unsigned ma_frame_queue_closed(
+    const ma_frame_queue_t* queue);
+
+C_API_END
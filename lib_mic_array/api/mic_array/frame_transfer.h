@@ -13,6 +13,41 @@
 
 C_API_START
 
+/**
+ * @brief Metadata describing a single frame of PCM samples.
+ *
+ * When enabled, this fixed-size header accompanies each frame delivered by the
+ * mic array so that downstream processing can detect lost audio and
+ * resynchronise or conceal gaps.
+ */
+typedef struct {
+  /**
+   * Sequence number of the frame. Incremented by one for each frame produced
+   * by the mic array, so a gap in received sequence numbers indicates that a
+   * consumer missed frames.
+   */
+  uint32_t sequence;
+  /**
+   * Value of the 100 MHz reference timer when the first sample of the frame was
+   * produced by the decimator.
+   *
+   * This is the decimator output time, not the PDM capture time. The PDM
+   * data behind the sample was captured earlier by the group delay of the
+   * decimation filters, plus the time taken to receive and process it. For
+   * the first sample of a frame, `mic_array_decimator_latency()` with a
+   * `samples_per_frame` of `1` gives that group delay in output samples,
+   * which is `mic_array_get_latency() - (MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME - 1)`
+   * for the default model. Subtract it, converted to reference timer ticks, to
+   * estimate the capture time.
+   */
+  uint32_t timestamp;
+  /**
+   * Number of blocks of PDM data dropped by the PDM rx service since the
+   * previous frame was produced.
+   */
+  uint32_t dropped_blocks;
+} ma_frame_metadata_t;
+
 /**
  * @brief Transmit 32-bit PCM frame over a channel.
  *
@@ -129,4 +164,49 @@ void ma_frame_rx_transpose(
     const unsigned sample_count);
 
 
+/**
+ * @brief Transmit 32-bit PCM frame and its metadata over a channel.
+ *
+ * This function behaves like `ma_frame_tx()`, except that the frame metadata
+ * `metadata` is transmitted ahead of the frame samples. The frame must be
+ * received with `ma_frame_rx_metadata()`.
+ *
+ * @param c_frame_out   Channel over which to send frame.
+ * @param metadata      Metadata to be transmitted with the frame.
+ * @param frame         Frame to be transmitted.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ *
+ * @return shutdown - 0 if no shutdown requested, 1 if shutdown requested
+ */
+MA_C_API
+unsigned ma_frame_tx_metadata(
+    const chanend_t c_frame_out,
+    const ma_frame_metadata_t* metadata,
+    const int32_t frame[],
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
+/**
+ * @brief Receive 32-bit PCM frame and its metadata over a channel.
+ *
+ * This function behaves like `ma_frame_rx()`, except that the frame metadata
+ * transmitted by `ma_frame_tx_metadata()` is received into `metadata`.
+ *
+ * @param metadata      Buffer to store received frame metadata.
+ * @param frame         Buffer to store received frame.
+ * @param c_frame_in    Channel from which to receive frame.
+ * @param channel_count Number of channels represented in the frame.
+ * @param sample_count  Number of samples represented in the frame.
+ */
+MA_C_API
+void ma_frame_rx_metadata(
+    ma_frame_metadata_t* metadata,
+    int32_t frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count);
+
+
 C_API_END
@@ -0,0 +1,53 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#pragma once
+
+#include "api.h"
+#include "mic_array_conf_struct.h"
+
+C_API_START
+
+/**
+ * @brief Get the PDM to frame latency of a decimator configuration.
+ *
+ * Computes the delay, in output samples, from a PDM sample being captured to
+ * it appearing in a frame, for a decimator with the filter stages of
+ * @p decimator_conf. This is the sum of the group delay of each filter stage
+ * plus the `samples_per_frame - 1` samples for which the oldest sample of a
+ * frame waits for the frame to be completed. It is rounded up to a whole
+ * number of output samples, and does not include processing time.
+ *
+ * The group delay of each stage is its delay at DC, computed from the filter
+ * coefficients. For a linear phase filter this is the delay at all
+ * frequencies. A minimum phase filter has a smaller delay, which varies with
+ * frequency, and the delay at DC is representative of low frequencies.
+ *
+ * `filter_conf[0]` is the stage 1 filter, with coefficients in the
+ * `fir_1xN_bit()` format for its `coef_bits` and a decimation factor of 32,
+ * or a CIC filter if its `cic_order` is non-zero, as for `mic_array::CicCompDecimator`. Each later stage is
+ * a FIR filter with `num_taps` int32 coefficients, whose output is decimated
+ * by `decimation_factor`. A stage with an `interpolation_factor` greater
+ * than `1` is a polyphase rational resampler, as for
+ * `mic_array::ThreeStageDecimator`. With MIC_ARRAY_CONFIG_USE_S16_FILTERS
+ * enabled, the coefficients of the later stages are int16 instead, as for
+ * the `mic_array::MultiStageDecimatorS16` used by
+ * mic_array_init_custom_filter(), unless stage 1 is a CIC filter. The default
+ * filters selected by mic_array_init() keep int32 coefficients, which
+ * mic_array_get_latency() accounts for.
+ *
+ * The stages must be in series, as for `mic_array::TwoStageDecimator` and
+ * `mic_array::ThreeStageDecimator`, rather than in parallel as for
+ * `mic_array::MultiRateDecimator`.
+ *
+ * @param decimator_conf      Decimator pipeline configuration.
+ * @param samples_per_frame   Number of samples in each output frame.
+ *
+ * @returns Latency in output samples.
+ */
+MA_C_API
+unsigned mic_array_decimator_latency(
+    const mic_array_decimator_conf_t* decimator_conf,
+    const unsigned samples_per_frame);
+
+C_API_END
@@ -61,4 +61,159 @@
 # define MIC_ARRAY_CONFIG_USE_DC_ELIMINATION    (1)
 #endif
 
+/** @brief Send a ma_frame_metadata_t header with each frame (1 = enabled).
+ * When enabled, frames must be received with ma_frame_rx_metadata().
+ * Default: 0
+*/
+#ifndef MIC_ARRAY_CONFIG_USE_FRAME_METADATA
+# define MIC_ARRAY_CONFIG_USE_FRAME_METADATA    (0)
+#endif
+
+/** @brief Deliver frames to a callback or queue in shared memory instead of a
+ * channel (1 = enabled). When enabled, the mic array is started with
+ * mic_array_start_callback() rather than mic_array_start().
+ * Default: 0
+*/
+#ifndef MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK
+# define MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK    (0)
+#endif
+
+/**
+ * @brief Number of frame buffers used by the output handler.
+ * When MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK is enabled, up to
+ * MIC_ARRAY_CONFIG_FRAME_COUNT - 1 frames can be queued at once, so this must
+ * be >= 2.
+ * Default: 1, or 2 if MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK is enabled
+ */
+#ifndef MIC_ARRAY_CONFIG_FRAME_COUNT
+# if MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK
+#  define MIC_ARRAY_CONFIG_FRAME_COUNT    (2)
+# else
+#  define MIC_ARRAY_CONFIG_FRAME_COUNT    (1)
+# endif
+#else
+# if ((MIC_ARRAY_CONFIG_FRAME_COUNT) < 1)
+#  error MIC_ARRAY_CONFIG_FRAME_COUNT must be positive.
+# elif (MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK && ((MIC_ARRAY_CONFIG_FRAME_COUNT) < 2))
+#  error MIC_ARRAY_CONFIG_FRAME_COUNT must be at least 2 with MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK.
+# endif
+#endif
+
+/** @brief Use the low MIPS 3 stage filters when mic_array_init() is called for
+ * 8 kHz output from a 3.072 MHz PDM clock (1 = enabled). The output sample
+ * rate of a mic array started this way cannot be changed with
+ * mic_array_set_output_rate().
+ * Default: 0
+*/
+#ifndef MIC_ARRAY_CONFIG_USE_3_STAGE_8K
+# define MIC_ARRAY_CONFIG_USE_3_STAGE_8K    (0)
+#endif
+
+/** @brief Use the low latency minimum phase stage 2 filters for 16 kHz,
+ * 32 kHz and 48 kHz output with the default API (1 = enabled). These have the
+ * same magnitude response as the linear phase filters, but a non-linear phase
+ * response. Other output sample rates use the linear phase filters.
+ * Default: 0
+*/
+#ifndef MIC_ARRAY_CONFIG_USE_MIN_PHASE_FILTERS
+# define MIC_ARRAY_CONFIG_USE_MIN_PHASE_FILTERS    (0)
+#endif
+
+/** @brief Use 16-bit coefficients and state for filter stages 2 onwards with
+ * mic_array_init_custom_filter() (1 = enabled), which halves their memory.
+ * Custom filters are then run by mic_array::MultiStageDecimatorS16, and must
+ * be exported with `python/stage2.py --s16`. Does not affect mic_array_init().
+ * Default: 0
+*/
+#ifndef MIC_ARRAY_CONFIG_USE_S16_FILTERS
+# define MIC_ARRAY_CONFIG_USE_S16_FILTERS    (0)
+#endif
+
+/** @brief Output sample rate flags for MIC_ARRAY_CONFIG_SUPPORTED_RATES.
+ * Each selects the default filters for one stage 2 decimation factor, named
+ * by the output sample rate it gives from a 3.072 MHz PDM clock, i.e. 12, 6,
+ * 4, 3, 2 and 1 for 8 kHz to 96 kHz.
+*/
+#define MIC_ARRAY_RATE_8K     (0x01)
+/** @copydoc MIC_ARRAY_RATE_8K */
+#define MIC_ARRAY_RATE_16K    (0x02)
+/** @copydoc MIC_ARRAY_RATE_8K */
+#define MIC_ARRAY_RATE_24K    (0x04)
+/** @copydoc MIC_ARRAY_RATE_8K */
+#define MIC_ARRAY_RATE_32K    (0x08)
+/** @copydoc MIC_ARRAY_RATE_8K */
+#define MIC_ARRAY_RATE_48K    (0x10)
+/** @copydoc MIC_ARRAY_RATE_8K */
+#define MIC_ARRAY_RATE_96K    (0x20)
+/** @brief All of the MIC_ARRAY_RATE_8K flags. */
+#define MIC_ARRAY_RATE_ALL    (0x3F)
+
+/** @brief Output sample rates supported by mic_array_init() and
+ * mic_array_set_output_rate(), as a bitwise OR of MIC_ARRAY_RATE_8K flags.
+ * Only the filter coefficients, filter state and PDM buffers needed for these
+ * rates are built in, e.g. `MIC_ARRAY_RATE_16K` alone leaves out all the
+ * other stage 1 and stage 2 tables and sizes the PDM buffers for a stage 2
+ * decimation factor of 6. Asking for any other rate asserts.
+ * Default: MIC_ARRAY_RATE_16K | MIC_ARRAY_RATE_32K | MIC_ARRAY_RATE_48K, plus
+ * MIC_ARRAY_RATE_8K if MIC_ARRAY_CONFIG_USE_3_STAGE_8K is enabled
+*/
+#ifndef MIC_ARRAY_CONFIG_SUPPORTED_RATES
+# if MIC_ARRAY_CONFIG_USE_3_STAGE_8K
+#  define MIC_ARRAY_CONFIG_SUPPORTED_RATES    (MIC_ARRAY_RATE_8K | MIC_ARRAY_RATE_16K \
+                                              | MIC_ARRAY_RATE_32K | MIC_ARRAY_RATE_48K)
+# else
+#  define MIC_ARRAY_CONFIG_SUPPORTED_RATES    (MIC_ARRAY_RATE_16K | MIC_ARRAY_RATE_32K \
+                                              | MIC_ARRAY_RATE_48K)
+# endif
+#elif (((MIC_ARRAY_CONFIG_SUPPORTED_RATES) & MIC_ARRAY_RATE_ALL) == 0)
+# error MIC_ARRAY_CONFIG_SUPPORTED_RATES must include at least one MIC_ARRAY_RATE_* flag.
+#endif
+
+/** @brief Support changing the output sample rate while running with
+ * mic_array_set_output_rate() (1 = enabled). When enabled, and more than one
+ * rate is in MIC_ARRAY_CONFIG_SUPPORTED_RATES, the stage 2 filter state is
+ * double buffered so that the filters for the new rate can be filled while
+ * the current ones are in use. When disabled, mic_array_set_output_rate()
+ * traps.
+ * Default: 0
+*/
+#ifndef MIC_ARRAY_CONFIG_USE_RATE_SWITCHING
+# define MIC_ARRAY_CONFIG_USE_RATE_SWITCHING    (0)
+#endif
+
+/** @brief Support mic_array_init_custom_filter() (1 = enabled). When
+ * disabled, the decimators used only for custom filters, i.e. those for CIC,
+ * 3 stage (unless used by MIC_ARRAY_CONFIG_USE_3_STAGE_8K) and more than 3
+ * stage filters, are left out, and mic_array_init_custom_filter() traps.
+ * Default: 1
+*/
+#ifndef MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+# define MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS    (1)
+#endif
+
+/** @brief Number of mic array instances which can be initialised at the same
+ * time with mic_array_instance_init() or
+ * mic_array_instance_init_custom_filter(). Each instance has its own PDM
+ * port, filter state and decimator thread, but all share this compile-time
+ * configuration. Storage is allocated for this many instances.
+ * Default: 1
+*/
+#ifndef MIC_ARRAY_CONFIG_MAX_INSTANCES
+# define MIC_ARRAY_CONFIG_MAX_INSTANCES    (1)
+#elif ((MIC_ARRAY_CONFIG_MAX_INSTANCES) < 1)
+# error MIC_ARRAY_CONFIG_MAX_INSTANCES must be at least 1.
+#endif
+
+/** @brief Largest number of decimation filter stages, including the first
+ * stage, accepted by mic_array_init_custom_filter(). Filters with more than 3
+ * stages are run by mic_array::MultiStageDecimator, whose state grows with
+ * this. Must be at least 3.
+ * Default: 4
+*/
+#ifndef MIC_ARRAY_CONFIG_MAX_FILTER_STAGES
+# define MIC_ARRAY_CONFIG_MAX_FILTER_STAGES    (4)
+#elif ((MIC_ARRAY_CONFIG_MAX_FILTER_STAGES) < 3)
+# error MIC_ARRAY_CONFIG_MAX_FILTER_STAGES must be at least 3.
+#endif
+
 #endif // _MIC_ARRAY_CONF_DEFAULT_H_
@@ -15,6 +15,12 @@ C_API_START
  * All memory referenced by this structure is owned by the caller. The caller
  * must allocate and initialize all buffers (coefficients and state) and ensure
  * that all pointers remain valid for the entire lifetime of the decimator.
+ *
+ * The structure must be zero-initialized (e.g. with `memset()`) before its
+ * fields are filled in. The decimator is chosen from `interpolation_factor`,
+ * `cic_order` and `coef_bits` as well as the stage count, and zero selects the
+ * usual FIR stage for each, so a caller which only sets the other fields
+ * gets the same filters as before they were added.
  */
 typedef struct
 {
@@ -60,6 +66,38 @@ typedef struct
      * Used to index state for each mic: state[mic * state_words_per_channel ... ].
      */
     unsigned state_words_per_channel;
+
+    /**
+     * @brief Interpolation ratio (upsampling factor) applied by this filter stage
+     * @details
+     * Only used by the third stage of a three stage decimator, which is a
+     * polyphase rational resampler when this is greater than `1`. It then
+     * changes the sample rate by `interpolation_factor / decimation_factor`.
+     * Must be `0` (or `1`) for any other stage.
+     */
+    unsigned interpolation_factor;
+
+    /**
+     * @brief Order of a CIC first stage
+     * @details
+     * Only used by the first stage, which is a CIC filter of this order
+     * decimating by 32 when it is non-zero, as for
+     * `mic_array::CicCompDecimator`. `coef` and `num_taps` are then unused,
+     * and `state_words_per_channel` must be at least `2 * cic_order`.
+     * Must be `0` for a FIR stage.
+     */
+    unsigned cic_order;
+
+    /**
+     * @brief Number of coefficient bit-planes of a FIR first stage
+     * @details
+     * Only used by the first stage. `0` (or `16`) is the usual 16-bit
+     * `fir_1x16_bit()` coefficient format. `8`, `10`, `12` or `14` select the
+     * reduced precision `fir_1x8_bit()` family of filters, with `coef`
+     * holding `coef_bits * 8` words, as emitted by `stage1.py --stage1-bits`.
+     * Must be `0` for any other stage.
+     */
+    unsigned coef_bits;
 }mic_array_filter_conf_t;
 
 /**
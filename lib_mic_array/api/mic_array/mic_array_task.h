@@ -8,6 +8,21 @@
 
 C_API_START
 
+/**
+ * @brief Handle of a mic array instance
+ *
+ * Returned by mic_array_instance_init() or
+ * mic_array_instance_init_custom_filter(), and passed to the other
+ * `mic_array_instance_*()` functions. Up to MIC_ARRAY_CONFIG_MAX_INSTANCES
+ * instances, each with its own PDM port and decimator thread, can run on a
+ * tile at the same time, e.g. to capture two groups of microphones at
+ * different output sample rates.
+ *
+ * The functions without a handle, such as mic_array_init() and
+ * mic_array_start(), use a single default instance.
+ */
+typedef struct mic_array_instance mic_array_instance_t;
+
 /**
  * @brief Initializes the mic array task
  *
@@ -28,11 +43,52 @@ C_API_START
  *                          - If channel_map is NULL, a default 1:1 mapping is used: PDM pin i -> mic output channel i.
  *                          - Valid values for channel_map[i] are in [0, MIC_ARRAY_CONFIG_MIC_IN_COUNT-1].
  * @param output_samp_freq  Target sampling rate (in Hz) for the decimated PCM output stream
- *                          Supported values: 16000, 32000, 48000 (Hz).
+ *                          Supported values: those of 8000, 16000, 24000, 32000, 48000
+ *                          and 96000 (Hz) in MIC_ARRAY_CONFIG_SUPPORTED_RATES, by default
+ *                          16000, 32000 and 48000.
+ *                          With MIC_ARRAY_CONFIG_USE_3_STAGE_8K enabled, 8000 uses the
+ *                          low MIPS 3 stage filters.
+ *
+ * @note This initialises the default instance, which is used by mic_array_start() and the
+ *       other functions without an instance handle. Use mic_array_instance_init() to
+ *       initialise more than one instance.
  */
 MA_C_API
 void mic_array_init(pdm_rx_resources_t *pdm_res, const unsigned *channel_map, unsigned output_samp_freq);
 
+/**
+ * @brief Change the output sample rate while the mic array is running
+ *
+ * Switches the decimator to the default filters for @p output_samp_freq
+ * without stopping the mic array threads or the PDM clock. The new stage 2
+ * filter is first filled from the stage 1 output alongside the current one,
+ * and the PDM rx block size and the filters are then changed together at a
+ * block boundary, so there is no gap or warm-up transient in the output. The
+ * switch completes within a few milliseconds (the length of the new stage 2
+ * filter plus a few PDM blocks).
+ *
+ * Frames keep MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME samples, so frames arrive at
+ * a different rate after the switch. The frame containing the switch holds
+ * samples at both rates.
+ *
+ * Requires MIC_ARRAY_CONFIG_USE_RATE_SWITCHING; otherwise this traps. Asking
+ * for the current rate does nothing.
+ *
+ * May be called from any thread on the tile of the mic array, once
+ * mic_array_start() has been called on a mic array initialised with
+ * mic_array_init(). This call blocks: if a previous change is still in
+ * progress, it busy-waits for it to complete, which takes at most a few
+ * milliseconds. If the previous change has not completed after 100 ms, i.e.
+ * the mic array is not running, this traps.
+ *
+ * @param output_samp_freq  New output sampling rate (in Hz). The same values are
+ *                          supported as for mic_array_init(), but 8000 always uses the
+ *                          2 stage filters. Not supported if mic_array_init() chose the
+ *                          3 stage 8 kHz filters.
+ */
+MA_C_API
+void mic_array_set_output_rate(unsigned output_samp_freq);
+
 /**
  * @brief Initialize the mic array using application-supplied decimation filter and PDM RX buffers.
  *
@@ -41,6 +97,14 @@ void mic_array_init(pdm_rx_resources_t *pdm_res, const unsigned *channel_map, un
  * @ref mic_array_start returns. This excludes the @ref mic_array_conf_t structure
  * itself and the @ref mic_array_decimator_conf_t::filter_conf array, which may reside on the caller’s stack.
  *
+ * The decimator is chosen by the number of filter stages,
+ * @ref mic_array_decimator_conf_t::num_filter_stages, which may be from 2 to
+ * MIC_ARRAY_CONFIG_MAX_FILTER_STAGES. 2 stages use mic_array::TwoStageDecimator
+ * (or mic_array::CicCompDecimator for a CIC first stage), 3 stages use
+ * mic_array::ThreeStageDecimator, and more stages use
+ * mic_array::MultiStageDecimator. With MIC_ARRAY_CONFIG_USE_S16_FILTERS
+ * enabled, all but CIC filters use mic_array::MultiStageDecimatorS16.
+ *
  * After successful initialization, the PDM clock is configured and started, but
  * no threads/ISRs are running until mic_array_start() is called.
  *
@@ -56,6 +120,26 @@ void mic_array_init(pdm_rx_resources_t *pdm_res, const unsigned *channel_map, un
 MA_C_API
 void mic_array_init_custom_filter(pdm_rx_resources_t* pdm_res, mic_array_conf_t* mic_array_conf);
 
+/**
+ * @brief Get the PDM to frame latency of the mic array
+ *
+ * Reports the delay, in output samples, from a PDM sample being captured to
+ * it appearing in a frame, for the filters selected by mic_array_init(),
+ * mic_array_init_custom_filter() or the latest call to
+ * mic_array_set_output_rate(). This includes the group delay of the
+ * decimation filters and the buffering of MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME
+ * samples into each frame. See mic_array_decimator_latency() for details.
+ *
+ * With MIC_ARRAY_CONFIG_USE_MIN_PHASE_FILTERS enabled, the 16 kHz, 32 kHz and
+ * 48 kHz default filters have a much lower latency.
+ *
+ * May be called at any time after the mic array has been initialised.
+ *
+ * @returns Latency in output samples.
+ */
+MA_C_API
+unsigned mic_array_get_latency(void);
+
 /**
  * @brief Start the mic array task
  *
@@ -67,11 +151,150 @@ void mic_array_init_custom_filter(pdm_rx_resources_t* pdm_res, mic_array_conf_t*
  * another thread waiting to pull frames from the other end of `c_frames_out`
  * as they become available.
  *
+ * With MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK=1 this traps, and
+ * mic_array_start_callback() must be used instead.
+ *
  * @param c_frames_out  (Non-streaming) Channel over which to send processed
  *                      frames of audio.
  */
 MA_C_API
 void mic_array_start(chanend_t c_frames_out);
 
+/**
+ * @brief Start the mic array task, delivering frames in shared memory
+ *
+ * This is the equivalent of mic_array_start() for applications built with
+ * MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK=1, in which frames are delivered by
+ * pointer into a pool of MIC_ARRAY_CONFIG_FRAME_COUNT library-owned frame
+ * buffers instead of being sent over a channel. Without
+ * MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK=1 it traps.
+ *
+ * If @p callback is not NULL it is called from the mic array thread with each
+ * frame (see @ref ma_frame_callback_t), and the mic array shuts down when it
+ * returns non-zero.
+ *
+ * If @p callback is NULL each frame is pushed onto the queue returned by
+ * mic_array_get_frame_queue(), from which another thread on the same tile
+ * takes frames with ma_frame_queue_acquire() and ma_frame_queue_release(). The
+ * mic array shuts down after ma_frame_queue_request_shutdown() is called.
+ *
+ * Like mic_array_start(), this function returns only once the mic array has
+ * shut down.
+ *
+ * @param callback  Function called for each frame, or NULL to use the queue.
+ * @param context   Application context passed to @p callback.
+ */
+MA_C_API
+void mic_array_start_callback(ma_frame_callback_t callback, void* context);
+
+/**
+ * @brief Get the queue onto which frames are pushed
+ *
+ * Only available with MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK=1, and traps
+ * otherwise. Must be called after the mic array has been initialised and
+ * before it is started, typically to pass the queue to the consumer thread.
+ *
+ * @returns Frame queue of the initialised mic array.
+ */
+MA_C_API
+ma_frame_queue_t* mic_array_get_frame_queue(void);
+
+/**
+ * @brief Initialize a mic array instance with the default filters
+ *
+ * The same as mic_array_init(), but initialises a new instance, which must be
+ * started with mic_array_instance_start() (or
+ * mic_array_instance_start_callback()). Each instance must have its own
+ * @p pdm_res, with a separate PDM data port.
+ *
+ * The instance is free for reuse once it has been started and has shut down.
+ * Initialising more than MIC_ARRAY_CONFIG_MAX_INSTANCES instances at a time
+ * traps. Instances should be initialised from one thread.
+ *
+ * @param pdm_res           As for mic_array_init().
+ * @param channel_map       As for mic_array_init().
+ * @param output_samp_freq  As for mic_array_init().
+ *
+ * @returns Handle of the new instance.
+ */
+MA_C_API
+mic_array_instance_t* mic_array_instance_init(pdm_rx_resources_t *pdm_res, const unsigned *channel_map, unsigned output_samp_freq);
+
+/**
+ * @brief Initialize a mic array instance using application-supplied filters
+ *
+ * The same as mic_array_init_custom_filter(), but initialises a new instance,
+ * as for mic_array_instance_init(). Each instance must have its own buffers
+ * in @p mic_array_conf.
+ *
+ * @param pdm_res         As for mic_array_init_custom_filter().
+ * @param mic_array_conf  As for mic_array_init_custom_filter().
+ *
+ * @returns Handle of the new instance.
+ */
+MA_C_API
+mic_array_instance_t* mic_array_instance_init_custom_filter(pdm_rx_resources_t* pdm_res, mic_array_conf_t* mic_array_conf);
+
+/**
+ * @brief Change the output sample rate of a mic array instance
+ *
+ * The same as mic_array_set_output_rate(), for an instance initialised with
+ * mic_array_instance_init().
+ *
+ * @param instance          Mic array instance.
+ * @param output_samp_freq  As for mic_array_set_output_rate().
+ */
+MA_C_API
+void mic_array_instance_set_output_rate(mic_array_instance_t* instance, unsigned output_samp_freq);
+
+/**
+ * @brief Get the PDM to frame latency of a mic array instance
+ *
+ * The same as mic_array_get_latency(), for @p instance.
+ *
+ * @param instance  Mic array instance.
+ *
+ * @returns Latency in output samples.
+ */
+MA_C_API
+unsigned mic_array_instance_get_latency(mic_array_instance_t* instance);
+
+/**
+ * @brief Start a mic array instance
+ *
+ * The same as mic_array_start(), for @p instance. Runs the instance's
+ * decimator, and with MIC_ARRAY_CONFIG_USE_PDM_ISR=1 its PDM rx ISR, on the
+ * calling thread, so each instance must be started on a different thread.
+ *
+ * @param instance      Mic array instance.
+ * @param c_frames_out  As for mic_array_start().
+ */
+MA_C_API
+void mic_array_instance_start(mic_array_instance_t* instance, chanend_t c_frames_out);
+
+/**
+ * @brief Start a mic array instance, delivering frames in shared memory
+ *
+ * The same as mic_array_start_callback(), for @p instance.
+ *
+ * @param instance  Mic array instance.
+ * @param callback  As for mic_array_start_callback().
+ * @param context   As for mic_array_start_callback().
+ */
+MA_C_API
+void mic_array_instance_start_callback(mic_array_instance_t* instance, ma_frame_callback_t callback, void* context);
+
+/**
+ * @brief Get the queue onto which a mic array instance pushes frames
+ *
+ * The same as mic_array_get_frame_queue(), for @p instance.
+ *
+ * @param instance  Mic array instance.
+ *
+ * @returns Frame queue of @p instance.
+ */
+MA_C_API
+ma_frame_queue_t* mic_array_instance_get_frame_queue(mic_array_instance_t* instance);
+
 
 C_API_END
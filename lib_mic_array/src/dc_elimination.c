@@ -12,6 +12,10 @@ void dcoe_state_init(
   memset(state, 0, sizeof(dcoe_chan_state_t) * chan_count);
 }
 
+// On xcore.ai, dcoe_filter() and dcoe_filter_frame() are implemented in
+// dcoe_filter.S
+#if !defined(__XS3A__)
+
 void dcoe_filter(
     int32_t new_output[],
     dcoe_chan_state_t state[],
@@ -35,3 +39,18 @@ void dcoe_filter(
   #undef N
   #undef Q
 }
+
+void dcoe_filter_frame(
+    int32_t frame[],
+    dcoe_chan_state_t state[],
+    const unsigned chan_count,
+    const unsigned sample_count)
+{
+  for(int k = 0; k < chan_count; k++){
+    int32_t* chan = &frame[k * sample_count];
+    for(int s = 0; s < sample_count; s++)
+      dcoe_filter(&chan[s], &state[k], &chan[s], 1);
+  }
+}
+
+#endif // !defined(__XS3A__)
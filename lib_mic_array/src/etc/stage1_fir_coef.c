@@ -68,3 +68,23 @@ uint32_t stage1_48k_coefs[MIC_ARRAY_48K_STAGE_1_FILTER_WORD_COUNT] =
   0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFF8, 0x00000000, 0x0001FFFF, 0xFFFFFFFF,
   0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
 };
+
+uint32_t stage1_96k_coefs[MIC_ARRAY_96K_STAGE_1_FILTER_WORD_COUNT] =
+{
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFCCAD6, 0xDEEEEEE8, 0x7FFB68F4, 0xFCFCBC5B, 0x7FF85DDD, 0xDDEDAD4C,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFE1F9A, 0xC635031A, 0x5EE8E0E3, 0x28531C1C, 0x5DE96302, 0xB18D67E1,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFF422F, 0x3AEC6EAC, 0x014627E4, 0xCFCC9F91, 0x8A00D5D8, 0xDD73D10B,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFF9622, 0x65B6FD56, 0x40B46341, 0xF03E0B18, 0xB409AAFD, 0xB69911A7,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFE49C, 0xF1F46DDC, 0x0C87D2D7, 0x3333AD2F, 0x84C0EED8, 0xBE3CE49F,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFF8D5, 0xFBD65504, 0xE187DFAB, 0x878757EF, 0x861C82A9, 0xAF7EAC7F,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFF19, 0x57E26DB9, 0xF4783444, 0xE31C88B0, 0x78BE76D9, 0x1FAA63FF,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFE1, 0x9AAE777E, 0xAC000D7D, 0x14A2FAC0, 0x00D5FBB9, 0xD5661FFF,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE, 0x1CCB2CFF, 0x36AAA983, 0x586B0655, 0x55B3FCD3, 0x4CE1FFFF,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xE0F3B6AA, 0x926664AA, 0x60195499, 0x992555B7, 0x3C1FFFFF,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFF03C733, 0x24B4B6CC, 0x7FF8CDB4, 0xB493338F, 0x03FFFFFF,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFC07C3, 0xC738C70F, 0x8007C38C, 0x738F0F80, 0xFFFFFFFF,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFF803, 0xF83F07F0, 0x00003F83, 0xF07F007F, 0xFFFFFFFF,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFC, 0x003FF800, 0x0000007F, 0xF000FFFF, 0xFFFFFFFF,
+  0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFC00000, 0x00000000, 0x0FFFFFFF, 0xFFFFFFFF,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+};
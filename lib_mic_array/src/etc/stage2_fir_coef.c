@@ -74,6 +74,12 @@ int32_t stage2_coef[STAGE2_TAP_COUNT] = {
 right_shift_t stage2_shr = 1;
 right_shift_t stage2_32k_shift = 2;
 right_shift_t stage2_48k_shift = 2;
+right_shift_t stage2_8k_shift = 2;
+right_shift_t stage2_24k_shift = 2;
+right_shift_t stage2_96k_shift = 1;
+right_shift_t stage2_8k_3stg_shift = 2;
+right_shift_t stage3_8k_3stg_shift = 1;
+right_shift_t stage2_16k_cic_shift = 1;
 
 int32_t stage2_32k_coefs[MIC_ARRAY_32K_STAGE_2_TAP_COUNT] =
 {
@@ -130,3 +136,368 @@ int32_t stage2_48k_coefs[MIC_ARRAY_48K_STAGE_2_TAP_COUNT] =
     0xffeb1, -0x172687, -0x132961, 0x61005,
     0xd2701, 0x1b2ad, -0x5df31, -0x2b744,
 };
+
+int32_t stage2_8k_coefs[MIC_ARRAY_8K_STAGE_2_TAP_COUNT] =
+{
+    -0x441a9, -0x4c4ab, -0x4f40f, -0x4b762,
+    -0x3fc50, -0x2b979, -0xf0c9, 0x14ee5,
+    0x3e91e, 0x6b458, 0x97bb3, 0xc01f8,
+    0xe05c8, 0xf46af, 0xf8ad5, 0xea4d4,
+    0xc794d, 0x9039d, 0x4594d, -0x15445,
+    -0x7b850, -0xe6d60, -0x14fa63, -0x1ad9e8,
+    -0x1f8337, -0x2274b4, -0x233ee0, -0x218f21,
+    -0x1d3979, -0x164048, -0xcd93b, -0x16ed4,
+    0xb6204, 0x18d087, 0x25f2a0, 0x31cb1e,
+    0x3b5abb, 0x41b301, 0x4409bb, 0x41cb90,
+    0x3aac43, 0x2eb32c, 0x1e429d, 0xa1936,
+    -0xcb388, -0x24c385, -0x3c7f00, -0x522f36,
+    -0x641b82, -0x70a914, -0x767b44, -0x749208,
+    -0x6a6445, -0x57f3ad, -0x3dd82d, -0x1d4173,
+    0x81262, 0x2feb12, 0x57b4ef, 0x7ca883,
+    0x9bf905, 0xb306c0, 0xbf921b, 0xbfeba0,
+    0xb31d61, 0x990a3c, 0x72800b, 0x413a80,
+    0x7d56d, -0x3651da, -0x754ae0, -0xb0ce22,
+    -0xe48376, -0x10c4e81, -0x1249c47, -0x12aac67,
+    -0x11cd090, -0xfa9d1a, -0xc5064b, -0x7e6704,
+    -0x2a6edf, 0x3208a0, 0x913e57, 0xece03e,
+    0x13e71b7, 0x17fbb61, 0x1ab3d38, 0x1bc9b2b,
+    0x1b0fc57, 0x187556f, 0x14097d7, 0xdfc09d,
+    0x69c440, -0x1aa965, -0xa56f61, -0x12d87dd,
+    -0x1a98fc2, -0x2106553, -0x259cb9f, -0x27f07f4,
+    -0x27b6e11, -0x24cd08f, -0x1f3cc22, -0x173e682,
+    -0xd37c48, -0x1b7c3f, 0xa90dff, 0x16d9ad9,
+    0x224ea78, 0x2c1e003, 0x33866c7, 0x37e524f,
+    0x38c29d8, 0x35dd04c, 0x2f2fb6b, 0x24f6f63,
+    0x17af79d, 0x8119a6, -0x8f7c77, -0x1a5c42c,
+    -0x2af6224, -0x399ceff, -0x4539332, -0x4cd81c6,
+    -0x4fbdce6, -0x4d74f6a, -0x45da878, -0x3924958,
+    -0x27e3a1f, -0x12fdf04, 0x45b1a7, 0x1cbb2a0,
+    0x348ff8e, 0x4a39f4e, 0x5c271c9, 0x68ee6c9,
+    0x6f6a167, 0x6eceb62, 0x66bdd89, 0x57525b4,
+    0x4125833, 0x254c118, 0x54b1ac, -0x1cfb182,
+    -0x3f614ce, -0x5f9f704, -0x7b6ebfe, -0x90afeb1,
+    -0x9d90d3f, -0xa0af7fd, -0x9937d75, -0x86fa08a,
+    -0x6a77ba5, -0x44e6b98, -0x182863f, 0x194a472,
+    0x4c7f51c, 0x7e33e77, 0xab03e85, 0xcf9e781,
+    0xe8fc9d3, 0xf496c25, 0xf095d65, 0xdbfce39,
+    0xb6c846c, 0x8200267, 0x3fbc75b, -0xce6724,
+    -0x5fe2b89, -0xb4729ff, -0x10547297, -0x14cc944f,
+    -0x18562626, -0x1a9c8b04, -0x1b54afd1, -0x1a418143,
+    -0x1737d8c4, -0x1221a569, -0xb001efd, -0x1ecdd28,
+    0x8e644c1, 0x15307eac, 0x2294a3fe, 0x30a4c30f,
+    0x3ee6b248, 0x4cd953fa, 0x59fa4f3a, 0x65cbf4fb,
+    0x6fdb0542, 0x77c4091d, 0x7d37fb06, 0x7fffffff,
+    0x7fffffff, 0x7d37fb06, 0x77c4091d, 0x6fdb0542,
+    0x65cbf4fb, 0x59fa4f3a, 0x4cd953fa, 0x3ee6b248,
+    0x30a4c30f, 0x2294a3fe, 0x15307eac, 0x8e644c1,
+    -0x1ecdd28, -0xb001efd, -0x1221a569, -0x1737d8c4,
+    -0x1a418143, -0x1b54afd1, -0x1a9c8b04, -0x18562626,
+    -0x14cc944f, -0x10547297, -0xb4729ff, -0x5fe2b89,
+    -0xce6724, 0x3fbc75b, 0x8200267, 0xb6c846c,
+    0xdbfce39, 0xf095d65, 0xf496c25, 0xe8fc9d3,
+    0xcf9e781, 0xab03e85, 0x7e33e77, 0x4c7f51c,
+    0x194a472, -0x182863f, -0x44e6b98, -0x6a77ba5,
+    -0x86fa08a, -0x9937d75, -0xa0af7fd, -0x9d90d3f,
+    -0x90afeb1, -0x7b6ebfe, -0x5f9f704, -0x3f614ce,
+    -0x1cfb182, 0x54b1ac, 0x254c118, 0x4125833,
+    0x57525b4, 0x66bdd89, 0x6eceb62, 0x6f6a167,
+    0x68ee6c9, 0x5c271c9, 0x4a39f4e, 0x348ff8e,
+    0x1cbb2a0, 0x45b1a7, -0x12fdf04, -0x27e3a1f,
+    -0x3924958, -0x45da878, -0x4d74f6a, -0x4fbdce6,
+    -0x4cd81c6, -0x4539332, -0x399ceff, -0x2af6224,
+    -0x1a5c42c, -0x8f7c77, 0x8119a6, 0x17af79d,
+    0x24f6f63, 0x2f2fb6b, 0x35dd04c, 0x38c29d8,
+    0x37e524f, 0x33866c7, 0x2c1e003, 0x224ea78,
+    0x16d9ad9, 0xa90dff, -0x1b7c3f, -0xd37c48,
+    -0x173e682, -0x1f3cc22, -0x24cd08f, -0x27b6e11,
+    -0x27f07f4, -0x259cb9f, -0x2106553, -0x1a98fc2,
+    -0x12d87dd, -0xa56f61, -0x1aa965, 0x69c440,
+    0xdfc09d, 0x14097d7, 0x187556f, 0x1b0fc57,
+    0x1bc9b2b, 0x1ab3d38, 0x17fbb61, 0x13e71b7,
+    0xece03e, 0x913e57, 0x3208a0, -0x2a6edf,
+    -0x7e6704, -0xc5064b, -0xfa9d1a, -0x11cd090,
+    -0x12aac67, -0x1249c47, -0x10c4e81, -0xe48376,
+    -0xb0ce22, -0x754ae0, -0x3651da, 0x7d56d,
+    0x413a80, 0x72800b, 0x990a3c, 0xb31d61,
+    0xbfeba0, 0xbf921b, 0xb306c0, 0x9bf905,
+    0x7ca883, 0x57b4ef, 0x2feb12, 0x81262,
+    -0x1d4173, -0x3dd82d, -0x57f3ad, -0x6a6445,
+    -0x749208, -0x767b44, -0x70a914, -0x641b82,
+    -0x522f36, -0x3c7f00, -0x24c385, -0xcb388,
+    0xa1936, 0x1e429d, 0x2eb32c, 0x3aac43,
+    0x41cb90, 0x4409bb, 0x41b301, 0x3b5abb,
+    0x31cb1e, 0x25f2a0, 0x18d087, 0xb6204,
+    -0x16ed4, -0xcd93b, -0x164048, -0x1d3979,
+    -0x218f21, -0x233ee0, -0x2274b4, -0x1f8337,
+    -0x1ad9e8, -0x14fa63, -0xe6d60, -0x7b850,
+    -0x15445, 0x4594d, 0x9039d, 0xc794d,
+    0xea4d4, 0xf8ad5, 0xf46af, 0xe05c8,
+    0xc01f8, 0x97bb3, 0x6b458, 0x3e91e,
+    0x14ee5, -0xf0c9, -0x2b979, -0x3fc50,
+    -0x4b762, -0x4f40f, -0x4c4ab, -0x441a9,
+};
+
+int32_t stage2_24k_coefs[MIC_ARRAY_24K_STAGE_2_TAP_COUNT] =
+{
+    -0x5ca, -0x1f7, -0x3daf, -0xbbdf,
+    -0x118f9, -0xa0e0, 0x12e55, 0x3eeba,
+    0x5f7c1, 0x4ec4f, -0xbb6f, -0x9e3fb,
+    -0x120ca4, -0x12c14c, -0x746e3, 0xf1e08,
+    0x271646, 0x31cbfc, 0x225e76, -0x8d38d,
+    -0x4080e0, -0x67858c, -0x5fecbd, -0x1d33fc,
+    0x4deabc, 0xb03a5c, 0xcd9249, 0x7f1dd3,
+    -0x2f36fa, -0xf69a39, -0x16d5f75, -0x13a0bed,
+    -0x4aecf7, 0x10cc1b0, 0x229a891, 0x25fbff6,
+    0x15832c7, -0xa9ceea, -0x2c9b1cf, -0x3e71ef2,
+    -0x32c4833, -0x931580, 0x2e99959, 0x59d364e,
+    0x5e96f2d, 0x31ee9fc, -0x1f26ae1, -0x7183436,
+    -0x99b267a, -0x78fb4ee, -0x1025e97, 0x7a170f7,
+    0xe4a7aa6, 0xef5e42e, 0x7b834a8, -0x5cf9dc5,
+    -0x14639a43, -0x1cb3e7af, -0x181b9678, -0x384d960,
+    0x1ec2a253, 0x47263931, 0x6af95740, 0x7fffffff,
+    0x7fffffff, 0x6af95740, 0x47263931, 0x1ec2a253,
+    -0x384d960, -0x181b9678, -0x1cb3e7af, -0x14639a43,
+    -0x5cf9dc5, 0x7b834a8, 0xef5e42e, 0xe4a7aa6,
+    0x7a170f7, -0x1025e97, -0x78fb4ee, -0x99b267a,
+    -0x7183436, -0x1f26ae1, 0x31ee9fc, 0x5e96f2d,
+    0x59d364e, 0x2e99959, -0x931580, -0x32c4833,
+    -0x3e71ef2, -0x2c9b1cf, -0xa9ceea, 0x15832c7,
+    0x25fbff6, 0x229a891, 0x10cc1b0, -0x4aecf7,
+    -0x13a0bed, -0x16d5f75, -0xf69a39, -0x2f36fa,
+    0x7f1dd3, 0xcd9249, 0xb03a5c, 0x4deabc,
+    -0x1d33fc, -0x5fecbd, -0x67858c, -0x4080e0,
+    -0x8d38d, 0x225e76, 0x31cbfc, 0x271646,
+    0xf1e08, -0x746e3, -0x12c14c, -0x120ca4,
+    -0x9e3fb, -0xbb6f, 0x4ec4f, 0x5f7c1,
+    0x3eeba, 0x12e55, -0xa0e0, -0x118f9,
+    -0xbbdf, -0x3daf, -0x1f7, -0x5ca,
+};
+
+int32_t stage2_96k_coefs[MIC_ARRAY_96K_STAGE_2_TAP_COUNT] =
+{
+    0x42a03, -0xf9d43, 0x13edb0, 0x2c02c,
+    -0x3f0fec, 0x8ef502, -0xbf3e3a, 0x9486fa,
+    0x3637f, -0xc62b9c, 0x122b5c4, -0x897d6e,
+    -0x10e9485, 0x2bb4546, -0x2adbe10, -0x1046ec1,
+    0x8fda13e, -0x13278a05, 0x1a022737, -0x1563b0d3,
+    -0x301ac10, 0x32f60245, -0x6fdb8644, 0x7fffffff,
+    0x7fffffff, -0x6fdb8644, 0x32f60245, -0x301ac10,
+    -0x1563b0d3, 0x1a022737, -0x13278a05, 0x8fda13e,
+    -0x1046ec1, -0x2adbe10, 0x2bb4546, -0x10e9485,
+    -0x897d6e, 0x122b5c4, -0xc62b9c, 0x3637f,
+    0x9486fa, -0xbf3e3a, 0x8ef502, -0x3f0fec,
+    0x2c02c, 0x13edb0, -0xf9d43, 0x42a03,
+};
+
+int32_t stage2_8k_3stg_coefs[MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT] =
+{
+    -0x11a477, 0x0, 0x502264, 0x0,
+    0x1794d2a, 0x0, -0xd5fddb8, 0x0,
+    0x4babc06a, 0x7fffffff, 0x4babc06a, 0x0,
+    -0xd5fddb8, 0x0, 0x1794d2a, 0x0,
+    0x502264, 0x0, -0x11a477,
+};
+
+int32_t stage3_8k_3stg_coefs[MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT] =
+{
+    -0x5619d, -0x48036, -0x18aac, 0x34120,
+    0x8def9, 0xda43a, 0xfa528, 0xd4ddb,
+    0x60683, -0x552c0, -0x124e57, -0x1d4df9,
+    -0x2262d4, -0x1e7aee, -0x108e09, 0x5967a,
+    0x1f3a42, 0x358876, 0x41307b, 0x3c826b,
+    0x257993, -0xee06, -0x2ea0e8, -0x57de3b,
+    -0x6ffc2f, -0x6cf121, -0x4ab788, -0xd85e9,
+    0x3dfe90, 0x84f94c, 0xb2b692, 0xb64805,
+    0x87efc1, 0x2cc2d8, -0x48cd55, -0xbc20af,
+    -0x10cf0f9, -0x11fd62a, -0xe6a518, -0x664579,
+    0x47ffb0, 0xfab5bb, 0x1818642, 0x1b1ab2d,
+    0x1727a33, 0xc68f6a, -0x316332, -0x13bb650,
+    -0x2127106, -0x274e122, -0x239ebb8, -0x15e24e2,
+    -0x950ef, 0x1773709, 0x2c103c6, 0x374b89c,
+    0x35030b3, 0x243c427, 0x7c5db3, -0x1a19c19,
+    -0x38edfd1, -0x4c18ed5, -0x4d1dae7, -0x399b028,
+    -0x146621d, 0x1a9e444, 0x480796a, 0x678488e,
+    0x6f07497, 0x59b2517, 0x29bc783, -0x174f940,
+    -0x5a378d7, -0x8d62411, -0xa12938a, -0x8c2c138,
+    -0x4e8acd2, 0xceaae7, 0x7217b57, 0xc77b9ac,
+    0xf3f2a90, 0xe51dbd8, 0x94f8a45, 0xd350b5,
+    -0x98ab5f5, -0x136d8e5f, -0x1a1e2cd7, -0x1b15d551,
+    -0x148c6639, -0x5ec1972, 0xfefe307, 0x2ac2ab01,
+    0x472d538f, 0x61426c27, 0x7533a4f3, 0x7fffffff,
+    0x7fffffff, 0x7533a4f3, 0x61426c27, 0x472d538f,
+    0x2ac2ab01, 0xfefe307, -0x5ec1972, -0x148c6639,
+    -0x1b15d551, -0x1a1e2cd7, -0x136d8e5f, -0x98ab5f5,
+    0xd350b5, 0x94f8a45, 0xe51dbd8, 0xf3f2a90,
+    0xc77b9ac, 0x7217b57, 0xceaae7, -0x4e8acd2,
+    -0x8c2c138, -0xa12938a, -0x8d62411, -0x5a378d7,
+    -0x174f940, 0x29bc783, 0x59b2517, 0x6f07497,
+    0x678488e, 0x480796a, 0x1a9e444, -0x146621d,
+    -0x399b028, -0x4d1dae7, -0x4c18ed5, -0x38edfd1,
+    -0x1a19c19, 0x7c5db3, 0x243c427, 0x35030b3,
+    0x374b89c, 0x2c103c6, 0x1773709, -0x950ef,
+    -0x15e24e2, -0x239ebb8, -0x274e122, -0x2127106,
+    -0x13bb650, -0x316332, 0xc68f6a, 0x1727a33,
+    0x1b1ab2d, 0x1818642, 0xfab5bb, 0x47ffb0,
+    -0x664579, -0xe6a518, -0x11fd62a, -0x10cf0f9,
+    -0xbc20af, -0x48cd55, 0x2cc2d8, 0x87efc1,
+    0xb64805, 0xb2b692, 0x84f94c, 0x3dfe90,
+    -0xd85e9, -0x4ab788, -0x6cf121, -0x6ffc2f,
+    -0x57de3b, -0x2ea0e8, -0xee06, 0x257993,
+    0x3c826b, 0x41307b, 0x358876, 0x1f3a42,
+    0x5967a, -0x108e09, -0x1e7aee, -0x2262d4,
+    -0x1d4df9, -0x124e57, -0x552c0, 0x60683,
+    0xd4ddb, 0xfa528, 0xda43a, 0x8def9,
+    0x34120, -0x18aac, -0x48036, -0x5619d,
+};
+
+int32_t stage2_16k_min_phase_coefs[MIC_ARRAY_16K_MIN_PHASE_STAGE_2_TAP_COUNT] =
+{
+    0x66e5c, 0x1eae6b, 0x5fc349, 0xef7ac4,
+    0x205399a, 0x3e9fab1, 0x6f40e7c, 0xb7d8a92,
+    0x11d523ba, 0x1a2a8206, 0x24787fca, 0x30713516,
+    0x3d70863b, 0x4a7a0d39, 0x56462afd, 0x5f5ffaa8,
+    0x6452d29c, 0x63e28fd0, 0x5d469db9, 0x505d7be9,
+    0x3dcde49a, 0x270c53c2, 0xe3f5d82, -0x9fd3aae,
+    -0x1ef06a5d, -0x2e2a8107, -0x35e9e97a, -0x356bceba,
+    -0x2d184b75, -0x1e7f074c, -0xc213a55, 0x6f0a336,
+    0x17963669, 0x2325e3e4, 0x27e21eb7, 0x2546e762,
+    0x1c1f86d1, 0xe5edddf, -0x13fa1dc, -0xfbd072b,
+    -0x1a68c19d, -0x1f62d701, -0x1df4a3c2, -0x16ae4366,
+    -0xb42b335, 0x1d5fda9, 0xde308af, 0x167a6970,
+    0x19fd9d69, 0x17e9d9fc, 0x10eb5d78, 0x6b096c0,
+    -0x4786ba6, -0xe244f4b, -0x144ff2cb, -0x15cc2ce2,
+    -0x1278d8c7, -0xb433e5e, -0x1e97ce7, 0x76e5fff,
+    0xeb35636, 0x125e26bf, 0x11c3e908, 0xd34d1a8,
+    0x5e18e8f, -0x27133bb, -0x9d66cf8, -0xeaa1bcc,
+    -0xfee60b4, -0xd7f89c9, -0x8145a48, -0x10c02d4,
+    0x5e90def, 0xb302f26, 0xda2d9f1, 0xcceb592,
+    0x9095200, 0x3547951, -0x2e4d9fe, -0x827baf4,
+    -0xb42f975, -0xb940853, -0x92796c7, -0x4af6c4c,
+    0xae771b, 0x5a26af2, 0x9049b85, 0xa19c40d,
+    0x8bb309c, 0x55997bc, 0xdb9316, -0x39ec11f,
+    -0x70367c7, -0x88fa949, -0x7fb51d3, -0x5847e20,
+    -0x1da7758, 0x211dc7e, 0x54b3ffe, 0x713a69e,
+    0x70f9659, 0x5579502, 0x26c8c3b, -0xeca8e5,
+    -0x3de8043, -0x5b790b2, -0x613faf9, -0x4f1cb68,
+    -0x2ac6750, 0x1eabcd, 0x2b9c808, 0x484ebd1,
+    0x51bc145, 0x46aff1c, 0x2b0ae55, 0x686f32,
+    -0x1d66269, -0x37f7b54, -0x4338dc0, -0x3d52d25,
+    -0x28c39a9, -0xb7f440, 0x12bd334, 0x2a712a5,
+    0x362fc8d, 0x33d7765, 0x24e4c7e, 0xdda54e,
+    -0xb0eb24, -0x1f8e2ac, -0x2addb5a, -0x2acfa58,
+    -0x202e4ea, -0xe571d3, 0x5c82e1, 0x17077ec,
+    0x2152020, 0x22984fa, 0x1b30516, 0xd94b05,
+    -0x261344, -0x1089413, -0x197d8f5, -0x1b6675a,
+    -0x1653f85, -0xc15429, 0x5d58e, 0xbb8bc4,
+    0x1339bdc, 0x154d662, 0x11ded77, 0xa3eae1,
+    0xb1404, -0x837d43, -0xe4addf, -0x103cc78,
+    -0xdea63b, -0x848bac, -0x10f395, 0x5c8df5,
+    0xa8af51, 0xc30e0f, 0xa96db0, 0x670f5f,
+    0x109e98, -0x41f21d, -0x7bdd53, -0x9098fa,
+    -0x7e5379, -0x4d70bb, -0xd6fd7, 0x2fc09e,
+    0x5a9fe8, 0x69e70c, 0x5c5913, 0x385289,
+    0x964f4, -0x232b41, -0x42097a, -0x4c93c7,
+    -0x422248, -0x27980e, -0x58f84, 0x1a4a83,
+    0x2fdb3c, 0x36953e, 0x2e4b4f, 0x1aca78,
+    0x26bbd, -0x13dcc2, -0x226a25, -0x264058,
+    -0x1f8fa6, -0x114df6, -0x2089, 0xf12ad,
+    0x187a6b, 0x1a423f, 0x14d5d7, 0xa8367,
+    -0x15b78, -0xb6729, -0x112539, -0x119071,
+    -0xd3453, -0x5d6c1, 0x22818, 0x88803,
+    0xbc1a8, 0xb5c24, 0x7eb2b, 0x2c6b0,
+    -0x26e3d, -0x6416e, -0x7d454, -0x704ef,
+    -0x460ee, -0xe4ff, 0x25678, 0x472d7,
+    0x4ffe7, 0x40f73, 0x21c05, -0x259a,
+    -0x20506, -0x3062f, -0x3005a, -0x21c41,
+    -0xbe9c, 0x9f88, 0x1963e, 0x1ec58,
+    0x1a0a2, 0xe35e, -0x13, -0xbda4,
+    -0x120b9, -0x1182a, -0xb7b9, -0x2bad,
+    0x5737, 0xa736, 0xb0e0, 0x7b20,
+    0x2134, -0x3782, -0x6e2b, -0x7055,
+    -0x41b0, 0x772, 0x4743, 0x5aba,
+    0x2e2b, -0x2be8, -0x63b5, 0x36eb,
+};
+
+int32_t stage2_32k_min_phase_coefs[MIC_ARRAY_32K_MIN_PHASE_STAGE_2_TAP_COUNT] =
+{
+    0x6bda6f, 0x28717e0, 0x8aa5015, 0x15969b75,
+    0x2a9ea775, 0x4549590b, 0x5e104b86, 0x69fcdc2e,
+    0x5f8b0201, 0x3cd78f6a, 0xb465178, -0x22c2f559,
+    -0x3a43558a, -0x32173c28, -0x1113a925, 0x14e52fda,
+    0x2a0c94db, 0x239d220e, 0x822fe63, -0x1538bb14,
+    -0x2184d6d6, -0x166498d5, 0x27482f0, 0x16dde813,
+    0x1947440c, 0x9d0ffc2, -0xad8c705, -0x158308c5,
+    -0xf92aa35, 0xf1b47b, 0xee7ac94, 0x105e1a6a,
+    0x5a0292f, -0x802a3e6, -0xe12de87, -0x8ea4344,
+    0x245bc7d, 0xa58dd59, 0x999c6de, 0x1b5ab31,
+    -0x66b41d3, -0x8928562, -0x3ea51e6, 0x30e2fc3,
+    0x6ade21c, 0x4a9b872, -0x9c0a6d, -0x496f0a2,
+    -0x469bf74, -0xe0c107, 0x2bcc688, 0x39f775c,
+    0x18f1d43, -0x1565f0c, -0x2aaf6ec, -0x1af6f61,
+    0x68d4a9, 0x1c48c35, 0x1792245, 0x174637,
+    -0x11163b3, -0x122ffbb, -0x4b7fb3, 0x9746ca,
+    0xce5e89, 0x549e1a, -0x4be25b, -0x893126,
+    -0x49844f, 0x218233, 0x567b61, 0x37db76,
+    -0xc219e, -0x342460, -0x26acd8, 0x2d6f7,
+    0x1e57ab, 0x18d6b1, 0x3fa8, -0x113d08,
+    -0xee818, -0x9f99, 0x9b63b, 0x85be3,
+    0x1c3c, -0x58b22, -0x4533a, 0x861f,
+    0x34d16, 0x1e5d9, -0x126ec, -0x20b99,
+    0x1816, 0x1d785, -0x117de, 0x3134,
+};
+
+int32_t stage2_48k_min_phase_coefs[MIC_ARRAY_48K_MIN_PHASE_STAGE_2_TAP_COUNT] =
+{
+    0xb56430, 0x53aadd9, 0x137fc08b, 0x2fabd471,
+    0x52ffd1a1, 0x67d2f144, 0x55f8c5fc, 0x1ba09eef,
+    -0x25c8b1a9, -0x3efa2f37, -0x1e9f5a99, 0x18d7156a,
+    0x2fd2015a, 0x126dcf14, -0x1ab4223b, -0x2471941f,
+    -0x388bc13, 0x1d772738, 0x178c5504, -0xa1f0ed8,
+    -0x1b842806, -0x8c387d6, 0x12e531e2, 0x137fefe2,
+    -0x4ebd58a, -0x1449be5f, -0x79a514b, 0xd99cbf8,
+    0xe903c63, -0x3cc8362, -0xf0774e4, -0x4f9b9fd,
+    0xa894af1, 0xa1b5f94, -0x3d2dec4, -0xae68f64,
+    -0x26a0ce9, 0x83e15f9, 0x6611850, -0x3dc074c,
+    -0x77b8bc9, -0x7806ae, 0x62ec203, 0x37bf8a6,
+    -0x389b907, -0x4b0b7fb, 0xb39261, 0x447b124,
+    0x176f5ef, -0x2ddf0b8, -0x290bbe3, 0x129b619,
+    0x2a3b3d7, 0x420204, -0x207e6c9, -0x1210ddb,
+    0x11f11df, 0x164c816, -0x47a665, -0x1375bec,
+    -0x4bd918, 0xd2a87b, 0x91a137, -0x6716a2,
+    -0x9918a3, 0x11fa4e, 0x7b3f47, 0x21f829,
+    -0x4fa159, -0x3735f7, 0x26b937, 0x36cc41,
+    -0x8cfad, -0x2afd2d, -0x86c11, 0x1c05ae,
+    0xf3ad4, -0xeea42, -0xf5719, 0x5bac3,
+    0xc3dc6, -0x7a8e, -0x86b07, -0x1c869,
+    0x527f5, 0x24955, -0x2f783, -0x1e0e9,
+    0x1a017, 0x15d86, -0x13564, -0x705e,
+    0xa495, -0x100d, -0x1fcf, 0xa66,
+};
+
+int32_t stage2_16k_cic_coefs[MIC_ARRAY_16K_CIC_STAGE_2_TAP_COUNT] =
+{
+    -0x2909a, 0x24c3, 0x636c8, 0xf52e6,
+    0x1962b1, 0x2070c7, 0x1f5563, 0x113f8b,
+    -0xc2346, -0x367959, -0x6560fc, -0x8ac29e,
+    -0x955e1f, -0x758291, -0x231217, 0x5cce0b,
+    0xf4670e, 0x17e6d13, 0x1cc5a98, 0x1b1d0b0,
+    0x112e915, -0xe2010, -0x188502a, -0x30c6763,
+    -0x430c3d5, -0x488335f, -0x3bfe3ff, -0x1bda988,
+    0x149daf0, 0x4cd43c8, 0x7fdf943, 0x9eded39,
+    0x9c6571e, 0x704d681, 0x1b0cda2, -0x585b63c,
+    -0xd49016d, -0x13c79dd9, -0x1701656a, -0x152b4069,
+    -0xd163b7a, 0x17c50ed, 0x15adca94, 0x2d89efe9,
+    0x4645e220, 0x5cada332, 0x6dac8734, 0x76d66cb2,
+    0x76d66cb2, 0x6dac8734, 0x5cada332, 0x4645e220,
+    0x2d89efe9, 0x15adca94, 0x17c50ed, -0xd163b7a,
+    -0x152b4069, -0x1701656a, -0x13c79dd9, -0xd49016d,
+    -0x585b63c, 0x1b0cda2, 0x704d681, 0x9c6571e,
+    0x9eded39, 0x7fdf943, 0x4cd43c8, 0x149daf0,
+    -0x1bda988, -0x3bfe3ff, -0x488335f, -0x430c3d5,
+    -0x30c6763, -0x188502a, -0xe2010, 0x112e915,
+    0x1b1d0b0, 0x1cc5a98, 0x17e6d13, 0xf4670e,
+    0x5cce0b, -0x231217, -0x758291, -0x955e1f,
+    -0x8ac29e, -0x6560fc, -0x367959, -0xc2346,
+    0x113f8b, 0x1f5563, 0x2070c7, 0x1962b1,
+    0xf52e6, 0x636c8, 0x24c3, -0x2909a,
+};
@@ -0,0 +1,106 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+
+#include "mic_array/frame_callback.h"
+
+// Producer and consumer run on separate threads of the same tile. Memory
+// accesses are not reordered by the hardware, so only the compiler needs to
+// be prevented from moving them across index updates.
+#define COMPILER_BARRIER()    asm volatile("" ::: "memory")
+
+
+void ma_frame_queue_init(
+    ma_frame_queue_t* queue,
+    ma_frame_queue_entry_t* entries,
+    const unsigned depth)
+{
+  assert(queue);
+  assert(entries);
+  assert(depth);
+
+  queue->entries = entries;
+  queue->depth = depth;
+  queue->head = 0;
+  queue->tail = 0;
+  queue->shutdown_requested = 0;
+  queue->closed = 0;
+}
+
+
+unsigned ma_frame_queue_push(
+    ma_frame_queue_t* queue,
+    int32_t* frame,
+    const ma_frame_metadata_t* metadata)
+{
+  const unsigned head = queue->head;
+
+  while(head - queue->tail >= queue->depth){
+    if(queue->shutdown_requested)
+      return 1;
+  }
+
+  ma_frame_queue_entry_t* entry = &queue->entries[head % queue->depth];
+  entry->frame = frame;
+  if(metadata)
+    entry->metadata = *metadata;
+  else
+    memset(&entry->metadata, 0, sizeof(ma_frame_metadata_t));
+
+  COMPILER_BARRIER();
+  queue->head = head + 1;
+
+  return queue->shutdown_requested? 1 : 0;
+}
+
+
+int32_t* ma_frame_queue_acquire(
+    ma_frame_queue_t* queue,
+    ma_frame_metadata_t* metadata)
+{
+  const unsigned tail = queue->tail;
+
+  if(queue->head == tail)
+    return NULL;
+
+  COMPILER_BARRIER();
+
+  ma_frame_queue_entry_t* entry = &queue->entries[tail % queue->depth];
+  if(metadata)
+    *metadata = entry->metadata;
+  return entry->frame;
+}
+
+
+void ma_frame_queue_release(
+    ma_frame_queue_t* queue)
+{
+  assert(queue->head != queue->tail);
+  COMPILER_BARRIER();
+  queue->tail = queue->tail + 1;
+}
+
+
+void ma_frame_queue_request_shutdown(
+    ma_frame_queue_t* queue)
+{
+  queue->shutdown_requested = 1;
+}
+
+
+void ma_frame_queue_close(
+    ma_frame_queue_t* queue)
+{
+  COMPILER_BARRIER();
+  queue->closed = 1;
+}
+
+
+unsigned ma_frame_queue_closed(
+    const ma_frame_queue_t* queue)
+{
+  return queue->closed;
+}
@@ -36,6 +36,35 @@ unsigned ma_frame_tx(
   return shutdown;
 }
 
+unsigned ma_frame_tx_metadata(
+    const chanend_t c_frame_out,
+    const ma_frame_metadata_t* metadata,
+    const int32_t frame[],
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  unsigned shutdown = 0;
+  chanend_out_control_token(c_frame_out, XS1_CT_END);
+  shutdown = chanend_test_control_token_next_byte(c_frame_out);
+  if(shutdown)
+  {
+    chanend_check_control_token(c_frame_out, XS1_CT_END);
+  }
+  else {
+    int dummy = chanend_in_byte(c_frame_out);
+    (void)dummy;
+    chanend_out_word(c_frame_out, metadata->sequence);
+    chanend_out_word(c_frame_out, metadata->timestamp);
+    chanend_out_word(c_frame_out, metadata->dropped_blocks);
+    for(int i=0; i<channel_count*sample_count; i++) {
+      chanend_out_word(c_frame_out, frame[i]);
+    }
+    chanend_out_control_token(c_frame_out, XS1_CT_END);
+    chanend_check_control_token(c_frame_out, XS1_CT_END);
+  }
+  return shutdown;
+}
+
 void ma_frame_rx(
     int32_t frame[],
     const chanend_t c_frame_in,
@@ -52,6 +81,26 @@ void ma_frame_rx(
 }
 
 
+void ma_frame_rx_metadata(
+    ma_frame_metadata_t* metadata,
+    int32_t frame[],
+    const chanend_t c_frame_in,
+    const unsigned channel_count,
+    const unsigned sample_count)
+{
+  chanend_check_control_token(c_frame_in, XS1_CT_END);
+  chanend_out_byte(c_frame_in, 0); //dummy indicating wish to proceed with data transfer
+  metadata->sequence = chanend_in_word(c_frame_in);
+  metadata->timestamp = chanend_in_word(c_frame_in);
+  metadata->dropped_blocks = chanend_in_word(c_frame_in);
+  for(int i=0; i<channel_count*sample_count; i++) {
+    frame[i] = chanend_in_word(c_frame_in);
+  }
+  chanend_check_control_token(c_frame_in, XS1_CT_END);
+  chanend_out_control_token(c_frame_in, XS1_CT_END);
+}
+
+
 void ma_frame_rx_transpose(
     int32_t frame[],
     const chanend_t c_frame_in,
@@ -0,0 +1,102 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <assert.h>
+#include <math.h>
+
+#include "mic_array/latency.h"
+#include "mic_array/mic_array_conf_full.h"
+#include "mic_array/etc/fir_1xN_bit.h"
+#include "mic_array/etc/filters_default.h"
+
+// DC group delay of the stage 1 filter, in PDM samples.
+//
+// The coefficients are recovered from the filter's response to a single PDM
+// sample: a bit value of 0 represents +1, so flipping bit `b` of an all-zero
+// history changes the output by -2 * coef. Within the history, word 0 is the
+// newest and less significant bits are older samples. The coefficients have
+// `coef_bits` bit-planes, as for fir_1xN_bit().
+static float stage1_group_delay(
+    const uint32_t coef[],
+    const unsigned coef_bits)
+{
+  uint32_t hist[STAGE1_TAP_COUNT / 32] = {0};
+  const int dc = fir_1xN_bit(hist, coef, coef_bits);
+
+  int64_t sum = 0;
+  int64_t moment = 0;
+  for(unsigned w = 0; w < STAGE1_TAP_COUNT / 32; w++){
+    for(unsigned b = 0; b < 32; b++){
+      hist[w] = (1u << b);
+      const int64_t h = dc - fir_1xN_bit(hist, coef, coef_bits);
+      const unsigned age = 32 * w + (31 - b);
+      sum += h;
+      moment += h * age;
+    }
+    hist[w] = 0;
+  }
+  assert(sum != 0);
+  return (float) moment / (float) sum;
+}
+
+// DC group delay of a FIR filter, in samples at its (interpolated) rate.
+//
+// With an interpolation factor of L, phase p holds h[p + j*L] of the
+// prototype filter. The coefficients are int16 if `s16` is set.
+static float fir_group_delay(
+    const mic_array_filter_conf_t* conf,
+    const unsigned s16)
+{
+  const unsigned L = (conf->interpolation_factor > 1)? conf->interpolation_factor : 1;
+  const unsigned phase_taps = conf->num_taps / L;
+
+  int64_t sum = 0;
+  int64_t moment = 0;
+  for(unsigned k = 0; k < conf->num_taps; k++){
+    const unsigned n = (k % phase_taps) * L + (k / phase_taps);
+    const int32_t coef = s16? ((const int16_t*) conf->coef)[k] : conf->coef[k];
+    sum += coef;
+    moment += (int64_t) coef * n;
+  }
+  assert(sum != 0);
+  return (float) moment / (float) sum;
+}
+
+// As mic_array_decimator_latency(), for stages after stage 1 with int16
+// coefficients if `coef_s16` is set, or int32 coefficients otherwise.
+unsigned _mic_array_decimator_latency(
+    const mic_array_decimator_conf_t* decimator_conf,
+    const unsigned samples_per_frame,
+    const unsigned coef_s16)
+{
+  assert(decimator_conf->num_filter_stages >= 1);
+  assert(samples_per_frame >= 1);
+
+  // Delay in samples at the output rate of each stage in turn. A CIC filter of
+  // order N is N moving averages of 32 samples, each delaying by 15.5 samples.
+  const mic_array_filter_conf_t* conf1 = &decimator_conf->filter_conf[0];
+  float delay = ((conf1->cic_order != 0)? conf1->cic_order * 15.5f
+                                        : stage1_group_delay((const uint32_t*) conf1->coef,
+                                                             conf1->coef_bits))
+              / STAGE1_DEC_FACTOR;
+
+  for(unsigned s = 1; s < decimator_conf->num_filter_stages; s++){
+    const mic_array_filter_conf_t* conf = &decimator_conf->filter_conf[s];
+    const unsigned L = (conf->interpolation_factor > 1)? conf->interpolation_factor : 1;
+    const unsigned M = (conf->decimation_factor > 1)? conf->decimation_factor : 1;
+    delay = (delay * L + fir_group_delay(conf, coef_s16)) / M;
+  }
+
+  return (unsigned) ceilf(delay) + (samples_per_frame - 1);
+}
+
+unsigned mic_array_decimator_latency(
+    const mic_array_decimator_conf_t* decimator_conf,
+    const unsigned samples_per_frame)
+{
+  // Only mic_array::CicCompDecimator keeps 32-bit coefficients with 16-bit
+  // filters enabled.
+  const unsigned coef_s16 = MIC_ARRAY_CONFIG_USE_S16_FILTERS
+                         && (decimator_conf->filter_conf[0].cic_order == 0);
+  return _mic_array_decimator_latency(decimator_conf, samples_per_frame, coef_s16);
+}
@@ -6,38 +6,157 @@
 #include <xcore/interrupt.h>
 #include <xcore/parallel.h>
 #include <xcore/assert.h>
+#include <xcore/hwtimer.h>
 #include <platform.h>
 
 #include "mic_array.h"
 #include "mic_array/etc/filters_default.h"
 #include "mic_array_task_internal.hpp"
 
-TMicArray *g_mics = nullptr;  // Global mic array instance.
-TMicArray_3stg_decimator *g_mics_3stg = nullptr;
-bool use_3_stg_decimator = false;
-// NOTE: g_mics must persist (remain non-null and its backing storage valid)
-// until mic_array_start() completes. mic_array_start() performs shutdown and
-// then sets g_mics back to nullptr.
+// Mic array instances. An instance is in use from its initialisation until its
+// mic array shuts down, when mic_array_instance_start() (or
+// mic_array_instance_start_callback()) returns, and is then free for reuse.
+static mic_array_instance_t instances[MIC_ARRAY_CONFIG_MAX_INSTANCES];
+// Instance used by the functions without an instance handle, set by
+// mic_array_init() and mic_array_init_custom_filter().
+static mic_array_instance_t* default_instance = nullptr;
+
+// Longest mic_array_set_output_rate() waits for a previous change to complete,
+// in reference clock ticks (100 ms).
+#define SET_OUTPUT_RATE_TIMEOUT_TICKS   (10000000)
+
+// Storage for a mic array of type T, for placement new.
+template <typename T>
+struct SMicStorage {
+  uint8_t __attribute__((aligned(8))) bytes[sizeof(T)];
+};
 
 #if !defined(__XS2A__)
 ////////////////////
 // Mic array init //
 ////////////////////
+static unsigned default_stg2_decimation_factor(unsigned pdm_freq, unsigned output_samp_freq)
+{
+  unsigned stg2_decimation_factor = (pdm_freq/STAGE1_DEC_FACTOR)/output_samp_freq;
+  assert ((output_samp_freq*STAGE1_DEC_FACTOR*stg2_decimation_factor) == pdm_freq); // assert if it doesn't divide cleanly
+  // assert if unsupported decimation factor. (for example. when starting with a pdm_freq of 3.072MHz, supported
+  // output sampling freqs are [96000, 48000, 32000, 24000, 16000, 8000], less any not in
+  // MIC_ARRAY_CONFIG_SUPPORTED_RATES)
+  assert (default_stg2_dec_factor_supported(stg2_decimation_factor));
+  return stg2_decimation_factor;
+}
+
+// Whether an instance has no initialised mic array.
+static bool instance_free(const mic_array_instance_t* inst)
+{
+  return inst->mics == nullptr
+#if USE_3STG_DECIMATOR
+      && inst->mics_3stg == nullptr
+#endif
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+      && inst->mics_cic == nullptr && inst->mics_multistg == nullptr
+#endif
+      ;
+}
+
+// Index of a free instance.
+static unsigned alloc_instance()
+{
+  for(unsigned k = 0; k < MIC_ARRAY_CONFIG_MAX_INSTANCES; k++) {
+    if(instance_free(&instances[k]))
+      return k;
+  }
+  __builtin_trap(); // All MIC_ARRAY_CONFIG_MAX_INSTANCES instances are in use
+}
+
+mic_array_instance_t* mic_array_instance_init(pdm_rx_resources_t *pdm_res, const unsigned *channel_map, unsigned output_samp_freq)
+{
+  static SDefaultFilterMem default_filter_mem[MIC_ARRAY_CONFIG_MAX_INSTANCES];
+  static SMicStorage<UDefaultMicArray> mic_storage[MIC_ARRAY_CONFIG_MAX_INSTANCES];
+
+  const unsigned k = alloc_instance();
+  mic_array_instance_t* inst = &instances[k];
+  inst->default_mem = &default_filter_mem[k];
+  inst->default_model_pdm_freq = pdm_res->pdm_freq;
+
+  unsigned stg2_decimation_factor = default_stg2_decimation_factor(pdm_res->pdm_freq, output_samp_freq);
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+  inst->use_cic_decimator = false;
+  inst->use_multi_stg_decimator = false;
+#endif
+#if DEFAULT_USE_3STG_8K
+  if(stg2_decimation_factor == 12) {
+    inst->use_3_stg_decimator = true;
+    inst->mics_3stg = new (mic_storage[k].bytes) TMicArray_3stg_decimator();
+    init_mics_default_8k_3stg_filter(inst, pdm_res, channel_map);
+    return inst;
+  }
+#endif
+
+#if USE_3STG_DECIMATOR
+  inst->use_3_stg_decimator = false;
+#endif
+  inst->mics = new (mic_storage[k].bytes) TMicArray();
+  init_mics_default_filter(inst, pdm_res, channel_map, stg2_decimation_factor);
+  return inst;
+}
+
 void mic_array_init(pdm_rx_resources_t *pdm_res, const unsigned *channel_map, unsigned output_samp_freq)
 {
-  assert(g_mics == nullptr); // Mic array instance already initialised
+  // Mic array instance already initialised
+  assert(default_instance == nullptr || instance_free(default_instance));
+  default_instance = mic_array_instance_init(pdm_res, channel_map, output_samp_freq);
+}
 
-  use_3_stg_decimator = false;
+void mic_array_instance_set_output_rate(mic_array_instance_t* inst, unsigned output_samp_freq)
+{
+#if MIC_ARRAY_CONFIG_USE_RATE_SWITCHING
+  // Requires mic_array_instance_init(), and not the 3 stage 8 kHz filters
+  assert(inst != nullptr);
+  assert(inst->mics != nullptr && inst->default_model_pdm_freq != 0);
+  SDefaultFilterMem* mem = inst->default_mem;
 
-  unsigned stg2_decimation_factor = (pdm_res->pdm_freq/STAGE1_DEC_FACTOR)/output_samp_freq;
-  assert ((output_samp_freq*STAGE1_DEC_FACTOR*stg2_decimation_factor) == pdm_res->pdm_freq); // assert if it doesn't divide cleanly
-  // assert if unsupported decimation factor. (for example. when starting with a pdm_freq of 3.072MHz, supported
-  // output sampling freqs are [48000, 32000, 16000]
-  assert ((stg2_decimation_factor == 2) || (stg2_decimation_factor == 3) || (stg2_decimation_factor == 6));
-  static uint8_t __attribute__((aligned(8))) mic_storage[sizeof(TMicArray)];
-  g_mics = new (mic_storage) TMicArray();
-  init_mics_default_filter(g_mics, pdm_res, channel_map, stg2_decimation_factor);
+  unsigned stg2_decimation_factor = default_stg2_decimation_factor(inst->default_model_pdm_freq, output_samp_freq);
+  if(stg2_decimation_factor == inst->active_filter_conf[1].decimation_factor)
+    return;
+
+  // The stage 2 state of the current filters stays in use until the switch,
+  // so wait for any previous switch to complete before reusing the other half.
+  // A running decimator completes it within a few ms; one which is not
+  // running never does.
+  const uint32_t start_time = get_reference_time();
+  while(inst->mics->Decimator.IsReconfiguring()) {
+    if(get_reference_time() - start_time > SET_OUTPUT_RATE_TIMEOUT_TICKS)
+      __builtin_trap(); // The mic array is not running
+  }
+  mem->stg2_filter_state_index = (mem->stg2_filter_state_index + 1) % DEFAULT_STG2_STATE_BUFFERS;
+
+  mic_array_filter_conf_t filter_conf[2] = {{0}};
+  default_filter_conf(mem, filter_conf, stg2_decimation_factor, mem->stg2_filter_state_index);
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+  inst->mics->Decimator.Reconfigure(decimator_conf);
+  set_active_decimator_conf(inst, decimator_conf, false);
+#else
+  __builtin_trap(); // Requires MIC_ARRAY_CONFIG_USE_RATE_SWITCHING
+#endif
+}
+
+void mic_array_set_output_rate(unsigned output_samp_freq)
+{
+  mic_array_instance_set_output_rate(default_instance, output_samp_freq);
+}
 
+unsigned mic_array_instance_get_latency(mic_array_instance_t* inst)
+{
+  assert(inst != nullptr);
+  assert(inst->active_decimator_conf.num_filter_stages != 0); // Requires mic_array_instance_init()
+  return _mic_array_decimator_latency(&inst->active_decimator_conf, MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME,
+                                      inst->active_coef_s16);
+}
+
+unsigned mic_array_get_latency()
+{
+  return mic_array_instance_get_latency(default_instance);
 }
 
 template <typename TMics>
@@ -54,28 +173,69 @@ static inline void init_from_conf(TMics*& mics_ptr,
   mics_ptr->PdmRx.AssertOnDroppedBlock(false);
 }
 
-void mic_array_init_custom_filter(pdm_rx_resources_t* pdm_res,
-                                         mic_array_conf_t* mic_array_conf)
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+mic_array_instance_t* mic_array_instance_init_custom_filter(pdm_rx_resources_t* pdm_res,
+                                                            mic_array_conf_t* mic_array_conf)
 {
   assert(pdm_res);
   assert(mic_array_conf);
-  assert(g_mics == nullptr && g_mics_3stg == nullptr);
-  static uint8_t __attribute__((aligned(8))) mic_storage[sizeof(UAnyMicArray)];
+  assert(mic_array_conf->decimator_conf.num_filter_stages >= 2);
+  assert(mic_array_conf->decimator_conf.num_filter_stages <= MIC_ARRAY_CONFIG_MAX_FILTER_STAGES);
+  static SMicStorage<UAnyMicArray> mic_array_storage[MIC_ARRAY_CONFIG_MAX_INSTANCES];
+
+  const unsigned k = alloc_instance();
+  mic_array_instance_t* inst = &instances[k];
+  uint8_t* mic_storage = mic_array_storage[k].bytes;
+  inst->default_mem = nullptr;
+  inst->default_model_pdm_freq = 0;
 
-  if(mic_array_conf->decimator_conf.num_filter_stages == 2)
+  inst->use_cic_decimator = false;
+  inst->use_multi_stg_decimator = false;
+  if(mic_array_conf->decimator_conf.num_filter_stages == 2 &&
+     mic_array_conf->decimator_conf.filter_conf[0].cic_order != 0)
   {
-    use_3_stg_decimator = false;
-    init_from_conf<TMicArray>(g_mics, mic_storage, pdm_res, mic_array_conf);
+    inst->use_3_stg_decimator = false;
+    init_from_conf<TMicArray_cic>(inst->mics_cic, mic_storage, pdm_res, mic_array_conf);
+    inst->use_cic_decimator = true;
   }
-  else if(mic_array_conf->decimator_conf.num_filter_stages == 3)
+  else if(MIC_ARRAY_CONFIG_USE_S16_FILTERS || mic_array_conf->decimator_conf.num_filter_stages > 3)
   {
-    init_from_conf<TMicArray_3stg_decimator>(g_mics_3stg, mic_storage, pdm_res, mic_array_conf);
-    use_3_stg_decimator = true;
+    inst->use_3_stg_decimator = false;
+    init_from_conf<TMicArray_multistg>(inst->mics_multistg, mic_storage, pdm_res, mic_array_conf);
+    inst->use_multi_stg_decimator = true;
   }
+  else if(mic_array_conf->decimator_conf.num_filter_stages == 2)
+  {
+    inst->use_3_stg_decimator = false;
+    init_from_conf<TMicArray>(inst->mics, mic_storage, pdm_res, mic_array_conf);
+  }
+  else
+  {
+    init_from_conf<TMicArray_3stg_decimator>(inst->mics_3stg, mic_storage, pdm_res, mic_array_conf);
+    inst->use_3_stg_decimator = true;
+  }
+  set_active_decimator_conf(inst, mic_array_conf->decimator_conf,
+                            MIC_ARRAY_CONFIG_USE_S16_FILTERS && inst->use_multi_stg_decimator);
   // Configure and start clocks
   const unsigned divide = pdm_res->mclk_freq / pdm_res->pdm_freq;
   mic_array_resources_configure(pdm_res, divide);
   mic_array_pdm_clock_start(pdm_res);
+  return inst;
+}
+#else
+mic_array_instance_t* mic_array_instance_init_custom_filter(pdm_rx_resources_t* pdm_res,
+                                                            mic_array_conf_t* mic_array_conf)
+{
+  __builtin_trap(); // Requires MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+}
+#endif
+
+void mic_array_init_custom_filter(pdm_rx_resources_t* pdm_res,
+                                         mic_array_conf_t* mic_array_conf)
+{
+  // Mic array instance already initialised
+  assert(default_instance == nullptr || instance_free(default_instance));
+  default_instance = mic_array_instance_init_custom_filter(pdm_res, mic_array_conf);
 }
 
 
@@ -94,6 +254,29 @@ void default_ma_task_start_decimator(TMicArray& mics, chanend_t c_audio_frames){
   mics.ThreadEntry();
 }
 
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+DECLARE_JOB(default_ma_task_start_pdm_cic, (TMicArray_cic&));
+void default_ma_task_start_pdm_cic(TMicArray_cic& mics){
+  mics.PdmRx.ThreadEntry();
+}
+
+DECLARE_JOB(default_ma_task_start_decimator_cic, (TMicArray_cic&, chanend_t));
+void default_ma_task_start_decimator_cic(TMicArray_cic& mics, chanend_t c_audio_frames){
+  mics.ThreadEntry();
+}
+
+DECLARE_JOB(default_ma_task_start_pdm_multistg, (TMicArray_multistg&));
+void default_ma_task_start_pdm_multistg(TMicArray_multistg& mics){
+  mics.PdmRx.ThreadEntry();
+}
+
+DECLARE_JOB(default_ma_task_start_decimator_multistg, (TMicArray_multistg&, chanend_t));
+void default_ma_task_start_decimator_multistg(TMicArray_multistg& mics, chanend_t c_audio_frames){
+  mics.ThreadEntry();
+}
+#endif
+
+#if USE_3STG_DECIMATOR
 DECLARE_JOB(default_ma_task_start_pdm_3stg, (TMicArray_3stg_decimator&));
 void default_ma_task_start_pdm_3stg(TMicArray_3stg_decimator& mics){
   mics.PdmRx.ThreadEntry();
@@ -103,6 +286,7 @@ DECLARE_JOB(default_ma_task_start_decimator_3stg, (TMicArray_3stg_decimator&, ch
 void default_ma_task_start_decimator_3stg(TMicArray_3stg_decimator& mics, chanend_t c_audio_frames){
   mics.ThreadEntry();
 }
+#endif
 
 #if defined(__XS3A__)
 #define CLRSR(c)                asm volatile("clrsr %0" : : "n"(c));
@@ -112,66 +296,268 @@ void default_ma_task_start_decimator_3stg(TMicArray_3stg_decimator& mics, chanen
 #endif
 #define CLEAR_KEDI()            CLRSR(XS1_SR_KEDI_MASK)
 
+#if MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK
+template <typename TMics>
+static inline void set_frame_callback(TMics* mics_ptr,
+                                      ma_frame_callback_t callback,
+                                      void* context)
+{
+  assert(mics_ptr != nullptr); // Attempting to start mic_array before initialising it
+  mics_ptr->OutputHandler.FrameTx.SetCallback(callback, context);
+}
+
+template <typename TMics>
+static inline ma_frame_queue_t* get_frame_queue(TMics* mics_ptr)
+{
+  assert(mics_ptr != nullptr); // Attempting to get the queue before initialising the mic_array
+  return mics_ptr->OutputHandler.FrameTx.GetQueue();
+}
+#else
+template <typename TMics>
+static inline void set_frame_output(TMics* mics_ptr, chanend_t c_frames_out)
+{
+  assert(mics_ptr != nullptr); // Attempting to start mic_array before initialising it
+  mics_ptr->OutputHandler.FrameTx.SetChannel(c_frames_out);
+#if MIC_ARRAY_CONFIG_USE_FRAME_METADATA
+  mics_ptr->OutputHandler.FrameTx.SetMetadataEnabled(true);
+#endif
+}
+#endif
+
 template <typename TMics>
-void start_mics_with_pdm_isr(TMics* mics_ptr, chanend_t c_frames_out)
+void start_mics_with_pdm_isr(TMics* mics_ptr)
 {
   assert(mics_ptr != nullptr);
   CLEAR_KEDI();
-  mics_ptr->OutputHandler.FrameTx.SetChannel(c_frames_out);
   mics_ptr->PdmRx.AssertOnDroppedBlock(false);
   mics_ptr->PdmRx.InstallISR();
+#if MIC_ARRAY_CONFIG_USE_FRAME_METADATA || MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK
+  mics_ptr->OutputHandler.SetDroppedBlockCounter(
+      mics_ptr->PdmRx.DroppedBlockCounter());
+#endif
   mics_ptr->PdmRx.UnmaskISR();
   mics_ptr->ThreadEntry();
 }
 
-void mic_array_start(
+// Run the mic array until shutdown, once its frame output has been configured.
+static void run_mics(
+    mic_array_instance_t* inst,
     chanend_t c_frames_out)
 {
 #if MIC_ARRAY_CONFIG_USE_PDM_ISR
-  if (use_3_stg_decimator) {
-    start_mics_with_pdm_isr<TMicArray_3stg_decimator>(g_mics_3stg, c_frames_out);
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+  if (inst->use_cic_decimator) {
+    start_mics_with_pdm_isr<TMicArray_cic>(inst->mics_cic);
+  }
+  else if (inst->use_multi_stg_decimator) {
+    start_mics_with_pdm_isr<TMicArray_multistg>(inst->mics_multistg);
   }
-  else {
-    start_mics_with_pdm_isr<TMicArray>(g_mics, c_frames_out);
+  else
+#endif
+#if USE_3STG_DECIMATOR
+  if (inst->use_3_stg_decimator) {
+    start_mics_with_pdm_isr<TMicArray_3stg_decimator>(inst->mics_3stg);
+  }
+  else
+#endif
+  {
+    start_mics_with_pdm_isr<TMicArray>(inst->mics);
   }
 #else
-  if (use_3_stg_decimator) {
-    assert(g_mics_3stg != nullptr); // Attempting to start mic_array before initialising it
-    g_mics_3stg->OutputHandler.FrameTx.SetChannel(c_frames_out);
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+  if (inst->use_cic_decimator) {
+    PAR_JOBS(
+      PJOB(default_ma_task_start_pdm_cic, (*inst->mics_cic)),
+      PJOB(default_ma_task_start_decimator_cic, (*inst->mics_cic, c_frames_out)));
+  }
+  else if (inst->use_multi_stg_decimator) {
     PAR_JOBS(
-      PJOB(default_ma_task_start_pdm_3stg, (*g_mics_3stg)),
-      PJOB(default_ma_task_start_decimator_3stg, (*g_mics_3stg, c_frames_out)));
+      PJOB(default_ma_task_start_pdm_multistg, (*inst->mics_multistg)),
+      PJOB(default_ma_task_start_decimator_multistg, (*inst->mics_multistg, c_frames_out)));
   }
   else
+#endif
+#if USE_3STG_DECIMATOR
+  if (inst->use_3_stg_decimator) {
+    PAR_JOBS(
+      PJOB(default_ma_task_start_pdm_3stg, (*inst->mics_3stg)),
+      PJOB(default_ma_task_start_decimator_3stg, (*inst->mics_3stg, c_frames_out)));
+  }
+  else
+#endif
   {
-    g_mics->OutputHandler.FrameTx.SetChannel(c_frames_out);
     PAR_JOBS(
-      PJOB(default_ma_task_start_pdm, (*g_mics)),
-      PJOB(default_ma_task_start_decimator, (*g_mics, c_frames_out)));
+      PJOB(default_ma_task_start_pdm, (*inst->mics)),
+      PJOB(default_ma_task_start_decimator, (*inst->mics, c_frames_out)));
   }
 #endif
   // shutdown
-  if (use_3_stg_decimator) {
-    g_mics_3stg->~TMicArray_3stg_decimator();
-    g_mics_3stg = nullptr;
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+  if (inst->use_cic_decimator) {
+    inst->mics_cic->~TMicArray_cic();
+    inst->mics_cic = nullptr;
+  }
+  else if (inst->use_multi_stg_decimator) {
+    inst->mics_multistg->~TMicArray_multistg();
+    inst->mics_multistg = nullptr;
+  }
+  else
+#endif
+#if USE_3STG_DECIMATOR
+  if (inst->use_3_stg_decimator) {
+    inst->mics_3stg->~TMicArray_3stg_decimator();
+    inst->mics_3stg = nullptr;
+  }
+  else
+#endif
+  {
+    inst->mics->~TMicArray();
+    inst->mics = nullptr;
+  }
+}
+
+#if MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK
+void mic_array_instance_start(
+    mic_array_instance_t* inst,
+    chanend_t c_frames_out)
+{
+  __builtin_trap(); // MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK is enabled, use mic_array_instance_start_callback()
+}
+
+void mic_array_instance_start_callback(
+    mic_array_instance_t* inst,
+    ma_frame_callback_t callback,
+    void* context)
+{
+  assert(inst != nullptr); // Attempting to start mic_array before initialising it
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+  if (inst->use_cic_decimator) {
+    set_frame_callback(inst->mics_cic, callback, context);
+  }
+  else if (inst->use_multi_stg_decimator) {
+    set_frame_callback(inst->mics_multistg, callback, context);
   }
-  else {
-    g_mics->~TMicArray();
-    g_mics = nullptr;
+  else
+#endif
+#if USE_3STG_DECIMATOR
+  if (inst->use_3_stg_decimator) {
+    set_frame_callback(inst->mics_3stg, callback, context);
+  }
+  else
+#endif
+  {
+    set_frame_callback(inst->mics, callback, context);
   }
+  run_mics(inst, 0);
 }
+
+ma_frame_queue_t* mic_array_instance_get_frame_queue(mic_array_instance_t* inst)
+{
+  assert(inst != nullptr); // Attempting to get the queue before initialising the mic_array
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+  if (inst->use_cic_decimator) {
+    return get_frame_queue(inst->mics_cic);
+  }
+  if (inst->use_multi_stg_decimator) {
+    return get_frame_queue(inst->mics_multistg);
+  }
+#endif
+#if USE_3STG_DECIMATOR
+  if (inst->use_3_stg_decimator) {
+    return get_frame_queue(inst->mics_3stg);
+  }
+#endif
+  return get_frame_queue(inst->mics);
+}
+#else
+void mic_array_instance_start(
+    mic_array_instance_t* inst,
+    chanend_t c_frames_out)
+{
+  assert(inst != nullptr); // Attempting to start mic_array before initialising it
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+  if (inst->use_cic_decimator) {
+    set_frame_output(inst->mics_cic, c_frames_out);
+  }
+  else if (inst->use_multi_stg_decimator) {
+    set_frame_output(inst->mics_multistg, c_frames_out);
+  }
+  else
+#endif
+#if USE_3STG_DECIMATOR
+  if (inst->use_3_stg_decimator) {
+    set_frame_output(inst->mics_3stg, c_frames_out);
+  }
+  else
+#endif
+  {
+    set_frame_output(inst->mics, c_frames_out);
+  }
+  run_mics(inst, c_frames_out);
+}
+
+void mic_array_instance_start_callback(
+    mic_array_instance_t* inst,
+    ma_frame_callback_t callback,
+    void* context)
+{
+  __builtin_trap(); // Requires MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK
+}
+
+ma_frame_queue_t* mic_array_instance_get_frame_queue(mic_array_instance_t* inst)
+{
+  __builtin_trap(); // Requires MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK
+}
+#endif
+
+void mic_array_start(
+    chanend_t c_frames_out)
+{
+  mic_array_instance_start(default_instance, c_frames_out);
+}
+
+void mic_array_start_callback(
+    ma_frame_callback_t callback,
+    void* context)
+{
+  mic_array_instance_start_callback(default_instance, callback, context);
+}
+
+ma_frame_queue_t* mic_array_get_frame_queue()
+{
+  return mic_array_instance_get_frame_queue(default_instance);
+}
+
 // Override pdm data port. Only used in tests where a chanend is used as a 'port' for input pdm data.
-void _mic_array_override_pdm_port(chanend_t c_pdm)
+void _mic_array_instance_override_pdm_port(mic_array_instance_t* inst, chanend_t c_pdm)
 {
-  if (use_3_stg_decimator) {
-    assert(g_mics_3stg != nullptr);
-    g_mics_3stg->PdmRx.SetPort((port_t)c_pdm);
-  } else {
-    assert(g_mics != nullptr);
-    g_mics->PdmRx.SetPort((port_t)c_pdm);
+  assert(inst != nullptr);
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+  if (inst->use_cic_decimator) {
+    assert(inst->mics_cic != nullptr);
+    inst->mics_cic->PdmRx.SetPort((port_t)c_pdm);
+  } else if (inst->use_multi_stg_decimator) {
+    assert(inst->mics_multistg != nullptr);
+    inst->mics_multistg->PdmRx.SetPort((port_t)c_pdm);
+  } else
+#endif
+#if USE_3STG_DECIMATOR
+  if (inst->use_3_stg_decimator) {
+    assert(inst->mics_3stg != nullptr);
+    inst->mics_3stg->PdmRx.SetPort((port_t)c_pdm);
+  } else
+#endif
+  {
+    assert(inst->mics != nullptr);
+    inst->mics->PdmRx.SetPort((port_t)c_pdm);
   }
 }
 
+void _mic_array_override_pdm_port(chanend_t c_pdm)
+{
+  _mic_array_instance_override_pdm_port(default_instance, c_pdm);
+}
+
 // C wrapper
 extern "C" void _mic_array_override_pdm_port_c(chanend_t c_pdm)
 {
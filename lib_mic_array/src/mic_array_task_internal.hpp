@@ -6,6 +6,27 @@
 #include "mic_array.h"
 #include "mic_array/etc/filters_default.h"
 
+// Whether the default filters for an output sample rate (MIC_ARRAY_RATE_*) are
+// built in, selected by MIC_ARRAY_CONFIG_SUPPORTED_RATES.
+#define DEFAULT_RATE_ENABLED(RATE)  (((MIC_ARRAY_CONFIG_SUPPORTED_RATES) & (RATE)) != 0)
+
+// The low MIPS 8 kHz preset is only used if 8 kHz is supported.
+#define DEFAULT_USE_3STG_8K   (MIC_ARRAY_CONFIG_USE_3_STAGE_8K && DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_8K))
+
+// The 3 stage decimator is used by the 8 kHz preset and by custom filters.
+#define USE_3STG_DECIMATOR    (DEFAULT_USE_3STG_8K || MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS)
+
+// Frame transmitter used by the default model, selected by
+// MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK.
+#if MIC_ARRAY_CONFIG_USE_FRAME_CALLBACK
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+using TFrameTransmitter = mic_array::CallbackFrameTransmitter<MIC_COUNT, SAMPLE_COUNT,
+                                                              MIC_ARRAY_CONFIG_FRAME_COUNT - 1>;
+#else
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+using TFrameTransmitter = mic_array::ChannelFrameTransmitter<MIC_COUNT, SAMPLE_COUNT>;
+#endif
+
 using TMicArray =  mic_array::MicArray<MIC_ARRAY_CONFIG_MIC_COUNT,
                         mic_array::TwoStageDecimator<MIC_ARRAY_CONFIG_MIC_COUNT>,
                         mic_array::StandardPdmRxService<MIC_ARRAY_CONFIG_MIC_IN_COUNT,
@@ -17,7 +38,8 @@ using TMicArray =  mic_array::MicArray<MIC_ARRAY_CONFIG_MIC_COUNT,
                                             mic_array::NopSampleFilter<MIC_ARRAY_CONFIG_MIC_COUNT>>::type,
                         mic_array::FrameOutputHandler<MIC_ARRAY_CONFIG_MIC_COUNT,
                                                       MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME,
-                                                      mic_array::ChannelFrameTransmitter>>;
+                                                      TFrameTransmitter,
+                                                      MIC_ARRAY_CONFIG_FRAME_COUNT>>;
 
 using TMicArray_3stg_decimator =  mic_array::MicArray<MIC_ARRAY_CONFIG_MIC_COUNT,
                         mic_array::ThreeStageDecimator<MIC_ARRAY_CONFIG_MIC_COUNT>,
@@ -30,69 +52,323 @@ using TMicArray_3stg_decimator =  mic_array::MicArray<MIC_ARRAY_CONFIG_MIC_COUNT
                                             mic_array::NopSampleFilter<MIC_ARRAY_CONFIG_MIC_COUNT>>::type,
                         mic_array::FrameOutputHandler<MIC_ARRAY_CONFIG_MIC_COUNT,
                                                       MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME,
-                                                      mic_array::ChannelFrameTransmitter>>;
+                                                      TFrameTransmitter,
+                                                      MIC_ARRAY_CONFIG_FRAME_COUNT>>;
+using TMicArray_cic =  mic_array::MicArray<MIC_ARRAY_CONFIG_MIC_COUNT,
+                        mic_array::CicCompDecimator<MIC_ARRAY_CONFIG_MIC_COUNT>,
+                        mic_array::StandardPdmRxService<MIC_ARRAY_CONFIG_MIC_IN_COUNT,
+                                                        MIC_ARRAY_CONFIG_MIC_COUNT>,
+                        // std::conditional uses USE_DCOE to determine which
+                        // sample filter is used.
+                        typename std::conditional<MIC_ARRAY_CONFIG_USE_DC_ELIMINATION,
+                                            mic_array::DcoeSampleFilter<MIC_ARRAY_CONFIG_MIC_COUNT>,
+                                            mic_array::NopSampleFilter<MIC_ARRAY_CONFIG_MIC_COUNT>>::type,
+                        mic_array::FrameOutputHandler<MIC_ARRAY_CONFIG_MIC_COUNT,
+                                                      MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME,
+                                                      TFrameTransmitter,
+                                                      MIC_ARRAY_CONFIG_FRAME_COUNT>>;
+using TMicArray_multistg =  mic_array::MicArray<MIC_ARRAY_CONFIG_MIC_COUNT,
+                        // std::conditional uses USE_S16_FILTERS to determine
+                        // the width of the PCM stages.
+                        typename std::conditional<MIC_ARRAY_CONFIG_USE_S16_FILTERS,
+                                            mic_array::MultiStageDecimatorS16<MIC_ARRAY_CONFIG_MIC_COUNT,
+                                                                              MIC_ARRAY_CONFIG_MAX_FILTER_STAGES>,
+                                            mic_array::MultiStageDecimator<MIC_ARRAY_CONFIG_MIC_COUNT,
+                                                                           MIC_ARRAY_CONFIG_MAX_FILTER_STAGES>>::type,
+                        mic_array::StandardPdmRxService<MIC_ARRAY_CONFIG_MIC_IN_COUNT,
+                                                        MIC_ARRAY_CONFIG_MIC_COUNT>,
+                        // std::conditional uses USE_DCOE to determine which
+                        // sample filter is used.
+                        typename std::conditional<MIC_ARRAY_CONFIG_USE_DC_ELIMINATION,
+                                            mic_array::DcoeSampleFilter<MIC_ARRAY_CONFIG_MIC_COUNT>,
+                                            mic_array::NopSampleFilter<MIC_ARRAY_CONFIG_MIC_COUNT>>::type,
+                        mic_array::FrameOutputHandler<MIC_ARRAY_CONFIG_MIC_COUNT,
+                                                      MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME,
+                                                      TFrameTransmitter,
+                                                      MIC_ARRAY_CONFIG_FRAME_COUNT>>;
 union UAnyMicArray {
     TMicArray m_2stg;
+#if USE_3STG_DECIMATOR
+    TMicArray_3stg_decimator m_3stg;
+#endif
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+    TMicArray_cic m_cic;
+    TMicArray_multistg m_multistg;
+#endif
+};
+
+// Mic array types that mic_array_init() can start.
+union UDefaultMicArray {
+    TMicArray m_2stg;
+#if DEFAULT_USE_3STG_8K
     TMicArray_3stg_decimator m_3stg;
+#endif
 };
 
 union UStg2_filter_state {
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_8K)
+  int32_t filter_state_df_12[MIC_ARRAY_CONFIG_MIC_COUNT][MIC_ARRAY_8K_STAGE_2_TAP_COUNT];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_16K)
   int32_t filter_state_df_6[MIC_ARRAY_CONFIG_MIC_COUNT][STAGE2_TAP_COUNT];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_24K)
+  int32_t filter_state_df_4[MIC_ARRAY_CONFIG_MIC_COUNT][MIC_ARRAY_24K_STAGE_2_TAP_COUNT];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_32K)
   int32_t filter_state_df_3[MIC_ARRAY_CONFIG_MIC_COUNT][MIC_ARRAY_32K_STAGE_2_TAP_COUNT];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_48K)
   int32_t filter_state_df_2[MIC_ARRAY_CONFIG_MIC_COUNT][MIC_ARRAY_48K_STAGE_2_TAP_COUNT];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_96K)
+  int32_t filter_state_df_1[MIC_ARRAY_CONFIG_MIC_COUNT][MIC_ARRAY_96K_STAGE_2_TAP_COUNT];
+#endif
+#if DEFAULT_USE_3STG_8K
+  struct {
+    int32_t stg2[MIC_ARRAY_CONFIG_MIC_COUNT][MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT];
+    int32_t stg3[MIC_ARRAY_CONFIG_MIC_COUNT][MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT];
+  } filter_state_8k_3stg;
+#endif
 };
 
-union UPdmRx_out_block {
-  uint32_t out_block_df_6[MIC_ARRAY_CONFIG_MIC_COUNT][6];
-  uint32_t out_block_df_3[MIC_ARRAY_CONFIG_MIC_COUNT][3];
-  uint32_t out_block_df_2[MIC_ARRAY_CONFIG_MIC_COUNT][2];
+// Number of stage 2 filter state buffers. A second is only needed to switch
+// between rates while running.
+#define DEFAULT_STG2_STATE_BUFFERS  ((MIC_ARRAY_CONFIG_USE_RATE_SWITCHING \
+    && ((MIC_ARRAY_CONFIG_SUPPORTED_RATES) & ((MIC_ARRAY_CONFIG_SUPPORTED_RATES) - 1)) != 0)? 2 : 1)
+
+// Largest stage 2 decimation factor of the supported default filters. PDM
+// buffers are sized for it, so that the output sample rate can be changed
+// while running.
+static constexpr unsigned DEFAULT_MAX_STG2_DEC_FACTOR =
+    DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_8K)?  12 :
+    DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_16K)?  6 :
+    DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_24K)?  4 :
+    DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_32K)?  3 :
+    DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_48K)?  2 : 1;
+
+// PDM rx buffers are only ever used at one block size at a time, so they are
+// sized for the largest.
+struct SPdmRx_out_block {
+  uint32_t out_block[MIC_ARRAY_CONFIG_MIC_COUNT][DEFAULT_MAX_STG2_DEC_FACTOR];
 };
 
-union UPdmRx_out_block_double_buf {
-  uint32_t __attribute__((aligned (8))) out_block_double_buf_df_6[2][MIC_ARRAY_CONFIG_MIC_IN_COUNT * 6];
-  uint32_t __attribute__((aligned (8))) out_block_double_buf_df_3[2][MIC_ARRAY_CONFIG_MIC_IN_COUNT * 3];
-  uint32_t __attribute__((aligned (8))) out_block_double_buf_df_2[2][MIC_ARRAY_CONFIG_MIC_IN_COUNT * 2];
+struct SPdmRx_out_block_double_buf {
+  uint32_t __attribute__((aligned (8))) out_block_double_buf[2][MIC_ARRAY_CONFIG_MIC_IN_COUNT * DEFAULT_MAX_STG2_DEC_FACTOR];
 };
 
-extern TMicArray* g_mics;
+// Filter state and PDM rx buffers of a mic array instance using the default
+// filters.
+struct SDefaultFilterMem {
+  // With rate switching, stage 2 filter state is double buffered, so that the
+  // filters for a new output sample rate can be filled while the current
+  // filters are in use.
+  UStg2_filter_state stg2_filter_state_mem[DEFAULT_STG2_STATE_BUFFERS];
+  unsigned stg2_filter_state_index;
+  int32_t stg1_filter_state[MIC_ARRAY_CONFIG_MIC_COUNT][8];
+  SPdmRx_out_block pdm_rx_out_block;
+  SPdmRx_out_block_double_buf __attribute__((aligned (8))) pdm_rx_out_block_double_buf; // deinterleave() functions expect dword alignment
+};
 
-UStg2_filter_state stg2_filter_state_mem;
-UPdmRx_out_block pdm_rx_out_block;
-UPdmRx_out_block_double_buf __attribute__((aligned (8))) pdm_rx_out_block_double_buf; // deinterleave() functions expect dword alignment
+// A mic array instance of the C API. At most one of the mic array pointers is
+// non-null, from initialisation until the mic array shuts down, and the flags
+// say which.
+struct mic_array_instance {
+  TMicArray* mics;
+#if USE_3STG_DECIMATOR
+  TMicArray_3stg_decimator* mics_3stg;
+  bool use_3_stg_decimator;
+#endif
+#if MIC_ARRAY_CONFIG_USE_CUSTOM_FILTERS
+  TMicArray_cic* mics_cic;
+  bool use_cic_decimator;
+  TMicArray_multistg* mics_multistg;
+  bool use_multi_stg_decimator;
+#endif
+  // PDM clock frequency given to mic_array_instance_init(), or 0 for custom filters
+  unsigned default_model_pdm_freq;
+  // Filter state and buffers, when using the default filters
+  SDefaultFilterMem* default_mem;
+  // Filter configuration of the decimator, for mic_array_instance_get_latency()
+  mic_array_filter_conf_t active_filter_conf[MIC_ARRAY_CONFIG_MAX_FILTER_STAGES];
+  mic_array_decimator_conf_t active_decimator_conf;
+  // Whether stages after stage 1 have int16 coefficients, as for
+  // mic_array::MultiStageDecimatorS16
+  bool active_coef_s16;
+};
 
+// Whether the default filters for a stage 2 decimation factor are built in.
+inline bool default_stg2_dec_factor_supported(unsigned stg2_dec_factor) {
+  switch(stg2_dec_factor){
+    case 1:  return DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_96K);
+    case 2:  return DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_48K);
+    case 3:  return DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_32K);
+    case 4:  return DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_24K);
+    case 6:  return DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_16K);
+    case 12: return DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_8K);
+    default: return false;
+  }
+}
+
+// The helpers below only refer to the tables and state of supported decimation
+// factors, so that the others are not linked in. They must only be called with
+// a factor for which default_stg2_dec_factor_supported() is true.
 inline const uint32_t* stage_1_filter(unsigned stg2_dec_factor) {
   // stg2 decimation factor also seems to affect the stage1 filter used
-  return (stg2_dec_factor == 2) ? &stage1_48k_coefs[0] : ((stg2_dec_factor == 3) ? &stage1_32k_coefs[0] : &stage1_coef[0]);
+  switch(stg2_dec_factor){
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_96K)
+    case 1:  return &stage1_96k_coefs[0];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_48K)
+    case 2:  return &stage1_48k_coefs[0];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_32K)
+    case 3:  return &stage1_32k_coefs[0];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_24K)
+    case 4:  return &stage1_48k_coefs[0];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_16K)
+    case 6:  return &stage1_coef[0];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_8K)
+    case 12: return &stage1_coef[0];
+#endif
+    default: return nullptr;
+  }
 }
 inline const int32_t* stage_2_filter(unsigned stg2_dec_factor) {
-    return (stg2_dec_factor == 2) ? &stage2_48k_coefs[0] : ((stg2_dec_factor == 3) ? &stage2_32k_coefs[0] : &stage2_coef[0]);
+  switch(stg2_dec_factor){
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_96K)
+    case 1:  return &stage2_96k_coefs[0];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_48K)
+    case 2:  return MIC_ARRAY_CONFIG_USE_MIN_PHASE_FILTERS? &stage2_48k_min_phase_coefs[0]
+                                                         : &stage2_48k_coefs[0];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_32K)
+    case 3:  return MIC_ARRAY_CONFIG_USE_MIN_PHASE_FILTERS? &stage2_32k_min_phase_coefs[0]
+                                                         : &stage2_32k_coefs[0];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_24K)
+    case 4:  return &stage2_24k_coefs[0];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_16K)
+    case 6:  return MIC_ARRAY_CONFIG_USE_MIN_PHASE_FILTERS? &stage2_16k_min_phase_coefs[0]
+                                                         : &stage2_coef[0];
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_8K)
+    case 12: return &stage2_8k_coefs[0];
+#endif
+    default: return nullptr;
+  }
 }
 inline const right_shift_t stage_2_shift(unsigned stg2_dec_factor) {
-    return (stg2_dec_factor == 2) ? stage2_48k_shift : ((stg2_dec_factor == 3) ? stage2_32k_shift : stage2_shr);
+  switch(stg2_dec_factor){
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_96K)
+    case 1:  return stage2_96k_shift;
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_48K)
+    case 2:  return stage2_48k_shift;
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_32K)
+    case 3:  return stage2_32k_shift;
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_24K)
+    case 4:  return stage2_24k_shift;
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_16K)
+    case 6:  return stage2_shr;
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_8K)
+    case 12: return stage2_8k_shift;
+#endif
+    default: return 0;
+  }
 }
+// The minimum phase filters have the same tap counts and output shifts as the
+// linear phase filters they replace.
+static_assert(MIC_ARRAY_16K_MIN_PHASE_STAGE_2_TAP_COUNT == STAGE2_TAP_COUNT
+           && MIC_ARRAY_32K_MIN_PHASE_STAGE_2_TAP_COUNT == MIC_ARRAY_32K_STAGE_2_TAP_COUNT
+           && MIC_ARRAY_48K_MIN_PHASE_STAGE_2_TAP_COUNT == MIC_ARRAY_48K_STAGE_2_TAP_COUNT,
+              "Minimum phase stage 2 tap count mismatch");
 inline unsigned stage_2_num_taps(unsigned stg2_dec_factor) {
-    return (stg2_dec_factor == 2) ? MIC_ARRAY_48K_STAGE_2_TAP_COUNT : ((stg2_dec_factor == 3) ? MIC_ARRAY_32K_STAGE_2_TAP_COUNT : STAGE2_TAP_COUNT);
+  switch(stg2_dec_factor){
+    case 1:  return MIC_ARRAY_96K_STAGE_2_TAP_COUNT;
+    case 2:  return MIC_ARRAY_48K_STAGE_2_TAP_COUNT;
+    case 3:  return MIC_ARRAY_32K_STAGE_2_TAP_COUNT;
+    case 4:  return MIC_ARRAY_24K_STAGE_2_TAP_COUNT;
+    case 12: return MIC_ARRAY_8K_STAGE_2_TAP_COUNT;
+    default: return STAGE2_TAP_COUNT;
+  }
+}
+inline int32_t* stage_2_state_memory(SDefaultFilterMem* mem, unsigned stg2_dec_factor, unsigned index) {
+  switch(stg2_dec_factor){
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_96K)
+    case 1:  return (int32_t*)mem->stg2_filter_state_mem[index].filter_state_df_1;
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_48K)
+    case 2:  return (int32_t*)mem->stg2_filter_state_mem[index].filter_state_df_2;
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_32K)
+    case 3:  return (int32_t*)mem->stg2_filter_state_mem[index].filter_state_df_3;
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_24K)
+    case 4:  return (int32_t*)mem->stg2_filter_state_mem[index].filter_state_df_4;
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_16K)
+    case 6:  return (int32_t*)mem->stg2_filter_state_mem[index].filter_state_df_6;
+#endif
+#if DEFAULT_RATE_ENABLED(MIC_ARRAY_RATE_8K)
+    case 12: return (int32_t*)mem->stg2_filter_state_mem[index].filter_state_df_12;
+#endif
+    default: return nullptr;
+  }
 }
-inline int32_t* stage_2_state_memory(unsigned stg2_dec_factor) {
-   return (stg2_dec_factor == 2) ? (int32_t*)stg2_filter_state_mem.filter_state_df_2 \
-            : ((stg2_dec_factor == 3) ? (int32_t*)stg2_filter_state_mem.filter_state_df_3 \
-            : (int32_t*)stg2_filter_state_mem.filter_state_df_6);
+
+// Defined in latency.c
+extern "C" unsigned _mic_array_decimator_latency(const mic_array_decimator_conf_t* decimator_conf,
+                                                 const unsigned samples_per_frame,
+                                                 const unsigned coef_s16);
+
+inline void set_active_decimator_conf(mic_array_instance* inst, const mic_array_decimator_conf_t& decimator_conf, bool coef_s16) {
+  assert(decimator_conf.num_filter_stages <= MIC_ARRAY_CONFIG_MAX_FILTER_STAGES);
+  memcpy(inst->active_filter_conf, decimator_conf.filter_conf,
+         decimator_conf.num_filter_stages * sizeof(mic_array_filter_conf_t));
+  inst->active_decimator_conf.filter_conf = &inst->active_filter_conf[0];
+  inst->active_decimator_conf.num_filter_stages = decimator_conf.num_filter_stages;
+  inst->active_coef_s16 = coef_s16;
 }
 
-inline uint32_t* get_pdm_rx_out_block(unsigned stg2_dec_factor) {
-   return (stg2_dec_factor == 2) ? (uint32_t*)pdm_rx_out_block.out_block_df_2 \
-            : ((stg2_dec_factor == 3) ? (uint32_t*)pdm_rx_out_block.out_block_df_3 \
-            : (uint32_t*)pdm_rx_out_block.out_block_df_6);
+inline void init_pdm_rx_default(SDefaultFilterMem* mem, pdm_rx_conf_t& pdm_rx_config, unsigned words_per_channel) {
+  pdm_rx_config.pdm_out_words_per_channel = words_per_channel;
+  pdm_rx_config.pdm_out_block = (uint32_t*)mem->pdm_rx_out_block.out_block;
+  pdm_rx_config.pdm_in_double_buf = (uint32_t*)mem->pdm_rx_out_block_double_buf.out_block_double_buf;
 }
 
-inline uint32_t* get_pdm_rx_out_block_double_buf(unsigned stg2_dec_factor) {
-   return (stg2_dec_factor == 2) ? (uint32_t*)pdm_rx_out_block_double_buf.out_block_double_buf_df_6 \
-            : ((stg2_dec_factor == 3) ? (uint32_t*)pdm_rx_out_block_double_buf.out_block_double_buf_df_3 \
-            : (uint32_t*)pdm_rx_out_block_double_buf.out_block_double_buf_df_2);
+// Fill in the default filter configuration for a stage 2 decimation factor,
+// with stage 2 state in mem->stg2_filter_state_mem[stg2_state_index].
+inline void default_filter_conf(SDefaultFilterMem* mem, mic_array_filter_conf_t filter_conf[2], unsigned stg2_dec_factor, unsigned stg2_state_index) {
+  //filter stage 1
+  filter_conf[0].coef = (int32_t*)stage_1_filter(stg2_dec_factor);
+  filter_conf[0].num_taps = 256;
+  filter_conf[0].decimation_factor = 32;
+  filter_conf[0].shr = 0;
+  filter_conf[0].state_words_per_channel = filter_conf[0].num_taps/32;
+  filter_conf[0].state = (int32_t*)mem->stg1_filter_state;
+
+  // filter stage 2
+  filter_conf[1].coef = (int32_t*)stage_2_filter(stg2_dec_factor);
+  filter_conf[1].num_taps = stage_2_num_taps(stg2_dec_factor);
+  filter_conf[1].decimation_factor = stg2_dec_factor;
+  filter_conf[1].shr = stage_2_shift(stg2_dec_factor);
+  filter_conf[1].state_words_per_channel = filter_conf[1].num_taps;
+  filter_conf[1].state = stage_2_state_memory(mem, stg2_dec_factor, stg2_state_index);
 }
 
-inline void init_mics_default_filter(TMicArray* m, pdm_rx_resources_t* pdm_res, const unsigned* channel_map, unsigned stg2_dec_factor) {
-  static int32_t stg1_filter_state[MIC_ARRAY_CONFIG_MIC_COUNT][8];
+inline void init_mics_default_filter(mic_array_instance* inst, pdm_rx_resources_t* pdm_res, const unsigned* channel_map, unsigned stg2_dec_factor) {
+  TMicArray* m = inst->mics;
+  SDefaultFilterMem* mem = inst->default_mem;
   mic_array_decimator_conf_t decimator_conf;
   memset(&decimator_conf, 0, sizeof(decimator_conf));
   mic_array_filter_conf_t filter_conf[2] = {{0}};
@@ -100,29 +376,62 @@ inline void init_mics_default_filter(TMicArray* m, pdm_rx_resources_t* pdm_res,
   // decimator
   decimator_conf.filter_conf = &filter_conf[0];
   decimator_conf.num_filter_stages = 2;
+  mem->stg2_filter_state_index = 0;
+  default_filter_conf(mem, filter_conf, stg2_dec_factor, mem->stg2_filter_state_index);
+
+  m->Decimator.Init(decimator_conf);
+  set_active_decimator_conf(inst, decimator_conf, false);
+
+  pdm_rx_conf_t pdm_rx_config;
+  init_pdm_rx_default(mem, pdm_rx_config, stg2_dec_factor);
+
+  m->PdmRx.Init(pdm_res->p_pdm_mics, pdm_rx_config, DEFAULT_MAX_STG2_DEC_FACTOR);
+
+  if(channel_map) {
+      m->PdmRx.MapChannels(channel_map);
+  }
+  int divide = pdm_res->mclk_freq / pdm_res->pdm_freq;
+  mic_array_resources_configure(pdm_res, divide);
+  mic_array_pdm_clock_start(pdm_res);
+}
+
+#if DEFAULT_USE_3STG_8K
+// Initialise the low MIPS 8 kHz preset, a 3 stage decimator with a stage 2
+// decimation factor of 2 and a stage 3 decimation factor of 6.
+inline void init_mics_default_8k_3stg_filter(mic_array_instance* inst, pdm_rx_resources_t* pdm_res, const unsigned* channel_map) {
+  TMicArray_3stg_decimator* m = inst->mics_3stg;
+  SDefaultFilterMem* mem = inst->default_mem;
+  mic_array_filter_conf_t filter_conf[3] = {{0}};
+
   //filter stage 1
-  filter_conf[0].coef = (int32_t*)stage_1_filter(stg2_dec_factor);
+  filter_conf[0].coef = (int32_t*)stage1_coef;
   filter_conf[0].num_taps = 256;
   filter_conf[0].decimation_factor = 32;
-  filter_conf[0].shr = 0;
   filter_conf[0].state_words_per_channel = filter_conf[0].num_taps/32;
-  filter_conf[0].state = (int32_t*)stg1_filter_state;
+  filter_conf[0].state = (int32_t*)mem->stg1_filter_state;
 
   // filter stage 2
-  filter_conf[1].coef = (int32_t*)stage_2_filter(stg2_dec_factor);
-  filter_conf[1].num_taps = stage_2_num_taps(stg2_dec_factor);
-  filter_conf[1].decimation_factor = stg2_dec_factor;
-  filter_conf[1].shr = stage_2_shift(stg2_dec_factor);
-  filter_conf[1].state_words_per_channel = decimator_conf.filter_conf[1].num_taps;
-  filter_conf[1].state = stage_2_state_memory(stg2_dec_factor);
+  filter_conf[1].coef = stage2_8k_3stg_coefs;
+  filter_conf[1].num_taps = MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT;
+  filter_conf[1].decimation_factor = 2;
+  filter_conf[1].shr = stage2_8k_3stg_shift;
+  filter_conf[1].state_words_per_channel = filter_conf[1].num_taps;
+  filter_conf[1].state = (int32_t*)mem->stg2_filter_state_mem[0].filter_state_8k_3stg.stg2;
 
+  // filter stage 3
+  filter_conf[2].coef = stage3_8k_3stg_coefs;
+  filter_conf[2].num_taps = MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT;
+  filter_conf[2].decimation_factor = 6;
+  filter_conf[2].shr = stage3_8k_3stg_shift;
+  filter_conf[2].state_words_per_channel = filter_conf[2].num_taps;
+  filter_conf[2].state = (int32_t*)mem->stg2_filter_state_mem[0].filter_state_8k_3stg.stg3;
+
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 3 };
   m->Decimator.Init(decimator_conf);
+  set_active_decimator_conf(inst, decimator_conf, false);
 
   pdm_rx_conf_t pdm_rx_config;
-  pdm_rx_config.pdm_out_words_per_channel = stg2_dec_factor;
-  pdm_rx_config.pdm_out_block = get_pdm_rx_out_block(stg2_dec_factor);
-  pdm_rx_config.pdm_in_double_buf = get_pdm_rx_out_block_double_buf(stg2_dec_factor);
-
+  init_pdm_rx_default(mem, pdm_rx_config, filter_conf[1].decimation_factor * filter_conf[2].decimation_factor);
 
   m->PdmRx.Init(pdm_res->p_pdm_mics, pdm_rx_config);
 
@@ -133,3 +442,4 @@ inline void init_mics_default_filter(TMicArray* m, pdm_rx_resources_t* pdm_res,
   mic_array_resources_configure(pdm_res, divide);
   mic_array_pdm_clock_start(pdm_res);
 }
+#endif // DEFAULT_USE_3STG_8K
@@ -15,7 +15,7 @@ This script loads a pickled filter design and emits:
 - Stage-2 macros/arrays (from stage2.py)
 
 Usage:
-  python combined.py <coef_pkl_file> -fp <prefix> [-fd <out_dir>]
+  python combined.py <coef_pkl_file> -fp <prefix> [-fd <out_dir>] [--s16] [--stage1-bits <bits>]
 
 If -fp is provided, the header <out_dir>/<prefix>.h is written and also echoed
 to stdout. If -fp is omitted, content is printed to stdout only.
@@ -33,9 +33,9 @@ if __name__ == "__main__":
     out_path.parent.mkdir(parents=True, exist_ok=True)
     with open(out_path, "w") as f:
       header_utils.print_header(args, [sys.stdout, f])
-      stage1.main(args.coef_pkl_file, prefix=args.file_prefix, outstreams=[sys.stdout, f])
-      num_fir_stages = stage2.main(args.coef_pkl_file, prefix=args.file_prefix, outstreams=[sys.stdout, f])
+      stage1.main(args.coef_pkl_file, prefix=args.file_prefix, outstreams=[sys.stdout, f], coef_bits=args.stage1_bits)
+      num_fir_stages = stage2.main(args.coef_pkl_file, prefix=args.file_prefix, outstreams=[sys.stdout, f], s16=args.s16)
       header_utils.print_footer([sys.stdout, f], num_filter_stages=num_fir_stages+1)
   else:
-    stage1.main(args.coef_pkl_file, outstreams=[sys.stdout])
-    num_fir_stages = stage2.main(args.coef_pkl_file, outstreams=[sys.stdout])
+    stage1.main(args.coef_pkl_file, outstreams=[sys.stdout], coef_bits=args.stage1_bits)
+    num_fir_stages = stage2.main(args.coef_pkl_file, outstreams=[sys.stdout], s16=args.s16)
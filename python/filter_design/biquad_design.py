@@ -0,0 +1,163 @@
+# Copyright 2026 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+"""
+Design helpers for mic_array::BiquadCascadeSampleFilter.
+
+Each biquad section is represented as a list of normalised floating point
+coefficients [b0, b1, b2, a1, a2] (with a0 = 1). A cascade is a list of
+sections. ``to_q30`` converts a cascade into the integer format expected by
+BiquadCascadeSampleFilter, {b0, b1, b2, -a1, -a2} in Q2.30, and ``to_c_array``
+formats it as a C array initialiser.
+
+Running this file prints an example cascade: a 2nd order Butterworth
+high-pass filter at 100 Hz followed by a +3 dB presence peak at 3 kHz, for a
+16 kHz output rate.
+"""
+
+import argparse
+
+import numpy as np
+import scipy.signal as spsig
+
+
+Q30 = 2**30
+
+
+def _rbj_common(fc, fs, q):
+    w0 = 2 * np.pi * fc / fs
+    alpha = np.sin(w0) / (2 * q)
+    return w0, alpha
+
+
+def _normalise(b, a):
+    b = np.asarray(b, dtype=float) / a[0]
+    a = np.asarray(a, dtype=float) / a[0]
+    return [b[0], b[1], b[2], a[1], a[2]]
+
+
+def highpass(fc, fs, q=1/np.sqrt(2)):
+    """2nd order high-pass section (RBJ cookbook)."""
+    w0, alpha = _rbj_common(fc, fs, q)
+    cw = np.cos(w0)
+    b = [(1 + cw) / 2, -(1 + cw), (1 + cw) / 2]
+    a = [1 + alpha, -2 * cw, 1 - alpha]
+    return _normalise(b, a)
+
+
+def lowpass(fc, fs, q=1/np.sqrt(2)):
+    """2nd order low-pass section (RBJ cookbook)."""
+    w0, alpha = _rbj_common(fc, fs, q)
+    cw = np.cos(w0)
+    b = [(1 - cw) / 2, 1 - cw, (1 - cw) / 2]
+    a = [1 + alpha, -2 * cw, 1 - alpha]
+    return _normalise(b, a)
+
+
+def peaking(fc, fs, gain_db, q=1/np.sqrt(2)):
+    """Peaking EQ section (RBJ cookbook)."""
+    w0, alpha = _rbj_common(fc, fs, q)
+    A = 10**(gain_db / 40)
+    cw = np.cos(w0)
+    b = [1 + alpha * A, -2 * cw, 1 - alpha * A]
+    a = [1 + alpha / A, -2 * cw, 1 - alpha / A]
+    return _normalise(b, a)
+
+
+def lowshelf(fc, fs, gain_db, q=1/np.sqrt(2)):
+    """Low shelf section (RBJ cookbook)."""
+    w0, alpha = _rbj_common(fc, fs, q)
+    A = 10**(gain_db / 40)
+    cw = np.cos(w0)
+    sa = 2 * np.sqrt(A) * alpha
+    b = [A * ((A + 1) - (A - 1) * cw + sa),
+         2 * A * ((A - 1) - (A + 1) * cw),
+         A * ((A + 1) - (A - 1) * cw - sa)]
+    a = [(A + 1) + (A - 1) * cw + sa,
+         -2 * ((A - 1) + (A + 1) * cw),
+         (A + 1) + (A - 1) * cw - sa]
+    return _normalise(b, a)
+
+
+def highshelf(fc, fs, gain_db, q=1/np.sqrt(2)):
+    """High shelf section (RBJ cookbook)."""
+    w0, alpha = _rbj_common(fc, fs, q)
+    A = 10**(gain_db / 40)
+    cw = np.cos(w0)
+    sa = 2 * np.sqrt(A) * alpha
+    b = [A * ((A + 1) + (A - 1) * cw + sa),
+         -2 * A * ((A - 1) + (A + 1) * cw),
+         A * ((A + 1) + (A - 1) * cw - sa)]
+    a = [(A + 1) - (A - 1) * cw + sa,
+         2 * ((A - 1) - (A + 1) * cw),
+         (A + 1) - (A - 1) * cw - sa]
+    return _normalise(b, a)
+
+
+def butterworth(order, fc, fs, btype="highpass"):
+    """Butterworth filter of any order, as a cascade of biquad sections."""
+    sos = spsig.butter(order, fc, btype=btype, fs=fs, output="sos")
+    return [[s[0], s[1], s[2], s[4], s[5]] for s in sos]
+
+
+def to_q30(cascade):
+    """
+    Convert a cascade to BiquadCascadeSampleFilter's integer format.
+
+    Returns a list of [b0, b1, b2, -a1, -a2] per section, in Q2.30. Raises
+    ValueError if a coefficient is outside the Q2.30 range [-2, 2).
+    """
+    out = []
+    for b0, b1, b2, a1, a2 in cascade:
+        sec = np.round(np.array([b0, b1, b2, -a1, -a2]) * Q30)
+        if np.any(sec >= 2 * Q30) or np.any(sec < -2 * Q30):
+            raise ValueError("biquad coefficient outside Q2.30 range: %s"
+                             % str(sec / Q30))
+        out.append([int(c) for c in sec])
+    return out
+
+
+def response(cascade, fs, n_points=1024):
+    """Frequency response (Hz, complex) of a floating point cascade."""
+    sos = np.array([[b0, b1, b2, 1.0, a1, a2] for b0, b1, b2, a1, a2 in cascade])
+    return spsig.sosfreqz(sos, worN=n_points, fs=fs)
+
+
+def q30_response(q30_cascade, fs, n_points=1024):
+    """Frequency response (Hz, complex) of a quantised cascade."""
+    cascade = [[b0 / Q30, b1 / Q30, b2 / Q30, -na1 / Q30, -na2 / Q30]
+               for b0, b1, b2, na1, na2 in q30_cascade]
+    return response(cascade, fs, n_points)
+
+
+def to_c_array(name, q30_cascade):
+    """Format a quantised cascade as a C array initialiser."""
+    lines = ["const int32_t %s[%d][5] = {" % (name, len(q30_cascade))]
+    for sec in q30_cascade:
+        lines.append("  { " + ", ".join("%d" % c for c in sec) + " },")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--fs", type=float, default=16000, help="output sample rate (Hz)")
+    parser.add_argument("--hpf", type=float, default=100, help="high-pass cutoff (Hz)")
+    parser.add_argument("--hpf-order", type=int, default=2, help="high-pass filter order")
+    parser.add_argument("--name", default="mic_biquad_coef", help="C array name")
+    args = parser.parse_args()
+
+    cascade = butterworth(args.hpf_order, args.hpf, args.fs)
+    cascade.append(peaking(3000, args.fs, 3.0, q=1.0))
+
+    q30 = to_q30(cascade)
+    print(to_c_array(args.name, q30))
+
+    f, h = q30_response(q30, args.fs)
+    f_ref, h_ref = response(cascade, args.fs)
+    err_db = np.max(np.abs(20 * np.log10(np.abs(h[1:]) / np.abs(h_ref[1:]))))
+    print("// Max quantisation error: %.2e dB" % err_db)
+
+
+if __name__ == "__main__":
+    main()
@@ -38,7 +38,7 @@ class stage_params(object):
 
 
 def design_2_stage(fs_0, decimations, ma_stages, stage_2: stage_params, int_coeffs=False,
-                   compensate_s1=True):
+                   compensate_s1=True, min_phase=False):
     """
     Design a 2 stage decimation filter.
 
@@ -57,6 +57,10 @@ def design_2_stage(fs_0, decimations, ma_stages, stage_2: stage_params, int_coef
     compensate_s1 : bool
         If True, stage 2 will compensate for any frequency response change in
         previous stages.
+    min_phase : bool
+        If True, stage 2 is converted to a minimum phase filter with the same
+        magnitude response. This reduces the group delay at the cost of a
+        non-linear phase response.
 
     Returns
     -------
@@ -92,6 +96,9 @@ def design_2_stage(fs_0, decimations, ma_stages, stage_2: stage_params, int_coef
     gains = np.concatenate((gains, np.zeros(2)))
     coeff_2 = spsig.firwin2(stage_2.taps, freqs, gains, window=stage_2.fir_window, fs=fses[1])
 
+    if min_phase:
+        coeff_2 = spsig.minimum_phase(coeff_2, method='homomorphic', half=False)
+
     if int_coeffs:
         coeff_2 = ft.float_coeffs_to_int32(coeff_2)
 
@@ -173,8 +180,10 @@ def design_3_stage(fs_0, decimations, ma_stages, stage_2: stage_params, stage_3:
     # add stopband filter points, design filter using windowed FIR method
     freqs = np.concatenate((freqs, np.array((stage_3.cutoff + stage_3.transition_bw/2, 0.5*fses[2]))))
     gains = np.concatenate((gains, np.zeros(2)))
+    # the combined response may be extended precision, which firwin2 rejects
+    freqs_float64 = freqs.astype(np.float64, copy=True)
     gains_float64 = gains.astype(np.float64, copy=True)
-    coeff_3 = spsig.firwin2(stage_3.taps, freqs, gains_float64, window=stage_3.fir_window, fs=fses[2])
+    coeff_3 = spsig.firwin2(stage_3.taps, freqs_float64, gains_float64, window=stage_3.fir_window, fs=fses[2])
 
     if int_coeffs:
         coeff_2 = ft.float_coeffs_to_int32(coeff_2)
@@ -358,6 +367,272 @@ def small_48k_filter(int_coeffs: bool):
     return coeffs
 
 
+def good_8k_filter(int_coeffs: bool):
+    """
+    Design a 2 stage decimation filter for 3.072 Mhz to 8 kHz for narrowband
+    telephony
+
+    This is the 16 kHz filter with the stage 2 decimation factor doubled. The
+    stage 2 filter is longer than the 16 kHz one, but is only evaluated at
+    8 kHz. The passband extends to 3.5 kHz.
+
+    If int_coeffs is True, integer filter coefficients are returned.
+    Otherwise, float coefficients are returned
+    """
+
+    # sample rates and decimations
+    fs_0 = 3072000
+    decimations = [32, 12]
+
+    # stage 1 parameters
+    ma_stages = 4
+
+    # stage 2 parameters
+    cutoff = 3900
+    transition_bandwidth = 0
+    taps_2 = 384
+    fir_window = ("kaiser", 7)
+    stage_2 = stage_params(cutoff, transition_bandwidth, taps_2, fir_window)
+
+    coeffs = design_2_stage(fs_0, decimations, ma_stages, stage_2, int_coeffs=int_coeffs)
+
+    return coeffs
+
+
+def good_8k_3_stage_filter(int_coeffs: bool):
+    """
+    Design a 3 stage decimation filter for 3.072 Mhz to 8 kHz with a low MIPS
+    cost
+
+    A short half band filter decimates to 48 kHz, so the final stage only
+    needs half the taps of the 2 stage 8 kHz filter for better alias
+    rejection.
+
+    If int_coeffs is True, integer filter coefficients are returned.
+    Otherwise, float coefficients are returned
+    """
+
+    # sample rates and decimations
+    fs_0 = 3072000
+    decimations = [32, 2, 6]
+
+    # stage 1 parameters
+    ma_stages = 4
+
+    # stage 2 parameters
+    cutoff = 16000
+    transition_bandwidth = 0
+    taps_2 = 19
+    fir_window = ("kaiser", 5)
+    stage_2 = stage_params(cutoff, transition_bandwidth, taps_2, fir_window)
+
+    # stage 3 parameters
+    cutoff = 3875
+    transition_bandwidth = 250
+    taps_3 = 192
+    fir_window = ("kaiser", 6)
+    stage_3 = stage_params(cutoff, transition_bandwidth, taps_3, fir_window)
+
+    coeffs = design_3_stage(fs_0, decimations, ma_stages, stage_2, stage_3, int_coeffs=int_coeffs)
+
+    return coeffs
+
+
+def good_24k_filter(int_coeffs: bool):
+    """
+    Design a 2 stage decimation filter for 3.072 Mhz to 24 kHz for wideband
+    speech
+
+    As for the 32 kHz filter, stage 1 has 5 moving average stages. The
+    passband extends to 10 kHz.
+
+    If int_coeffs is True, integer filter coefficients are returned.
+    Otherwise, float coefficients are returned
+    """
+
+    # sample rates and decimations
+    fs_0 = 3072000
+    decimations = [32, 4]
+
+    # stage 1 parameters
+    ma_stages = 5
+
+    # stage 2 parameters
+    cutoff = 10750
+    transition_bandwidth = 1500
+    taps_2 = 128
+    fir_window = ("kaiser", 6.5)
+    stage_2 = stage_params(cutoff, transition_bandwidth, taps_2, fir_window)
+
+    coeffs = design_2_stage(fs_0, decimations, ma_stages, stage_2, int_coeffs=int_coeffs)
+
+    return coeffs
+
+
+def good_96k_filter(int_coeffs: bool):
+    """
+    Design a 2 stage decimation filter for 3.072 Mhz to 96 kHz for ultrasonic
+    applications
+
+    Stage 2 does not decimate, so all alias rejection comes from stage 1,
+    which has 7 moving average stages to suppress the PDM noise that would
+    fold into the audio band. Stage 2 is a short filter which compensates for
+    the stage 1 rolloff up to 36 kHz. Alias rejection is around 32 dB at the
+    passband edge, rising to 80 dB for aliases below 20 kHz.
+
+    If int_coeffs is True, integer filter coefficients are returned.
+    Otherwise, float coefficients are returned
+    """
+
+    # sample rates and decimations
+    fs_0 = 3072000
+    decimations = [32, 1]
+
+    # stage 1 parameters
+    ma_stages = 7
+
+    # stage 2 parameters
+    cutoff = 40000
+    transition_bandwidth = 8000
+    taps_2 = 48
+    fir_window = ("kaiser", 5)
+    stage_2 = stage_params(cutoff, transition_bandwidth, taps_2, fir_window)
+
+    coeffs = design_2_stage(fs_0, decimations, ma_stages, stage_2, int_coeffs=int_coeffs)
+
+    return coeffs
+
+
+def min_phase_16k_filter(int_coeffs: bool):
+    """
+    Design a low latency 2 stage decimation filter for 3.072 Mhz to 16 kHz
+
+    This is good_2_stage_filter with a minimum phase stage 2. The magnitude
+    response is unchanged, but the stage 2 group delay at low frequencies is
+    reduced from 127.5 to around 13 stage 2 input samples, at the cost of a
+    non-linear phase response.
+
+    If int_coeffs is True, integer filter coefficients are returned.
+    Otherwise, float coefficients are returned
+    """
+
+    # sample rates and decimations
+    fs_0 = 3072000
+    decimations = [32, 6]
+
+    # stage 1 parameters
+    ma_stages = 4
+
+    # stage 2 parameters
+    cutoff = 7800
+    transition_bandwidth = 0
+    taps_2 = 256
+    fir_window = ("kaiser", 8)
+    stage_2 = stage_params(cutoff, transition_bandwidth, taps_2, fir_window)
+
+    coeffs = design_2_stage(fs_0, decimations, ma_stages, stage_2, int_coeffs=int_coeffs,
+                            min_phase=True)
+
+    return coeffs
+
+
+def min_phase_32k_filter(int_coeffs: bool):
+    """
+    Design a low latency 2 stage decimation filter for 3.072 Mhz to 32 kHz
+
+    This is good_32k_filter with a minimum phase stage 2, which reduces the
+    stage 2 group delay at low frequencies from 47.5 to around 6 stage 2 input
+    samples.
+
+    If int_coeffs is True, integer filter coefficients are returned.
+    Otherwise, float coefficients are returned
+    """
+
+    # sample rates and decimations
+    fs_0 = 3072000
+    decimations = [32, 3]
+
+    # stage 1 parameters
+    ma_stages = 5
+
+    # stage 2 parameters
+    cutoff = 14500
+    transition_bandwidth = 1000
+    taps_2 = 96
+    fir_window = ("kaiser", 6.5)
+    stage_2 = stage_params(cutoff, transition_bandwidth, taps_2, fir_window)
+
+    coeffs = design_2_stage(fs_0, decimations, ma_stages, stage_2, int_coeffs=int_coeffs,
+                            min_phase=True)
+
+    return coeffs
+
+
+def min_phase_48k_filter(int_coeffs: bool):
+    """
+    Design a low latency 2 stage decimation filter for 3.072 Mhz to 48 kHz
+
+    This is good_48k_filter with a minimum phase stage 2, which reduces the
+    stage 2 group delay at low frequencies from 47.5 to around 4 stage 2 input
+    samples.
+
+    If int_coeffs is True, integer filter coefficients are returned.
+    Otherwise, float coefficients are returned
+    """
+
+    # sample rates and decimations
+    fs_0 = 3072000
+    decimations = [32, 2]
+
+    # stage 1 parameters
+    ma_stages = 5
+
+    # stage 2 parameters
+    cutoff = 20000
+    transition_bandwidth = 1000
+    taps_2 = 96
+    fir_window = ("kaiser", 6.5)
+    stage_2 = stage_params(cutoff, transition_bandwidth, taps_2, fir_window)
+
+    coeffs = design_2_stage(fs_0, decimations, ma_stages, stage_2, int_coeffs=int_coeffs,
+                            min_phase=True)
+
+    return coeffs
+
+
+def cic_16k_filter(int_coeffs: bool):
+    """
+    Design a CIC and compensation 2 stage decimation filter for 3.072 Mhz to 16 kHz
+
+    Stage 1 is a 4th order CIC filter, the same response as the 4 moving
+    average stages of good_2_stage_filter, to be run by
+    mic_array::CicCompDecimator. Stage 2 is a short filter which compensates
+    for the CIC passband droop, with a wider transition band than
+    good_2_stage_filter.
+
+    If int_coeffs is True, integer filter coefficients are returned.
+    Otherwise, float coefficients are returned
+    """
+
+    # sample rates and decimations
+    fs_0 = 3072000
+    decimations = [32, 6]
+
+    # stage 1 parameters
+    ma_stages = 4
+
+    # stage 2 parameters
+    cutoff = 7250
+    transition_bandwidth = 1500
+    taps_2 = 96
+    fir_window = ("kaiser", 6)
+    stage_2 = stage_params(cutoff, transition_bandwidth, taps_2, fir_window)
+
+    coeffs = design_2_stage(fs_0, decimations, ma_stages, stage_2, int_coeffs=int_coeffs)
+
+    return coeffs
+
+
 def main():
     coeffs = small_2_stage_filter(int_coeffs=True)
     out_path = "small_2_stage_filter_int.pkl"
@@ -386,5 +661,37 @@ def main():
     out_path = "small_48k_filter_int.pkl"
     ft.save_packed_filter(out_path, coeffs)
 
+    coeffs = good_8k_filter(int_coeffs=True)
+    out_path = "good_8k_filter_int.pkl"
+    ft.save_packed_filter(out_path, coeffs)
+
+    coeffs = good_8k_3_stage_filter(int_coeffs=True)
+    out_path = "good_8k_3_stage_filter_int.pkl"
+    ft.save_packed_filter(out_path, coeffs)
+
+    coeffs = good_24k_filter(int_coeffs=True)
+    out_path = "good_24k_filter_int.pkl"
+    ft.save_packed_filter(out_path, coeffs)
+
+    coeffs = good_96k_filter(int_coeffs=True)
+    out_path = "good_96k_filter_int.pkl"
+    ft.save_packed_filter(out_path, coeffs)
+
+    coeffs = min_phase_16k_filter(int_coeffs=True)
+    out_path = "min_phase_16k_filter_int.pkl"
+    ft.save_packed_filter(out_path, coeffs)
+
+    coeffs = min_phase_32k_filter(int_coeffs=True)
+    out_path = "min_phase_32k_filter_int.pkl"
+    ft.save_packed_filter(out_path, coeffs)
+
+    coeffs = min_phase_48k_filter(int_coeffs=True)
+    out_path = "min_phase_48k_filter_int.pkl"
+    ft.save_packed_filter(out_path, coeffs)
+
+    coeffs = cic_16k_filter(int_coeffs=True)
+    out_path = "cic_16k_filter_int.pkl"
+    ft.save_packed_filter(out_path, coeffs)
+
 if __name__ == "__main__":
     main()
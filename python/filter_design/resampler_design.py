@@ -0,0 +1,128 @@
+# Copyright 2026 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+"""
+Design helpers for the rational resampling third stage of
+mic_array::ThreeStageDecimator.
+
+The resampler changes the sample rate of the second stage output by L/M
+(with L <= M). It is a low-pass prototype filter at L times the input rate,
+applied as L polyphase branches of num_taps / L taps. ``design`` returns the
+floating point prototype, ``to_polyphase`` quantises and rearranges it into the
+int32 format expected by ThreeStageDecimator (phase p holds h[p + j*L]), and
+``to_c_header`` formats it as C source with the filter's defines.
+
+Running this file prints a resampler from 48 kHz to 44.1 kHz, i.e. L/M =
+147/160, for a 2 stage filter with a second stage decimation factor of 2.
+"""
+
+import argparse
+from fractions import Fraction
+
+import numpy as np
+import scipy.signal as spsig
+
+
+INT32_MAX = 2**31 - 1
+
+
+def ratio(fs_in, fs_out):
+    """Interpolation and decimation factors (L, M) for fs_in to fs_out."""
+    r = Fraction(int(fs_out), int(fs_in))
+    if r > 1:
+        raise ValueError("the resampler can only lower the sample rate")
+    return r.numerator, r.denominator
+
+
+def design(fs_in, fs_out, taps_per_phase=32, passband=0.9, beta=8.0):
+    """
+    Design a floating point prototype filter for resampling fs_in to fs_out.
+
+    Parameters
+    ----------
+    fs_in, fs_out : int
+        input and output sample rates
+    taps_per_phase : int
+        taps in each of the L polyphase branches, i.e. the filter history in
+        input samples
+    passband : float
+        cutoff, as a fraction of the lower Nyquist frequency
+    beta : float
+        Kaiser window parameter
+
+    Returns
+    -------
+    h : ndarray
+        L * taps_per_phase prototype taps, with a DC gain of L
+    L, M : int
+        interpolation and decimation factors
+    """
+    L, M = ratio(fs_in, fs_out)
+    cutoff = passband * 0.5 * min(fs_in, fs_out)
+    h = spsig.firwin(L * taps_per_phase, cutoff, window=("kaiser", beta), fs=L * fs_in)
+    return L * h, L, M
+
+
+def to_polyphase(h, L):
+    """
+    Quantise a prototype filter and rearrange it into L phases.
+
+    Returns the int32 coefficients, one phase after another, and the output
+    right shift. The shift is the largest for which all coefficients fit in
+    int32, and the filter output is sum(x * coef) >> (30 + shr).
+    """
+    h = np.asarray(h, dtype=float)
+    if len(h) % L:
+        raise ValueError("tap count must be a multiple of L")
+    shr = int(np.floor(np.log2(INT32_MAX / np.max(np.abs(h))))) - 30
+    shr = max(shr, 0)
+    q = np.round(np.ldexp(h, 30 + shr)).astype(np.int64)
+    if np.any(np.abs(q) > INT32_MAX):
+        raise ValueError("resampler coefficient outside int32 range")
+    phases = [q[p::L] for p in range(L)]
+    return [int(c) for phase in phases for c in phase], shr
+
+
+def response(h, fs, n_points=4096):
+    """Frequency response (Hz, complex) of the prototype filter at fs."""
+    return spsig.freqz(h, worN=n_points, fs=fs)
+
+
+def to_c_header(prefix, coef, L, M, shr):
+    """Format the polyphase coefficients as C source with their defines."""
+    lines = [
+        "#define %s_STG3_INTERPOLATION_FACTOR   %d" % (prefix.upper(), L),
+        "#define %s_STG3_DECIMATION_FACTOR      %d" % (prefix.upper(), M),
+        "#define %s_STG3_TAP_COUNT              %d" % (prefix.upper(), len(coef)),
+        "#define %s_STG3_PHASE_TAP_COUNT        %d" % (prefix.upper(), len(coef) // L),
+        "#define %s_STG3_SHR                    %d" % (prefix.upper(), shr),
+        "",
+        "int32_t %s_stg3_coef[%d] = {" % (prefix, len(coef)),
+    ]
+    for i in range(0, len(coef), 4):
+        lines.append(", ".join("0x%08x" % (c & 0xFFFFFFFF) for c in coef[i:i+4]) + ",")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--fs-in", type=int, default=48000, help="second stage output rate (Hz)")
+    parser.add_argument("--fs-out", type=int, default=44100, help="output sample rate (Hz)")
+    parser.add_argument("--taps-per-phase", type=int, default=32, help="taps per polyphase branch")
+    parser.add_argument("--prefix", default="resampler", help="C array and define prefix")
+    args = parser.parse_args()
+
+    h, L, M = design(args.fs_in, args.fs_out, args.taps_per_phase)
+    coef, shr = to_polyphase(h, L)
+    print(to_c_header(args.prefix, coef, L, M, shr))
+
+    # Frequencies above fs_out - cutoff alias into the passband.
+    f, H = response(h / L, L * args.fs_in)
+    cutoff = 0.9 * 0.5 * min(args.fs_in, args.fs_out)
+    stop = f >= min(args.fs_in, args.fs_out) - cutoff
+    print("// Alias attenuation: %.1f dB" % (-20 * np.log10(np.max(np.abs(H[stop])))))
+
+
+if __name__ == "__main__":
+    main()
@@ -24,6 +24,10 @@ def build_parser(prog="filters"):
                    help="Filename prefix; if set, writes <prefix>.h.")
     p.add_argument("--file-dir", "-fd", type=str, default=str(Path.cwd()),
                    help="Directory to create the file. Default cwd.")
+    p.add_argument("--s16", action="store_true",
+                   help="Emit 16-bit coefficients for stages 2 onwards, for MIC_ARRAY_CONFIG_USE_S16_FILTERS.")
+    p.add_argument("--stage1-bits", type=int, default=16, choices=[8, 10, 12, 14, 16],
+                   help="Number of stage 1 coefficient bit-planes. Fewer than 16 gives a lower power, lower precision stage 1 filter.")
     return p
 
 def print_header(args, outstreams=[sys.stdout]):
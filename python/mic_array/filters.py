@@ -24,20 +24,33 @@ class Stage1Filter(object):
   INT16_MAX_COEFFICIENT = 32766
   BLOCK_SIZE = 256
 
-  def __init__(self, coefs: np.ndarray, decimation_factor: int = 32):
+  # Supported numbers of coefficient bit-planes (fir_1xN_bit() on the device)
+  COEF_BITS = (8, 10, 12, 14, 16)
+
+  def __init__(self, coefs: np.ndarray, decimation_factor: int = 32, coef_bits: int = 16):
 
     assert (coefs.ndim == 1), "Stage1Filter coefs must be a single dimensional ndarray"
     assert (len(coefs) % Stage1Filter.BLOCK_SIZE == 0), f"Stage1Filter must have a multiple of 256 coefficients ({len(coefs)})"
     assert (coefs.dtype == np.int16), "Stage1Filter coefs must have dtype np.int16"
+    assert (coef_bits in Stage1Filter.COEF_BITS), f"Stage1Filter coef_bits must be one of {Stage1Filter.COEF_BITS}"
 
     # The decimation factor
     self.dec_factor = decimation_factor
 
-    # The coefficients themselves
-    self.coefs = coefs
+    # The number of coefficient bit-planes
+    self.coef_bits = coef_bits
 
-    # The bipolar {-1,1} filter coefficient representation
-    self.coefs_bipolar = util.int16_vect_to_bipolar_matrix(self.coefs, util.int16_dual)
+    # The bipolar {-1,1} filter coefficient representation. With fewer than 16
+    # bits only the most significant bit-planes are kept, which rounds each
+    # coefficient to the nearest value they can represent.
+    bipolar = util.int16_vect_to_bipolar_matrix(coefs, util.int16_dual)
+    self.coefs_bipolar = bipolar[:,16-coef_bits:]
+
+    # The coefficients themselves
+    if coef_bits == 16:
+      self.coefs = coefs
+    else:
+      self.coefs = ((self.coefs_bipolar @ util.int16_dual[16-coef_bits:]) // 2).astype(np.int16)
 
     # The binary {1,0} filter coefficient representation
     #  (note that the binary matrix is from the bipolar transposed)
@@ -55,6 +68,10 @@ class Stage1Filter(object):
   def BlockCount(self):
     return len(self.coefs) // Stage1Filter.BLOCK_SIZE
 
+  @property
+  def CoefBits(self):
+    return self.coef_bits
+
   @property
   def Coef(self):
     return self.coefs
@@ -94,6 +111,8 @@ class Stage1Filter(object):
     return (res << 8) # stage1 does this on device
 
   def ToXCoreCoefArray(self):
+    # 8 words per block of 256 taps for each of the CoefBits bit-planes, least
+    # significant bit-plane first, as expected by fir_1xN_bit()
 
     B = self.CoefBinary
     B = B.reshape((B.size // 256, 8, 32)).astype(np.uint32)
@@ -114,6 +133,73 @@ class Stage1Filter(object):
 
 
 
+class CicStage1Filter(object):
+  """
+  Model of the CIC first stage of mic_array::CicCompDecimator.
+
+  This is `order` cascaded moving averages of `decimation_factor` samples,
+  with exact integer arithmetic. The output has the same scale as that of a
+  Stage1Filter, a full scale input giving 2**28.
+  """
+
+  def __init__(self, order: int, decimation_factor: int = 32):
+
+    assert (1 <= order <= 5), "CicStage1Filter order must be between 1 and 5"
+    assert (decimation_factor == 32), "CicStage1Filter must have a decimation factor of 32"
+
+    self.order = order
+    self.dec_factor = decimation_factor
+
+    # The impulse response of the cascaded moving averages
+    self.coefs = np.ones(1, dtype=np.int64)
+    for _ in range(order):
+      self.coefs = np.convolve(self.coefs, np.ones(decimation_factor, dtype=np.int64))
+
+  @property
+  def DecimationFactor(self):
+    return self.dec_factor
+
+  @property
+  def Order(self):
+    return self.order
+
+  @property
+  def TapCount(self):
+    return len(self.coefs)
+
+  @property
+  def Coef(self):
+    return self.coefs
+
+  def _pad_input(self, sig_in):
+    if sig_in.ndim == 1:
+      sig_in = sig_in[np.newaxis,:]
+    CHANS,SAMP_IN = sig_in.shape
+    Q = self.DecimationFactor
+    P = self.TapCount - Q
+    S = np.zeros((CHANS, P+SAMP_IN), dtype=sig_in.dtype)
+    S[:,:P] = (2*(np.arange(P) % 2) - 1).astype(sig_in.dtype)
+    S[:,P:] = sig_in
+    return S
+
+  def FilterInt16(self, pdm_signal: np.ndarray) -> np.ndarray:
+    # Same interface as Stage1Filter.FilterInt16(), so that it can be used in
+    # a TwoStageFilter. Each output is for the last TapCount PDM samples.
+    if pdm_signal.ndim == 1:
+      pdm_signal = pdm_signal[np.newaxis,:]
+    CHANS, SAMPS_IN = pdm_signal.shape
+    Q = self.DecimationFactor
+    N_pcm = SAMPS_IN // self.DecimationFactor
+
+    S = self._pad_input(pdm_signal)
+    coefs = self.Coef[:,np.newaxis]
+    res = np.empty((CHANS, N_pcm), dtype=np.int32)
+    for k in range(N_pcm):
+      x = S[:,Q*k:Q*k+self.TapCount].astype(np.int64)
+      res[:,k] = np.matmul(x, coefs).squeeze()
+    return (res << (28 - 5 * self.order))
+
+
 class Stage2Filter(object):
 
   INT32_MAX_COEFFICIENT = (2**31)-1
@@ -203,6 +289,74 @@ class Stage2Filter(object):
     return res
 
 
+class Stage2FilterS16(object):
+  """
+  16-bit version of a Stage2Filter, as run by mic_array::MultiStageDecimatorS16.
+
+  The int32 coefficients are rounded to int16 with as much precision as the
+  32-bit accumulator of filter_fir_s16() allows for a full scale int16 input.
+  The shift is chosen so that the output is that of the Stage2Filter shifted
+  right by 16 bits, given an input which is that of the Stage2Filter shifted
+  right by input_shr bits (STAGE1_SHR for the first PCM stage, or 16 for the
+  following stages).
+  """
+
+  INT16_MAX_COEFFICIENT = (2**15)-1
+  STAGE1_SHR = 14
+
+  def __init__(self, s2_filter: Stage2Filter, input_shr: int = STAGE1_SHR):
+
+    self.s2 = s2_filter
+    self.input_shr = input_shr
+
+    coefs = s2_filter.Coef.astype(np.int64)
+    # Scale the coefficients down by 2**exp, so that they fit in int16 and a
+    # full scale input can't overflow the 32-bit accumulator.
+    max_exp = np.log2(np.max(np.abs(coefs)) / Stage2FilterS16.INT16_MAX_COEFFICIENT)
+    acc_exp = np.log2(np.sum(np.abs(coefs)) * (2**15) / (2**31 - 1))
+    self.exp = int(np.ceil(max(max_exp, acc_exp)))
+    self.coefs = np.round(np.ldexp(coefs, -self.exp)).astype(np.int16)
+
+    # The sum of products of the Stage2Filter is right-shifted by 30 + Shr
+    self.shr = int(30 + s2_filter.Shr + 16 - input_shr - self.exp)
+    assert self.shr >= 0, f"Stage2FilterS16 shift ({self.shr}) must not be negative"
+
+  @property
+  def DecimationFactor(self):
+    return self.s2.DecimationFactor
+
+  @property
+  def TapCount(self):
+    return len(self.coefs)
+
+  @property
+  def Coef(self):
+    return self.coefs
+
+  @property
+  def Shr(self):
+    return self.shr
+
+  def FilterInt16(self, signal_in: np.ndarray) -> np.ndarray:
+    if signal_in.ndim == 1:
+      signal_in = signal_in[np.newaxis,:]
+
+    CHANS, SAMPS_IN = signal_in.shape
+    Q = self.DecimationFactor
+    SAMPS_OUT = SAMPS_IN // self.DecimationFactor
+
+    S = self.s2._pad_input(signal_in.astype(np.int64))
+    res = np.empty((CHANS,SAMPS_OUT), dtype=np.int16)
+    coefs = np.flip(self.Coef.astype(np.int64))[:,np.newaxis]
+
+    for k in range(SAMPS_OUT):
+      x = S[:,Q*k:Q*k+self.TapCount]
+      p = np.matmul(x, coefs)
+      p = np.round(np.ldexp(p, -self.shr))
+      res[:,k] = np.clip(p, -(2**15)+1, (2**15)-1).astype(np.int16).squeeze()
+    return res
+
+
 class TwoStageFilter(object):
 
   def __init__(self, s1_filter: Stage1Filter, s2_filter: Stage2Filter):
@@ -242,6 +396,34 @@ class ThreeStageFilter(object):
     return self.s3.FilterInt32(s2_output)
 
 
+class MultiStageFilterS16(object):
+  """
+  Model of mic_array::MultiStageDecimatorS16, a stage 1 filter followed by any
+  number of 16-bit PCM stages.
+  """
+
+  def __init__(self, s1_filter: Stage1Filter, fir_filters: list):
+    self.s1 = s1_filter
+    self.stages = [Stage2FilterS16(f, Stage2FilterS16.STAGE1_SHR if i == 0 else 16)
+                   for i, f in enumerate(fir_filters)]
+
+  @property
+  def DecimationFactor(self):
+    return self.s1.DecimationFactor * int(np.prod([f.DecimationFactor for f in self.stages]))
+
+  @property
+  def NumStages(self):
+    return 1 + len(self.stages)
+
+  def Filter(self, pdm_signal: np.ndarray) -> np.ndarray:
+    s1_output = self.s1.FilterInt16(pdm_signal).astype(np.int64)
+    shr = Stage2FilterS16.STAGE1_SHR
+    signal = ((s1_output + (1 << (shr - 1))) >> shr).astype(np.int16)
+    for f in self.stages:
+      signal = f.FilterInt16(signal)
+    return signal.astype(np.int32) << 16
+
+
 def load(coef_file: str):
   filters = []
   with open(coef_file, "rb") as pkl_file:
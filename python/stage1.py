@@ -16,7 +16,7 @@ This script loads a .pkl filter file, quantises and formats the stage1 coefficie
 the XCORE DUT expected format and prints the coefficient array and the filter params #defines.
 
 Usage:
-  python stage1.py <coef_pkl_file> -fp <prefix> [-fd <out_dir>]
+  python stage1.py <coef_pkl_file> -fp <prefix> [-fd <out_dir>] [--stage1-bits <bits>]
 
 If -fp is provided, a header <out_dir>/<prefix>.h is written and also echoed
 to stdout. If -fp is omitted, content is printed to stdout only.
@@ -24,11 +24,16 @@ to stdout. If -fp is omitted, content is printed to stdout only.
 Refer to python/README.rst for more details.
 """
 
-def main(coef_pkl_file, prefix="custom_filt", outstreams=[sys.stdout]):
+def main(coef_pkl_file, prefix="custom_filt", outstreams=[sys.stdout], coef_bits=16):
 
   stage_filters = filters.load(coef_pkl_file)
   assert len(stage_filters)
 
+  # requantise to fewer bit-planes if needed
+  if coef_bits != 16:
+    s1 = stage_filters[0]
+    stage_filters[0] = filters.Stage1Filter(s1.Coef, s1.DecimationFactor, coef_bits)
+
   out = header_utils.Tee(*outstreams)
 
   # get the byte array representing the binary matrix
@@ -38,9 +43,10 @@ def main(coef_pkl_file, prefix="custom_filt", outstreams=[sys.stdout]):
   print(f"#define {prefix.upper()}_STG1_DECIMATION_FACTOR   {stage_filters[0].DecimationFactor}", file=out)
   print(f"#define {prefix.upper()}_STG1_TAP_COUNT           {stage_filters[0].TapCount}", file=out)
   print(f"#define {prefix.upper()}_STG1_SHR                 0 /*shr not relevant for stage 1*/", file=out)
+  print(f"#define {prefix.upper()}_STG1_COEF_BITS           {stage_filters[0].CoefBits}", file=out)
 
   print("\n", file=out)
-  words = np.array(["0x%08X" % x for x in s1_coef_words], dtype=str).reshape((16,8))
+  words = np.array(["0x%08X" % x for x in s1_coef_words], dtype=str).reshape((-1,8))
   print(f"uint32_t {prefix}_stg1_coef[{len(s1_coef_words)}] = {{", file=out)
 
   for r in range(words.shape[0]):
@@ -59,8 +65,8 @@ if __name__ == "__main__":
     out_path.parent.mkdir(parents=True, exist_ok=True)
     with open(out_path, "w") as f:
       header_utils.print_header(args, [sys.stdout, f])
-      main(args.coef_pkl_file, prefix=args.file_prefix, outstreams=[sys.stdout, f])
+      main(args.coef_pkl_file, prefix=args.file_prefix, outstreams=[sys.stdout, f], coef_bits=args.stage1_bits)
       header_utils.print_footer([sys.stdout, f])
   else:
-    main(args.coef_pkl_file, outstreams=[sys.stdout])
+    main(args.coef_pkl_file, outstreams=[sys.stdout], coef_bits=args.stage1_bits)
 
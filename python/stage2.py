@@ -16,7 +16,11 @@ This script loads a .pkl filter file, quantises and formats the stage2 coefficie
 the XCORE DUT expected format and prints the coefficient array and the filter params #defines.
 
 Usage:
-  python stage2.py <coef_pkl_file> -fp <prefix> [-fd <out_dir>]
+  python stage2.py <coef_pkl_file> -fp <prefix> [-fd <out_dir>] [--s16]
+
+With --s16, the coefficients are emitted as int16 for
+mic_array::MultiStageDecimatorS16 (MIC_ARRAY_CONFIG_USE_S16_FILTERS), along
+with the number of 32-bit state words needed per channel.
 
 If -fp is provided, a header <out_dir>/<prefix>.h is written and also echoed
 to stdout. If -fp is omitted, content is printed to stdout only.
@@ -24,9 +28,11 @@ to stdout. If -fp is omitted, content is printed to stdout only.
 Refer to python/README.rst for more details and examples.
 """
 
-def main(coef_pkl_file, prefix="custom_filt", outstreams=[sys.stdout]):
+def main(coef_pkl_file, prefix="custom_filt", outstreams=[sys.stdout], s16=False):
 
   stage_filters = filters.load(coef_pkl_file)
+  if s16:
+    stage_filters = [stage_filters[0]] + filters.MultiStageFilterS16(stage_filters[0], stage_filters[1:]).stages
 
   out = header_utils.Tee(*outstreams)
   for i, stage in enumerate(stage_filters):
@@ -36,16 +42,21 @@ def main(coef_pkl_file, prefix="custom_filt", outstreams=[sys.stdout]):
     print(f"#define {prefix.upper()}_STG{i+1}_DECIMATION_FACTOR   {stage.DecimationFactor}", file=out)
     print(f"#define {prefix.upper()}_STG{i+1}_TAP_COUNT           {stage.TapCount}", file=out)
     print(f"#define {prefix.upper()}_STG{i+1}_SHR                 {stage.Shr}", file=out)
+    if s16:
+      print(f"#define {prefix.upper()}_STG{i+1}_STATE_WORDS         {(stage.TapCount + 1) // 2}", file=out)
     num_coefs = len(stage.Coef)
     initial_count = (num_coefs//4) * 4
     print("\n", file=out)
-    print(f"int32_t {prefix}_stg{i+1}_coef[{stage.TapCount}] = {{", file=out)
+    if s16:
+      print(f"int16_t __attribute__((aligned (4))) {prefix}_stg{i+1}_coef[{stage.TapCount}] = {{", file=out)
+    else:
+      print(f"int32_t {prefix}_stg{i+1}_coef[{stage.TapCount}] = {{", file=out)
     for i in range(0,initial_count,4): # print 4 coefs per row
-      s = ", ".join( [hex(x) for x in stage.Coef[i:i+4]] )
+      s = ", ".join( [hex(int(x)) for x in stage.Coef[i:i+4]] )
       print(s,end=',\n', file=out)
 
     if initial_count != num_coefs:
-      print(", ".join( [hex(x) for x in stage.Coef[initial_count:]] ), file=out)
+      print(", ".join( [hex(int(x)) for x in stage.Coef[initial_count:]] ), file=out)
 
     print("};", file=out)
   return len(stage_filters) - 1
@@ -62,7 +73,7 @@ if __name__ == "__main__":
     out_path.parent.mkdir(parents=True, exist_ok=True)
     with open(out_path, "w") as f:
       header_utils.print_header(args, [sys.stdout, f])
-      main(args.coef_pkl_file, prefix=args.file_prefix, outstreams=[sys.stdout, f])
+      main(args.coef_pkl_file, prefix=args.file_prefix, outstreams=[sys.stdout, f], s16=args.s16)
       header_utils.print_footer([sys.stdout, f])
   else:
-    main(args.coef_pkl_file, outstreams=[sys.stdout])
+    main(args.coef_pkl_file, outstreams=[sys.stdout], s16=args.s16)
@@ -77,3 +77,32 @@ class MicArraySharedBase:
       return filters.TwoStageFilter(stg_filters[0], stg_filters[1])
     else:
       return filters.ThreeStageFilter(stg_filters[0], stg_filters[1], stg_filters[2])
+
+  def cic_filter(self, filter_pkl_file):
+    # load a CIC preset from the pkl file. Stage 1 is the moving average
+    # filter that the CIC implements, of (order * 31 + 1) taps.
+    with open(filter_pkl_file, "rb") as f:
+      stages = pickle.load(f)
+    assert len(stages) == 2, f"Invalid number of filter stages: {len(stages)}"
+
+    s1_coef, s1_dec_factor = stages[0]
+    order = (len(s1_coef) - 1) // (s1_dec_factor - 1)
+    s2_coef, s2_dec_factor = stages[1]
+
+    return filters.TwoStageFilter(filters.CicStage1Filter(order, s1_dec_factor),
+                                  filters.Stage2Filter(s2_coef, s2_dec_factor))
+
+  def s16_filter(self, filter_pkl_file):
+    # load a filter from the pkl file, as run with 16-bit stages 2 onwards by
+    # mic_array::MultiStageDecimatorS16.
+    stg_filters = filters.load(filter_pkl_file)
+    return filters.MultiStageFilterS16(stg_filters[0], stg_filters[1:])
+
+  def stage1_bits_filter(self, filter_pkl_file, coef_bits):
+    # load a two stage filter from the pkl file, with the stage 1 coefficients
+    # rounded to coef_bits bit-planes, as for fir_1xN_bit().
+    stg_filters = filters.load(filter_pkl_file)
+    assert len(stg_filters) == 2, f"Invalid number of filter stages: {len(stg_filters)}"
+    s1 = stg_filters[0]
+    s1_reduced = filters.Stage1Filter(s1.Coef, s1.DecimationFactor, coef_bits)
+    return filters.TwoStageFilter(s1_reduced, stg_filters[1])
@@ -226,6 +226,7 @@ static void init_mic_conf(mic_array_conf_t *mic_array_conf, mic_array_filter_con
   static int32_t stg1_filter_state[MIC_ARRAY_CONFIG_MIC_COUNT][8];
   static int32_t stg2_filter_state[MIC_ARRAY_CONFIG_MIC_COUNT][CUSTOM_FILTER_STG2_TAP_COUNT];
   memset(mic_array_conf, 0, sizeof(mic_array_conf_t));
+  memset(filter_conf, 0, NUM_DECIMATION_STAGES * sizeof(mic_array_filter_conf_t));
 
   //decimator
   mic_array_conf->decimator_conf.filter_conf = &filter_conf[0];
@@ -146,3 +146,93 @@ class Test_BasicMicArray(MicArraySharedBase):
         print(f"result_diff = {result_diff}")
         assert result_diff <= threshold, f"max diff between python and xcore mic array output ({result_diff}) exceeds threshold ({threshold})"
 
+  @pytest.mark.parametrize("freq_hz", [300, 6000])
+  def test_thdn_cic(self, freq_hz):
+    # THD+N of the python model of the 16 kHz CIC preset, as run by
+    # mic_array::CicCompDecimator. The preset has a wider transition band than
+    # the default 16 kHz filter, so tones are limited to its 6 kHz passband.
+    # The threshold is only a sanity check; the measured value is printed.
+    fs = 16000
+    duration_s = 7
+    thdn_threshold = -100.0
+
+    filter = self.cic_filter(Path(__file__).parent / "cic_16k_filter_int.pkl")
+    assert int(3.072e6 / filter.DecimationFactor) == fs
+
+    sig_sine_pdm, sig_sine_pcm = PdmSignal.sine([freq_hz], [0.52], fs, duration_s)
+    expected = filter.Filter(sig_sine_pdm.signal)
+    expected_output_float = expected.astype(np.float64)/np.iinfo(expected.dtype).max
+
+    input_thdn = THDN(sig_sine_pcm[0], fs, fund_freq=freq_hz)
+    python_output_thdn = THDN(expected_output_float[0], fs, fund_freq=freq_hz)
+    print(f"CIC preset python_output_thdn = {python_output_thdn}, input_thdn = {input_thdn}")
+    assert python_output_thdn < thdn_threshold, f"At freq {freq_hz}, CIC preset python output THDN {python_output_thdn} exceeds threshold {thdn_threshold}"
+
+  @pytest.mark.parametrize("fs", [16000, 32000, 48000])
+  def test_thdn_s16(self, fs):
+    # THD+N of the python models of the default filters with 32-bit and 16-bit
+    # stage 2 filters (MIC_ARRAY_CONFIG_USE_S16_FILTERS), and the idle noise
+    # floor of each. The 16-bit filters trade precision for half the memory,
+    # so the threshold only checks that the loss is bounded; the measured
+    # values are printed for comparison.
+    duration_s = 7
+    freq_hz = {16000: [300, 7000], 32000: [300, 14000], 48000: [300, 20000]}
+    thdn_threshold = -80.0
+
+    filter_pkl = self.get_default_filter(fs)
+    filter32 = self.filter(filter_pkl)
+    filter16 = self.s16_filter(filter_pkl)
+
+    sig_sine_pdm, sig_sine_pcm = PdmSignal.sine(freq_hz[fs], [0.52]*len(freq_hz[fs]), fs, duration_s)
+    output32 = filter32.Filter(sig_sine_pdm.signal).astype(np.float64)/np.iinfo(np.int32).max
+    output16 = filter16.Filter(sig_sine_pdm.signal).astype(np.float64)/np.iinfo(np.int32).max
+
+    for i in range(len(freq_hz[fs])):
+      thdn32 = THDN(output32[i], fs, fund_freq=freq_hz[fs][i])
+      thdn16 = THDN(output16[i], fs, fund_freq=freq_hz[fs][i])
+      print(f"At {freq_hz[fs][i]} Hz, s32 python_output_thdn = {thdn32}, s16 python_output_thdn = {thdn16}")
+      assert thdn16 < thdn_threshold, f"At sampling rate {fs}, freq {freq_hz[fs][i]}, s16 python output THDN {thdn16} exceeds threshold {thdn_threshold}"
+
+    # Idle noise floor, from a zero signal
+    sig_zero_pdm, _ = PdmSignal.sine([freq_hz[fs][0]], [0.0], fs, 1)
+    noise32 = filter32.Filter(sig_zero_pdm.signal).astype(np.float64)/np.iinfo(np.int32).max
+    noise16 = filter16.Filter(sig_zero_pdm.signal).astype(np.float64)/np.iinfo(np.int32).max
+    skip = fs // 10
+    floor32 = 20 * np.log10(np.std(noise32[0][skip:]) + 1e-12)
+    floor16 = 20 * np.log10(np.std(noise16[0][skip:]) + 1e-12)
+    print(f"Idle noise floor: s32 {floor32} dBFS, s16 {floor16} dBFS")
+    assert floor16 < -90.0, f"s16 idle noise floor {floor16} dBFS exceeds -90 dBFS (s32 {floor32} dBFS)"
+
+  @pytest.mark.parametrize("coef_bits", [8, 10, 12])
+  def test_thdn_stage1_bits(self, coef_bits):
+    # THD+N and idle noise floor of the python model of the default 16 kHz
+    # filters with the stage 1 coefficients rounded to fewer bit-planes, for
+    # the low-power fir_1x8_bit() family of stage 1 filters. Rounding raises
+    # the stage 1 stopband, so the thresholds depend on coef_bits; the
+    # measured values are printed for comparison with the 16-bit filter.
+    fs = 16000
+    duration_s = 7
+    freq_hz = 300
+    thdn_threshold = {8: -55.0, 10: -65.0, 12: -75.0}[coef_bits]
+
+    filter_pkl = self.get_default_filter(fs)
+    filter16 = self.filter(filter_pkl)
+    filter_n = self.stage1_bits_filter(filter_pkl, coef_bits)
+
+    sig_sine_pdm, sig_sine_pcm = PdmSignal.sine([freq_hz], [0.52], fs, duration_s)
+    output16 = filter16.Filter(sig_sine_pdm.signal).astype(np.float64)/np.iinfo(np.int32).max
+    output_n = filter_n.Filter(sig_sine_pdm.signal).astype(np.float64)/np.iinfo(np.int32).max
+
+    thdn16 = THDN(output16[0], fs, fund_freq=freq_hz)
+    thdn_n = THDN(output_n[0], fs, fund_freq=freq_hz)
+    print(f"16-bit stage 1 python_output_thdn = {thdn16}, {coef_bits}-bit stage 1 python_output_thdn = {thdn_n}")
+    assert thdn_n < thdn_threshold, f"{coef_bits}-bit stage 1 python output THDN {thdn_n} exceeds threshold {thdn_threshold}"
+
+    # Idle noise floor, from a zero signal
+    sig_zero_pdm, _ = PdmSignal.sine([freq_hz], [0.0], fs, 1)
+    noise16 = filter16.Filter(sig_zero_pdm.signal).astype(np.float64)/np.iinfo(np.int32).max
+    noise_n = filter_n.Filter(sig_zero_pdm.signal).astype(np.float64)/np.iinfo(np.int32).max
+    skip = fs // 10
+    floor16 = 20 * np.log10(np.std(noise16[0][skip:]) + 1e-12)
+    floor_n = 20 * np.log10(np.std(noise_n[0][skip:]) + 1e-12)
+    print(f"Idle noise floor: 16-bit stage 1 {floor16} dBFS, {coef_bits}-bit stage 1 {floor_n} dBFS")
@@ -79,6 +79,7 @@ void process_signal(chanend_t c_from_host)
   mic_array_filter_conf_t filter_conf[2];
 
   memset(&decimator_conf, 0, sizeof(decimator_conf));
+  memset(filter_conf, 0, sizeof(filter_conf));
 
   decimator_conf.filter_conf = &filter_conf[0];
   decimator_conf.num_filter_stages = 2;
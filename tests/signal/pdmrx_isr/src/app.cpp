@@ -39,6 +39,46 @@ void app_pdm_rx_isr_setup(
 
 }
 
+// A second service on the same thread as my_pdm_rx, with its own ISR context.
+TPdmRxService other_pdm_rx;
+
+// Check that the ISRs of two services on the same thread each fill only the
+// blocks of their own service. c is the channel feeding my_pdm_rx.
+void test_two_services(chanend_t c)
+{
+  static uint32_t pdmrx_out_block[1][MY_STAGE2_DEC_FACTOR];
+  static uint32_t __attribute__((aligned (8))) pdmrx_in_block_double_buf[2][1 * MY_STAGE2_DEC_FACTOR];
+
+  streaming_channel_t c_other = s_chan_alloc();
+
+  pdm_rx_conf_t pdm_rx_config;
+  pdm_rx_config.pdm_out_words_per_channel = MY_STAGE2_DEC_FACTOR;
+  pdm_rx_config.pdm_out_block = (uint32_t*)pdmrx_out_block;
+  pdm_rx_config.pdm_in_double_buf = (uint32_t*)pdmrx_in_block_double_buf;
+
+  other_pdm_rx.Init((port_t)c_other.end_a, pdm_rx_config);
+  other_pdm_rx.AssertOnDroppedBlock(false);
+  other_pdm_rx.InstallISR();
+  other_pdm_rx.UnmaskISR();
+
+  for (int i=0; i<10; i++)
+  {
+    // Only the ISR of the service whose block is being read has credit, so
+    // each word is sent just before reading the block it completes.
+    interrupt_mask_all();
+    s_chan_out_word(c, 0x1000 + i);
+    uint32_t *my_samples = my_pdm_rx.GetPdmBlock();
+
+    interrupt_mask_all();
+    s_chan_out_word(c_other.end_b, 0x2000 + i);
+    uint32_t *other_samples = other_pdm_rx.GetPdmBlock();
+
+    printf("Received blocks %x %x\n", *my_samples, *other_samples);
+    assert(*my_samples == 0x1000 + i && msg("Error: wrong block from first service"));
+    assert(*other_samples == 0x2000 + i && msg("Error: wrong block from second service"));
+  }
+}
+
 void test()
 {
   streaming_channel_t c_pdm;
@@ -94,6 +134,9 @@ void test()
 
     s_chan_out_word(c, frame++);
   }
+
+  test_two_services(c);
+
   printf("PASS\n");
   exit(0);
 }
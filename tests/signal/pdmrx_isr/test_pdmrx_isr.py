@@ -4,7 +4,8 @@
 ######
 # Test: test_pdmrx_isr
 #
-# This test checks that the credit based scheme implemented in PDM RX ISR works
+# This test checks that the credit based scheme implemented in PDM RX ISR works,
+# and that two PDM RX ISRs on the same thread each use their own context
 #
 # Notes:
 #  - This test assumes that the CMake targets for this app are all already
@@ -73,6 +73,7 @@ void app_mic_array_init()
   mic_array_decimator_conf_t decimator_conf;
   mic_array_filter_conf_t filter_conf[2];
   memset(&decimator_conf, 0, sizeof(decimator_conf));
+  memset(filter_conf, 0, sizeof(filter_conf));
 
   decimator_conf.filter_conf = &filter_conf[0];
   decimator_conf.num_filter_stages = 2;
@@ -61,6 +61,7 @@ void init_mic_conf(
     static int32_t stg1_filter_state[MIC_ARRAY_CONFIG_MIC_COUNT][8];
     static int32_t stg2_filter_state[MIC_ARRAY_CONFIG_MIC_COUNT][CUSTOM_FILTER_STG2_TAP_COUNT];
     memset(mic_array_conf, 0, sizeof(mic_array_conf_t));
+    memset(filter_conf, 0, NUM_DECIMATION_STAGES * sizeof(mic_array_filter_conf_t));
 
     // decimator
     mic_array_conf->decimator_conf.filter_conf = &filter_conf[0];
@@ -99,6 +100,44 @@ void init_mic_conf(
     mic_array_conf->pdmrx_conf.pdm_in_double_buf = (uint32_t *)pdmrx_out_block_double_buf;
     mic_array_conf->pdmrx_conf.channel_map = channel_map;
 }
+#elif USE_CIC_FILTER
+
+// 16 kHz CIC preset from filters_default.h
+#define CIC_STG2_DECIMATION_FACTOR (6)
+
+void init_mic_conf(
+    mic_array_conf_t *mic_array_conf,
+    mic_array_filter_conf_t filter_conf[2],
+    unsigned *channel_map)
+{
+    static int32_t stg1_filter_state[MIC_ARRAY_CONFIG_MIC_COUNT][2 * MIC_ARRAY_16K_CIC_ORDER];
+    static int32_t stg2_filter_state[MIC_ARRAY_CONFIG_MIC_COUNT][MIC_ARRAY_16K_CIC_STAGE_2_TAP_COUNT];
+    memset(mic_array_conf, 0, sizeof(mic_array_conf_t));
+    memset(filter_conf, 0, 2 * sizeof(mic_array_filter_conf_t));
+
+    // decimator
+    mic_array_conf->decimator_conf.filter_conf = &filter_conf[0];
+    mic_array_conf->decimator_conf.num_filter_stages = 2;
+    // stage 1
+    filter_conf[0].cic_order = MIC_ARRAY_16K_CIC_ORDER;
+    filter_conf[0].decimation_factor = 32;
+    filter_conf[0].state = (int32_t *)stg1_filter_state;
+    filter_conf[0].state_words_per_channel = 2 * MIC_ARRAY_16K_CIC_ORDER;
+    // stage 2
+    filter_conf[1].coef = stage2_16k_cic_coefs;
+    filter_conf[1].num_taps = MIC_ARRAY_16K_CIC_STAGE_2_TAP_COUNT;
+    filter_conf[1].decimation_factor = CIC_STG2_DECIMATION_FACTOR;
+    filter_conf[1].state = (int32_t *)stg2_filter_state;
+    filter_conf[1].shr = stage2_16k_cic_shift;
+    filter_conf[1].state_words_per_channel = MIC_ARRAY_16K_CIC_STAGE_2_TAP_COUNT;
+    // pdm rx
+    static uint32_t pdmrx_out_block[MIC_ARRAY_CONFIG_MIC_COUNT][CIC_STG2_DECIMATION_FACTOR];
+    static uint32_t __attribute__((aligned(8))) pdmrx_out_block_double_buf[2][MIC_ARRAY_CONFIG_MIC_COUNT * CIC_STG2_DECIMATION_FACTOR];
+    mic_array_conf->pdmrx_conf.pdm_out_words_per_channel = CIC_STG2_DECIMATION_FACTOR;
+    mic_array_conf->pdmrx_conf.pdm_out_block = (uint32_t *)pdmrx_out_block;
+    mic_array_conf->pdmrx_conf.pdm_in_double_buf = (uint32_t *)pdmrx_out_block_double_buf;
+    mic_array_conf->pdmrx_conf.channel_map = channel_map;
+}
 #endif
 
 void mic_array_initialise()
@@ -118,7 +157,12 @@ void mic_array_initialise()
 #endif
 
     // Initialise the mic array
-#if !USE_CUSTOM_FILTER
+#if USE_CIC_FILTER
+    mic_array_conf_t mic_array_conf;
+    mic_array_filter_conf_t filter_conf[2];
+    init_mic_conf(&mic_array_conf, filter_conf, NULL);
+    mic_array_init_custom_filter(&pdm_res, &mic_array_conf);
+#elif !USE_CUSTOM_FILTER
     mic_array_init(&pdm_res, NULL, APP_SAMP_FREQ);
 #else
     mic_array_conf_t mic_array_conf;
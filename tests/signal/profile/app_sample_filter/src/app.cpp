@@ -0,0 +1,141 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <xcore/hwtimer.h>
+
+#include "mic_array.h"
+
+// Measures the cost of applying DCOE followed by a 2-section biquad cascade
+// (a) as separate filter calls, (b) through a hand-written wrapper filter and
+// (c) through SampleFilterChain, both per sample and per frame. The chain is
+// expected to cost no more than the hand-written wrapper.
+
+#define SAMPLE_COUNT    (16)
+#define FRAME_COUNT     (1000)
+
+// 100 Hz high-pass + 3 kHz peak at 16 kHz (python/filter_design/biquad_design.py)
+static const int32_t biquad_coef[2][5] = {
+  { 1044336221, -2088672443, 1044336221, 2087866987, -1015736075 },
+  { 1197720911, -591792233, 348706718, 591792233, -472685805 },
+};
+
+using TDcoe = mic_array::DcoeFrameSampleFilter<APP_N_MICS>;
+using TBiquad = mic_array::BiquadCascadeSampleFilter<APP_N_MICS, 2>;
+using TChain = mic_array::SampleFilterChain<APP_N_MICS, TDcoe, TBiquad>;
+
+class HandFusedFilter
+{
+  public:
+    TDcoe Dcoe;
+    TBiquad Biquad;
+
+    void Filter(int32_t sample[APP_N_MICS])
+    {
+      Dcoe.Filter(sample);
+      Biquad.Filter(sample);
+    }
+
+    void FilterFrame(int32_t frame[APP_N_MICS][SAMPLE_COUNT])
+    {
+      Dcoe.FilterFrame<SAMPLE_COUNT>(frame);
+      Biquad.FilterFrame<SAMPLE_COUNT>(frame);
+    }
+};
+
+static TDcoe dcoe;
+static TBiquad biquad;
+static HandFusedFilter fused;
+static TChain chain;
+
+static int32_t frame[APP_N_MICS][SAMPLE_COUNT];
+
+
+static void fill_frame()
+{
+  for(int k = 0; k < APP_N_MICS; k++)
+    for(int s = 0; s < SAMPLE_COUNT; s++)
+      frame[k][s] = rand() - (RAND_MAX / 2);
+}
+
+// Per-sample calls are made on a copy of each sample, as MicArray does.
+#define MEASURE_PER_SAMPLE(NAME, FILTER_SAMPLE)                     \
+__attribute__((noinline))                                           \
+static uint32_t NAME()                                              \
+{                                                                   \
+  uint32_t total = 0;                                               \
+  for(int f = 0; f < FRAME_COUNT; f++){                             \
+    fill_frame();                                                   \
+    uint32_t t0 = get_reference_time();                             \
+    for(int s = 0; s < SAMPLE_COUNT; s++){                          \
+      int32_t sample[APP_N_MICS];                                   \
+      for(int k = 0; k < APP_N_MICS; k++)                           \
+        sample[k] = frame[k][s];                                    \
+      FILTER_SAMPLE;                                                \
+      for(int k = 0; k < APP_N_MICS; k++)                           \
+        frame[k][s] = sample[k];                                    \
+    }                                                               \
+    total += get_reference_time() - t0;                             \
+  }                                                                 \
+  return total;                                                     \
+}
+
+#define MEASURE_PER_FRAME(NAME, FILTER_FRAME)                       \
+__attribute__((noinline))                                           \
+static uint32_t NAME()                                              \
+{                                                                   \
+  uint32_t total = 0;                                               \
+  for(int f = 0; f < FRAME_COUNT; f++){                             \
+    fill_frame();                                                   \
+    uint32_t t0 = get_reference_time();                             \
+    FILTER_FRAME;                                                   \
+    total += get_reference_time() - t0;                             \
+  }                                                                 \
+  return total;                                                     \
+}
+
+MEASURE_PER_SAMPLE(separate_sample, dcoe.Filter(sample); biquad.Filter(sample))
+MEASURE_PER_SAMPLE(fused_sample,    fused.Filter(sample))
+MEASURE_PER_SAMPLE(chain_sample,    chain.Filter(sample))
+
+MEASURE_PER_FRAME(separate_frame, dcoe.FilterFrame<SAMPLE_COUNT>(frame);
+                                  biquad.FilterFrame<SAMPLE_COUNT>(frame))
+MEASURE_PER_FRAME(fused_frame,    fused.FilterFrame(frame))
+MEASURE_PER_FRAME(chain_frame,    chain.FilterFrame<SAMPLE_COUNT>(frame))
+
+
+static void report(const char* name, uint32_t ticks)
+{
+  // Reference clock is 100 MHz. Report the average per sample time (all
+  // channels) in reference clock ticks.
+  printf("%s: %lu.%02lu ticks/sample\n", name,
+      (unsigned long) (ticks / (FRAME_COUNT * SAMPLE_COUNT)),
+      (unsigned long) ((100 * ticks / (FRAME_COUNT * SAMPLE_COUNT)) % 100));
+}
+
+MA_C_API
+void measure_sample_filters()
+{
+  printf("Running " APP_NAME "..\n");
+
+  dcoe.Init();
+  biquad.Init(biquad_coef);
+  fused.Dcoe.Init();
+  fused.Biquad.Init(biquad_coef);
+  chain.Stage<0>().Init();
+  chain.Stage<1>().Init(biquad_coef);
+
+  srand(1234);
+
+  report("separate_sample", separate_sample());
+  report("fused_sample", fused_sample());
+  report("chain_sample", chain_sample());
+  report("separate_frame", separate_frame());
+  report("fused_frame", fused_frame());
+  report("chain_frame", chain_frame());
+
+  exit(0);
+}
@@ -22,8 +22,14 @@ def write_rst_table(results: dict, outfile: Path):
     Write results dict to an RST list-table.
     cfg key format: '{mics}mic_{pdmrx}_{fs}fs'
     """
+    def sort_key(item):
+        # Order by mic count, PDM RX mode, then numerically by sample rate
+        parts = item[0].split('_')
+        fs_digits = re.match(r"\d+", parts[-1])
+        return (parts[:-1], int(fs_digits.group(0)) if fs_digits else 0, parts[-1])
+
     rows = []
-    for cfg, mips in sorted(results.items()):
+    for cfg, mips in sorted(results.items(), key=sort_key):
         # Parse cfg
         # e.g. 2mic_thread_32000fs
         try:
@@ -77,10 +83,12 @@ def test_measure_mips(pytestconfig):
     cwd = Path(__file__).parent
     mics = [1, 2]
     pdmrx = ["isr", "thread"]
-    fs = [16000, 32000, 48000]
+    # 8000fs-3stg is 8 kHz with the low MIPS 3 stage filters, and 16000fs-cic
+    # is 16 kHz with the CIC preset
+    fs = ["8000fs", "8000fs-3stg", "16000fs", "16000fs-cic", "24000fs", "32000fs", "48000fs", "96000fs"]
     results = {}
     for chans, pdmrx_type, samp_freq in itertools.product(mics, pdmrx, fs):
-        cfg = f"{chans}mic_{pdmrx_type}_{samp_freq}fs"
+        cfg = f"{chans}mic_{pdmrx_type}_{samp_freq}"
         xe_path = f'{cwd}/app_mips/bin/{cfg}/test_mips_{cfg}.xe'
         assert Path(xe_path).exists(), f"Cannot find {xe_path}"
         ret = subprocess.run(["xrun", "--xscope", "--id", "0", xe_path], capture_output=True, text=True, check=True, timeout=15)
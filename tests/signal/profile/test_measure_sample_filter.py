@@ -0,0 +1,42 @@
+# Copyright 2026 XMOS LIMITED.
+# This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+from pathlib import Path
+import subprocess
+import re
+
+import pytest
+
+def parse_ticks(lines):
+    results = {}
+    for line in lines:
+        # Look for patterns like "chain_sample: 123.45 ticks/sample"
+        match = re.search(r"(\w+):\s*([\d.]+)\s*ticks/sample", line)
+        if match:
+            results[match.group(1)] = float(match.group(2))
+    return results
+
+@pytest.mark.parametrize("chans", [1, 2, 4])
+def test_measure_sample_filter(chans):
+    """
+    Compare the cost of SampleFilterChain against a hand-written wrapper
+    filter and against separate filter calls, for DCOE followed by a biquad
+    cascade.
+
+    The chain is resolved at compile time, so it must not cost more than the
+    hand-written wrapper, either per sample or per frame. A tolerance of 1%
+    allows for differences in code placement.
+    """
+    cwd = Path(__file__).parent
+    cfg = f"{chans}mic"
+    xe_path = f'{cwd}/app_sample_filter/bin/{cfg}/test_sample_filter_{cfg}.xe'
+    assert Path(xe_path).exists(), f"Cannot find {xe_path}"
+    ret = subprocess.run(["xrun", "--xscope", "--id", "0", xe_path], capture_output=True, text=True, check=True, timeout=15)
+    print(ret.stdout)
+    results = parse_ticks(ret.stdout.splitlines())
+
+    for mode in ["sample", "frame"]:
+        fused = results[f"fused_{mode}"]
+        chain = results[f"chain_{mode}"]
+        assert chain <= 1.01 * fused, (f"For cfg {cfg}, SampleFilterChain {mode} cost {chain} ticks/sample "
+                                       f"exceeds the hand-written filter's {fused} ticks/sample.")
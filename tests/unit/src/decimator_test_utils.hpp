@@ -0,0 +1,106 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "mic_array.h"
+
+// PDM input and filter configurations shared by the decimator tests.
+
+static inline uint32_t random_word()
+{
+  return (uint32_t) rand() ^ ((uint32_t) rand() << 16);
+}
+
+// Random PDM word with a ones density of 3/4 if `high`, or 1/4 otherwise, so
+// that the decimator output is not close to 0.
+static inline uint32_t biased_random_word(bool high)
+{
+  return high? (random_word() | random_word())
+             : (random_word() & random_word());
+}
+
+// First-order sigma-delta modulation of a sine, one PDM word at a time.
+// Less significant bits are older samples, and bit value 0 represents +1.
+static inline uint32_t sine_pdm_word(double freq, double amplitude, double& integ, unsigned& t)
+{
+  uint32_t word = 0;
+  for(int b = 0; b < 32; b++, t++){
+    const double y = (integ >= 0)? 1.0 : -1.0;
+    integ += amplitude * sin(2 * M_PI * freq * t / 3072000.0) - y;
+    if(y < 0)
+      word |= (1u << b);
+  }
+  return word;
+}
+
+// 256 tap stage 1 filter, with 8 words of state per channel.
+static inline void stage1_conf(mic_array_filter_conf_t& conf,
+                               const uint32_t* coef,
+                               uint32_t* state)
+{
+  memset(&conf, 0, sizeof(conf));
+  conf.coef = (int32_t*) coef;
+  conf.num_taps = 256;
+  conf.decimation_factor = 32;
+  conf.state = (int32_t*) state;
+  conf.state_words_per_channel = 8;
+}
+
+// 32-bit FIR stage after stage 1.
+static inline void fir_stage_conf(mic_array_filter_conf_t& conf,
+                                  const int32_t* coef,
+                                  unsigned num_taps,
+                                  unsigned decimation_factor,
+                                  right_shift_t shr,
+                                  int32_t* state)
+{
+  memset(&conf, 0, sizeof(conf));
+  conf.coef = (int32_t*) coef;
+  conf.num_taps = num_taps;
+  conf.decimation_factor = decimation_factor;
+  conf.shr = shr;
+  conf.state = state;
+  conf.state_words_per_channel = num_taps;
+}
+
+// Default filters for a stage 2 decimation factor of 6 (16 kHz), 3 (32 kHz)
+// or 2 (48 kHz).
+static inline void default_conf(mic_array_filter_conf_t filter_conf[2],
+                                unsigned dec_factor,
+                                uint32_t* stg1_state,
+                                int32_t* stg2_state)
+{
+  switch(dec_factor){
+    case 2:
+      stage1_conf(filter_conf[0], stage1_48k_coefs, stg1_state);
+      fir_stage_conf(filter_conf[1], stage2_48k_coefs, MIC_ARRAY_48K_STAGE_2_TAP_COUNT,
+                     2, stage2_48k_shift, stg2_state);
+      break;
+    case 3:
+      stage1_conf(filter_conf[0], stage1_32k_coefs, stg1_state);
+      fir_stage_conf(filter_conf[1], stage2_32k_coefs, MIC_ARRAY_32K_STAGE_2_TAP_COUNT,
+                     3, stage2_32k_shift, stg2_state);
+      break;
+    default:
+      stage1_conf(filter_conf[0], stage1_coef, stg1_state);
+      fir_stage_conf(filter_conf[1], stage2_coef, STAGE2_TAP_COUNT,
+                     dec_factor, stage2_shr, stg2_state);
+      break;
+  }
+}
+
+// Filter configuration of the 3 stage 8 kHz preset.
+static inline void preset_8k_3stg_conf(mic_array_filter_conf_t filter_conf[3],
+                                       uint32_t* stg1_state, int32_t* stg2_state, int32_t* stg3_state)
+{
+  stage1_conf(filter_conf[0], stage1_coef, stg1_state);
+  fir_stage_conf(filter_conf[1], stage2_8k_3stg_coefs, MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT,
+                 2, stage2_8k_3stg_shift, stg2_state);
+  fir_stage_conf(filter_conf[2], stage3_8k_3stg_coefs, MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT,
+                 6, stage3_8k_3stg_shift, stg3_state);
+}
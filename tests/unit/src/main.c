@@ -18,11 +18,28 @@ int main(int argc, const char* argv[])
   RUN_TEST_GROUP(dcoe_state_init);
   RUN_TEST_GROUP(dcoe_filter);
   RUN_TEST_GROUP(DcoeSampleFilter);
+  RUN_TEST_GROUP(BiquadCascadeSampleFilter);
+  RUN_TEST_GROUP(GainSampleFilter);
+  RUN_TEST_GROUP(FractionalDelaySampleFilter);
+  RUN_TEST_GROUP(LevelMeterSampleFilter);
+  RUN_TEST_GROUP(SampleFilterChain);
+  RUN_TEST_GROUP(TwoStageDecimator);
+  RUN_TEST_GROUP(ThreeStageDecimator);
+  RUN_TEST_GROUP(SummingDecimator);
+  RUN_TEST_GROUP(MultiRateDecimator);
+  RUN_TEST_GROUP(fir_1xN_bit);
+  RUN_TEST_GROUP(CicCompDecimator);
+  RUN_TEST_GROUP(MultiStageDecimator);
+  RUN_TEST_GROUP(mic_array_decimator_latency);
+  RUN_TEST_GROUP(mic_array_get_latency);
 
   RUN_TEST_GROUP(ma_frame_tx_rx);
   RUN_TEST_GROUP(ma_frame_tx_rx_transpose);
   RUN_TEST_GROUP(ChannelFrameTransmitter);
   RUN_TEST_GROUP(FrameOutputHandler);
+  RUN_TEST_GROUP(BroadcastFrameTransmitter);
+  RUN_TEST_GROUP(CallbackFrameTransmitter);
+  RUN_TEST_GROUP(BeamformingOutputHandler);
 
   RUN_TEST_GROUP(deinterleave2);
   RUN_TEST_GROUP(deinterleave4);
@@ -30,6 +47,7 @@ int main(int argc, const char* argv[])
   RUN_TEST_GROUP(deinterleave16);
 
   RUN_TEST_GROUP(deinterleave_pdm_samples);
+  RUN_TEST_GROUP(PdmHealthMonitor);
 
   return UNITY_END();
 }
@@ -0,0 +1,244 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(BeamformingOutputHandler) {
+  RUN_TEST_CASE(BeamformingOutputHandler, default_is_average);
+  RUN_TEST_CASE(BeamformingOutputHandler, steered_impulse);
+  RUN_TEST_CASE(BeamformingOutputHandler, fractional_delay_sine);
+  RUN_TEST_CASE(BeamformingOutputHandler, weights);
+  RUN_TEST_CASE(BeamformingOutputHandler, shutdown);
+  RUN_TEST_CASE(BeamformingOutputHandler, frame_output);
+}
+
+TEST_GROUP(BeamformingOutputHandler);
+TEST_SETUP(BeamformingOutputHandler) {}
+TEST_TEAR_DOWN(BeamformingOutputHandler) {}
+
+}
+
+// Output handler which records the most recent beam sample.
+template <unsigned BEAM_COUNT>
+class RecordingOutputHandler
+{
+  public:
+    int32_t last[BEAM_COUNT];
+    unsigned count = 0;
+    unsigned shutdown_after = 0;
+    bool shutdown_complete = false;
+
+    bool OutputSample(int32_t sample[BEAM_COUNT])
+    {
+      memcpy(last, sample, sizeof(last));
+      return ++count == shutdown_after;
+    }
+
+    void CompleteShutdown() { shutdown_complete = true; }
+};
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+using TCallbackFrameTx = mic_array::CallbackFrameTransmitter<MIC_COUNT, SAMPLE_COUNT>;
+
+template <unsigned MIC_COUNT, unsigned BEAM_COUNT>
+using TBeamformer = mic_array::BeamformingOutputHandler<MIC_COUNT, BEAM_COUNT,
+                        RecordingOutputHandler<BEAM_COUNT>>;
+
+extern "C" {
+
+TEST(BeamformingOutputHandler, default_is_average)
+{
+  constexpr unsigned MICS = 4;
+
+  TBeamformer<MICS, 1> bf;
+  bf.Init();
+
+  srand(5675);
+
+  int32_t prev_mean = 0;
+  for(int t = 0; t < 100; t++){
+    int32_t sample[MICS];
+    int64_t sum = 0;
+    for(int m = 0; m < MICS; m++)
+      sum += sample[m] = (rand() - (RAND_MAX / 2)) >> 2;
+
+    TEST_ASSERT_FALSE(bf.OutputSample(sample));
+
+    // One sample of latency
+    TEST_ASSERT_INT32_WITHIN(2, prev_mean, bf.BeamOutput.last[0]);
+    prev_mean = (int32_t) (sum / MICS);
+  }
+}
+
+TEST(BeamformingOutputHandler, steered_impulse)
+{
+  constexpr unsigned MICS = 4;
+  constexpr unsigned BEAMS = 2;
+  constexpr int32_t AMP = 0x10000000;
+
+  // An impulse reaches mic m at time 10 + 2*m. Beam 0 is steered at it, beam
+  // 1 is not steered.
+  const float steer[MICS] = { 6, 4, 2, 0 };
+
+  TBeamformer<MICS, BEAMS> bf;
+  bf.Init();
+  bf.SetBeam(0, steer);
+  for(int m = 0; m < MICS; m++)
+    TEST_ASSERT_EQUAL_FLOAT(steer[m], bf.GetDelay(0, m));
+
+  int32_t peak[BEAMS] = {0, 0};
+
+  for(int t = 0; t < 40; t++){
+    int32_t sample[MICS];
+    for(int m = 0; m < MICS; m++)
+      sample[m] = (t == 10 + 2 * m)? AMP : 0;
+
+    bf.OutputSample(sample);
+
+    for(int b = 0; b < BEAMS; b++)
+      if(bf.BeamOutput.last[b] > peak[b])
+        peak[b] = bf.BeamOutput.last[b];
+
+    // Aligned beam peaks at time 10 + 6 + 1
+    if(t == 17)
+      TEST_ASSERT_INT32_WITHIN(2, AMP, bf.BeamOutput.last[0]);
+  }
+
+  TEST_ASSERT_INT32_WITHIN(2, AMP, peak[0]);
+  TEST_ASSERT_INT32_WITHIN(2, AMP / MICS, peak[1]);
+}
+
+TEST(BeamformingOutputHandler, fractional_delay_sine)
+{
+  constexpr unsigned MICS = 2;
+  const double w = 2 * M_PI * 500.0 / 16000.0;
+  const double amp = 0x20000000;
+
+  // Mic 1 lags mic 0 by 1.5 samples.
+  const float steer[MICS] = { 1.5f, 0.0f };
+
+  TBeamformer<MICS, 1> bf;
+  bf.Init();
+  bf.SetBeam(0, steer);
+
+  for(int t = 0; t < 200; t++){
+    int32_t sample[MICS] = {
+      (int32_t) round(amp * sin(w * t)),
+      (int32_t) round(amp * sin(w * (t - 1.5))),
+    };
+
+    bf.OutputSample(sample);
+
+    if(t < 10)
+      continue;
+
+    int32_t expected = (int32_t) round(amp * sin(w * (t - 1 - 1.5)));
+    TEST_ASSERT_INT32_WITHIN((int32_t)(amp / 1000), expected, bf.BeamOutput.last[0]);
+  }
+}
+
+TEST(BeamformingOutputHandler, weights)
+{
+  constexpr unsigned MICS = 3;
+  constexpr unsigned BEAMS = 3;
+
+  TBeamformer<MICS, BEAMS> bf;
+  bf.Init();
+
+  // Beam b selects mic b.
+  for(int b = 0; b < BEAMS; b++){
+    const float delay[MICS] = {0, 0, 0};
+    float weight[MICS] = {0, 0, 0};
+    weight[b] = 1.0f;
+    bf.SetBeam(b, delay, weight);
+  }
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, bf.GetWeight(1, 1));
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, bf.GetWeight(1, 2));
+
+  // Then beam 2 is changed to -mic 0
+  bf.SetWeight(2, 2, 0.0f);
+  bf.SetWeight(2, 0, -1.0f);
+
+  srand(3453);
+
+  int32_t prev[MICS] = {0, 0, 0};
+  for(int t = 0; t < 50; t++){
+    int32_t sample[MICS];
+    for(int m = 0; m < MICS; m++)
+      sample[m] = (rand() - (RAND_MAX / 2)) >> 2;
+
+    bf.OutputSample(sample);
+
+    TEST_ASSERT_INT32_WITHIN(1, prev[0], bf.BeamOutput.last[0]);
+    TEST_ASSERT_INT32_WITHIN(1, prev[1], bf.BeamOutput.last[1]);
+    TEST_ASSERT_INT32_WITHIN(1, -prev[0], bf.BeamOutput.last[2]);
+
+    memcpy(prev, sample, sizeof(prev));
+  }
+}
+
+TEST(BeamformingOutputHandler, shutdown)
+{
+  TBeamformer<2, 1> bf;
+  bf.Init();
+  bf.BeamOutput.shutdown_after = 3;
+
+  int32_t sample[2] = {0, 0};
+  TEST_ASSERT_FALSE(bf.OutputSample(sample));
+  TEST_ASSERT_FALSE(bf.OutputSample(sample));
+  TEST_ASSERT_TRUE(bf.OutputSample(sample));
+
+  bf.CompleteShutdown();
+  TEST_ASSERT_TRUE(bf.BeamOutput.shutdown_complete);
+}
+
+TEST(BeamformingOutputHandler, frame_output)
+{
+  constexpr unsigned MICS = 4;
+  constexpr unsigned BEAMS = 2;
+  constexpr unsigned SAMPLE_COUNT = 8;
+
+  mic_array::BeamformingOutputHandler<MICS, BEAMS,
+      mic_array::FrameOutputHandler<BEAMS, SAMPLE_COUNT,
+                                    TCallbackFrameTx, 2>> bf;
+  bf.Init();
+
+  // Beam 1 is the negated average.
+  const float delay[MICS] = {0, 0, 0, 0};
+  const float weight[MICS] = {-0.25f, -0.25f, -0.25f, -0.25f};
+  bf.SetBeam(1, delay, weight);
+
+  ma_frame_queue_t* queue = bf.BeamOutput.FrameTx.GetQueue();
+
+  for(int t = 0; t < SAMPLE_COUNT; t++){
+    int32_t sample[MICS] = { 4000, 4000, 4000, 4000 };
+    TEST_ASSERT_FALSE(bf.OutputSample(sample));
+  }
+
+  ma_frame_metadata_t metadata;
+  int32_t* frame = ma_frame_queue_acquire(queue, &metadata);
+  TEST_ASSERT_NOT_NULL(frame);
+
+  // Frames have BEAMS channels. The first sample is the one sample latency.
+  TEST_ASSERT_EQUAL_INT32(0, frame[0]);
+  TEST_ASSERT_EQUAL_INT32(0, frame[SAMPLE_COUNT]);
+  for(int s = 1; s < SAMPLE_COUNT; s++){
+    TEST_ASSERT_EQUAL_INT32(4000, frame[s]);
+    TEST_ASSERT_EQUAL_INT32(-4000, frame[SAMPLE_COUNT + s]);
+  }
+  ma_frame_queue_release(queue);
+}
+
+}
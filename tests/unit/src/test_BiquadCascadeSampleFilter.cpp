@@ -0,0 +1,156 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/SampleFilter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(BiquadCascadeSampleFilter) {
+  RUN_TEST_CASE(BiquadCascadeSampleFilter, identity_1_section);
+  RUN_TEST_CASE(BiquadCascadeSampleFilter, identity_10_sections);
+  RUN_TEST_CASE(BiquadCascadeSampleFilter, per_channel_coefficients);
+  RUN_TEST_CASE(BiquadCascadeSampleFilter, highpass_removes_dc);
+  RUN_TEST_CASE(BiquadCascadeSampleFilter, frame_matches_sample);
+}
+
+TEST_GROUP(BiquadCascadeSampleFilter);
+TEST_SETUP(BiquadCascadeSampleFilter) {}
+TEST_TEAR_DOWN(BiquadCascadeSampleFilter) {}
+
+}
+
+#define Q30(X)    ((int32_t)((X) * (1 << 30)))
+
+// 2nd order Butterworth high-pass at 100 Hz, followed by a +3 dB peak at
+// 3 kHz, for 16 kHz. Generated by python/filter_design/biquad_design.py
+static const int32_t hpf_eq_coef[2][5] = {
+  { 1044336221, -2088672443, 1044336221, 2087866987, -1015736075 },
+  { 1197720911, -591792233, 348706718, 591792233, -472685805 },
+};
+
+template <unsigned N_SECTIONS>
+static void identity_coef(int32_t coef[N_SECTIONS][5], int32_t gain)
+{
+  memset(coef, 0, sizeof(int32_t) * N_SECTIONS * 5);
+  for(int k = 0; k < N_SECTIONS; k++)
+    coef[k][0] = (k == 0)? gain : Q30(1.0);
+}
+
+template <unsigned CHANS, unsigned N_SECTIONS>
+static void test_identity()
+{
+  srand(4567 + N_SECTIONS);
+
+  int32_t coef[N_SECTIONS][5];
+  identity_coef<N_SECTIONS>(coef, Q30(1.0));
+
+  mic_array::BiquadCascadeSampleFilter<CHANS, N_SECTIONS> filter;
+  filter.Init(coef);
+
+  for(int r = 0; r < 200; r++){
+    int32_t sample[CHANS];
+    int32_t expected[CHANS];
+    for(int k = 0; k < CHANS; k++)
+      expected[k] = sample[k] = rand() - (RAND_MAX / 2);
+
+    filter.Filter(sample);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, CHANS);
+  }
+}
+
+extern "C" {
+
+TEST(BiquadCascadeSampleFilter, identity_1_section)   { test_identity<4,1>();  }
+TEST(BiquadCascadeSampleFilter, identity_10_sections) { test_identity<2,10>(); }
+
+TEST(BiquadCascadeSampleFilter, per_channel_coefficients)
+{
+  constexpr unsigned CHANS = 2;
+
+  int32_t unity[1][5];
+  int32_t half[1][5];
+  identity_coef<1>(unity, Q30(1.0));
+  identity_coef<1>(half, Q30(0.5));
+
+  mic_array::BiquadCascadeSampleFilter<CHANS, 1> filter;
+  filter.Init(unity);
+  filter.SetChannelCoefficients(1, half);
+
+  srand(3456);
+
+  for(int r = 0; r < 200; r++){
+    int32_t x = rand() - (RAND_MAX / 2);
+    int32_t sample[CHANS] = { x, x };
+
+    filter.Filter(sample);
+
+    TEST_ASSERT_EQUAL_INT32(x, sample[0]);
+    TEST_ASSERT_INT32_WITHIN(1, x / 2, sample[1]);
+  }
+}
+
+TEST(BiquadCascadeSampleFilter, highpass_removes_dc)
+{
+  constexpr unsigned CHANS = 2;
+
+  mic_array::BiquadCascadeSampleFilter<CHANS, 2> filter;
+  filter.Init(hpf_eq_coef);
+
+  int32_t sample[CHANS];
+
+  // One second at 16 kHz
+  for(int r = 0; r < 16000; r++){
+    sample[0] = 0x10000000;
+    sample[1] = -0x10000000;
+    filter.Filter(sample);
+  }
+
+  // Residual DC should be more than 80 dB down
+  TEST_ASSERT_INT32_WITHIN(0x10000000 / 10000, 0, sample[0]);
+  TEST_ASSERT_INT32_WITHIN(0x10000000 / 10000, 0, sample[1]);
+}
+
+TEST(BiquadCascadeSampleFilter, frame_matches_sample)
+{
+  constexpr unsigned CHANS = 4;
+  constexpr unsigned SAMPLE_COUNT = 32;
+
+  mic_array::BiquadCascadeSampleFilter<CHANS, 2> frame_filter;
+  mic_array::BiquadCascadeSampleFilter<CHANS, 2> sample_filter;
+  frame_filter.Init(hpf_eq_coef);
+  sample_filter.Init(hpf_eq_coef);
+
+  srand(8765);
+
+  for(int r = 0; r < 20; r++){
+    int32_t frame[CHANS][SAMPLE_COUNT];
+    int32_t expected[CHANS][SAMPLE_COUNT];
+
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      int32_t sample[CHANS];
+      for(int k = 0; k < CHANS; k++)
+        frame[k][s] = sample[k] = (rand() - (RAND_MAX / 2)) >> 2;
+
+      sample_filter.Filter(sample);
+
+      for(int k = 0; k < CHANS; k++)
+        expected[k][s] = sample[k];
+    }
+
+    frame_filter.FilterFrame(frame);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &frame[0][0], CHANS * SAMPLE_COUNT);
+  }
+}
+
+}
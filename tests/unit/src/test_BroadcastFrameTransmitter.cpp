@@ -0,0 +1,238 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include <xcore/thread.h>
+#include <xcore/channel.h>
+#include <xcore/channel_transaction.h>
+#include <xcore/assert.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+  channel_t c_broadcast;
+
+  TEST_GROUP_RUNNER(BroadcastFrameTransmitter) {
+    RUN_TEST_CASE(BroadcastFrameTransmitter, AllConsumersReceive_1x1);
+    RUN_TEST_CASE(BroadcastFrameTransmitter, AllConsumersReceive_2x16);
+    RUN_TEST_CASE(BroadcastFrameTransmitter, AllConsumersReceive_4x256);
+    RUN_TEST_CASE(BroadcastFrameTransmitter, NoFrameAvailable);
+    RUN_TEST_CASE(BroadcastFrameTransmitter, HeldFrameNotOverwritten);
+    RUN_TEST_CASE(BroadcastFrameTransmitter, SlowConsumerSkips);
+    RUN_TEST_CASE(BroadcastFrameTransmitter, RequestShutdown);
+    RUN_TEST_CASE(BroadcastFrameTransmitter, Metadata);
+    RUN_TEST_CASE(BroadcastFrameTransmitter, ChannelConsumer);
+  }
+
+  TEST_GROUP(BroadcastFrameTransmitter);
+
+  TEST_SETUP(BroadcastFrameTransmitter) {
+    c_broadcast = chan_alloc();
+  }
+
+  TEST_TEAR_DOWN(BroadcastFrameTransmitter) {
+    chan_free(c_broadcast);
+  }
+
+  static unsigned __attribute__((aligned (8))) stack[8000]; // dword alignment requirement. see comment in test_ma_frame_tx_rx.cpp
+  static void* stack_start = stack_base(stack, 8000);
+
+}
+
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static void fill_frame(int32_t frame[CHANS][SAMPLE_COUNT])
+{
+  for(int c = 0; c < CHANS; c++)
+    for(int s = 0; s < SAMPLE_COUNT; s++)
+      frame[c][s] = rand();
+}
+
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static
+void test_AllConsumersReceive()
+{
+  srand(2342341*CHANS + SAMPLE_COUNT);
+
+  constexpr unsigned LOOP_COUNT = 100;
+  constexpr unsigned CONSUMERS = 3;
+
+  static mic_array::BroadcastFrameTransmitter<CHANS,SAMPLE_COUNT,CONSUMERS> frame_tx;
+
+  for(int r = 0; r < LOOP_COUNT; r++){
+    int32_t exp_frame[CHANS][SAMPLE_COUNT];
+    fill_frame<CHANS,SAMPLE_COUNT>(exp_frame);
+
+    TEST_ASSERT_FALSE(frame_tx.OutputFrame(exp_frame));
+
+    for(int k = 0; k < CONSUMERS; k++){
+      auto frame = frame_tx.AcquireFrame(k);
+      TEST_ASSERT_NOT_NULL(frame);
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frame[0][0], &frame[0][0], CHANS * SAMPLE_COUNT);
+      frame_tx.ReleaseFrame(k);
+      TEST_ASSERT_NULL(frame_tx.AcquireFrame(k));
+    }
+  }
+
+  for(int k = 0; k < CONSUMERS; k++)
+    TEST_ASSERT_EQUAL_UINT(0, frame_tx.SkippedFrames(k));
+}
+
+extern "C" {
+
+  TEST(BroadcastFrameTransmitter, AllConsumersReceive_1x1)   { test_AllConsumersReceive<1,1>();   }
+  TEST(BroadcastFrameTransmitter, AllConsumersReceive_2x16)  { test_AllConsumersReceive<2,16>();  }
+  TEST(BroadcastFrameTransmitter, AllConsumersReceive_4x256) { test_AllConsumersReceive<4,256>(); }
+
+  TEST(BroadcastFrameTransmitter, NoFrameAvailable) {
+    auto frame_tx = mic_array::BroadcastFrameTransmitter<2,4>();
+    TEST_ASSERT_EQUAL_UINT32(0, frame_tx.GetChannel());
+    TEST_ASSERT_NULL(frame_tx.AcquireFrame(0));
+    TEST_ASSERT_NULL(frame_tx.AcquireFrame(1));
+  }
+
+  TEST(BroadcastFrameTransmitter, HeldFrameNotOverwritten) {
+    srand(6786786);
+
+    constexpr unsigned CHANS = 2;
+    constexpr unsigned SAMPLE_COUNT = 8;
+
+    auto frame_tx = mic_array::BroadcastFrameTransmitter<CHANS,SAMPLE_COUNT,2,3>();
+
+    int32_t held_frame[CHANS][SAMPLE_COUNT];
+    fill_frame<CHANS,SAMPLE_COUNT>(held_frame);
+    frame_tx.OutputFrame(held_frame);
+
+    // Consumer 0 holds the first frame while many more are published.
+    auto frame = frame_tx.AcquireFrame(0);
+    TEST_ASSERT_NOT_NULL(frame);
+
+    TEST_ASSERT_NOT_NULL(frame_tx.AcquireFrame(1));
+    frame_tx.ReleaseFrame(1);
+
+    int32_t exp_frame[CHANS][SAMPLE_COUNT];
+    for(int r = 0; r < 50; r++){
+      fill_frame<CHANS,SAMPLE_COUNT>(exp_frame);
+      frame_tx.OutputFrame(exp_frame);
+
+      // Consumer 1 keeps up.
+      auto latest = frame_tx.AcquireFrame(1);
+      TEST_ASSERT_NOT_NULL(latest);
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frame[0][0], &latest[0][0], CHANS * SAMPLE_COUNT);
+      frame_tx.ReleaseFrame(1);
+
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&held_frame[0][0], &frame[0][0], CHANS * SAMPLE_COUNT);
+    }
+
+    frame_tx.ReleaseFrame(0);
+    TEST_ASSERT_EQUAL_UINT(0, frame_tx.SkippedFrames(1));
+  }
+
+  TEST(BroadcastFrameTransmitter, SlowConsumerSkips) {
+    srand(34534);
+
+    constexpr unsigned CHANS = 1;
+    constexpr unsigned SAMPLE_COUNT = 4;
+    constexpr unsigned BUFFERS = 4;
+    constexpr unsigned PUBLISHED = 10;
+
+    auto frame_tx = mic_array::BroadcastFrameTransmitter<CHANS,SAMPLE_COUNT,1,BUFFERS>();
+
+    int32_t frames[PUBLISHED][CHANS][SAMPLE_COUNT];
+    for(int r = 0; r < PUBLISHED; r++){
+      fill_frame<CHANS,SAMPLE_COUNT>(frames[r]);
+      frame_tx.OutputFrame(frames[r]);
+    }
+
+    // Only the newest BUFFERS frames are still available, oldest first.
+    for(int r = PUBLISHED - BUFFERS; r < PUBLISHED; r++){
+      auto frame = frame_tx.AcquireFrame(0);
+      TEST_ASSERT_NOT_NULL(frame);
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&frames[r][0][0], &frame[0][0], CHANS * SAMPLE_COUNT);
+      frame_tx.ReleaseFrame(0);
+    }
+
+    TEST_ASSERT_NULL(frame_tx.AcquireFrame(0));
+    TEST_ASSERT_EQUAL_UINT(PUBLISHED - BUFFERS, frame_tx.SkippedFrames(0));
+  }
+
+  TEST(BroadcastFrameTransmitter, RequestShutdown) {
+    int32_t frame[2][2] = {{0}};
+    auto frame_tx = mic_array::BroadcastFrameTransmitter<2,2>();
+
+    TEST_ASSERT_FALSE(frame_tx.OutputFrame(frame));
+    frame_tx.RequestShutdown();
+    TEST_ASSERT_TRUE(frame_tx.OutputFrame(frame));
+
+    // No channel configured, so this must not block.
+    frame_tx.CompleteShutdown();
+  }
+
+  TEST(BroadcastFrameTransmitter, Metadata) {
+    int32_t frame[1][4] = {{0}};
+    auto frame_tx = mic_array::BroadcastFrameTransmitter<1,4,2>();
+
+    ma_frame_metadata_t md = {0};
+    for(int r = 0; r < 10; r++){
+      md.sequence = r;
+      md.timestamp = 1000 * r;
+      md.dropped_blocks = r & 1;
+      frame_tx.OutputFrame(frame, &md);
+
+      for(int k = 0; k < 2; k++){
+        TEST_ASSERT_NOT_NULL(frame_tx.AcquireFrame(k));
+        const ma_frame_metadata_t* got = frame_tx.FrameMetadata(k);
+        TEST_ASSERT_EQUAL_UINT32(md.sequence, got->sequence);
+        TEST_ASSERT_EQUAL_UINT32(md.timestamp, got->timestamp);
+        TEST_ASSERT_EQUAL_UINT32(md.dropped_blocks, got->dropped_blocks);
+        frame_tx.ReleaseFrame(k);
+      }
+    }
+  }
+
+}
+
+static mic_array::BroadcastFrameTransmitter<2,16,1> channel_frame_tx;
+
+static void broadcast_frame(void* vframe)
+{
+  auto frame = reinterpret_cast<int32_t (*)[16]>(vframe);
+
+  channel_frame_tx.OutputFrame(frame);
+}
+
+extern "C" {
+
+  TEST(BroadcastFrameTransmitter, ChannelConsumer) {
+    srand(98798);
+
+    channel_frame_tx.SetChannel(c_broadcast.end_a);
+    TEST_ASSERT_EQUAL_UINT32(c_broadcast.end_a, channel_frame_tx.GetChannel());
+
+    for(int r = 0; r < 40; r++){
+      int32_t exp_frame[2][16];
+      fill_frame<2,16>(exp_frame);
+
+      run_async(broadcast_frame, &exp_frame[0][0], stack_start);
+
+      int32_t received[2][16];
+      ma_frame_rx(&received[0][0], c_broadcast.end_b, 2, 16);
+
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frame[0][0], &received[0][0], 2 * 16);
+
+      // Local consumers see the same frame.
+      auto local = channel_frame_tx.AcquireFrame(0);
+      TEST_ASSERT_NOT_NULL(local);
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frame[0][0], &local[0][0], 2 * 16);
+      channel_frame_tx.ReleaseFrame(0);
+    }
+  }
+
+}
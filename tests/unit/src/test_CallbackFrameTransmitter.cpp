@@ -0,0 +1,168 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include <xcore/assert.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/OutputHandler.hpp"
+
+extern "C" {
+
+  TEST_GROUP_RUNNER(CallbackFrameTransmitter) {
+    RUN_TEST_CASE(CallbackFrameTransmitter, Callback);
+    RUN_TEST_CASE(CallbackFrameTransmitter, CallbackShutdown);
+    RUN_TEST_CASE(CallbackFrameTransmitter, Queue);
+    RUN_TEST_CASE(CallbackFrameTransmitter, QueueEmpty);
+    RUN_TEST_CASE(CallbackFrameTransmitter, QueueShutdown);
+  }
+
+  TEST_GROUP(CallbackFrameTransmitter);
+  TEST_SETUP(CallbackFrameTransmitter) {}
+  TEST_TEAR_DOWN(CallbackFrameTransmitter) {}
+
+}
+
+struct callback_record_t {
+  unsigned calls;
+  unsigned shutdown_after;
+  int32_t* last_frame;
+  ma_frame_metadata_t last_metadata;
+};
+
+static unsigned record_frame(
+    void* context,
+    int32_t* frame,
+    const ma_frame_metadata_t* metadata)
+{
+  auto* rec = reinterpret_cast<callback_record_t*>(context);
+  rec->calls++;
+  rec->last_frame = frame;
+  rec->last_metadata = *metadata;
+  return rec->calls == rec->shutdown_after;
+}
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+using TCallbackFrameTx = mic_array::CallbackFrameTransmitter<MIC_COUNT, SAMPLE_COUNT>;
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+using TQueueFrameTx = mic_array::CallbackFrameTransmitter<MIC_COUNT, SAMPLE_COUNT, 3>;
+
+extern "C" {
+
+  TEST(CallbackFrameTransmitter, Callback) {
+    constexpr unsigned CHANS = 2;
+    constexpr unsigned SAMPLE_COUNT = 4;
+
+    mic_array::FrameOutputHandler<CHANS, SAMPLE_COUNT,
+        TCallbackFrameTx, 2> handler;
+
+    callback_record_t rec = {0};
+    handler.FrameTx.SetCallback(record_frame, &rec);
+
+    srand(7897);
+
+    for(int r = 0; r < 10; r++){
+      int32_t exp_frame[CHANS][SAMPLE_COUNT];
+
+      for(int s = 0; s < SAMPLE_COUNT; s++){
+        int32_t sample[CHANS];
+        for(int c = 0; c < CHANS; c++)
+          exp_frame[c][s] = sample[c] = rand();
+        TEST_ASSERT_FALSE(handler.OutputSample(sample));
+      }
+
+      TEST_ASSERT_EQUAL_UINT(r+1, rec.calls);
+      TEST_ASSERT_EQUAL_UINT32(r, rec.last_metadata.sequence);
+      // Frames are delivered by pointer, not copied.
+      TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frame[0][0], rec.last_frame, CHANS * SAMPLE_COUNT);
+    }
+  }
+
+  TEST(CallbackFrameTransmitter, CallbackShutdown) {
+    int32_t frame[1][2] = {{0}};
+    auto frame_tx = mic_array::CallbackFrameTransmitter<1,2>();
+
+    callback_record_t rec = {0};
+    rec.shutdown_after = 3;
+    frame_tx.SetCallback(record_frame, &rec);
+
+    TEST_ASSERT_FALSE(frame_tx.OutputFrame(frame));
+    TEST_ASSERT_FALSE(frame_tx.OutputFrame(frame));
+    TEST_ASSERT_TRUE(frame_tx.OutputFrame(frame));
+  }
+
+  TEST(CallbackFrameTransmitter, Queue) {
+    constexpr unsigned CHANS = 2;
+    constexpr unsigned SAMPLE_COUNT = 8;
+    constexpr unsigned FRAME_COUNT = 4;
+
+    mic_array::FrameOutputHandler<CHANS, SAMPLE_COUNT,
+        TQueueFrameTx, FRAME_COUNT> handler;
+
+    ma_frame_queue_t* queue = handler.FrameTx.GetQueue();
+
+    srand(23423);
+
+    int32_t exp_frames[FRAME_COUNT - 1][CHANS][SAMPLE_COUNT];
+
+    for(int r = 0; r < 20; r++){
+      // Fill the queue
+      for(int f = 0; f < FRAME_COUNT - 1; f++){
+        for(int s = 0; s < SAMPLE_COUNT; s++){
+          int32_t sample[CHANS];
+          for(int c = 0; c < CHANS; c++)
+            exp_frames[f][c][s] = sample[c] = rand();
+          TEST_ASSERT_FALSE(handler.OutputSample(sample));
+        }
+      }
+
+      // Drain it in order
+      for(int f = 0; f < FRAME_COUNT - 1; f++){
+        ma_frame_metadata_t metadata;
+        int32_t* frame = ma_frame_queue_acquire(queue, &metadata);
+        TEST_ASSERT_NOT_NULL(frame);
+        TEST_ASSERT_EQUAL_UINT32(r * (FRAME_COUNT - 1) + f, metadata.sequence);
+        TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frames[f][0][0], frame, CHANS * SAMPLE_COUNT);
+        ma_frame_queue_release(queue);
+      }
+
+      TEST_ASSERT_NULL(ma_frame_queue_acquire(queue, NULL));
+    }
+  }
+
+  TEST(CallbackFrameTransmitter, QueueEmpty) {
+    auto frame_tx = mic_array::CallbackFrameTransmitter<2,4>();
+    ma_frame_queue_t* queue = frame_tx.GetQueue();
+
+    TEST_ASSERT_NULL(ma_frame_queue_acquire(queue, NULL));
+    TEST_ASSERT_FALSE(ma_frame_queue_closed(queue));
+  }
+
+  TEST(CallbackFrameTransmitter, QueueShutdown) {
+    int32_t frame[1][2] = {{0}};
+    auto frame_tx = mic_array::CallbackFrameTransmitter<1,2,1>();
+    ma_frame_queue_t* queue = frame_tx.GetQueue();
+
+    TEST_ASSERT_FALSE(frame_tx.OutputFrame(frame));
+
+    // The queue is now full; with shutdown requested the next frame must be
+    // discarded rather than waiting for the consumer.
+    ma_frame_queue_request_shutdown(queue);
+    TEST_ASSERT_TRUE(frame_tx.OutputFrame(frame));
+
+    frame_tx.CompleteShutdown();
+    TEST_ASSERT_TRUE(ma_frame_queue_closed(queue));
+
+    TEST_ASSERT_EQUAL_PTR(&frame[0][0], ma_frame_queue_acquire(queue, NULL));
+    ma_frame_queue_release(queue);
+    TEST_ASSERT_NULL(ma_frame_queue_acquire(queue, NULL));
+  }
+
+}
@@ -0,0 +1,230 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/MicArray.hpp"
+
+#include "decimator_test_utils.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(CicCompDecimator) {
+  RUN_TEST_CASE(CicCompDecimator, stage1_matches_moving_average);
+  RUN_TEST_CASE(CicCompDecimator, matches_two_stage_decimator);
+  RUN_TEST_CASE(CicCompDecimator, default_16k_preset_passband_gain);
+}
+
+TEST_GROUP(CicCompDecimator);
+TEST_SETUP(CicCompDecimator) {}
+TEST_TEAR_DOWN(CicCompDecimator) {}
+
+}
+
+#define CHANS         (2)
+#define MAX_ORDER     (mic_array::CicCompDecimator<CHANS>::MAX_ORDER)
+
+// Configuration for a CIC of the given order followed by a stage 2 filter.
+static void cic_conf(mic_array_filter_conf_t filter_conf[2], unsigned order,
+                     uint32_t* stg1_state, int32_t* stg2_state, const int32_t* stg2_coef,
+                     unsigned stg2_taps, unsigned stg2_dec_factor, right_shift_t stg2_shr)
+{
+  memset(&filter_conf[0], 0, sizeof(filter_conf[0]));
+  filter_conf[0].cic_order = order;
+  filter_conf[0].decimation_factor = 32;
+  filter_conf[0].state = (int32_t*) stg1_state;
+  filter_conf[0].state_words_per_channel = 2 * MAX_ORDER;
+  fir_stage_conf(filter_conf[1], stg2_coef, stg2_taps, stg2_dec_factor, stg2_shr, stg2_state);
+}
+
+extern "C" {
+
+TEST(CicCompDecimator, stage1_matches_moving_average)
+{
+  constexpr unsigned WORDS = 200;
+  constexpr unsigned HIST = 32 * (MAX_ORDER + 1);
+
+  static uint32_t stg1_state[CHANS][2 * MAX_ORDER];
+  static int32_t stg2_state[CHANS][1];
+  const int32_t unity[1] = { 1 << 30 };
+
+  srand(5342);
+
+  for(unsigned order = 1; order <= MAX_ORDER; order++){
+    // Impulse response of `order` moving averages of 32 samples.
+    int32_t h[HIST] = {0};
+    h[0] = 1;
+    for(int n = 0; n < order; n++){
+      int32_t prev[HIST];
+      memcpy(prev, h, sizeof(h));
+      for(int i = 0; i < HIST; i++){
+        h[i] = 0;
+        for(int j = 0; j < 32 && j <= i; j++)
+          h[i] += prev[i - j];
+      }
+    }
+
+    // A unity stage 2 filter which doesn't decimate exposes the stage 1 output.
+    mic_array_filter_conf_t filter_conf[2];
+    cic_conf(filter_conf, order, &stg1_state[0][0], &stg2_state[0][0], unity, 1, 1, 0);
+    mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+    static mic_array::CicCompDecimator<CHANS> dec;
+    dec.Init(decimator_conf);
+
+    // PDM sample history, newest first, starting from silence.
+    int8_t hist[CHANS][HIST + 32];
+    for(int k = 0; k < CHANS; k++)
+      for(int i = 0; i < HIST; i++)
+        hist[k][i] = (i & 1)? -1 : 1;
+
+    double integ = 0;
+    unsigned t = 0;
+    for(int w = 0; w < WORDS; w++){
+      // Channel 0 is a full scale sine, and channel 1 is random.
+      uint32_t pdm_block[CHANS];
+      pdm_block[0] = sine_pdm_word(1000, 0.9, integ, t);
+      pdm_block[1] = random_word();
+
+      int32_t sample_out[CHANS];
+      dec.ProcessBlock(sample_out, pdm_block);
+
+      for(int k = 0; k < CHANS; k++){
+        memmove(&hist[k][32], &hist[k][0], HIST);
+        for(int b = 0; b < 32; b++)
+          hist[k][31 - b] = ((pdm_block[k] >> b) & 1)? -1 : 1;
+
+        int64_t expected = 0;
+        for(int i = 0; i < HIST; i++)
+          expected += h[i] * hist[k][i];
+        TEST_ASSERT_EQUAL_INT32((int32_t) (expected << (28 - 5 * order)), sample_out[k]);
+      }
+    }
+  }
+}
+
+TEST(CicCompDecimator, matches_two_stage_decimator)
+{
+  // The 16 kHz default stage 1 filter is a 4th order moving average, so a 4th
+  // order CIC gives the same output. stage1_coef has 125 non-zero taps at the
+  // oldest end of its 256, so it is later by 131 PDM samples.
+  constexpr unsigned WORDS = 200;
+  constexpr unsigned DELAY_WORDS = 131 / 32;
+  constexpr unsigned DELAY_BITS = 131 % 32;
+
+  static uint32_t cic_stg1_state[CHANS][2 * MAX_ORDER];
+  static int32_t cic_stg2_state[CHANS][1];
+  static uint32_t ref_stg1_state[CHANS][8];
+  static int32_t ref_stg2_state[CHANS][1];
+  const int32_t unity[1] = { 1 << 30 };
+
+  // Unity stage 2 filters which don't decimate expose the stage 1 outputs.
+  static mic_array::CicCompDecimator<CHANS> dec;
+  {
+    mic_array_filter_conf_t filter_conf[2];
+    cic_conf(filter_conf, 4, &cic_stg1_state[0][0], &cic_stg2_state[0][0], unity, 1, 1, 0);
+    mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+    dec.Init(decimator_conf);
+  }
+
+  static mic_array::TwoStageDecimator<CHANS> ref;
+  {
+    mic_array_filter_conf_t filter_conf[2];
+    stage1_conf(filter_conf[0], stage1_coef, &ref_stg1_state[0][0]);
+    fir_stage_conf(filter_conf[1], unity, 1, 1, 0, &ref_stg2_state[0][0]);
+    mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+    ref.Init(decimator_conf);
+  }
+
+  srand(8871);
+
+  uint32_t delay_line[CHANS][DELAY_WORDS + 1] = {{0}};
+  uint32_t carry[CHANS] = {0};
+  double integ = 0;
+  unsigned t = 0;
+  for(int w = 0; w < WORDS; w++){
+    uint32_t pdm_block[CHANS];
+    pdm_block[0] = sine_pdm_word(440, 0.7, integ, t);
+    pdm_block[1] = random_word();
+
+    uint32_t delayed_block[CHANS];
+    for(int k = 0; k < CHANS; k++){
+      memmove(&delay_line[k][1], &delay_line[k][0], DELAY_WORDS * sizeof(uint32_t));
+      delay_line[k][0] = pdm_block[k];
+      delayed_block[k] = mic_array::delay_pdm_word(delay_line[k][DELAY_WORDS], carry[k], DELAY_BITS);
+    }
+
+    int32_t expected[CHANS];
+    int32_t sample_out[CHANS];
+    ref.ProcessBlock(expected, pdm_block);
+    dec.ProcessBlock(sample_out, delayed_block);
+
+    // Once both filters have filled with the same input.
+    if(w >= 8 + DELAY_WORDS + 1){
+      for(int k = 0; k < CHANS; k++)
+        TEST_ASSERT_EQUAL_INT32(expected[k], sample_out[k]);
+    }
+  }
+}
+
+TEST(CicCompDecimator, default_16k_preset_passband_gain)
+{
+  constexpr unsigned SAMPLES = 96;
+  constexpr unsigned WARMUP = 40;
+  constexpr double AMPLITUDE = 0.5;
+  const double tones[] = { 500, 1000, 4000, 6000 };
+
+  static uint32_t stg1_state[CHANS][2 * MAX_ORDER];
+  static int32_t stg2_state[CHANS][MIC_ARRAY_16K_CIC_STAGE_2_TAP_COUNT];
+  mic_array_filter_conf_t filter_conf[2];
+  cic_conf(filter_conf, MIC_ARRAY_16K_CIC_ORDER, &stg1_state[0][0], &stg2_state[0][0],
+           stage2_16k_cic_coefs, MIC_ARRAY_16K_CIC_STAGE_2_TAP_COUNT, 6, stage2_16k_cic_shift);
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+
+  // Output for a full scale DC input with the default 16 kHz filters, which
+  // the preset matches.
+  uint32_t hist[8] = {0};
+  int64_t sum = 0;
+  for(int k = 0; k < STAGE2_TAP_COUNT; k++)
+    sum += stage2_coef[k];
+  const double expected = AMPLITUDE * fir_1x16_bit(hist, stage1_coef)
+                        * ldexp((double) sum, -30 - stage2_shr);
+
+  for(int f = 0; f < sizeof(tones) / sizeof(tones[0]); f++){
+    static mic_array::CicCompDecimator<CHANS> dec;
+    dec.Init(decimator_conf);
+
+    double integ = 0;
+    unsigned t = 0;
+    double re = 0, im = 0;
+    for(int n = 0; n < WARMUP + SAMPLES; n++){
+      uint32_t block[CHANS * 6];
+      for(int s = 0; s < 6; s++){
+        const uint32_t word = sine_pdm_word(tones[f], AMPLITUDE, integ, t);
+        for(int k = 0; k < CHANS; k++)
+          block[k * 6 + s] = word;
+      }
+      int32_t sample_out[CHANS];
+      dec.ProcessBlock(sample_out, block);
+      if(n >= WARMUP){
+        re += sample_out[1] * cos(2 * M_PI * tones[f] * n / 16000.0);
+        im += sample_out[1] * sin(2 * M_PI * tones[f] * n / 16000.0);
+      }
+    }
+    const double amplitude = 2 * sqrt(re * re + im * im) / SAMPLES;
+
+    // Passband ripple is under 1 dB up to 6 kHz.
+    TEST_ASSERT_TRUE(amplitude < 1.02 * expected);
+    TEST_ASSERT_TRUE(amplitude > 0.88 * expected);
+  }
+}
+
+}
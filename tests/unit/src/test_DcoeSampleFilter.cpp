@@ -20,6 +20,10 @@ TEST_GROUP_RUNNER(DcoeSampleFilter) {
   RUN_TEST_CASE(DcoeSampleFilter, states4);
   RUN_TEST_CASE(DcoeSampleFilter, states8);
   RUN_TEST_CASE(DcoeSampleFilter, states32);
+  RUN_TEST_CASE(DcoeSampleFilter, frame_1x1);
+  RUN_TEST_CASE(DcoeSampleFilter, frame_2x16);
+  RUN_TEST_CASE(DcoeSampleFilter, frame_8x240);
+  RUN_TEST_CASE(DcoeSampleFilter, frame_opt_in);
 }
 
 TEST_GROUP(DcoeSampleFilter);
@@ -39,6 +43,28 @@ class TestDcoeSampleFilter : public mic_array::DcoeSampleFilter<CHANS>
     }
 };
 
+template<unsigned CHANS>
+class TestDcoeFrameSampleFilter : public mic_array::DcoeFrameSampleFilter<CHANS>
+{
+  public:
+    dcoe_chan_state_t GetState(unsigned channel) {
+      return this->state[channel];
+    }
+};
+
+template <class T, unsigned SAMPLE_COUNT>
+static auto has_filter_frame(T& filter, int)
+    -> decltype(filter.FilterFrame(std::declval<int32_t (*)[SAMPLE_COUNT]>()), bool())
+{
+  return true;
+}
+
+template <class T, unsigned SAMPLE_COUNT>
+static bool has_filter_frame(T& filter, long)
+{
+  return false;
+}
+
 template <unsigned CHANS, unsigned ITER_COUNT>
 static
 void test_DcoeSampleFilter()
@@ -90,3 +116,58 @@ TEST(DcoeSampleFilter, states8)  { test_DcoeSampleFilter<8,1000>(); }
 TEST(DcoeSampleFilter, states32) { test_DcoeSampleFilter<32,1000>(); }
 
 }
+
+
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static
+void test_DcoeSampleFilter_frame()
+{
+  srand(2342*CHANS + SAMPLE_COUNT);
+
+  TestDcoeFrameSampleFilter<CHANS> frame_filter;
+  TestDcoeSampleFilter<CHANS> sample_filter;
+
+  frame_filter.Init();
+  sample_filter.Init();
+
+  for(int r = 0; r < 20; r++){
+    int32_t frame[CHANS][SAMPLE_COUNT];
+    int32_t expected[CHANS][SAMPLE_COUNT];
+
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      int32_t sample[CHANS];
+      for(int k = 0; k < CHANS; k++)
+        frame[k][s] = sample[k] = rand();
+
+      sample_filter.Filter(sample);
+
+      for(int k = 0; k < CHANS; k++)
+        expected[k][s] = sample[k];
+    }
+
+    frame_filter.FilterFrame(frame);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &frame[0][0], CHANS * SAMPLE_COUNT);
+    for(int k = 0; k < CHANS; k++)
+      TEST_ASSERT_TRUE(sample_filter.GetState(k).prev_y == frame_filter.GetState(k).prev_y);
+  }
+}
+
+extern "C" {
+
+TEST(DcoeSampleFilter, frame_1x1)   { test_DcoeSampleFilter_frame<1,1>();   }
+TEST(DcoeSampleFilter, frame_2x16)  { test_DcoeSampleFilter_frame<2,16>();  }
+TEST(DcoeSampleFilter, frame_8x240) { test_DcoeSampleFilter_frame<8,240>(); }
+
+// DcoeSampleFilter is applied per sample by MicArray. Frame-level DCOE must
+// be asked for with DcoeFrameSampleFilter.
+TEST(DcoeSampleFilter, frame_opt_in)
+{
+  mic_array::DcoeSampleFilter<2> sample_filter;
+  mic_array::DcoeFrameSampleFilter<2> frame_filter;
+
+  TEST_ASSERT_FALSE((has_filter_frame<decltype(sample_filter), 16>(sample_filter, 0)));
+  TEST_ASSERT_TRUE((has_filter_frame<decltype(frame_filter), 16>(frame_filter, 0)));
+}
+
+}
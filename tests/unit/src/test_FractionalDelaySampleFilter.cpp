@@ -0,0 +1,187 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/Decimator.hpp"
+#include "mic_array/cpp/SampleFilter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(FractionalDelaySampleFilter) {
+  RUN_TEST_CASE(FractionalDelaySampleFilter, integer_delay);
+  RUN_TEST_CASE(FractionalDelaySampleFilter, fractional_delay_sine);
+  RUN_TEST_CASE(FractionalDelaySampleFilter, update_applied_on_next_sample);
+  RUN_TEST_CASE(FractionalDelaySampleFilter, frame_matches_sample);
+  RUN_TEST_CASE(FractionalDelaySampleFilter, delay_pdm_word);
+}
+
+TEST_GROUP(FractionalDelaySampleFilter);
+TEST_SETUP(FractionalDelaySampleFilter) {}
+TEST_TEAR_DOWN(FractionalDelaySampleFilter) {}
+
+}
+
+extern "C" {
+
+TEST(FractionalDelaySampleFilter, integer_delay)
+{
+  constexpr unsigned CHANS = 3;
+  constexpr unsigned MAX_DELAY = 4;
+  constexpr unsigned LEN = 100;
+  const unsigned delay[CHANS] = { 0, 2, 4 };
+
+  mic_array::FractionalDelaySampleFilter<CHANS, MAX_DELAY> filter;
+  filter.Init();
+  for(int k = 0; k < CHANS; k++)
+    filter.SetDelay(k, delay[k]);
+
+  srand(2342);
+
+  int32_t input[LEN][CHANS];
+
+  for(int t = 0; t < LEN; t++){
+    int32_t sample[CHANS];
+    for(int k = 0; k < CHANS; k++)
+      input[t][k] = sample[k] = rand() - (RAND_MAX / 2);
+
+    filter.Filter(sample);
+
+    // One sample of fixed latency, plus the channel's delay.
+    for(int k = 0; k < CHANS; k++){
+      int d = 1 + delay[k];
+      int32_t expected = (t >= d)? input[t - d][k] : 0;
+      TEST_ASSERT_INT32_WITHIN(1, expected, sample[k]);
+    }
+  }
+}
+
+TEST(FractionalDelaySampleFilter, fractional_delay_sine)
+{
+  constexpr unsigned CHANS = 2;
+  const float delay[CHANS] = { 0.5f, 2.25f };
+  const double w = 2 * M_PI * 500.0 / 16000.0;
+  const double amp = 0x20000000;
+
+  mic_array::FractionalDelaySampleFilter<CHANS> filter;
+  filter.Init();
+  for(int k = 0; k < CHANS; k++){
+    filter.SetDelay(k, delay[k]);
+    TEST_ASSERT_EQUAL_FLOAT(delay[k], filter.GetDelay(k));
+  }
+
+  for(int t = 0; t < 200; t++){
+    int32_t sample[CHANS];
+    for(int k = 0; k < CHANS; k++)
+      sample[k] = (int32_t) round(amp * sin(w * t));
+
+    filter.Filter(sample);
+
+    if(t < 10)
+      continue;
+
+    // Cubic interpolation of a 500 Hz tone at 16 kHz is accurate to ~-60 dB
+    for(int k = 0; k < CHANS; k++){
+      int32_t expected = (int32_t) round(amp * sin(w * (t - 1 - delay[k])));
+      TEST_ASSERT_INT32_WITHIN((int32_t)(amp / 1000), expected, sample[k]);
+    }
+  }
+}
+
+TEST(FractionalDelaySampleFilter, update_applied_on_next_sample)
+{
+  constexpr unsigned CHANS = 1;
+
+  mic_array::FractionalDelaySampleFilter<CHANS> filter;
+  filter.Init();
+
+  int32_t sample[CHANS];
+  for(int t = 0; t < 8; t++){
+    sample[0] = 1000 * (t + 1);
+    filter.Filter(sample);
+  }
+  TEST_ASSERT_EQUAL_INT32(7000, sample[0]);
+
+  filter.SetDelay(0, 2);
+
+  // The history is kept, so the new delay applies immediately.
+  sample[0] = 9000;
+  filter.Filter(sample);
+  TEST_ASSERT_INT32_WITHIN(1, 6000, sample[0]);
+}
+
+TEST(FractionalDelaySampleFilter, frame_matches_sample)
+{
+  constexpr unsigned CHANS = 3;
+  constexpr unsigned SAMPLE_COUNT = 16;
+  const float delay[CHANS] = { 0.0f, 1.3f, 3.9f };
+
+  mic_array::FractionalDelaySampleFilter<CHANS> frame_filter;
+  mic_array::FractionalDelaySampleFilter<CHANS> sample_filter;
+  frame_filter.Init();
+  sample_filter.Init();
+  for(int k = 0; k < CHANS; k++){
+    frame_filter.SetDelay(k, delay[k]);
+    sample_filter.SetDelay(k, delay[k]);
+  }
+
+  srand(45645);
+
+  for(int r = 0; r < 20; r++){
+    int32_t frame[CHANS][SAMPLE_COUNT];
+    int32_t expected[CHANS][SAMPLE_COUNT];
+
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      int32_t sample[CHANS];
+      for(int k = 0; k < CHANS; k++)
+        frame[k][s] = sample[k] = (rand() - (RAND_MAX / 2)) >> 2;
+
+      sample_filter.Filter(sample);
+
+      for(int k = 0; k < CHANS; k++)
+        expected[k][s] = sample[k];
+    }
+
+    frame_filter.FilterFrame(frame);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &frame[0][0], CHANS * SAMPLE_COUNT);
+  }
+}
+
+TEST(FractionalDelaySampleFilter, delay_pdm_word)
+{
+  constexpr unsigned WORDS = 20;
+
+  srand(7867);
+
+  uint32_t input[WORDS];
+  for(int k = 0; k < WORDS; k++)
+    input[k] = (uint32_t) rand() ^ ((uint32_t) rand() << 16);
+
+  for(unsigned bits = 0; bits < 32; bits++){
+    uint32_t carry = 0;
+
+    for(int k = 0; k < WORDS; k++){
+      uint32_t output = mic_array::delay_pdm_word(input[k], carry, bits);
+      TEST_ASSERT_EQUAL_UINT32(input[k], carry);
+
+      // Bit i of word k is PDM sample 32*k+i of the stream.
+      for(int i = 0; i < 32; i++){
+        int n = 32 * k + i - bits;
+        unsigned expected = (n < 0)? 0 : (input[n / 32] >> (n % 32)) & 1;
+        TEST_ASSERT_EQUAL_UINT((expected), (output >> i) & 1);
+      }
+    }
+  }
+}
+
+}
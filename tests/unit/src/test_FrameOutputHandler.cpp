@@ -14,6 +14,7 @@
 #include "unity_fixture.h"
 
 #include "mic_array/cpp/OutputHandler.hpp"
+#include "mic_array/cpp/MicArray.hpp"
 
 extern "C" {
 
@@ -32,6 +33,10 @@ extern "C" {
     RUN_TEST_CASE(FrameOutputHandler, case_4x1024);
 
     RUN_TEST_CASE(FrameOutputHandler, multibuffer);
+    RUN_TEST_CASE(FrameOutputHandler, metadata);
+    RUN_TEST_CASE(FrameOutputHandler, frame_filter);
+    RUN_TEST_CASE(FrameOutputHandler, sample_filter_fallback);
+    RUN_TEST_CASE(FrameOutputHandler, frame_filter_timing);
   }
 
   TEST_GROUP(FrameOutputHandler);
@@ -179,3 +184,210 @@ extern "C" {
   }
 
 }
+
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+class MockMetadataFrameTransmitter
+{
+  public:
+
+    unsigned OutputFrame_called = 0;
+
+    ma_frame_metadata_t last_metadata;
+
+    MockMetadataFrameTransmitter() {}
+
+    bool OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT],
+                     const ma_frame_metadata_t* metadata)
+    {
+      OutputFrame_called++;
+      last_metadata = *metadata;
+      return false;
+    }
+};
+
+extern "C" {
+
+  TEST(FrameOutputHandler, metadata)
+  {
+    constexpr unsigned CHANS = 2;
+    constexpr unsigned SAMPLE_COUNT = 8;
+
+    using TFrameOutputHandler = mic_array::FrameOutputHandler<CHANS,SAMPLE_COUNT,
+                                    MockMetadataFrameTransmitter,2>;
+
+    TFrameOutputHandler handler;
+
+    volatile unsigned dropped = 7;
+    handler.SetDroppedBlockCounter(&dropped);
+
+    int32_t sample[CHANS] = {0};
+
+    for(int r = 0; r < 20; r++){
+      // Drop r blocks during frame r
+      dropped += r;
+
+      for(int s = 0; s < SAMPLE_COUNT; s++)
+        handler.OutputSample(sample);
+
+      TEST_ASSERT_EQUAL(r+1, handler.FrameTx.OutputFrame_called);
+      TEST_ASSERT_EQUAL_UINT32(r, handler.FrameTx.last_metadata.sequence);
+      TEST_ASSERT_EQUAL_UINT32(r, handler.FrameTx.last_metadata.dropped_blocks);
+    }
+  }
+}
+
+
+// Negates every sample, counting how it was invoked.
+template <unsigned MIC_COUNT>
+class MockFrameFilter
+{
+  public:
+
+    unsigned Filter_called = 0;
+    unsigned FilterFrame_called = 0;
+
+    void Filter(int32_t sample[MIC_COUNT])
+    {
+      Filter_called++;
+      for(int c = 0; c < MIC_COUNT; c++)
+        sample[c] = -sample[c];
+    }
+
+    template <unsigned SAMPLE_COUNT>
+    void FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+    {
+      FilterFrame_called++;
+      for(int c = 0; c < MIC_COUNT; c++)
+        for(int s = 0; s < SAMPLE_COUNT; s++)
+          frame[c][s] = -frame[c][s];
+    }
+};
+
+// Only provides the per-sample interface.
+template <unsigned MIC_COUNT>
+class MockSampleFilter
+{
+  public:
+
+    unsigned Filter_called = 0;
+
+    void Filter(int32_t sample[MIC_COUNT])
+    {
+      Filter_called++;
+      for(int c = 0; c < MIC_COUNT; c++)
+        sample[c] = -sample[c];
+    }
+};
+
+// FilterFrame() calls counted by MockFrameFilter when each frame was sent.
+static unsigned frames_filtered = 0;
+static unsigned frames_filtered_at_tx = 0;
+
+template <unsigned MIC_COUNT, unsigned SAMPLE_COUNT>
+class MockOrderFrameTransmitter
+{
+  public:
+
+    unsigned OutputFrame_called = 0;
+
+    bool OutputFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+    {
+      OutputFrame_called++;
+      frames_filtered_at_tx = frames_filtered;
+      return false;
+    }
+};
+
+template <unsigned MIC_COUNT>
+class MockCountingFrameFilter : public MockFrameFilter<MIC_COUNT>
+{
+  public:
+
+    template <unsigned SAMPLE_COUNT>
+    void FilterFrame(int32_t frame[MIC_COUNT][SAMPLE_COUNT])
+    {
+      frames_filtered++;
+      MockFrameFilter<MIC_COUNT>::template FilterFrame<SAMPLE_COUNT>(frame);
+    }
+};
+
+template <class TSampleFilter>
+static void test_output_filtered_sample(TSampleFilter& filter)
+{
+  constexpr unsigned CHANS = 2;
+  constexpr unsigned SAMPLE_COUNT = 16;
+
+  mic_array::FrameOutputHandler<CHANS,SAMPLE_COUNT,MockFrameTransmitter,2> handler;
+
+  srand(32452);
+
+  for(int r = 0; r < 10; r++){
+    int32_t exp_frame[CHANS][SAMPLE_COUNT];
+
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      int32_t sample[CHANS];
+      for(int c = 0; c < CHANS; c++){
+        sample[c] = rand() - (RAND_MAX / 2);
+        exp_frame[c][s] = -sample[c];
+      }
+      mic_array::detail::output_filtered_sample(handler, filter, sample, 0);
+    }
+
+    TEST_ASSERT_EQUAL(r+1, handler.FrameTx.OutputFrame_called);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&exp_frame[0][0], &handler.FrameTx.last_frame[0][0], CHANS * SAMPLE_COUNT);
+  }
+}
+
+extern "C" {
+
+  TEST(FrameOutputHandler, frame_filter)
+  {
+    MockFrameFilter<2> filter;
+    test_output_filtered_sample(filter);
+
+    // FilterFrame() is preferred when available.
+    TEST_ASSERT_EQUAL(0, filter.Filter_called);
+    TEST_ASSERT_EQUAL(10, filter.FilterFrame_called);
+  }
+
+  TEST(FrameOutputHandler, sample_filter_fallback)
+  {
+    MockSampleFilter<2> filter;
+    test_output_filtered_sample(filter);
+
+    TEST_ASSERT_EQUAL(10 * 16, filter.Filter_called);
+  }
+
+  // With FilterFrame(), no filtering happens as samples arrive. The whole
+  // frame is filtered when its last sample arrives, just before it is sent.
+  TEST(FrameOutputHandler, frame_filter_timing)
+  {
+    constexpr unsigned CHANS = 2;
+    constexpr unsigned SAMPLE_COUNT = 8;
+
+    mic_array::FrameOutputHandler<CHANS,SAMPLE_COUNT,MockOrderFrameTransmitter,2> handler;
+    MockCountingFrameFilter<CHANS> filter;
+    frames_filtered = 0;
+
+    for(int r = 0; r < 3; r++){
+      for(int s = 0; s < SAMPLE_COUNT; s++){
+        int32_t sample[CHANS] = { s, -s };
+        mic_array::detail::output_filtered_sample(handler, filter, sample, 0);
+
+        // Samples are buffered unfiltered until the frame is complete.
+        if(s < SAMPLE_COUNT - 1){
+          TEST_ASSERT_EQUAL_INT32(s, sample[0]);
+          TEST_ASSERT_EQUAL(r, frames_filtered);
+          TEST_ASSERT_EQUAL(r, handler.FrameTx.OutputFrame_called);
+        }
+      }
+
+      TEST_ASSERT_EQUAL(r + 1, frames_filtered);
+      TEST_ASSERT_EQUAL(r + 1, handler.FrameTx.OutputFrame_called);
+      TEST_ASSERT_EQUAL(r + 1, frames_filtered_at_tx);
+    }
+
+    TEST_ASSERT_EQUAL(0, filter.Filter_called);
+  }
+}
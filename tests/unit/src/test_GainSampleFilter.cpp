@@ -0,0 +1,256 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/Decimator.hpp"
+#include "mic_array/cpp/SampleFilter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(GainSampleFilter) {
+  RUN_TEST_CASE(GainSampleFilter, unity);
+  RUN_TEST_CASE(GainSampleFilter, per_channel_gain);
+  RUN_TEST_CASE(GainSampleFilter, saturation);
+  RUN_TEST_CASE(GainSampleFilter, update_applied_on_next_sample);
+  RUN_TEST_CASE(GainSampleFilter, set_gains_twice);
+  RUN_TEST_CASE(GainSampleFilter, frame_matches_sample);
+  RUN_TEST_CASE(GainSampleFilter, decimator_output_shift);
+}
+
+TEST_GROUP(GainSampleFilter);
+TEST_SETUP(GainSampleFilter) {}
+TEST_TEAR_DOWN(GainSampleFilter) {}
+
+}
+
+#define Q30(X)    ((int32_t)((X) * (1 << 30)))
+
+static int32_t apply_gain(int32_t x, int32_t gain)
+{
+  int64_t y = ((int64_t) x * gain + (1 << 29)) >> 30;
+  if(y > INT32_MAX)   return INT32_MAX;
+  if(y < -INT32_MAX)  return -INT32_MAX;
+  return (int32_t) y;
+}
+
+extern "C" {
+
+TEST(GainSampleFilter, unity)
+{
+  constexpr unsigned CHANS = 4;
+
+  mic_array::GainSampleFilter<CHANS> filter;
+  filter.Init();
+
+  srand(3454);
+
+  for(int r = 0; r < 200; r++){
+    int32_t sample[CHANS];
+    int32_t expected[CHANS];
+    for(int k = 0; k < CHANS; k++)
+      expected[k] = sample[k] = rand() - (RAND_MAX / 2);
+
+    filter.Filter(sample);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, CHANS);
+  }
+}
+
+TEST(GainSampleFilter, per_channel_gain)
+{
+  constexpr unsigned CHANS = 4;
+  const int32_t gain[CHANS] = { Q30(0.5), Q30(1.41), Q30(-1.0), Q30(0.708) };
+
+  mic_array::GainSampleFilter<CHANS> filter;
+  filter.Init(gain);
+
+  srand(7685);
+
+  for(int r = 0; r < 200; r++){
+    int32_t sample[CHANS];
+    int32_t expected[CHANS];
+    for(int k = 0; k < CHANS; k++){
+      sample[k] = (rand() - (RAND_MAX / 2)) >> 1;
+      expected[k] = apply_gain(sample[k], gain[k]);
+    }
+
+    filter.Filter(sample);
+
+    for(int k = 0; k < CHANS; k++)
+      TEST_ASSERT_INT32_WITHIN(1, expected[k], sample[k]);
+  }
+}
+
+TEST(GainSampleFilter, saturation)
+{
+  constexpr unsigned CHANS = 2;
+  const int32_t gain[CHANS] = { Q30(1.99), Q30(1.99) };
+
+  mic_array::GainSampleFilter<CHANS> filter;
+  filter.Init(gain);
+
+  int32_t sample[CHANS] = { 0x60000000, -0x60000000 };
+  filter.Filter(sample);
+
+  TEST_ASSERT_EQUAL_INT32(INT32_MAX, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(-INT32_MAX, sample[1]);
+}
+
+TEST(GainSampleFilter, update_applied_on_next_sample)
+{
+  constexpr unsigned CHANS = 2;
+  const int32_t gain[CHANS] = { Q30(0.5), Q30(0.25) };
+
+  mic_array::GainSampleFilter<CHANS> filter;
+  filter.Init();
+
+  int32_t sample[CHANS] = { 0x1000000, 0x1000000 };
+  filter.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(0x1000000, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(0x1000000, sample[1]);
+
+  filter.SetGains(gain);
+  TEST_ASSERT_EQUAL_INT32(Q30(0.5), filter.GetChannelGain(0));
+  TEST_ASSERT_EQUAL_INT32(Q30(0.25), filter.GetChannelGain(1));
+
+  filter.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(0x800000, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(0x400000, sample[1]);
+
+  // Only channel 1 changes.
+  filter.SetChannelGain(1, Q30(1.0));
+  TEST_ASSERT_EQUAL_INT32(Q30(0.5), filter.GetChannelGain(0));
+  TEST_ASSERT_EQUAL_INT32(Q30(1.0), filter.GetChannelGain(1));
+
+  sample[0] = sample[1] = 0x1000000;
+  filter.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(0x800000, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(0x1000000, sample[1]);
+
+  // Several updates between samples must not wait for the filter.
+  filter.SetChannelGain(0, Q30(0.25));
+  filter.SetChannelGain(1, Q30(0.125));
+
+  sample[0] = sample[1] = 0x1000000;
+  filter.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(0x400000, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(0x200000, sample[1]);
+}
+
+TEST(GainSampleFilter, set_gains_twice)
+{
+  constexpr unsigned CHANS = 2;
+  constexpr unsigned SAMPLE_COUNT = 4;
+  const int32_t first[CHANS] = { Q30(0.5), Q30(0.25) };
+  const int32_t second[CHANS] = { Q30(0.125), Q30(1.5) };
+
+  // e.g. an application's init code setting gains twice before the mic
+  // array thread has filtered anything. Neither call may wait for the filter.
+  mic_array::GainSampleFilter<CHANS> filter;
+  filter.Init();
+  filter.SetGains(first);
+  filter.SetGains(second);
+
+  int32_t sample[CHANS] = { 0x1000000, 0x1000000 };
+  filter.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(0x200000, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(0x1800000, sample[1]);
+
+  mic_array::GainSampleFilter<CHANS> frame_filter;
+  frame_filter.Init(first);
+  frame_filter.SetGains(first);
+  frame_filter.SetGains(second);
+
+  int32_t frame[CHANS][SAMPLE_COUNT];
+  for(int ch = 0; ch < CHANS; ch++)
+    for(int s = 0; s < SAMPLE_COUNT; s++)
+      frame[ch][s] = 0x1000000;
+
+  frame_filter.FilterFrame<SAMPLE_COUNT>(frame);
+  for(int s = 0; s < SAMPLE_COUNT; s++){
+    TEST_ASSERT_EQUAL_INT32(0x200000, frame[0][s]);
+    TEST_ASSERT_EQUAL_INT32(0x1800000, frame[1][s]);
+  }
+}
+
+TEST(GainSampleFilter, frame_matches_sample)
+{
+  constexpr unsigned CHANS = 3;
+  constexpr unsigned SAMPLE_COUNT = 16;
+  const int32_t gain[CHANS] = { Q30(1.2), Q30(0.8), Q30(1.9) };
+
+  mic_array::GainSampleFilter<CHANS> frame_filter;
+  mic_array::GainSampleFilter<CHANS> sample_filter;
+  frame_filter.Init();
+  sample_filter.Init();
+  frame_filter.SetGains(gain);
+  sample_filter.SetGains(gain);
+
+  srand(6789);
+
+  for(int r = 0; r < 20; r++){
+    int32_t frame[CHANS][SAMPLE_COUNT];
+    int32_t expected[CHANS][SAMPLE_COUNT];
+
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      int32_t sample[CHANS];
+      for(int k = 0; k < CHANS; k++)
+        frame[k][s] = sample[k] = rand() - (RAND_MAX / 2);
+
+      sample_filter.Filter(sample);
+
+      for(int k = 0; k < CHANS; k++)
+        expected[k][s] = sample[k];
+    }
+
+    frame_filter.FilterFrame(frame);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &frame[0][0], CHANS * SAMPLE_COUNT);
+  }
+}
+
+TEST(GainSampleFilter, decimator_output_shift)
+{
+  constexpr unsigned CHANS = 2;
+
+  static uint32_t stg1_state[CHANS][8];
+  static int32_t stg2_state[CHANS][STAGE2_TAP_COUNT];
+
+  mic_array_filter_conf_t filter_conf[2];
+  memset(filter_conf, 0, sizeof(filter_conf));
+  filter_conf[0].coef = (int32_t*) stage1_coef;
+  filter_conf[0].num_taps = 256;
+  filter_conf[0].state = (int32_t*) stg1_state;
+  filter_conf[0].state_words_per_channel = 8;
+  filter_conf[1].coef = (int32_t*) stage2_coef;
+  filter_conf[1].num_taps = STAGE2_TAP_COUNT;
+  filter_conf[1].decimation_factor = STAGE2_DEC_FACTOR;
+  filter_conf[1].state = (int32_t*) stg2_state;
+  filter_conf[1].shr = stage2_shr;
+  filter_conf[1].state_words_per_channel = STAGE2_TAP_COUNT;
+
+  mic_array_decimator_conf_t decimator_conf;
+  memset(&decimator_conf, 0, sizeof(decimator_conf));
+  decimator_conf.filter_conf = &filter_conf[0];
+  decimator_conf.num_filter_stages = 2;
+
+  mic_array::TwoStageDecimator<CHANS> decimator;
+  decimator.Init(decimator_conf);
+
+  TEST_ASSERT_EQUAL_INT(stage2_shr, decimator.GetOutputShift());
+
+  // +6 dB on all channels
+  decimator.SetOutputShift(stage2_shr - 1);
+  TEST_ASSERT_EQUAL_INT(stage2_shr - 1, decimator.GetOutputShift());
+}
+
+}
@@ -0,0 +1,174 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/SampleFilter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(LevelMeterSampleFilter) {
+  RUN_TEST_CASE(LevelMeterSampleFilter, peak_and_reset);
+  RUN_TEST_CASE(LevelMeterSampleFilter, rms_sine);
+  RUN_TEST_CASE(LevelMeterSampleFilter, clip_count);
+  RUN_TEST_CASE(LevelMeterSampleFilter, frame_matches_sample);
+}
+
+TEST_GROUP(LevelMeterSampleFilter);
+TEST_SETUP(LevelMeterSampleFilter) {}
+TEST_TEAR_DOWN(LevelMeterSampleFilter) {}
+
+}
+
+extern "C" {
+
+TEST(LevelMeterSampleFilter, peak_and_reset)
+{
+  constexpr unsigned CHANS = 3;
+
+  mic_array::LevelMeterSampleFilter<CHANS> meter;
+  meter.Init();
+
+  srand(4564);
+
+  int32_t peak[CHANS] = {0};
+  for(int t = 0; t < 100; t++){
+    int32_t sample[CHANS];
+    int32_t orig[CHANS];
+    for(int k = 0; k < CHANS; k++){
+      orig[k] = sample[k] = (rand() - (RAND_MAX / 2)) >> k;
+      int32_t mag = abs(sample[k]);
+      if(mag > peak[k])
+        peak[k] = mag;
+    }
+
+    meter.Filter(sample);
+
+    // Samples are not modified
+    TEST_ASSERT_EQUAL_INT32_ARRAY(orig, sample, CHANS);
+    for(int k = 0; k < CHANS; k++)
+      TEST_ASSERT_EQUAL_INT32(peak[k], meter.GetPeak(k));
+  }
+
+  // The reset is applied by the next sample.
+  meter.ResetPeaks();
+  int32_t sample[CHANS] = { 100, -200, 0 };
+  meter.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(100, meter.GetPeak(0));
+  TEST_ASSERT_EQUAL_INT32(200, meter.GetPeak(1));
+  TEST_ASSERT_EQUAL_INT32(0, meter.GetPeak(2));
+
+  sample[2] = INT32_MIN;
+  meter.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(INT32_MAX, meter.GetPeak(2));
+}
+
+TEST(LevelMeterSampleFilter, rms_sine)
+{
+  constexpr unsigned CHANS = 2;
+  const double amp[CHANS] = { 0x40000000, 0x01000000 };
+  const double w = 2 * M_PI * 500.0 / 16000.0;
+
+  mic_array::LevelMeterSampleFilter<CHANS, 8> meter;
+  meter.Init();
+
+  for(int t = 0; t < 4000; t++){
+    int32_t sample[CHANS];
+    for(int k = 0; k < CHANS; k++)
+      sample[k] = (int32_t) round(amp[k] * sin(w * t));
+    meter.Filter(sample);
+  }
+
+  for(int k = 0; k < CHANS; k++){
+    const double expected = amp[k] / sqrt(2.0);
+    TEST_ASSERT_INT32_WITHIN((int32_t)(0.02 * expected), (int32_t) expected, meter.GetRms(k));
+  }
+}
+
+TEST(LevelMeterSampleFilter, clip_count)
+{
+  constexpr unsigned CHANS = 2;
+
+  mic_array::LevelMeterSampleFilter<CHANS> meter;
+
+  // Default threshold counts saturated samples
+  meter.Init();
+
+  int32_t sample[CHANS] = { INT32_MAX, 0x7FFFFFF0 };
+  meter.Filter(sample);
+  sample[0] = -INT32_MAX;
+  meter.Filter(sample);
+  sample[0] = INT32_MIN;
+  meter.Filter(sample);
+  TEST_ASSERT_EQUAL_UINT32(3, meter.GetClipCount(0));
+  TEST_ASSERT_EQUAL_UINT32(0, meter.GetClipCount(1));
+
+  // Lower threshold
+  meter.Init(0x40000000);
+
+  sample[0] = 0x3FFFFFFF;
+  sample[1] = -0x40000000;
+  meter.Filter(sample);
+  meter.Filter(sample);
+  TEST_ASSERT_EQUAL_UINT32(0, meter.GetClipCount(0));
+  TEST_ASSERT_EQUAL_UINT32(2, meter.GetClipCount(1));
+}
+
+TEST(LevelMeterSampleFilter, frame_matches_sample)
+{
+  constexpr unsigned CHANS = 3;
+  constexpr unsigned SAMPLE_COUNT = 16;
+  constexpr int32_t THRESHOLD = 0x30000000;
+
+  mic_array::LevelMeterSampleFilter<CHANS> frame_meter;
+  mic_array::LevelMeterSampleFilter<CHANS> sample_meter;
+  frame_meter.Init(THRESHOLD);
+  sample_meter.Init(THRESHOLD);
+
+  srand(12321);
+
+  for(int r = 0; r < 500; r++){
+    int32_t frame[CHANS][SAMPLE_COUNT];
+    int32_t orig[CHANS][SAMPLE_COUNT];
+
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      int32_t sample[CHANS];
+      for(int k = 0; k < CHANS; k++){
+        // Channel k has amplitude 2^(30-k), so only channel 0 clips
+        double u = 2.0 * rand() / RAND_MAX - 1.0;
+        orig[k][s] = frame[k][s] = sample[k] = (int32_t) (u * (0x40000000 >> k));
+      }
+
+      sample_meter.Filter(sample);
+    }
+
+    frame_meter.FilterFrame<SAMPLE_COUNT>(frame);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&orig[0][0], &frame[0][0], CHANS * SAMPLE_COUNT);
+
+    if(r == 250){
+      frame_meter.ResetPeaks();
+      sample_meter.ResetPeaks();
+    }
+  }
+
+  for(int k = 0; k < CHANS; k++){
+    TEST_ASSERT_EQUAL_INT32(sample_meter.GetPeak(k), frame_meter.GetPeak(k));
+    TEST_ASSERT_EQUAL_UINT32(sample_meter.GetClipCount(k), frame_meter.GetClipCount(k));
+
+    const int32_t rms = sample_meter.GetRms(k);
+    TEST_ASSERT_INT32_WITHIN(rms / 10, rms, frame_meter.GetRms(k));
+  }
+  TEST_ASSERT_NOT_EQUAL(0, frame_meter.GetClipCount(0));
+  TEST_ASSERT_EQUAL_UINT32(0, frame_meter.GetClipCount(2));
+}
+
+}
@@ -0,0 +1,276 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/MicArray.hpp"
+
+#include "decimator_test_utils.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(MultiRateDecimator) {
+  RUN_TEST_CASE(MultiRateDecimator, block_words);
+  RUN_TEST_CASE(MultiRateDecimator, matches_two_stage);
+  RUN_TEST_CASE(MultiRateDecimator, mic_array_shutdown);
+  RUN_TEST_CASE(MultiRateDecimator, mic_array_shutdown_one_at_a_time);
+}
+
+TEST_GROUP(MultiRateDecimator);
+TEST_SETUP(MultiRateDecimator) {}
+TEST_TEAR_DOWN(MultiRateDecimator) {}
+
+}
+
+#define CHANS   (3)
+
+// 48 kHz and 16 kHz outputs, sharing the 48 kHz stage 1 filter.
+struct TestDecimator
+{
+  uint32_t stg1_state[CHANS][8];
+  int32_t stg2_48k_state[CHANS][MIC_ARRAY_48K_STAGE_2_TAP_COUNT];
+  int32_t stg2_16k_state[CHANS][STAGE2_TAP_COUNT];
+  mic_array::MultiRateDecimator<CHANS, 2> decimator;
+
+  void Init()
+  {
+    mic_array_filter_conf_t filter_conf[3];
+    Conf(filter_conf);
+
+    mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 3 };
+    decimator.Init(decimator_conf);
+  }
+
+  void Conf(mic_array_filter_conf_t filter_conf[3])
+  {
+    default_conf(filter_conf, 2, &stg1_state[0][0], &stg2_48k_state[0][0]);
+    fir_stage_conf(filter_conf[2], stage2_coef, STAGE2_TAP_COUNT, STAGE2_DEC_FACTOR,
+                   stage2_shr, &stg2_16k_state[0][0]);
+  }
+};
+
+// PDM rx service which delivers blocks of random PDM data.
+struct FakePdmRx
+{
+  uint32_t block[CHANS * 6];
+  unsigned blocks = 0;
+  bool shutdown = false;
+
+  uint32_t* GetPdmBlock()
+  {
+    for(int i = 0; i < CHANS * 6; i++)
+      block[i] = biased_random_word((blocks / 4) & 1);
+    blocks++;
+    return block;
+  }
+
+  void Shutdown()
+  {
+    shutdown = true;
+  }
+};
+
+// Output handler which requests shutdown after `limit` samples.
+template <unsigned BRANCH>
+struct FakeOutputHandler
+{
+  unsigned limit = 0;
+  unsigned count = 0;
+  bool completed = false;
+
+  bool OutputSample(int32_t sample[CHANS])
+  {
+    TEST_ASSERT_TRUE(count < limit);
+    return (++count == limit);
+  }
+
+  void CompleteShutdown()
+  {
+    completed = true;
+  }
+};
+
+// Output handlers read by a single consumer thread, which shuts the branches
+// down one at a time, in order, as with successive ma_shutdown() calls. While
+// it waits for one branch to complete shutdown it does not read the others, so
+// they can only buffer a sample each before the decimator would block.
+static unsigned branch_shutting_down;
+
+template <unsigned BRANCH>
+struct SequentialShutdownOutputHandler
+{
+  unsigned unread = 0;
+  bool completed = false;
+
+  bool OutputSample(int32_t sample[CHANS])
+  {
+    if(BRANCH == branch_shutting_down)
+      return true;
+    // A second unread sample would block the decimator forever.
+    TEST_ASSERT_LESS_OR_EQUAL(1, ++unread);
+    return false;
+  }
+
+  void CompleteShutdown()
+  {
+    TEST_ASSERT_EQUAL_UINT(BRANCH, branch_shutting_down);
+    completed = true;
+    branch_shutting_down++;
+  }
+};
+
+extern "C" {
+
+TEST(MultiRateDecimator, block_words)
+{
+  static int32_t stg2_state[4][CHANS][8];
+  static uint32_t stg1_state[CHANS][8];
+
+  const unsigned factors[][3] = { {2, 6, 6}, {2, 3, 6}, {4, 6, 12}, {3, 3, 3} };
+
+  for(int c = 0; c < 4; c++){
+    mic_array_filter_conf_t filter_conf[3];
+    stage1_conf(filter_conf[0], stage1_48k_coefs, &stg1_state[0][0]);
+    for(int b = 0; b < 2; b++)
+      fir_stage_conf(filter_conf[1 + b], stage2_48k_coefs, 8, factors[c][b], stage2_48k_shift,
+                     &stg2_state[b][0][0]);
+
+    mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 3 };
+    mic_array::MultiRateDecimator<CHANS, 2> dec;
+    dec.Init(decimator_conf);
+
+    TEST_ASSERT_EQUAL_UINT(factors[c][2], dec.BlockWords());
+    TEST_ASSERT_EQUAL_UINT(factors[c][0], dec.DecimationFactor(0));
+    TEST_ASSERT_EQUAL_UINT(factors[c][1], dec.DecimationFactor(1));
+  }
+}
+
+TEST(MultiRateDecimator, matches_two_stage)
+{
+  constexpr unsigned BLOCKS = 100;
+
+  static TestDecimator dec;
+  dec.Init();
+  TEST_ASSERT_EQUAL_UINT(6, dec.decimator.BlockWords());
+
+  // References which run a full two stage decimator for each rate.
+  static uint32_t ref_stg1_state[2][CHANS][8];
+  static int32_t ref_stg2_48k_state[CHANS][MIC_ARRAY_48K_STAGE_2_TAP_COUNT];
+  static int32_t ref_stg2_16k_state[CHANS][STAGE2_TAP_COUNT];
+  static mic_array::TwoStageDecimator<CHANS> ref_48k;
+  static mic_array::TwoStageDecimator<CHANS> ref_16k;
+  {
+    mic_array_filter_conf_t filter_conf[2];
+    mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+    default_conf(filter_conf, 2, &ref_stg1_state[0][0][0], &ref_stg2_48k_state[0][0]);
+    ref_48k.Init(decimator_conf);
+    stage1_conf(filter_conf[0], stage1_48k_coefs, &ref_stg1_state[1][0][0]);
+    fir_stage_conf(filter_conf[1], stage2_coef, STAGE2_TAP_COUNT, STAGE2_DEC_FACTOR, stage2_shr,
+                   &ref_stg2_16k_state[0][0]);
+    ref_16k.Init(decimator_conf);
+  }
+
+  srand(9182);
+
+  for(int blk = 0; blk < BLOCKS; blk++){
+    uint32_t pdm_block[CHANS][6];
+    for(int k = 0; k < CHANS; k++){
+      const bool high = ((blk / 4) + k) & 1;
+      for(int s = 0; s < 6; s++)
+        pdm_block[k][s] = biased_random_word(high);
+    }
+
+    int32_t expected[4][CHANS];
+    for(int n = 0; n < 3; n++){
+      uint32_t block[CHANS][2];
+      for(int k = 0; k < CHANS; k++)
+        for(int s = 0; s < 2; s++)
+          block[k][s] = pdm_block[k][2 * n + s];
+      ref_48k.ProcessBlock(expected[n], &block[0][0]);
+    }
+    ref_16k.ProcessBlock(expected[3], &pdm_block[0][0]);
+
+    // 48 kHz samples after words 2, 4 and 6, then the 16 kHz sample.
+    const unsigned expected_branch[4] = { 0, 0, 0, 1 };
+    unsigned count = 0;
+    dec.decimator.ProcessBlock(&pdm_block[0][0],
+        [&](unsigned branch, int32_t sample[CHANS]){
+          TEST_ASSERT_TRUE(count < 4);
+          TEST_ASSERT_EQUAL_UINT(expected_branch[count], branch);
+          TEST_ASSERT_EQUAL_INT32_ARRAY(expected[count], sample, CHANS);
+          count++;
+        });
+    TEST_ASSERT_EQUAL_UINT(4, count);
+  }
+}
+
+TEST(MultiRateDecimator, mic_array_shutdown)
+{
+  using TMicArray = mic_array::MultiRateMicArray<CHANS,
+                                                 mic_array::MultiRateDecimator<CHANS, 2>,
+                                                 FakePdmRx,
+                                                 FakeOutputHandler<0>,
+                                                 FakeOutputHandler<1>>;
+  static TMicArray mics;
+  static TestDecimator conf;
+
+  TEST_ASSERT_EQUAL_UINT(2, TMicArray::BRANCH_COUNT);
+
+  mic_array_filter_conf_t filter_conf[3];
+  conf.Conf(filter_conf);
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 3 };
+  mics.Decimator.Init(decimator_conf);
+
+  srand(4455);
+
+  // The 16 kHz branch shuts down first, and the 48 kHz branch keeps running.
+  std::get<0>(mics.OutputHandlers).limit = 40;
+  std::get<1>(mics.OutputHandlers).limit = 5;
+
+  mics.ThreadEntry();
+
+  TEST_ASSERT_TRUE(mics.PdmRx.shutdown);
+  TEST_ASSERT_EQUAL_UINT(14, mics.PdmRx.blocks);
+  TEST_ASSERT_EQUAL_UINT(40, std::get<0>(mics.OutputHandlers).count);
+  TEST_ASSERT_EQUAL_UINT(5, std::get<1>(mics.OutputHandlers).count);
+  TEST_ASSERT_TRUE(std::get<0>(mics.OutputHandlers).completed);
+  TEST_ASSERT_TRUE(std::get<1>(mics.OutputHandlers).completed);
+}
+
+TEST(MultiRateDecimator, mic_array_shutdown_one_at_a_time)
+{
+  using TMicArray = mic_array::MultiRateMicArray<CHANS,
+                                                 mic_array::MultiRateDecimator<CHANS, 2>,
+                                                 FakePdmRx,
+                                                 SequentialShutdownOutputHandler<0>,
+                                                 SequentialShutdownOutputHandler<1>>;
+  static TMicArray mics;
+  static TestDecimator conf;
+
+  mic_array_filter_conf_t filter_conf[3];
+  conf.Conf(filter_conf);
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 3 };
+  mics.Decimator.Init(decimator_conf);
+
+  srand(4456);
+  branch_shutting_down = 0;
+
+  // Branch 1 can only be shut down once branch 0 has completed its shutdown.
+  mics.ThreadEntry();
+
+  TEST_ASSERT_TRUE(mics.PdmRx.shutdown);
+  TEST_ASSERT_TRUE(std::get<0>(mics.OutputHandlers).completed);
+  TEST_ASSERT_TRUE(std::get<1>(mics.OutputHandlers).completed);
+  TEST_ASSERT_EQUAL_UINT(2, branch_shutting_down);
+}
+
+}
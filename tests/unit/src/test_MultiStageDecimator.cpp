@@ -0,0 +1,264 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+#include <algorithm>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/MicArray.hpp"
+
+#include "decimator_test_utils.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(MultiStageDecimator) {
+  RUN_TEST_CASE(MultiStageDecimator, two_stages_match_two_stage_decimator);
+  RUN_TEST_CASE(MultiStageDecimator, three_stages_match_three_stage_decimator);
+  RUN_TEST_CASE(MultiStageDecimator, four_stages_match_cascade);
+  RUN_TEST_CASE(MultiStageDecimator, s16_stages_close_to_s32);
+}
+
+TEST_GROUP(MultiStageDecimator);
+TEST_SETUP(MultiStageDecimator) {}
+TEST_TEAR_DOWN(MultiStageDecimator) {}
+
+}
+
+#define CHANS         (2)
+#define MAX_STAGES    (4)
+#define BLOCKS        (60)
+
+// Stage 4 of the four stage cascade, decimating by 2.
+#define STG4_TAP_COUNT      (MIC_ARRAY_48K_STAGE_2_TAP_COUNT)
+
+// Convert a 32-bit PCM stage to 16 bits as python/stage2.py --s16 does, with
+// its input right-shifted by input_shr bits relative to the 32-bit stage.
+static void s16_stage_conf(mic_array_filter_conf_t& conf16, const mic_array_filter_conf_t& conf32,
+                           int16_t* coef16, int32_t* state, right_shift_t input_shr)
+{
+  int32_t max_coef = 0;
+  int64_t sum_coef = 0;
+  for(int k = 0; k < conf32.num_taps; k++){
+    max_coef = std::max(max_coef, abs(conf32.coef[k]));
+    sum_coef += abs(conf32.coef[k]);
+  }
+  const int exp = (int) std::max(ceil(log2(max_coef / 32767.0)),
+                                 ceil(log2(sum_coef * 32768.0 / 2147483647.0)));
+  for(int k = 0; k < conf32.num_taps; k++)
+    coef16[k] = (int16_t) round(ldexp(conf32.coef[k], -exp));
+
+  conf16 = conf32;
+  conf16.coef = (int32_t*) coef16;
+  conf16.shr = 30 + conf32.shr + 16 - input_shr - exp;
+  conf16.state = state;
+  conf16.state_words_per_channel = (conf32.num_taps + 1) / 2;
+}
+
+extern "C" {
+
+TEST(MultiStageDecimator, two_stages_match_two_stage_decimator)
+{
+  static uint32_t stg1_state[2][CHANS][8];
+  static int32_t stg2_state[2][CHANS][STAGE2_TAP_COUNT];
+
+  mic_array_filter_conf_t filter_conf[2][2];
+  for(int d = 0; d < 2; d++)
+    default_conf(filter_conf[d], STAGE2_DEC_FACTOR, &stg1_state[d][0][0], &stg2_state[d][0][0]);
+
+  static mic_array::TwoStageDecimator<CHANS> ref;
+  static mic_array::MultiStageDecimator<CHANS, MAX_STAGES> dec;
+  mic_array_decimator_conf_t ref_conf = { &filter_conf[0][0], 2 };
+  mic_array_decimator_conf_t dec_conf = { &filter_conf[1][0], 2 };
+  ref.Init(ref_conf);
+  dec.Init(dec_conf);
+  TEST_ASSERT_EQUAL_UINT(STAGE2_DEC_FACTOR, dec.BlockWords());
+
+  srand(3317);
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[CHANS * STAGE2_DEC_FACTOR];
+    for(int k = 0; k < CHANS * STAGE2_DEC_FACTOR; k++)
+      pdm_block[k] = random_word();
+
+    int32_t expected[CHANS];
+    int32_t sample_out[CHANS];
+    ref.ProcessBlock(expected, pdm_block);
+    dec.ProcessBlock(sample_out, pdm_block);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample_out, CHANS);
+  }
+}
+
+TEST(MultiStageDecimator, three_stages_match_three_stage_decimator)
+{
+  constexpr unsigned BLOCK_WORDS = 12;
+
+  static uint32_t stg1_state[2][CHANS][8];
+  static int32_t stg2_state[2][CHANS][MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT];
+  static int32_t stg3_state[2][CHANS][MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT];
+
+  mic_array_filter_conf_t filter_conf[2][3];
+  for(int d = 0; d < 2; d++)
+    preset_8k_3stg_conf(filter_conf[d], &stg1_state[d][0][0], &stg2_state[d][0][0], &stg3_state[d][0][0]);
+
+  static mic_array::ThreeStageDecimator<CHANS> ref;
+  static mic_array::MultiStageDecimator<CHANS, MAX_STAGES> dec;
+  mic_array_decimator_conf_t ref_conf = { &filter_conf[0][0], 3 };
+  mic_array_decimator_conf_t dec_conf = { &filter_conf[1][0], 3 };
+  ref.Init(ref_conf);
+  dec.Init(dec_conf);
+  TEST_ASSERT_EQUAL_UINT(BLOCK_WORDS, dec.BlockWords());
+
+  srand(9120);
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[CHANS * BLOCK_WORDS];
+    for(int k = 0; k < CHANS * BLOCK_WORDS; k++)
+      pdm_block[k] = random_word();
+
+    int32_t expected[CHANS];
+    int32_t sample_out[CHANS];
+    ref.ProcessBlock(expected, pdm_block);
+    dec.ProcessBlock(sample_out, pdm_block);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample_out, CHANS);
+  }
+}
+
+TEST(MultiStageDecimator, four_stages_match_cascade)
+{
+  // The 3 stage 8 kHz preset followed by a fourth stage decimating by 2,
+  // compared with a ThreeStageDecimator followed by the same filter.
+  constexpr unsigned BLOCK_WORDS = 12;
+
+  static uint32_t stg1_state[2][CHANS][8];
+  static int32_t stg2_state[2][CHANS][MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT];
+  static int32_t stg3_state[2][CHANS][MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT];
+  static int32_t stg4_state[2][CHANS][STG4_TAP_COUNT];
+
+  mic_array_filter_conf_t filter_conf[2][4];
+  for(int d = 0; d < 2; d++)
+    preset_8k_3stg_conf(filter_conf[d], &stg1_state[d][0][0], &stg2_state[d][0][0], &stg3_state[d][0][0]);
+
+  fir_stage_conf(filter_conf[1][3], stage2_48k_coefs, STG4_TAP_COUNT, 2, stage2_48k_shift,
+                 &stg4_state[1][0][0]);
+
+  static mic_array::ThreeStageDecimator<CHANS> ref;
+  static mic_array::MultiStageDecimator<CHANS, MAX_STAGES> dec;
+  mic_array_decimator_conf_t ref_conf = { &filter_conf[0][0], 3 };
+  mic_array_decimator_conf_t dec_conf = { &filter_conf[1][0], 4 };
+  ref.Init(ref_conf);
+  dec.Init(dec_conf);
+  TEST_ASSERT_EQUAL_UINT(2 * BLOCK_WORDS, dec.BlockWords());
+
+  filter_fir_s32_t ref_stg4[CHANS];
+  for(int k = 0; k < CHANS; k++){
+    filter_fir_s32_init(&ref_stg4[k], &stg4_state[0][k][0], STG4_TAP_COUNT,
+                        stage2_48k_coefs, stage2_48k_shift);
+  }
+
+  srand(7741);
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[CHANS * 2 * BLOCK_WORDS];
+    for(int k = 0; k < CHANS * 2 * BLOCK_WORDS; k++)
+      pdm_block[k] = random_word();
+
+    // Split into the two blocks of the three stage decimator.
+    int32_t expected[CHANS];
+    for(int h = 0; h < 2; h++){
+      uint32_t ref_block[CHANS * BLOCK_WORDS];
+      for(int k = 0; k < CHANS; k++)
+        memcpy(&ref_block[k * BLOCK_WORDS], &pdm_block[(2 * k + h) * BLOCK_WORDS],
+               BLOCK_WORDS * sizeof(uint32_t));
+
+      int32_t stg3_out[CHANS];
+      ref.ProcessBlock(stg3_out, ref_block);
+      for(int k = 0; k < CHANS; k++){
+        if(h == 0)
+          filter_fir_s32_add_sample(&ref_stg4[k], stg3_out[k]);
+        else
+          expected[k] = filter_fir_s32(&ref_stg4[k], stg3_out[k]);
+      }
+    }
+
+    int32_t sample_out[CHANS];
+    dec.ProcessBlock(sample_out, pdm_block);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample_out, CHANS);
+  }
+}
+
+TEST(MultiStageDecimator, s16_stages_close_to_s32)
+{
+  // The 3 stage 8 kHz preset, with 32-bit and 16-bit PCM stages.
+  constexpr unsigned BLOCK_WORDS = 12;
+  constexpr unsigned WARMUP = 20;
+  constexpr unsigned STG2_WORDS = (MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT + 1) / 2;
+  constexpr unsigned STG3_WORDS = (MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT + 1) / 2;
+  constexpr int32_t CANARY = 0x5A5A5A5A;
+
+  static uint32_t stg1_state[2][CHANS][8];
+  static int32_t stg2_state[CHANS][MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT];
+  static int32_t stg3_state[CHANS][MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT];
+  // One extra word after the 16-bit state checks that it is large enough.
+  static int32_t stg2_state16[CHANS * STG2_WORDS + 1];
+  static int32_t stg3_state16[CHANS * STG3_WORDS + 1];
+  static int16_t __attribute__((aligned (4))) stg2_coef16[MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT];
+  static int16_t __attribute__((aligned (4))) stg3_coef16[MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT];
+  stg2_state16[CHANS * STG2_WORDS] = CANARY;
+  stg3_state16[CHANS * STG3_WORDS] = CANARY;
+
+  mic_array_filter_conf_t filter_conf[3];
+  mic_array_filter_conf_t filter_conf16[3];
+  preset_8k_3stg_conf(filter_conf, &stg1_state[0][0][0], &stg2_state[0][0], &stg3_state[0][0]);
+  filter_conf16[0] = filter_conf[0];
+  filter_conf16[0].state = (int32_t*) &stg1_state[1][0][0];
+  s16_stage_conf(filter_conf16[1], filter_conf[1], stg2_coef16, stg2_state16,
+                 mic_array::detail::FirStageS16<CHANS>::STAGE1_SHR);
+  s16_stage_conf(filter_conf16[2], filter_conf[2], stg3_coef16, stg3_state16, 16);
+
+  static mic_array::MultiStageDecimator<CHANS, MAX_STAGES> dec32;
+  static mic_array::MultiStageDecimatorS16<CHANS, MAX_STAGES> dec16;
+  mic_array_decimator_conf_t conf32 = { &filter_conf[0], 3 };
+  mic_array_decimator_conf_t conf16 = { &filter_conf16[0], 3 };
+  dec32.Init(conf32);
+  dec16.Init(conf16);
+
+  // Channel 0 is a 1 kHz tone, and channel 1 a 100 Hz tone.
+  double integ[CHANS] = {0};
+  unsigned t[CHANS] = {0};
+  const double freq[CHANS] = { 1000, 100 };
+  int32_t max_out = 0;
+  for(int b = 0; b < WARMUP + BLOCKS; b++){
+    uint32_t pdm_block[CHANS * BLOCK_WORDS];
+    for(int k = 0; k < CHANS; k++)
+      for(int w = 0; w < BLOCK_WORDS; w++)
+        pdm_block[k * BLOCK_WORDS + w] = sine_pdm_word(freq[k], 0.5, integ[k], t[k]);
+
+    int32_t out32[CHANS];
+    int32_t out16[CHANS];
+    dec32.ProcessBlock(out32, pdm_block);
+    dec16.ProcessBlock(out16, pdm_block);
+
+    // Within 2^-12 of full scale.
+    if(b >= WARMUP){
+      for(int k = 0; k < CHANS; k++){
+        TEST_ASSERT_INT32_WITHIN(1 << 19, out32[k], out16[k]);
+        max_out = std::max(max_out, abs(out32[k]));
+      }
+    }
+  }
+  // The comparison is only meaningful for a large output.
+  TEST_ASSERT_TRUE(max_out > (1 << 28));
+
+  TEST_ASSERT_EQUAL_INT32(CANARY, stg2_state16[CHANS * STG2_WORDS]);
+  TEST_ASSERT_EQUAL_INT32(CANARY, stg3_state16[CHANS * STG3_WORDS]);
+}
+
+}
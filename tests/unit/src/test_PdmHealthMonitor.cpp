@@ -0,0 +1,168 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/PdmRx.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(PdmHealthMonitor) {
+  RUN_TEST_CASE(PdmHealthMonitor, healthy_channels);
+  RUN_TEST_CASE(PdmHealthMonitor, failed_channels);
+  RUN_TEST_CASE(PdmHealthMonitor, recovery);
+  RUN_TEST_CASE(PdmHealthMonitor, newest_word_only);
+}
+
+TEST_GROUP(PdmHealthMonitor);
+TEST_SETUP(PdmHealthMonitor) {}
+TEST_TEAR_DOWN(PdmHealthMonitor) {}
+
+}
+
+// First-order sigma-delta modulation of a sine, one 32-bit word at a time.
+// Less significant bits are older samples.
+class SigmaDelta
+{
+  public:
+    double amp;
+    double w;
+    double integ = 0;
+    unsigned t = 0;
+
+    SigmaDelta(double amp, double w) : amp(amp), w(w) {}
+
+    uint32_t NextWord()
+    {
+      uint32_t word = 0;
+      for(int i = 0; i < 32; i++, t++){
+        // Bit value 0 represents +1
+        const double y = (integ >= 0)? 1.0 : -1.0;
+        integ += amp * sin(w * t) - y;
+        if(y < 0)
+          word |= (1u << i);
+      }
+      return word;
+    }
+};
+
+extern "C" {
+
+TEST(PdmHealthMonitor, healthy_channels)
+{
+  constexpr unsigned CHANS = 3;
+  constexpr unsigned WORDS = 6;
+  constexpr unsigned WINDOW = 64;
+
+  mic_array::PdmHealthMonitor<CHANS> monitor;
+  monitor.Init(WINDOW);
+
+  SigmaDelta loud(0.7, 2 * M_PI * 1000.0 / 3072000.0);
+  srand(6564);
+
+  for(int b = 0; b < 3 * WINDOW; b++){
+    uint32_t block[CHANS][WORDS];
+    for(int s = 0; s < WORDS; s++){
+      block[0][s] = 0x55555555;   // silence
+      block[1][s] = loud.NextWord();
+      block[2][s] = (uint32_t) rand() ^ ((uint32_t) rand() << 16);
+    }
+    monitor.Update(&block[0][0], WORDS);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.GetFailedChannels());
+
+  TEST_ASSERT_EQUAL_FLOAT(0.5f, monitor.GetOnesDensity(0));
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, monitor.GetTransitionDensity(0));
+  for(int k = 1; k < CHANS; k++){
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.5f, monitor.GetOnesDensity(k));
+    TEST_ASSERT_TRUE(monitor.GetTransitionDensity(k) > 0.3f);
+  }
+}
+
+TEST(PdmHealthMonitor, failed_channels)
+{
+  constexpr unsigned CHANS = 5;
+  constexpr unsigned WORDS = 2;
+  constexpr unsigned WINDOW = 100;
+
+  mic_array::PdmHealthMonitor<CHANS> monitor;
+  monitor.Init(WINDOW);
+
+  for(int b = 0; b < WINDOW; b++){
+    uint32_t block[CHANS][WORDS];
+    for(int s = 0; s < WORDS; s++){
+      block[0][s] = 0x55555555;                         // healthy
+      block[1][s] = 0x00000000;                         // stuck at 0
+      block[2][s] = 0xFFFFFFFF;                         // stuck at 1
+      block[3][s] = (b & 1)? 0xFFFFFFFF : 0xFFFFFFFE;   // almost always 1
+      block[4][s] = 0x0000FFFF;                         // 1 transition per word
+    }
+
+    // Not flagged until the window completes
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.GetFailedChannels());
+    monitor.Update(&block[0][0], WORDS);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0x0E, monitor.GetFailedChannels());
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, monitor.GetOnesDensity(1));
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, monitor.GetOnesDensity(2));
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, monitor.GetTransitionDensity(2));
+}
+
+TEST(PdmHealthMonitor, recovery)
+{
+  constexpr unsigned CHANS = 2;
+  constexpr unsigned WORDS = 1;
+  constexpr unsigned WINDOW = 16;
+
+  mic_array::PdmHealthMonitor<CHANS> monitor;
+  monitor.Init(WINDOW);
+
+  uint32_t block[CHANS] = { 0x55555555, 0x00000000 };
+  for(int b = 0; b < WINDOW; b++)
+    monitor.Update(block, WORDS);
+  TEST_ASSERT_EQUAL_UINT32(0x2, monitor.GetFailedChannels());
+
+  // Still flagged until the next window completes
+  block[1] = 0x33333333;
+  for(int b = 0; b < WINDOW - 1; b++)
+    monitor.Update(block, WORDS);
+  TEST_ASSERT_EQUAL_UINT32(0x2, monitor.GetFailedChannels());
+
+  monitor.Update(block, WORDS);
+  TEST_ASSERT_EQUAL_UINT32(0x0, monitor.GetFailedChannels());
+}
+
+TEST(PdmHealthMonitor, newest_word_only)
+{
+  constexpr unsigned CHANS = 2;
+  constexpr unsigned WORDS = 6;
+  constexpr unsigned WINDOW = 8;
+
+  mic_array::PdmHealthMonitor<CHANS> monitor;
+  monitor.Init(WINDOW);
+
+  // Only the last word of each channel is examined.
+  uint32_t block[CHANS][WORDS];
+  for(int k = 0; k < CHANS; k++)
+    for(int s = 0; s < WORDS; s++)
+      block[k][s] = (s == WORDS - 1)? 0x55555555 : 0x00000000;
+  block[1][WORDS - 1] = 0xFFFFFFFF;
+
+  for(int b = 0; b < WINDOW; b++)
+    monitor.Update(&block[0][0], WORDS);
+
+  TEST_ASSERT_EQUAL_UINT32(0x2, monitor.GetFailedChannels());
+  TEST_ASSERT_EQUAL_FLOAT(0.5f, monitor.GetOnesDensity(0));
+}
+
+}
@@ -0,0 +1,161 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/cpp/SampleFilter.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(SampleFilterChain) {
+  RUN_TEST_CASE(SampleFilterChain, stage_access);
+  RUN_TEST_CASE(SampleFilterChain, matches_separate_calls);
+  RUN_TEST_CASE(SampleFilterChain, frame_matches_separate_calls);
+  RUN_TEST_CASE(SampleFilterChain, frame_requires_all_stages);
+}
+
+TEST_GROUP(SampleFilterChain);
+TEST_SETUP(SampleFilterChain) {}
+TEST_TEAR_DOWN(SampleFilterChain) {}
+
+}
+
+// Same cascade as test_BiquadCascadeSampleFilter.cpp
+static const int32_t hpf_eq_coef[2][5] = {
+  { 1044336221, -2088672443, 1044336221, 2087866987, -1015736075 },
+  { 1197720911, -591792233, 348706718, 591792233, -472685805 },
+};
+
+// Sample filter without a FilterFrame() implementation.
+template <unsigned MIC_COUNT>
+class HalveSampleFilter
+{
+  public:
+    void Filter(int32_t sample[MIC_COUNT])
+    {
+      for(int k = 0; k < MIC_COUNT; k++)
+        sample[k] = sample[k] >> 1;
+    }
+};
+
+template <class T, unsigned SAMPLE_COUNT>
+static auto has_filter_frame(T& filter, int)
+    -> decltype(filter.FilterFrame(std::declval<int32_t (*)[SAMPLE_COUNT]>()), bool())
+{
+  return true;
+}
+
+template <class T, unsigned SAMPLE_COUNT>
+static bool has_filter_frame(T& filter, long)
+{
+  return false;
+}
+
+template <unsigned MIC_COUNT>
+using TChain = mic_array::SampleFilterChain<MIC_COUNT,
+                    mic_array::DcoeFrameSampleFilter<MIC_COUNT>,
+                    mic_array::BiquadCascadeSampleFilter<MIC_COUNT, 2>,
+                    mic_array::NopSampleFilter<MIC_COUNT>>;
+
+extern "C" {
+
+TEST(SampleFilterChain, stage_access)
+{
+  TChain<2> chain;
+
+  TEST_ASSERT_EQUAL_PTR(&chain.Head, &chain.Stage<0>());
+  TEST_ASSERT_EQUAL_PTR(&chain.Tail.Head, &chain.Stage<1>());
+  TEST_ASSERT_EQUAL_PTR(&chain.Tail.Tail.Head, &chain.Stage<2>());
+}
+
+TEST(SampleFilterChain, matches_separate_calls)
+{
+  constexpr unsigned CHANS = 4;
+
+  TChain<CHANS> chain;
+  chain.Stage<0>().Init();
+  chain.Stage<1>().Init(hpf_eq_coef);
+
+  mic_array::DcoeSampleFilter<CHANS> dcoe;
+  mic_array::BiquadCascadeSampleFilter<CHANS, 2> biquad;
+  dcoe.Init();
+  biquad.Init(hpf_eq_coef);
+
+  srand(56785);
+
+  for(int r = 0; r < 500; r++){
+    int32_t sample[CHANS];
+    int32_t expected[CHANS];
+    for(int k = 0; k < CHANS; k++)
+      expected[k] = sample[k] = (rand() - (RAND_MAX / 2)) >> 2;
+
+    dcoe.Filter(expected);
+    biquad.Filter(expected);
+
+    chain.Filter(sample);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, sample, CHANS);
+  }
+}
+
+TEST(SampleFilterChain, frame_matches_separate_calls)
+{
+  constexpr unsigned CHANS = 2;
+  constexpr unsigned SAMPLE_COUNT = 16;
+
+  TChain<CHANS> chain;
+  chain.Stage<0>().Init();
+  chain.Stage<1>().Init(hpf_eq_coef);
+
+  mic_array::DcoeFrameSampleFilter<CHANS> dcoe;
+  mic_array::BiquadCascadeSampleFilter<CHANS, 2> biquad;
+  dcoe.Init();
+  biquad.Init(hpf_eq_coef);
+
+  srand(8767);
+
+  for(int r = 0; r < 20; r++){
+    int32_t frame[CHANS][SAMPLE_COUNT];
+    int32_t expected[CHANS][SAMPLE_COUNT];
+
+    for(int k = 0; k < CHANS; k++)
+      for(int s = 0; s < SAMPLE_COUNT; s++)
+        expected[k][s] = frame[k][s] = (rand() - (RAND_MAX / 2)) >> 2;
+
+    dcoe.FilterFrame(expected);
+    biquad.FilterFrame(expected);
+
+    chain.FilterFrame(frame);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &frame[0][0], CHANS * SAMPLE_COUNT);
+  }
+}
+
+TEST(SampleFilterChain, frame_requires_all_stages)
+{
+  constexpr unsigned CHANS = 2;
+
+  TChain<CHANS> frame_chain;
+  mic_array::SampleFilterChain<CHANS,
+      mic_array::DcoeSampleFilter<CHANS>,
+      HalveSampleFilter<CHANS>> sample_chain;
+
+  TEST_ASSERT_TRUE((has_filter_frame<TChain<CHANS>, 8>(frame_chain, 0)));
+  TEST_ASSERT_FALSE((has_filter_frame<decltype(sample_chain), 8>(sample_chain, 0)));
+
+  // The per-sample interface is still available.
+  sample_chain.Stage<0>().Init();
+  int32_t sample[CHANS] = { 0x100000, -0x100000 };
+  sample_chain.Filter(sample);
+  TEST_ASSERT_EQUAL_INT32(0x80000, sample[0]);
+  TEST_ASSERT_EQUAL_INT32(-0x80000, sample[1]);
+}
+
+}
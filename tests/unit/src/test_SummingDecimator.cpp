@@ -0,0 +1,177 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/Decimator.hpp"
+#include "mic_array/cpp/SummingDecimator.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(SummingDecimator) {
+  RUN_TEST_CASE(SummingDecimator, plane_count);
+  RUN_TEST_CASE(SummingDecimator, matches_sum_of_channels);
+  RUN_TEST_CASE(SummingDecimator, pdm_delay);
+  RUN_TEST_CASE(SummingDecimator, full_scale_in_phase);
+}
+
+TEST_GROUP(SummingDecimator);
+TEST_SETUP(SummingDecimator) {}
+TEST_TEAR_DOWN(SummingDecimator) {}
+
+}
+
+static void init_filter_conf(mic_array_filter_conf_t filter_conf[2],
+                             uint32_t* stg1_state,
+                             int32_t* stg2_state)
+{
+  memset(filter_conf, 0, 2 * sizeof(mic_array_filter_conf_t));
+  filter_conf[0].coef = (int32_t*) stage1_coef;
+  filter_conf[0].num_taps = 256;
+  filter_conf[0].state = (int32_t*) stg1_state;
+  filter_conf[0].state_words_per_channel = 8;
+  filter_conf[1].coef = (int32_t*) stage2_coef;
+  filter_conf[1].num_taps = STAGE2_TAP_COUNT;
+  filter_conf[1].decimation_factor = STAGE2_DEC_FACTOR;
+  filter_conf[1].state = (int32_t*) stg2_state;
+  filter_conf[1].shr = stage2_shr;
+  filter_conf[1].state_words_per_channel = STAGE2_TAP_COUNT;
+}
+
+// Compare SummingDecimator against the sum of TwoStageDecimator's channels.
+template <unsigned CHANS>
+static void compare_with_two_stage(const unsigned delay[CHANS])
+{
+  constexpr unsigned BLOCKS = 100;
+  constexpr unsigned SCALE = 1 << mic_array::detail::ceil_log2(CHANS);
+
+  static uint32_t sum_stg1_state[CHANS][8];
+  static int32_t sum_stg2_state[STAGE2_TAP_COUNT];
+  static uint32_t ref_stg1_state[CHANS][8];
+  static int32_t ref_stg2_state[CHANS][STAGE2_TAP_COUNT];
+
+  mic_array_filter_conf_t sum_filter_conf[2];
+  mic_array_filter_conf_t ref_filter_conf[2];
+  init_filter_conf(sum_filter_conf, &sum_stg1_state[0][0], sum_stg2_state);
+  init_filter_conf(ref_filter_conf, &ref_stg1_state[0][0], &ref_stg2_state[0][0]);
+
+  mic_array_decimator_conf_t sum_conf = { &sum_filter_conf[0], 2 };
+  mic_array_decimator_conf_t ref_conf = { &ref_filter_conf[0], 2 };
+
+  mic_array::SummingDecimator<CHANS> summing;
+  mic_array::TwoStageDecimator<CHANS> reference;
+  summing.Init(sum_conf);
+  reference.Init(ref_conf);
+
+  for(int k = 0; k < CHANS; k++){
+    summing.SetPdmDelay(k, delay[k]);
+    reference.SetPdmDelay(k, delay[k]);
+    TEST_ASSERT_EQUAL_UINT(delay[k], summing.GetPdmDelay(k));
+  }
+
+  for(int b = 0; b < BLOCKS; b++){
+    uint32_t pdm_block[CHANS * STAGE2_DEC_FACTOR];
+    for(int k = 0; k < CHANS * STAGE2_DEC_FACTOR; k++)
+      pdm_block[k] = (uint32_t) rand() ^ ((uint32_t) rand() << 16);
+
+    int32_t sum_out[1];
+    int32_t ref_out[CHANS];
+    summing.ProcessBlock(sum_out, pdm_block);
+    reference.ProcessBlock(ref_out, pdm_block);
+
+    int64_t expected = 0;
+    for(int k = 0; k < CHANS; k++)
+      expected += ref_out[k];
+    expected /= SCALE;
+
+    // Stage-1 outputs are identical, so only stage-2 rounding differs.
+    TEST_ASSERT_INT32_WITHIN(CHANS, (int32_t) expected, sum_out[0]);
+  }
+}
+
+extern "C" {
+
+TEST(SummingDecimator, plane_count)
+{
+  TEST_ASSERT_EQUAL_UINT(1, mic_array::SummingDecimator<1>::PLANE_COUNT);
+  TEST_ASSERT_EQUAL_UINT(2, mic_array::SummingDecimator<2>::PLANE_COUNT);
+  TEST_ASSERT_EQUAL_UINT(2, mic_array::SummingDecimator<3>::PLANE_COUNT);
+  TEST_ASSERT_EQUAL_UINT(3, mic_array::SummingDecimator<4>::PLANE_COUNT);
+  TEST_ASSERT_EQUAL_UINT(3, mic_array::SummingDecimator<7>::PLANE_COUNT);
+  TEST_ASSERT_EQUAL_UINT(4, mic_array::SummingDecimator<8>::PLANE_COUNT);
+}
+
+TEST(SummingDecimator, matches_sum_of_channels)
+{
+  srand(2345);
+
+  const unsigned delay[8] = {0};
+  compare_with_two_stage<1>(delay);
+  compare_with_two_stage<2>(delay);
+  compare_with_two_stage<3>(delay);
+  compare_with_two_stage<4>(delay);
+  compare_with_two_stage<8>(delay);
+}
+
+TEST(SummingDecimator, pdm_delay)
+{
+  srand(8876);
+
+  const unsigned delay2[2] = { 0, 17 };
+  const unsigned delay4[4] = { 3, 0, 31, 12 };
+  compare_with_two_stage<2>(delay2);
+  compare_with_two_stage<4>(delay4);
+}
+
+
+TEST(SummingDecimator, full_scale_in_phase)
+{
+  // The same full-scale PDM stream on all 8 channels must not overflow, and
+  // the mean of the channels is then the output of any one channel.
+  constexpr unsigned CHANS = 8;
+  constexpr unsigned BLOCKS = 60;
+
+  static uint32_t sum_stg1_state[CHANS][8];
+  static int32_t sum_stg2_state[STAGE2_TAP_COUNT];
+  static uint32_t ref_stg1_state[1][8];
+  static int32_t ref_stg2_state[1][STAGE2_TAP_COUNT];
+
+  mic_array_filter_conf_t sum_filter_conf[2];
+  mic_array_filter_conf_t ref_filter_conf[2];
+  init_filter_conf(sum_filter_conf, &sum_stg1_state[0][0], sum_stg2_state);
+  init_filter_conf(ref_filter_conf, &ref_stg1_state[0][0], &ref_stg2_state[0][0]);
+
+  mic_array_decimator_conf_t sum_conf = { &sum_filter_conf[0], 2 };
+  mic_array_decimator_conf_t ref_conf = { &ref_filter_conf[0], 2 };
+
+  mic_array::SummingDecimator<CHANS> summing;
+  mic_array::TwoStageDecimator<1> reference;
+  summing.Init(sum_conf);
+  reference.Init(ref_conf);
+
+  for(int b = 0; b < BLOCKS; b++){
+    // Bit value 0 represents +1. Positive, then negative full scale.
+    const uint32_t word = (b < BLOCKS / 2)? 0x00000000 : 0xFFFFFFFF;
+
+    uint32_t pdm_block[CHANS * STAGE2_DEC_FACTOR];
+    for(int k = 0; k < CHANS * STAGE2_DEC_FACTOR; k++)
+      pdm_block[k] = word;
+
+    int32_t sum_out[1];
+    int32_t ref_out[1];
+    summing.ProcessBlock(sum_out, pdm_block);
+    reference.ProcessBlock(ref_out, pdm_block);
+
+    TEST_ASSERT_INT32_WITHIN(CHANS, ref_out[0], sum_out[0]);
+  }
+}
+
+}
@@ -0,0 +1,211 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/MicArray.hpp"
+
+#include "decimator_test_utils.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(ThreeStageDecimator) {
+  RUN_TEST_CASE(ThreeStageDecimator, resampler_output_count);
+  RUN_TEST_CASE(ThreeStageDecimator, resampler_matches_polyphase);
+  RUN_TEST_CASE(ThreeStageDecimator, default_8k_preset_passband_gain);
+}
+
+TEST_GROUP(ThreeStageDecimator);
+TEST_SETUP(ThreeStageDecimator) {}
+TEST_TEAR_DOWN(ThreeStageDecimator) {}
+
+}
+
+#define CHANS         (2)
+#define PHASE_TAPS    (8)
+#define MAX_L         (7)
+
+// A 48 kHz two stage decimator followed by an L/M resampler.
+struct TestDecimator
+{
+  uint32_t stg1_state[CHANS][8];
+  int32_t stg2_state[CHANS][MIC_ARRAY_48K_STAGE_2_TAP_COUNT];
+  int32_t stg3_state[CHANS][PHASE_TAPS];
+  int32_t stg3_coef[MAX_L * PHASE_TAPS];
+  mic_array::ThreeStageDecimator<CHANS> decimator;
+
+  void Init(unsigned L, unsigned M)
+  {
+    design(stg3_coef, L);
+
+    mic_array_filter_conf_t filter_conf[3];
+    default_conf(filter_conf, 2, &stg1_state[0][0], &stg2_state[0][0]);
+    fir_stage_conf(filter_conf[2], stg3_coef, L * PHASE_TAPS, M, 0, &stg3_state[0][0]);
+    filter_conf[2].interpolation_factor = L;
+    filter_conf[2].state_words_per_channel = PHASE_TAPS;
+
+    mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 3 };
+    decimator.Init(decimator_conf);
+  }
+
+  // Windowed sinc prototype with a DC gain of L, arranged into L phases of
+  // Q1.30 coefficients.
+  static void design(int32_t coef[], unsigned L)
+  {
+    const unsigned N = L * PHASE_TAPS;
+    for(int n = 0; n < N; n++){
+      const double t = n - (N - 1) / 2.0;
+      const double x = M_PI * t / L;
+      const double sinc = (fabs(x) < 1e-9)? 1.0 : sin(x) / x;
+      const double window = 0.54 - 0.46 * cos(2 * M_PI * n / (N - 1));
+      coef[(n % L) * PHASE_TAPS + (n / L)] = (int32_t) round(0.9 * sinc * window * (1 << 30));
+    }
+  }
+};
+
+extern "C" {
+
+TEST(ThreeStageDecimator, resampler_output_count)
+{
+  static TestDecimator dec;
+  const unsigned ratios[][2] = { {2, 5}, {2, 3}, {3, 4}, {7, 7}, {5, 7} };
+
+  for(int r = 0; r < 5; r++){
+    const unsigned L = ratios[r][0];
+    const unsigned M = ratios[r][1];
+    dec.Init(L, M);
+
+    // Output n is produced by input floor(n*M/L), so after input i
+    // (counting from 0) there have been ceil((i+1)*L/M) outputs.
+    unsigned outputs = 0;
+    for(unsigned i = 0; i < 200; i++){
+      uint32_t pdm_block[CHANS * 2];
+      for(int k = 0; k < CHANS * 2; k++)
+        pdm_block[k] = random_word();
+      int32_t sample_out[CHANS];
+      if(dec.decimator.ProcessBlock(sample_out, pdm_block))
+        outputs++;
+      TEST_ASSERT_EQUAL_UINT(((i + 1) * L + M - 1) / M, outputs);
+    }
+  }
+}
+
+TEST(ThreeStageDecimator, resampler_matches_polyphase)
+{
+  constexpr unsigned L = 3;
+  constexpr unsigned M = 4;
+  constexpr unsigned BLOCKS = 300;
+
+  static TestDecimator dec;
+  dec.Init(L, M);
+
+  // Reference for the stage 2 output.
+  static uint32_t ref_stg1_state[CHANS][8];
+  static int32_t ref_stg2_state[CHANS][MIC_ARRAY_48K_STAGE_2_TAP_COUNT];
+  static mic_array::TwoStageDecimator<CHANS> ref;
+  {
+    mic_array_filter_conf_t filter_conf[2];
+    default_conf(filter_conf, 2, &ref_stg1_state[0][0], &ref_stg2_state[0][0]);
+    mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+    ref.Init(decimator_conf);
+  }
+
+  srand(2233);
+
+  static int32_t stg2_out[BLOCKS][CHANS];
+  unsigned outputs = 0;
+
+  for(int i = 0; i < BLOCKS; i++){
+    uint32_t pdm_block[CHANS][2];
+    for(int k = 0; k < CHANS; k++){
+      const bool high = ((i / 8) + k) & 1;
+      for(int s = 0; s < 2; s++)
+        pdm_block[k][s] = biased_random_word(high);
+    }
+    ref.ProcessBlock(stg2_out[i], &pdm_block[0][0]);
+
+    int32_t sample_out[CHANS];
+    if(!dec.decimator.ProcessBlock(sample_out, &pdm_block[0][0]))
+      continue;
+
+    // Output n is at time n*M at the interpolated rate, where the zero-stuffed
+    // input is non-zero at multiples of L. Input i is the newest at this
+    // time, and the filter output is y = sum(h[n*M - j*L] * x[j]).
+    const unsigned n = outputs++;
+    TEST_ASSERT_EQUAL_UINT(i, (n * M) / L);
+    for(int k = 0; k < CHANS; k++){
+      int64_t acc = 0;
+      for(int j = i; j >= 0; j--){
+        const unsigned t = n * M - j * L;
+        if(t >= L * PHASE_TAPS)
+          break;
+        acc += (int64_t) dec.stg3_coef[(t % L) * PHASE_TAPS + (t / L)] * stg2_out[j][k];
+      }
+      const int32_t expected = (int32_t) ((acc + (1 << 29)) >> 30);
+      TEST_ASSERT_INT32_WITHIN(PHASE_TAPS, expected, sample_out[k]);
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT((BLOCKS * L + M - 1) / M, outputs);
+}
+
+TEST(ThreeStageDecimator, default_8k_preset_passband_gain)
+{
+  constexpr unsigned SAMPLES = 96;
+  constexpr unsigned WARMUP = 40;
+  constexpr double AMPLITUDE = 0.5;
+  constexpr double TONE = 1000;
+
+  static uint32_t stg1_state[CHANS][8];
+  static int32_t stg2_state[CHANS][MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT];
+  static int32_t stg3_state[CHANS][MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT];
+  mic_array_filter_conf_t filter_conf[3];
+  preset_8k_3stg_conf(filter_conf, &stg1_state[0][0], &stg2_state[0][0], &stg3_state[0][0]);
+
+  static mic_array::ThreeStageDecimator<CHANS> dec;
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 3 };
+  dec.Init(decimator_conf);
+
+  double integ = 0;
+  unsigned t = 0;
+  double re = 0, im = 0;
+  for(int n = 0; n < WARMUP + SAMPLES; n++){
+    uint32_t block[CHANS * 12];
+    for(int s = 0; s < 12; s++){
+      const uint32_t word = sine_pdm_word(TONE, AMPLITUDE, integ, t);
+      for(int k = 0; k < CHANS; k++)
+        block[k * 12 + s] = word;
+    }
+    int32_t sample_out[CHANS];
+    TEST_ASSERT_TRUE(dec.ProcessBlock(sample_out, block));
+    if(n >= WARMUP){
+      re += sample_out[0] * cos(2 * M_PI * TONE * n / 8000.0);
+      im += sample_out[0] * sin(2 * M_PI * TONE * n / 8000.0);
+    }
+  }
+  const double amplitude = 2 * sqrt(re * re + im * im) / SAMPLES;
+
+  // Output for a full scale DC input, from the filter coefficients.
+  uint32_t hist[8] = {0};
+  double expected = AMPLITUDE * fir_1x16_bit(hist, stage1_coef);
+  const mic_array_filter_conf_t* pcm_stages = &filter_conf[1];
+  for(int i = 0; i < 2; i++){
+    int64_t sum = 0;
+    for(int k = 0; k < pcm_stages[i].num_taps; k++)
+      sum += pcm_stages[i].coef[k];
+    expected *= ldexp((double) sum, -30 - pcm_stages[i].shr);
+  }
+
+  TEST_ASSERT_INT32_WITHIN((int32_t) (0.05 * expected), (int32_t) expected, (int32_t) amplitude);
+}
+
+}
@@ -0,0 +1,443 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/Decimator.hpp"
+
+#include "decimator_test_utils.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(TwoStageDecimator) {
+  RUN_TEST_CASE(TwoStageDecimator, inactive_channels_output_zero);
+  RUN_TEST_CASE(TwoStageDecimator, reactivated_channel_is_reset);
+  RUN_TEST_CASE(TwoStageDecimator, pdm_delay_set_while_running);
+  RUN_TEST_CASE(TwoStageDecimator, reconfigure);
+  RUN_TEST_CASE(TwoStageDecimator, default_presets_passband_gain);
+  RUN_TEST_CASE(TwoStageDecimator, reduced_stage1_coef_bits);
+}
+
+TEST_GROUP(TwoStageDecimator);
+TEST_SETUP(TwoStageDecimator) {}
+TEST_TEAR_DOWN(TwoStageDecimator) {}
+
+}
+
+#define CHANS   (4)
+
+// A decimator together with its filter state.
+struct TestDecimator
+{
+  uint32_t stg1_state[CHANS][8];
+  int32_t stg2_state[CHANS][STAGE2_TAP_COUNT];
+  mic_array::TwoStageDecimator<CHANS> decimator;
+
+  void Init(unsigned dec_factor = STAGE2_DEC_FACTOR)
+  {
+    mic_array_filter_conf_t filter_conf[2];
+    default_conf(filter_conf, dec_factor, &stg1_state[0][0], &stg2_state[0][0]);
+
+    mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+    decimator.Init(decimator_conf);
+  }
+};
+
+// Random PDM data whose ones density alternates between 1/4 and 3/4 every
+// 4 blocks.
+static void random_block(uint32_t pdm_block[CHANS * STAGE2_DEC_FACTOR], unsigned block)
+{
+  for(int k = 0; k < CHANS; k++){
+    const bool high = ((block / 4) + k) & 1;
+    for(int s = 0; s < STAGE2_DEC_FACTOR; s++)
+      pdm_block[k * STAGE2_DEC_FACTOR + s] = biased_random_word(high);
+  }
+}
+
+// sine_pdm_word() with its state.
+struct SineModulator
+{
+  double freq;
+  double amplitude;
+  double integ;
+  unsigned t;
+
+  SineModulator(double freq, double amplitude)
+      : freq(freq), amplitude(amplitude), integ(0), t(0) { }
+
+  uint32_t NextWord()
+  {
+    return sine_pdm_word(freq, amplitude, integ, t);
+  }
+};
+
+// Amplitude of the `freq` component of `n` samples at `fs`, where the samples
+// hold a whole number of periods.
+static double tone_amplitude(const int32_t* samples, unsigned n, double freq, double fs)
+{
+  double re = 0, im = 0;
+  for(unsigned k = 0; k < n; k++){
+    re += samples[k] * cos(2 * M_PI * freq * k / fs);
+    im += samples[k] * sin(2 * M_PI * freq * k / fs);
+  }
+  return 2 * sqrt(re * re + im * im) / n;
+}
+
+// Output for a full scale DC input, from the filter coefficients.
+static double dc_gain(const uint32_t* stage1, const int32_t* stage2,
+                      unsigned stage2_taps, right_shift_t stage2_shr)
+{
+  uint32_t hist[8] = {0};
+  double gain = fir_1x16_bit(hist, stage1);
+  int64_t sum = 0;
+  for(int k = 0; k < stage2_taps; k++)
+    sum += stage2[k];
+  return gain * ldexp((double) sum, -30 - stage2_shr);
+}
+
+extern "C" {
+
+TEST(TwoStageDecimator, inactive_channels_output_zero)
+{
+  static TestDecimator gated;
+  static TestDecimator full;
+  gated.Init();
+  full.Init();
+
+  TEST_ASSERT_EQUAL_UINT32(0xF, gated.decimator.GetActiveChannels());
+
+  gated.decimator.SetActiveChannels(0x5);
+  TEST_ASSERT_EQUAL_UINT32(0x5, gated.decimator.GetActiveChannels());
+
+  srand(8765);
+
+  for(int b = 0; b < 50; b++){
+    uint32_t pdm_block[CHANS * STAGE2_DEC_FACTOR];
+    random_block(pdm_block, b);
+
+    int32_t gated_out[CHANS];
+    int32_t full_out[CHANS];
+    gated.decimator.ProcessBlock(gated_out, pdm_block);
+    full.decimator.ProcessBlock(full_out, pdm_block);
+
+    TEST_ASSERT_EQUAL_INT32(full_out[0], gated_out[0]);
+    TEST_ASSERT_EQUAL_INT32(0, gated_out[1]);
+    TEST_ASSERT_EQUAL_INT32(full_out[2], gated_out[2]);
+    TEST_ASSERT_EQUAL_INT32(0, gated_out[3]);
+  }
+}
+
+TEST(TwoStageDecimator, reactivated_channel_is_reset)
+{
+  static TestDecimator gated;
+  static TestDecimator fresh;
+  gated.Init();
+
+  srand(3456);
+
+  uint32_t pdm_block[CHANS * STAGE2_DEC_FACTOR];
+  int32_t gated_out[CHANS];
+  int32_t fresh_out[CHANS];
+
+  for(int b = 0; b < 20; b++){
+    random_block(pdm_block, b);
+    gated.decimator.ProcessBlock(gated_out, pdm_block);
+  }
+
+  gated.decimator.SetActiveChannels(0x1);
+  for(int b = 0; b < 20; b++){
+    random_block(pdm_block, b);
+    gated.decimator.ProcessBlock(gated_out, pdm_block);
+  }
+
+  // Channels 1-3 restart as if newly initialized.
+  gated.decimator.SetActiveChannels(0xF);
+  fresh.Init();
+
+  for(int b = 0; b < 20; b++){
+    random_block(pdm_block, b);
+    gated.decimator.ProcessBlock(gated_out, pdm_block);
+    fresh.decimator.ProcessBlock(fresh_out, pdm_block);
+
+    for(int k = 1; k < CHANS; k++)
+      TEST_ASSERT_EQUAL_INT32(fresh_out[k], gated_out[k]);
+  }
+}
+
+TEST(TwoStageDecimator, pdm_delay_set_while_running)
+{
+  static const unsigned delay[CHANS] = { 0, 1, 17, 31 };
+
+  static TestDecimator delayed;
+  static TestDecimator reference;
+  delayed.Init();
+  reference.Init();
+
+  srand(7823);
+
+  uint32_t pdm_block[CHANS * STAGE2_DEC_FACTOR];
+  uint32_t ref_block[CHANS * STAGE2_DEC_FACTOR];
+  uint32_t prev[CHANS] = { 0x55555555, 0x55555555, 0x55555555, 0x55555555 };
+  int32_t delayed_out[CHANS];
+  int32_t ref_out[CHANS];
+
+  for(int b = 0; b < 40; b++){
+    // Delays are set after some blocks without delay, which must still keep
+    // track of the previous PDM word of each channel.
+    const bool delaying = (b >= 20);
+    if(b == 20){
+      for(int k = 0; k < CHANS; k++)
+        delayed.decimator.SetPdmDelay(k, delay[k]);
+    }
+
+    random_block(pdm_block, b);
+    for(int k = 0; k < CHANS; k++){
+      const unsigned bits = delaying? delay[k] : 0;
+      for(int s = 0; s < STAGE2_DEC_FACTOR; s++){
+        const uint32_t word = pdm_block[k * STAGE2_DEC_FACTOR + s];
+        ref_block[k * STAGE2_DEC_FACTOR + s] = bits? ((word << bits) | (prev[k] >> (32 - bits)))
+                                                   : word;
+        prev[k] = word;
+      }
+    }
+
+    delayed.decimator.ProcessBlock(delayed_out, pdm_block);
+    reference.decimator.ProcessBlock(ref_out, ref_block);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(ref_out, delayed_out, CHANS);
+  }
+}
+
+TEST(TwoStageDecimator, reconfigure)
+{
+  constexpr unsigned WORDS = 6 * 300;
+  constexpr unsigned SWITCH_BLOCK = 100;
+
+  // First-order sigma-delta modulation of a 500 Hz sine in each channel.
+  // Less significant bits are older samples, and bit value 0 represents +1.
+  static uint32_t pdm[CHANS][WORDS];
+  for(int k = 0; k < CHANS; k++){
+    double integ = 0;
+    for(int t = 0; t < 32 * WORDS; t++){
+      const double y = (integ >= 0)? 1.0 : -1.0;
+      integ += 0.5 * sin(2 * M_PI * 500.0 * t / 3072000.0 + k) - y;
+      if(!(t % 32))
+        pdm[k][t / 32] = 0;
+      if(y < 0)
+        pdm[k][t / 32] |= (1u << (t % 32));
+    }
+  }
+
+  // References which decimate the whole stream at 16 kHz and at 32 kHz.
+  static TestDecimator ref_16k;
+  static TestDecimator ref_32k;
+  ref_16k.Init(6);
+  ref_32k.Init(3);
+  static int32_t ref_16k_out[WORDS / 6][CHANS];
+  static int32_t ref_32k_out[WORDS / 3][CHANS];
+  for(int w = 0; w < WORDS; w += 3){
+    uint32_t block[CHANS * 6];
+    for(int k = 0; k < CHANS; k++)
+      for(int s = 0; s < 6; s++)
+        block[k * 6 + s] = pdm[k][(w + s) % WORDS];
+    if((w % 6) == 0)
+      ref_16k.decimator.ProcessBlock(ref_16k_out[w / 6], block);
+    for(int k = 0; k < CHANS; k++)
+      for(int s = 0; s < 3; s++)
+        block[k * 3 + s] = pdm[k][w + s];
+    ref_32k.decimator.ProcessBlock(ref_32k_out[w / 3], block);
+  }
+
+  int32_t max_out = 0;
+  for(int n = 0; n < WORDS / 3; n++)
+    for(int k = 0; k < CHANS; k++)
+      max_out = (abs(ref_32k_out[n][k]) > max_out)? abs(ref_32k_out[n][k]) : max_out;
+
+  static TestDecimator dec;
+  static int32_t stg2_state_32k[CHANS][MIC_ARRAY_32K_STAGE_2_TAP_COUNT];
+  dec.Init(6);
+
+  // As for a PDM rx ISR, a new block size applies from the block after next.
+  unsigned requested_words = 6;
+  unsigned isr_words = 6;
+  int switch_word = -1;
+
+  unsigned w = 0;
+  for(unsigned b = 0; w + 6 <= WORDS; b++){
+    if(b == SWITCH_BLOCK){
+      mic_array_filter_conf_t filter_conf[2];
+      default_conf(filter_conf, 3, &dec.stg1_state[0][0], &stg2_state_32k[0][0]);
+      mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+      dec.decimator.Reconfigure(decimator_conf);
+      TEST_ASSERT_TRUE(dec.decimator.IsReconfiguring());
+    }
+
+    const unsigned words = isr_words;
+    isr_words = requested_words;
+
+    uint32_t block[CHANS * 6];
+    for(int k = 0; k < CHANS; k++)
+      for(int s = 0; s < words; s++)
+        block[k * words + s] = pdm[k][w + s];
+    w += words;
+
+    dec.decimator.StartBlock(words);
+    requested_words = dec.decimator.RequiredWordsPerChannel();
+
+    int32_t out[CHANS];
+    dec.decimator.ProcessBlock(out, block);
+
+    if(words == 6){
+      TEST_ASSERT_EQUAL_INT32_ARRAY(ref_16k_out[w / 6 - 1], out, CHANS);
+      continue;
+    }
+
+    if(switch_word < 0){
+      TEST_ASSERT_FALSE(dec.decimator.IsReconfiguring());
+      switch_word = w - 3;
+      // Once stage 2 is filled, the new size is requested after the next
+      // block, and applies after the block in progress.
+      TEST_ASSERT_EQUAL_INT(6 * SWITCH_BLOCK + MIC_ARRAY_32K_STAGE_2_TAP_COUNT + 2 * 6,
+                            switch_word);
+    }
+
+    const int32_t* expected = ref_32k_out[w / 3 - 1];
+    if(w - switch_word > MIC_ARRAY_32K_STAGE_2_TAP_COUNT){
+      // Stage 2 only holds output of the new stage 1 filter.
+      TEST_ASSERT_EQUAL_INT32_ARRAY(expected, out, CHANS);
+    } else {
+      // Stage 2 was filled with scaled output of the previous stage 1 filter.
+      for(int k = 0; k < CHANS; k++)
+        TEST_ASSERT_INT32_WITHIN(max_out / 50, expected[k], out[k]);
+    }
+  }
+
+  TEST_ASSERT_TRUE(switch_word > 0);
+}
+
+TEST(TwoStageDecimator, default_presets_passband_gain)
+{
+  constexpr unsigned SAMPLES = 96;
+  constexpr double AMPLITUDE = 0.5;
+
+  struct {
+    unsigned dec_factor;
+    const uint32_t* stage1;
+    const int32_t* stage2;
+    unsigned taps;
+    right_shift_t shr;
+    double tone;
+  } presets[] = {
+    { 12, stage1_coef, stage2_8k_coefs, MIC_ARRAY_8K_STAGE_2_TAP_COUNT, stage2_8k_shift, 1000 },
+    { 6, stage1_coef, stage2_coef, STAGE2_TAP_COUNT, stage2_shr, 1000 },
+    { 4, stage1_48k_coefs, stage2_24k_coefs, MIC_ARRAY_24K_STAGE_2_TAP_COUNT, stage2_24k_shift, 3000 },
+    { 1, stage1_96k_coefs, stage2_96k_coefs, MIC_ARRAY_96K_STAGE_2_TAP_COUNT, stage2_96k_shift, 1000 },
+    { 1, stage1_96k_coefs, stage2_96k_coefs, MIC_ARRAY_96K_STAGE_2_TAP_COUNT, stage2_96k_shift, 30000 },
+  };
+
+  for(int p = 0; p < sizeof(presets) / sizeof(presets[0]); p++){
+    const unsigned df = presets[p].dec_factor;
+    const double fs = 96000.0 / df;
+
+    static uint32_t stg1_state[CHANS][8];
+    static int32_t stg2_state[CHANS][MIC_ARRAY_8K_STAGE_2_TAP_COUNT];
+    mic_array_filter_conf_t filter_conf[2];
+    stage1_conf(filter_conf[0], presets[p].stage1, &stg1_state[0][0]);
+    fir_stage_conf(filter_conf[1], presets[p].stage2, presets[p].taps, df, presets[p].shr,
+                   &stg2_state[0][0]);
+
+    static mic_array::TwoStageDecimator<CHANS> dec;
+    mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+    dec.Init(decimator_conf);
+
+    // Let the filters settle, then measure a whole number of periods.
+    SineModulator mod(presets[p].tone, AMPLITUDE);
+    const unsigned warmup = presets[p].taps / df + 2;
+    static int32_t out[SAMPLES][CHANS];
+    for(int n = 0; n < warmup + SAMPLES; n++){
+      uint32_t block[CHANS * 12];
+      for(int s = 0; s < df; s++){
+        const uint32_t word = mod.NextWord();
+        for(int k = 0; k < CHANS; k++)
+          block[k * df + s] = word;
+      }
+      dec.ProcessBlock(out[(n < warmup)? 0 : n - warmup], block);
+    }
+
+    int32_t samples[SAMPLES];
+    for(int n = 0; n < SAMPLES; n++)
+      samples[n] = out[n][0];
+
+    const double expected = AMPLITUDE * dc_gain(presets[p].stage1, presets[p].stage2,
+                                                presets[p].taps, presets[p].shr);
+    const double amplitude = tone_amplitude(samples, SAMPLES, presets[p].tone, fs);
+    TEST_ASSERT_INT32_WITHIN((int32_t) (0.05 * expected), (int32_t) expected, (int32_t) amplitude);
+  }
+}
+
+TEST(TwoStageDecimator, reduced_stage1_coef_bits)
+{
+  constexpr unsigned SAMPLES = 96;
+  constexpr unsigned WARMUP = STAGE2_TAP_COUNT / STAGE2_DEC_FACTOR + 2;
+  constexpr double AMPLITUDE = 0.5;
+  const unsigned coef_bits[] = { 8, 10, 12, 14 };
+
+  const double full_scale = dc_gain(stage1_coef, stage2_coef, STAGE2_TAP_COUNT, stage2_shr);
+
+  for(int b = 0; b < sizeof(coef_bits) / sizeof(coef_bits[0]); b++){
+    const unsigned bits = coef_bits[b];
+
+    static TestDecimator ref;
+    ref.Init();
+
+    // The last 8 * bits words of stage1_coef are the same filter rounded to
+    // that many bit-planes.
+    static TestDecimator dec;
+    {
+      mic_array_filter_conf_t filter_conf[2];
+      default_conf(filter_conf, STAGE2_DEC_FACTOR, &dec.stg1_state[0][0], &dec.stg2_state[0][0]);
+      filter_conf[0].coef = (int32_t*) &stage1_coef[8 * (16 - bits)];
+      filter_conf[0].coef_bits = bits;
+      mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+      dec.decimator.Init(decimator_conf);
+    }
+
+    SineModulator mod(1000, AMPLITUDE);
+    static int32_t out[SAMPLES][CHANS];
+    for(int n = 0; n < WARMUP + SAMPLES; n++){
+      uint32_t block[CHANS * STAGE2_DEC_FACTOR];
+      for(int s = 0; s < STAGE2_DEC_FACTOR; s++){
+        const uint32_t word = mod.NextWord();
+        for(int k = 0; k < CHANS; k++)
+          block[k * STAGE2_DEC_FACTOR + s] = word;
+      }
+      int32_t expected[CHANS];
+      int32_t* sample_out = out[(n < WARMUP)? 0 : n - WARMUP];
+      ref.decimator.ProcessBlock(expected, block);
+      dec.decimator.ProcessBlock(sample_out, block);
+
+      // The rounding error of each coefficient is at most 2^(15-bits), so
+      // the error relative to full scale halves with each extra bit.
+      for(int k = 0; k < CHANS; k++)
+        TEST_ASSERT_INT32_WITHIN((int32_t) ldexp(full_scale, 4 - (int) bits), expected[k], sample_out[k]);
+    }
+
+    int32_t samples[SAMPLES];
+    for(int n = 0; n < SAMPLES; n++)
+      samples[n] = out[n][0];
+    const double amplitude = tone_amplitude(samples, SAMPLES, 1000, 16000);
+    TEST_ASSERT_INT32_WITHIN((int32_t) (0.03 * AMPLITUDE * full_scale),
+                             (int32_t) (AMPLITUDE * full_scale), (int32_t) amplitude);
+  }
+}
+
+}
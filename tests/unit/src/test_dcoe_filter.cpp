@@ -19,6 +19,12 @@ TEST_GROUP_RUNNER(dcoe_filter) {
   RUN_TEST_CASE(dcoe_filter, states4);
   RUN_TEST_CASE(dcoe_filter, states8);
   RUN_TEST_CASE(dcoe_filter, states32);
+  RUN_TEST_CASE(dcoe_filter, bit_exact1);
+  RUN_TEST_CASE(dcoe_filter, bit_exact16);
+  RUN_TEST_CASE(dcoe_filter, frame_1x16);
+  RUN_TEST_CASE(dcoe_filter, frame_4x1);
+  RUN_TEST_CASE(dcoe_filter, frame_8x32);
+  RUN_TEST_CASE(dcoe_filter, frame_16x240);
 }
 
 TEST_GROUP(dcoe_filter);
@@ -79,3 +85,99 @@ TEST(dcoe_filter, states8)  { test_dcoe_filter<8,1000>(); }
 TEST(dcoe_filter, states32) { test_dcoe_filter<32,1000>(); }
 
 }
+
+
+// Reference 64-bit implementation of the DCOE filter, which the optimised
+// implementations must match exactly.
+static int32_t dcoe_reference(
+    int64_t* prev_y,
+    int32_t input)
+{
+  const int64_t x_new = ((int64_t)input) << 32;
+  *prev_y += x_new;
+  int32_t output = *prev_y >> 32;
+  *prev_y = *prev_y - (*prev_y >> 6);
+  *prev_y = *prev_y - x_new;
+  return output;
+}
+
+static int32_t rand_sample(int r)
+{
+  // Include full-scale runs, which exercise the carry between state words.
+  if((r % 300) < 20)
+    return (r & 0x100)? INT32_MAX : INT32_MIN;
+  return (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+}
+
+template <unsigned CHANS, unsigned ITER_COUNT>
+static
+void test_dcoe_filter_bit_exact()
+{
+  srand(4563 + CHANS);
+
+  dcoe_chan_state_t states[CHANS];
+  int64_t ref_states[CHANS];
+
+  dcoe_state_init(states, CHANS);
+  for(int k = 0; k < CHANS; k++) ref_states[k] = 0;
+
+  for(int r = 0; r < ITER_COUNT; r++){
+    int32_t input[CHANS];
+    int32_t output[CHANS];
+    int32_t expected[CHANS];
+
+    for(int k = 0; k < CHANS; k++){
+      input[k] = rand_sample(r);
+      expected[k] = dcoe_reference(&ref_states[k], input[k]);
+    }
+
+    dcoe_filter(output, states, input, CHANS);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, output, CHANS);
+    for(int k = 0; k < CHANS; k++)
+      TEST_ASSERT_TRUE(ref_states[k] == states[k].prev_y);
+  }
+}
+
+template <unsigned CHANS, unsigned SAMPLE_COUNT>
+static
+void test_dcoe_filter_frame()
+{
+  srand(97867*CHANS + SAMPLE_COUNT);
+
+  dcoe_chan_state_t states[CHANS];
+  int64_t ref_states[CHANS];
+
+  dcoe_state_init(states, CHANS);
+  for(int k = 0; k < CHANS; k++) ref_states[k] = 0;
+
+  for(int r = 0; r < 20; r++){
+    int32_t frame[CHANS][SAMPLE_COUNT];
+    int32_t expected[CHANS][SAMPLE_COUNT];
+
+    for(int s = 0; s < SAMPLE_COUNT; s++){
+      for(int k = 0; k < CHANS; k++){
+        frame[k][s] = rand_sample(r * SAMPLE_COUNT + s);
+        expected[k][s] = dcoe_reference(&ref_states[k], frame[k][s]);
+      }
+    }
+
+    dcoe_filter_frame(&frame[0][0], states, CHANS, SAMPLE_COUNT);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(&expected[0][0], &frame[0][0], CHANS * SAMPLE_COUNT);
+    for(int k = 0; k < CHANS; k++)
+      TEST_ASSERT_TRUE(ref_states[k] == states[k].prev_y);
+  }
+}
+
+extern "C" {
+
+TEST(dcoe_filter, bit_exact1)   { test_dcoe_filter_bit_exact<1,5000>();  }
+TEST(dcoe_filter, bit_exact16)  { test_dcoe_filter_bit_exact<16,5000>(); }
+
+TEST(dcoe_filter, frame_1x16)   { test_dcoe_filter_frame<1,16>();   }
+TEST(dcoe_filter, frame_4x1)    { test_dcoe_filter_frame<4,1>();    }
+TEST(dcoe_filter, frame_8x32)   { test_dcoe_filter_frame<8,32>();   }
+TEST(dcoe_filter, frame_16x240) { test_dcoe_filter_frame<16,240>(); }
+
+}
@@ -0,0 +1,84 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array/etc/fir_1xN_bit.h"
+#include "mic_array/etc/filters_default.h"
+
+TEST_GROUP_RUNNER(fir_1xN_bit) {
+  RUN_TEST_CASE(fir_1xN_bit, matches_reference);
+  RUN_TEST_CASE(fir_1xN_bit, default_filter_dc_gain);
+}
+
+TEST_GROUP(fir_1xN_bit);
+TEST_SETUP(fir_1xN_bit) {}
+TEST_TEAR_DOWN(fir_1xN_bit) {}
+
+#define REPS    (100)
+
+static const unsigned coef_bits[] = { 8, 10, 12, 14, 16 };
+
+static uint32_t random_word()
+{
+  return (uint32_t) rand() ^ ((uint32_t) rand() << 16);
+}
+
+// Inner product of the signal with the coefficients' `bits` most significant
+// bit-planes, each holding 256 +/-1 values (bit value 0 is +1).
+static int32_t fir_1xN_bit_ref(const uint32_t signal[8], const uint32_t coef[], unsigned bits)
+{
+  int64_t acc = 0;
+  for(unsigned p = 0; p < bits; p++){
+    const unsigned k = 16 - bits + p;
+    const int32_t magnitude = (k == 15)? 0x7FFF : (1 << k);
+    int32_t dot = 0;
+    for(int w = 0; w < 8; w++)
+      dot += 32 - 2 * __builtin_popcount(signal[w] ^ coef[8 * p + w]);
+    acc += magnitude * dot;
+  }
+  return (int32_t) (acc << 7);
+}
+
+TEST(fir_1xN_bit, matches_reference)
+{
+  srand(23578);
+
+  uint32_t signal[8];
+  uint32_t coef[16 * 8];
+
+  for(int r = 0; r < REPS; r++){
+    for(int k = 0; k < 8; k++)
+      signal[k] = random_word();
+    for(int k = 0; k < 16 * 8; k++)
+      coef[k] = random_word();
+
+    for(int b = 0; b < sizeof(coef_bits) / sizeof(coef_bits[0]); b++){
+      const int32_t expected = fir_1xN_bit_ref(signal, coef, coef_bits[b]);
+      TEST_ASSERT_EQUAL_INT32(expected, fir_1xN_bit(signal, coef, coef_bits[b]));
+    }
+    TEST_ASSERT_EQUAL_INT32(fir_1x16_bit(signal, coef), fir_1xN_bit(signal, coef, 0));
+  }
+}
+
+TEST(fir_1xN_bit, default_filter_dc_gain)
+{
+  // The last 8 * N words of stage1_coef are the same filter with N bit-planes,
+  // so it has about the same DC gain. Its zero taps all round to the same
+  // small value, which adds about 1.6% at 8 bits.
+  uint32_t signal[8] = {0};
+  const int32_t full = fir_1x16_bit(signal, stage1_coef);
+
+  for(int b = 0; b < sizeof(coef_bits) / sizeof(coef_bits[0]); b++){
+    const unsigned bits = coef_bits[b];
+    const int32_t reduced = fir_1xN_bit(signal, &stage1_coef[8 * (16 - bits)], bits);
+    TEST_ASSERT_INT32_WITHIN(full >> (bits - 3), full, reduced);
+  }
+}
@@ -0,0 +1,322 @@
+// Copyright 2026 XMOS LIMITED.
+// This Software is subject to the terms of the XMOS Public Licence: Version 1.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <xcore/assert.h>
+#include <stdarg.h>
+#include <platform.h>
+
+#include "unity_fixture.h"
+
+#include "mic_array.h"
+#include "mic_array/cpp/MicArray.hpp"
+
+extern "C" {
+
+TEST_GROUP_RUNNER(mic_array_decimator_latency) {
+  RUN_TEST_CASE(mic_array_decimator_latency, default_presets_step_response);
+  RUN_TEST_CASE(mic_array_decimator_latency, min_phase_presets);
+  RUN_TEST_CASE(mic_array_decimator_latency, default_8k_3stg_step_response);
+  RUN_TEST_CASE(mic_array_decimator_latency, samples_per_frame);
+  RUN_TEST_CASE(mic_array_decimator_latency, resampler_stage);
+  RUN_TEST_CASE(mic_array_decimator_latency, cic_preset_step_response);
+}
+
+TEST_GROUP(mic_array_decimator_latency);
+TEST_SETUP(mic_array_decimator_latency) {}
+TEST_TEAR_DOWN(mic_array_decimator_latency) {}
+
+TEST_GROUP_RUNNER(mic_array_get_latency) {
+  RUN_TEST_CASE(mic_array_get_latency, default_16k_step_response);
+}
+
+TEST_GROUP(mic_array_get_latency);
+TEST_SETUP(mic_array_get_latency) {}
+TEST_TEAR_DOWN(mic_array_get_latency) {}
+
+}
+
+#define MAX_BLOCK_WORDS   (12)
+#define STEP_BLOCK        (50)
+#define BLOCKS            (150)
+
+// PDM words with a mean of 0 and +0.5 (a bit value of 0 represents +1).
+#define PDM_ZERO          (0x55555555)
+#define PDM_HALF          (0x11111111)
+
+struct Preset {
+  const uint32_t* stage1_coef;
+  int32_t* stage2_coef;
+  unsigned stage2_taps;
+  unsigned stage2_dec_factor;
+  right_shift_t stage2_shr;
+};
+
+static const Preset linear_presets[] = {
+  { stage1_coef,       stage2_8k_coefs,  MIC_ARRAY_8K_STAGE_2_TAP_COUNT,  12, 2 },
+  { stage1_coef,       stage2_coef,      STAGE2_TAP_COUNT,                 6, 1 },
+  { stage1_48k_coefs,  stage2_24k_coefs, MIC_ARRAY_24K_STAGE_2_TAP_COUNT,  4, 2 },
+  { stage1_32k_coefs,  stage2_32k_coefs, MIC_ARRAY_32K_STAGE_2_TAP_COUNT,  3, 2 },
+  { stage1_48k_coefs,  stage2_48k_coefs, MIC_ARRAY_48K_STAGE_2_TAP_COUNT,  2, 2 },
+  { stage1_96k_coefs,  stage2_96k_coefs, MIC_ARRAY_96K_STAGE_2_TAP_COUNT,  1, 1 },
+};
+
+static const Preset min_phase_presets[] = {
+  { stage1_coef,       stage2_16k_min_phase_coefs, MIC_ARRAY_16K_MIN_PHASE_STAGE_2_TAP_COUNT, 6, 1 },
+  { stage1_32k_coefs,  stage2_32k_min_phase_coefs, MIC_ARRAY_32K_MIN_PHASE_STAGE_2_TAP_COUNT, 3, 2 },
+  { stage1_48k_coefs,  stage2_48k_min_phase_coefs, MIC_ARRAY_48K_MIN_PHASE_STAGE_2_TAP_COUNT, 2, 2 },
+};
+
+static uint32_t stg1_state[8];
+static int32_t stg2_state[MIC_ARRAY_8K_STAGE_2_TAP_COUNT];
+static int32_t stg3_state[MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT];
+
+static void preset_conf(mic_array_filter_conf_t filter_conf[2], const Preset& preset)
+{
+  memset(filter_conf, 0, 2 * sizeof(mic_array_filter_conf_t));
+  filter_conf[0].coef = (int32_t*) preset.stage1_coef;
+  filter_conf[0].num_taps = 256;
+  filter_conf[0].state = (int32_t*) stg1_state;
+  filter_conf[0].state_words_per_channel = 8;
+  filter_conf[1].decimation_factor = preset.stage2_dec_factor;
+  filter_conf[1].coef = preset.stage2_coef;
+  filter_conf[1].num_taps = preset.stage2_taps;
+  filter_conf[1].shr = preset.stage2_shr;
+  filter_conf[1].state = stg2_state;
+  filter_conf[1].state_words_per_channel = preset.stage2_taps;
+  memset(stg2_state, 0, sizeof(stg2_state));
+}
+
+// Measure the DC group delay of a decimator, in output samples, from its
+// response to a step at the start of block STEP_BLOCK. `process` processes
+// a block of `block_words` PDM words and outputs one sample.
+//
+// The change in output from sample n-1 to sample n is the sum of the impulse
+// response over the PDM samples between them, so the first moment of these
+// changes is the first moment of the impulse response.
+template <class TProcess>
+static double step_delay(unsigned block_words, int32_t* final_value, TProcess&& process)
+{
+  const unsigned W = 32 * block_words;
+  int32_t prev = 0;
+  double sum = 0, moment = 0;
+
+  for(int n = 0; n < BLOCKS; n++){
+    uint32_t block[MAX_BLOCK_WORDS];
+    for(int k = 0; k < block_words; k++)
+      block[k] = (n < STEP_BLOCK)? PDM_ZERO : PDM_HALF;
+
+    int32_t sample = process(block);
+    if(n >= STEP_BLOCK){
+      // Centre of the PDM samples since the previous output, relative to the step
+      const double t = (n - STEP_BLOCK + 1) * (double) W - 1 - (W - 1) / 2.0;
+      sum += (sample - prev);
+      moment += (sample - prev) * t;
+    }
+    prev = sample;
+  }
+  *final_value = prev;
+  return moment / sum / W;
+}
+
+static double preset_step_delay(const Preset& preset, int32_t* final_value)
+{
+  mic_array_filter_conf_t filter_conf[2];
+  preset_conf(filter_conf, preset);
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+
+  static mic_array::TwoStageDecimator<1> dec;
+  dec.Init(decimator_conf);
+
+  return step_delay(preset.stage2_dec_factor, final_value, [&](uint32_t* block){
+    int32_t sample;
+    dec.ProcessBlock(&sample, block);
+    return sample;
+  });
+}
+
+static unsigned preset_latency(const Preset& preset, unsigned samples_per_frame)
+{
+  mic_array_filter_conf_t filter_conf[2];
+  preset_conf(filter_conf, preset);
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+  return mic_array_decimator_latency(&decimator_conf, samples_per_frame);
+}
+
+extern "C" {
+
+TEST(mic_array_decimator_latency, default_presets_step_response)
+{
+  for(int p = 0; p < sizeof(linear_presets) / sizeof(linear_presets[0]); p++){
+    int32_t final_value;
+    const double delay = preset_step_delay(linear_presets[p], &final_value);
+    const unsigned latency = preset_latency(linear_presets[p], 1);
+
+    TEST_ASSERT_TRUE(final_value > 0);
+    TEST_ASSERT_TRUE(delay <= latency);
+    TEST_ASSERT_TRUE(delay > latency - 1);
+  }
+}
+
+TEST(mic_array_decimator_latency, min_phase_presets)
+{
+  // Linear phase presets with the same decimation factors
+  const Preset* linear[] = { &linear_presets[1], &linear_presets[3], &linear_presets[4] };
+
+  for(int p = 0; p < sizeof(min_phase_presets) / sizeof(min_phase_presets[0]); p++){
+    int32_t final_value, linear_final_value;
+    const double delay = preset_step_delay(min_phase_presets[p], &final_value);
+    const double linear_delay = preset_step_delay(*linear[p], &linear_final_value);
+    const unsigned latency = preset_latency(min_phase_presets[p], 1);
+
+    TEST_ASSERT_TRUE(delay <= latency);
+    TEST_ASSERT_TRUE(delay > latency - 1);
+
+    // Lower latency, with the same DC gain
+    TEST_ASSERT_TRUE(latency < preset_latency(*linear[p], 1));
+    TEST_ASSERT_TRUE(delay < linear_delay / 2);
+    TEST_ASSERT_INT32_WITHIN(linear_final_value / 1000, linear_final_value, final_value);
+  }
+}
+
+TEST(mic_array_decimator_latency, default_8k_3stg_step_response)
+{
+  mic_array_filter_conf_t filter_conf[3];
+  memset(filter_conf, 0, sizeof(filter_conf));
+  memset(stg2_state, 0, sizeof(stg2_state));
+  memset(stg3_state, 0, sizeof(stg3_state));
+  filter_conf[0].coef = (int32_t*) stage1_coef;
+  filter_conf[0].num_taps = 256;
+  filter_conf[0].state = (int32_t*) stg1_state;
+  filter_conf[0].state_words_per_channel = 8;
+  filter_conf[1].decimation_factor = 2;
+  filter_conf[1].coef = stage2_8k_3stg_coefs;
+  filter_conf[1].num_taps = MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT;
+  filter_conf[1].shr = stage2_8k_3stg_shift;
+  filter_conf[1].state = stg2_state;
+  filter_conf[1].state_words_per_channel = MIC_ARRAY_8K_3STG_STAGE_2_TAP_COUNT;
+  filter_conf[2].decimation_factor = 6;
+  filter_conf[2].coef = stage3_8k_3stg_coefs;
+  filter_conf[2].num_taps = MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT;
+  filter_conf[2].shr = stage3_8k_3stg_shift;
+  filter_conf[2].state = stg3_state;
+  filter_conf[2].state_words_per_channel = MIC_ARRAY_8K_3STG_STAGE_3_TAP_COUNT;
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 3 };
+
+  static mic_array::ThreeStageDecimator<1> dec;
+  dec.Init(decimator_conf);
+
+  int32_t final_value;
+  const double delay = step_delay(12, &final_value, [&](uint32_t* block){
+    int32_t sample;
+    TEST_ASSERT_TRUE(dec.ProcessBlock(&sample, block));
+    return sample;
+  });
+  const unsigned latency = mic_array_decimator_latency(&decimator_conf, 1);
+
+  TEST_ASSERT_TRUE(final_value > 0);
+  TEST_ASSERT_TRUE(delay <= latency);
+  TEST_ASSERT_TRUE(delay > latency - 1);
+}
+
+TEST(mic_array_decimator_latency, samples_per_frame)
+{
+  const unsigned latency = preset_latency(linear_presets[1], 1);
+  TEST_ASSERT_EQUAL_UINT(latency + 15, preset_latency(linear_presets[1], 16));
+  TEST_ASSERT_EQUAL_UINT(latency + 255, preset_latency(linear_presets[1], 256));
+}
+
+TEST(mic_array_decimator_latency, resampler_stage)
+{
+  // Stage 1 with equal taps has a delay of 127.5 PDM samples, and stage 2
+  // delays by 4 samples and decimates by 2.
+  static uint32_t s1_coef[STAGE1_WORDS];
+  int32_t s2_coef[8] = { 0, 0, 0, 0, 1 << 30, 0, 0, 0 };
+
+  // A 3/4 resampler with 4 taps per phase, phase p holds h[p + 3*j]. The
+  // prototype is a delay of 5 samples at 3 times the input rate.
+  int32_t s3_coef[12] = {0};
+  s3_coef[2 * 4 + 1] = 1 << 30;
+
+  mic_array_filter_conf_t filter_conf[3];
+  memset(filter_conf, 0, sizeof(filter_conf));
+  filter_conf[0].coef = (int32_t*) s1_coef;
+  filter_conf[0].num_taps = 256;
+  filter_conf[1].coef = s2_coef;
+  filter_conf[1].num_taps = 8;
+  filter_conf[1].decimation_factor = 2;
+  filter_conf[2].coef = s3_coef;
+  filter_conf[2].num_taps = 12;
+  filter_conf[2].decimation_factor = 4;
+  filter_conf[2].interpolation_factor = 3;
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 3 };
+
+  // ((127.5 / 32 + 4) / 2 * 3 + 5) / 4 = 4.24
+  TEST_ASSERT_EQUAL_UINT(5, mic_array_decimator_latency(&decimator_conf, 1));
+
+  // Without the resampler, (127.5 / 32 + 4) / 2 = 3.99
+  decimator_conf.num_filter_stages = 2;
+  TEST_ASSERT_EQUAL_UINT(4, mic_array_decimator_latency(&decimator_conf, 1));
+}
+
+TEST(mic_array_decimator_latency, cic_preset_step_response)
+{
+  static uint32_t cic_state[2 * mic_array::CicCompDecimator<1>::MAX_ORDER];
+  mic_array_filter_conf_t filter_conf[2];
+  memset(filter_conf, 0, sizeof(filter_conf));
+  memset(stg2_state, 0, sizeof(stg2_state));
+  filter_conf[0].cic_order = MIC_ARRAY_16K_CIC_ORDER;
+  filter_conf[0].decimation_factor = 32;
+  filter_conf[0].state = (int32_t*) cic_state;
+  filter_conf[0].state_words_per_channel = sizeof(cic_state) / sizeof(cic_state[0]);
+  filter_conf[1].decimation_factor = 6;
+  filter_conf[1].coef = stage2_16k_cic_coefs;
+  filter_conf[1].num_taps = MIC_ARRAY_16K_CIC_STAGE_2_TAP_COUNT;
+  filter_conf[1].shr = stage2_16k_cic_shift;
+  filter_conf[1].state = stg2_state;
+  filter_conf[1].state_words_per_channel = MIC_ARRAY_16K_CIC_STAGE_2_TAP_COUNT;
+  mic_array_decimator_conf_t decimator_conf = { &filter_conf[0], 2 };
+
+  static mic_array::CicCompDecimator<1> dec;
+  dec.Init(decimator_conf);
+
+  int32_t final_value;
+  const double delay = step_delay(6, &final_value, [&](uint32_t* block){
+    int32_t sample;
+    dec.ProcessBlock(&sample, block);
+    return sample;
+  });
+  const unsigned latency = mic_array_decimator_latency(&decimator_conf, 1);
+
+  // Lower latency than the default 16 kHz filters.
+  TEST_ASSERT_TRUE(final_value > 0);
+  TEST_ASSERT_TRUE(delay <= latency);
+  TEST_ASSERT_TRUE(delay > latency - 1);
+  TEST_ASSERT_TRUE(latency < preset_latency(linear_presets[1], 1));
+}
+
+// The default filters keep int32 coefficients with
+// MIC_ARRAY_CONFIG_USE_S16_FILTERS enabled, which is checked by the s16 build.
+TEST(mic_array_get_latency, default_16k_step_response)
+{
+  static pdm_rx_resources_t pdm_res = PDM_RX_RESOURCES_SDR(PORT_MCLK_IN,
+                                                           PORT_PDM_CLK,
+                                                           PORT_PDM_DATA,
+                                                           24576000,
+                                                           3072000,
+                                                           XS1_CLKBLK_1);
+  mic_array_init(&pdm_res, NULL, 16000);
+
+  int32_t final_value;
+  const double delay = preset_step_delay(linear_presets[1], &final_value);
+  const unsigned latency = mic_array_get_latency() - (MIC_ARRAY_CONFIG_SAMPLES_PER_FRAME - 1);
+
+  TEST_ASSERT_TRUE(delay <= latency);
+  TEST_ASSERT_TRUE(delay > latency - 1);
+}
+
+}